@@ -20,6 +20,7 @@
 #include <omp.h>
 
 #include <algorithm>
+#include <cstring>
 
 namespace
 {
@@ -31,6 +32,13 @@ const char* vtkSMPTools::GetBackend()
   return VTK_SMP_BACKEND;
 }
 
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  // This implementation is selected at configure time.
+  return backend && !strcmp(backend, VTK_SMP_BACKEND);
+}
+
 void vtkSMPTools::Initialize(int numThreads)
 {
 #pragma omp single
@@ -0,0 +1,285 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPThreadPool.h"
+
+#include <algorithm>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+namespace
+{
+// Index of the queue of the current thread if it is a worker of the pool,
+// -1 otherwise.
+thread_local int vtkSMPThreadPoolQueueId = -1;
+}
+
+//------------------------------------------------------------------------------
+// The chunks of a For(), handed out to the threads taking part in it.
+struct vtkSMPThreadPool::Job
+{
+  ExecuteFunctorPtrType FunctorExecuter;
+  void* Functor;
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+  vtkIdType NumberOfChunks;
+  std::atomic<vtkIdType> NextChunk;
+  std::atomic<vtkIdType> NumberOfDoneChunks;
+  std::mutex Mutex;
+  std::condition_variable Finished;
+};
+
+//------------------------------------------------------------------------------
+// A task is an invitation to help with a job. Tasks left once the job is
+// done find no chunk to process and are simply dropped.
+struct vtkSMPThreadPool::Queue
+{
+  std::mutex Mutex;
+  std::deque<std::shared_ptr<Job>> Tasks;
+};
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool& vtkSMPThreadPool::GetInstance()
+{
+  static vtkSMPThreadPool pool;
+  return pool;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::vtkSMPThreadPool()
+  : NumberOfThreads(0)
+  , NumberOfQueuedTasks(0)
+  , Stopping(false)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::~vtkSMPThreadPool()
+{
+  this->Stop();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Initialize(int numThreads)
+{
+  if (vtkSMPThreadPoolQueueId >= 0)
+  {
+    return; // a worker cannot restart its own pool
+  }
+  if (numThreads <= 0)
+  {
+    numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
+  std::lock_guard<std::mutex> lock(this->InitializeMutex);
+  if (numThreads != this->NumberOfThreads)
+  {
+    this->Stop();
+    this->Start(numThreads);
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPThreadPool::GetNumberOfThreads()
+{
+  std::lock_guard<std::mutex> lock(this->InitializeMutex);
+  if (!this->NumberOfThreads)
+  {
+    this->Start(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+  }
+  return this->NumberOfThreads;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Start(int numThreads)
+{
+  this->NumberOfThreads = numThreads;
+  for (int i = 0; i < numThreads; ++i)
+  {
+    this->Queues.emplace_back(new Queue);
+  }
+  for (int i = 0; i + 1 < numThreads; ++i)
+  {
+    this->Workers.emplace_back(&vtkSMPThreadPool::Work, this, i);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->WakeMutex);
+    this->Stopping = true;
+  }
+  this->Wake.notify_all();
+  for (std::thread& worker : this->Workers)
+  {
+    worker.join();
+  }
+  this->Workers.clear();
+  this->Queues.clear();
+  this->NumberOfQueuedTasks = 0;
+  this->Stopping = false;
+  this->NumberOfThreads = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::For(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  int numThreads = this->GetNumberOfThreads();
+  vtkIdType n = last - first;
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = n / (numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  std::shared_ptr<Job> job = std::make_shared<Job>();
+  job->FunctorExecuter = functorExecuter;
+  job->Functor = functor;
+  job->First = first;
+  job->Last = last;
+  job->Grain = grain;
+  job->NumberOfChunks = (n + grain - 1) / grain;
+  job->NextChunk = 0;
+  job->NumberOfDoneChunks = 0;
+
+  // Workers queue the tasks of nested jobs on their own queue; the other
+  // threads use the shared queue.
+  int queueId = vtkSMPThreadPoolQueueId >= 0 ? vtkSMPThreadPoolQueueId : numThreads - 1;
+  vtkIdType numTasks = std::min(static_cast<vtkIdType>(numThreads - 1), job->NumberOfChunks - 1);
+  if (numTasks > 0)
+  {
+    this->Push(queueId, job, static_cast<int>(numTasks));
+  }
+
+  this->RunJob(*job);
+
+  // Wait for the chunks still being processed by other threads. Running
+  // other tasks meanwhile could re-enter a functor whose thread local state
+  // is in use on this thread (e.g. the outer loop of this For()).
+  std::unique_lock<std::mutex> lock(job->Mutex);
+  job->Finished.wait(
+    lock, [&job] { return job->NumberOfDoneChunks.load() == job->NumberOfChunks; });
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Push(int queueId, const std::shared_ptr<Job>& job, int numTasks)
+{
+  {
+    Queue& queue = *this->Queues[queueId];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    for (int i = 0; i < numTasks; ++i)
+    {
+      queue.Tasks.push_back(job);
+    }
+  }
+  this->NumberOfQueuedTasks += numTasks;
+
+  {
+    // Make sure that the workers are either waiting or will see the tasks.
+    std::lock_guard<std::mutex> lock(this->WakeMutex);
+  }
+  if (numTasks == 1)
+  {
+    this->Wake.notify_one();
+  }
+  else
+  {
+    this->Wake.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Run the newest task of the given queue or, if it is empty, steal the
+// oldest task of another queue.
+bool vtkSMPThreadPool::RunTask(int queueId)
+{
+  std::shared_ptr<Job> job;
+  {
+    Queue& queue = *this->Queues[queueId];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty())
+    {
+      job = std::move(queue.Tasks.back());
+      queue.Tasks.pop_back();
+    }
+  }
+
+  int numQueues = static_cast<int>(this->Queues.size());
+  for (int i = 1; !job && i < numQueues; ++i)
+  {
+    Queue& queue = *this->Queues[(queueId + i) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty())
+    {
+      job = std::move(queue.Tasks.front());
+      queue.Tasks.pop_front();
+    }
+  }
+
+  if (!job)
+  {
+    return false;
+  }
+  --this->NumberOfQueuedTasks;
+  this->RunJob(*job);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::RunJob(Job& job)
+{
+  for (vtkIdType chunk = job.NextChunk++; chunk < job.NumberOfChunks; chunk = job.NextChunk++)
+  {
+    job.FunctorExecuter(job.Functor, job.First + chunk * job.Grain, job.Grain, job.Last);
+    if (++job.NumberOfDoneChunks == job.NumberOfChunks)
+    {
+      std::lock_guard<std::mutex> lock(job.Mutex);
+      job.Finished.notify_all();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Work(int queueId)
+{
+  vtkSMPThreadPoolQueueId = queueId;
+  for (;;)
+  {
+    if (this->RunTask(queueId))
+    {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->WakeMutex);
+    this->Wake.wait(lock, [this] { return this->Stopping || this->NumberOfQueuedTasks > 0; });
+    if (this->Stopping)
+    {
+      return;
+    }
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
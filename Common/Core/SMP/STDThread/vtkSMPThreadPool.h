@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadPool - A work stealing pool of std::thread used by the
+// STDThread backend of vtkSMPTools.
+// .SECTION Description
+// The pool owns one queue of tasks per worker thread, plus one shared queue
+// for the threads that do not belong to the pool (e.g., the main thread).
+// Executing a For() creates a job whose chunks are handed out through an
+// atomic counter; the calling thread pushes one task per other thread that
+// may help on its own queue and starts processing chunks. Idle workers steal
+// these tasks and join the job. Once no chunk is left, the calling thread
+// blocks until the chunks taken by other threads are done; it does not run
+// other tasks meanwhile, so that a functor is never re-entered on a thread
+// using its thread local state. A For() called from a worker (i.e., nested
+// in another For()) therefore only queues more work for the existing
+// threads: no thread is ever created after the pool is started.
+
+#ifndef vtkSMPThreadPool_h
+#define vtkSMPThreadPool_h
+
+#include "vtkType.h"
+
+#include "vtkSMPToolsInternal.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+class vtkSMPThreadPool
+{
+public:
+  // Description:
+  // Return the pool shared by all the threads of the process.
+  static vtkSMPThreadPool& GetInstance();
+
+  // Description:
+  // Set the number of threads executing a For(), including the calling
+  // thread. 0 means the number of hardware threads. The pool is restarted
+  // with the new size; this must not be called during a For().
+  void Initialize(int numThreads);
+
+  // Description:
+  // Return the number of threads executing a For(), including the calling
+  // thread.
+  int GetNumberOfThreads();
+
+  // Description:
+  // Execute functorExecuter on the chunks of [first, last) of size grain
+  // on the threads of the pool, and return once all of them are done.
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+    ExecuteFunctorPtrType functorExecuter, void* functor);
+
+  ~vtkSMPThreadPool();
+
+private:
+  struct Job;
+  struct Queue;
+
+  vtkSMPThreadPool();
+  void Start(int numThreads);
+  void Stop();
+  void Push(int queueId, const std::shared_ptr<Job>& job, int numTasks);
+  bool RunTask(int queueId);
+  void RunJob(Job& job);
+  void Work(int queueId);
+
+  std::mutex InitializeMutex;
+  int NumberOfThreads;
+  std::vector<std::unique_ptr<Queue>> Queues; // per worker, then shared
+  std::vector<std::thread> Workers;
+
+  std::mutex WakeMutex;
+  std::condition_variable Wake;
+  std::atomic<int> NumberOfQueuedTasks;
+  bool Stopping;
+
+  vtkSMPThreadPool(const vtkSMPThreadPool&) = delete;
+  void operator=(const vtkSMPThreadPool&) = delete;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadPool.h
@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkSMP.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPToolsBackends.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+// Implementation that selects the backend at runtime. The STDThread backend
+// is a pool of std::thread; Sequential runs everything in the calling
+// thread; OpenMP and TBB are available when enabled at configure time.
+
+namespace
+{
+enum BackendType
+{
+  Sequential = 0,
+  STDThread,
+  OpenMP,
+  TBB,
+  NumberOfBackends
+};
+
+const char* const BackendNames[NumberOfBackends] = { "Sequential", "STDThread", "OpenMP", "TBB" };
+
+bool IsAvailable(int backend)
+{
+  switch (backend)
+  {
+    case Sequential:
+    case STDThread:
+      return true;
+    case OpenMP:
+      return VTK_SMP_ENABLE_OPENMP != 0;
+    case TBB:
+      return VTK_SMP_ENABLE_TBB != 0;
+    default:
+      return false;
+  }
+}
+
+int FindBackend(const char* name)
+{
+  for (int backend = 0; name && backend < NumberOfBackends; ++backend)
+  {
+    if (!strcmp(name, BackendNames[backend]) && IsAvailable(backend))
+    {
+      return backend;
+    }
+  }
+  return -1;
+}
+
+// The backend in use, initially taken from the VTK_SMP_BACKEND_IN_USE
+// environment variable if it names an available backend.
+int InitialBackend()
+{
+  int backend = FindBackend(std::getenv("VTK_SMP_BACKEND_IN_USE"));
+  return backend >= 0 ? backend : STDThread;
+}
+
+std::atomic<int>& BackendInUse()
+{
+  static std::atomic<int> backend(InitialBackend());
+  return backend;
+}
+
+int vtkSMPNumberOfSpecifiedThreads = 0;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPTools::GetBackend()
+{
+  return BackendNames[BackendInUse()];
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  int type = FindBackend(backend);
+  if (type < 0)
+  {
+    return false;
+  }
+  BackendInUse() = type;
+  if (vtkSMPNumberOfSpecifiedThreads)
+  {
+    vtkSMPTools::Initialize(vtkSMPNumberOfSpecifiedThreads);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtkSMPNumberOfSpecifiedThreads = numThreads > 0 ? numThreads : 0;
+  switch (BackendInUse())
+  {
+    case STDThread:
+      vtk::detail::smp::vtkSMPThreadPool::GetInstance().Initialize(numThreads);
+      break;
+#if VTK_SMP_ENABLE_OPENMP
+    case OpenMP:
+      vtk::detail::smp::InitializeOpenMP(numThreads);
+      break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+    case TBB:
+      vtk::detail::smp::InitializeTBB(numThreads);
+      break;
+#endif
+    default:
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtk::detail::smp::GetNumberOfThreads();
+}
+
+//------------------------------------------------------------------------------
+int vtk::detail::smp::GetNumberOfThreads()
+{
+  switch (BackendInUse())
+  {
+    case STDThread:
+      return vtkSMPThreadPool::GetInstance().GetNumberOfThreads();
+#if VTK_SMP_ENABLE_OPENMP
+    case OpenMP:
+      return GetNumberOfThreadsOpenMP();
+#endif
+#if VTK_SMP_ENABLE_TBB
+    case TBB:
+      return GetNumberOfThreadsTBB();
+#endif
+    default:
+      return 1;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPTools_Impl_For_Backend(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  switch (BackendInUse())
+  {
+    case STDThread:
+      vtkSMPThreadPool::GetInstance().For(first, last, grain, functorExecuter, functor);
+      break;
+#if VTK_SMP_ENABLE_OPENMP
+    case OpenMP:
+      vtkSMPTools_Impl_For_OpenMP(first, last, grain, functorExecuter, functor);
+      break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+    case TBB:
+      vtkSMPTools_Impl_For_TBB(first, last, grain, functorExecuter, functor);
+      break;
+#endif
+    default:
+      // Same as the Sequential implementation: a single call without grain.
+      if (grain <= 0)
+      {
+        grain = last - first;
+      }
+      for (vtkIdType from = first; from < last; from += grain)
+      {
+        functorExecuter(functor, from, grain, last);
+      }
+      break;
+  }
+}
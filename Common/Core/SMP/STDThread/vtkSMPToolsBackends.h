@@ -0,0 +1,53 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsBackends.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// The entry points of the OpenMP and TBB backends that the STDThread
+// implementation can select at runtime, when they were enabled at
+// configure time (VTK_SMP_ENABLE_OPENMP and VTK_SMP_ENABLE_TBB).
+
+#ifndef vtkSMPToolsBackends_h
+#define vtkSMPToolsBackends_h
+
+#include "vtkSMP.h"
+#include "vtkType.h"
+
+#include "vtkSMPToolsInternal.h"
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+#if VTK_SMP_ENABLE_OPENMP
+void InitializeOpenMP(int numThreads);
+int GetNumberOfThreadsOpenMP();
+void vtkSMPTools_Impl_For_OpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor);
+#endif
+
+#if VTK_SMP_ENABLE_TBB
+void InitializeTBB(int numThreads);
+int GetNumberOfThreadsTBB();
+void vtkSMPTools_Impl_For_TBB(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor);
+#endif
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsBackends.h
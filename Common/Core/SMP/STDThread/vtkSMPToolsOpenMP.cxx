@@ -0,0 +1,54 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsOpenMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsBackends.h"
+
+#include <omp.h>
+
+namespace
+{
+int vtkSMPNumberOfSpecifiedThreads = 0;
+}
+
+void vtk::detail::smp::InitializeOpenMP(int numThreads)
+{
+#pragma omp single
+  if (numThreads)
+  {
+    vtkSMPNumberOfSpecifiedThreads = numThreads;
+    omp_set_num_threads(numThreads);
+  }
+}
+
+int vtk::detail::smp::GetNumberOfThreadsOpenMP()
+{
+  return vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads : omp_get_max_threads();
+}
+
+void vtk::detail::smp::vtkSMPTools_Impl_For_OpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = (last - first) / (omp_get_max_threads() * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+#pragma omp parallel for schedule(runtime)
+  for (vtkIdType from = first; from < last; from += grain)
+  {
+    functorExecuter(functor, from, grain, last);
+  }
+}
@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsTBB.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsBackends.h"
+
+#ifdef _MSC_VER
+#pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#define __TBB_NO_IMPLICIT_LINKAGE 1
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#ifdef _MSC_VER
+#pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#endif
+
+#include <memory>
+
+namespace
+{
+// The arena limiting the number of threads, when specified.
+std::unique_ptr<tbb::task_arena> vtkTBBArena;
+int vtkTBBNumSpecifiedThreads = 0;
+
+struct FuncCall
+{
+  vtk::detail::smp::ExecuteFunctorPtrType FunctorExecuter;
+  void* Functor;
+  vtkIdType Last;
+
+  void operator()(const tbb::blocked_range<vtkIdType>& r) const
+  {
+    this->FunctorExecuter(this->Functor, r.begin(), r.end() - r.begin(), this->Last);
+  }
+};
+
+struct ParallelFor
+{
+  const tbb::blocked_range<vtkIdType>& Range;
+  const FuncCall& Call;
+
+  void operator()() const { tbb::parallel_for(this->Range, this->Call); }
+};
+}
+
+void vtk::detail::smp::InitializeTBB(int numThreads)
+{
+  if (numThreads > 0)
+  {
+    vtkTBBArena.reset(new tbb::task_arena(numThreads));
+  }
+  else
+  {
+    vtkTBBArena.reset();
+  }
+  vtkTBBNumSpecifiedThreads = numThreads > 0 ? numThreads : 0;
+}
+
+int vtk::detail::smp::GetNumberOfThreadsTBB()
+{
+  return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
+                                   : tbb::this_task_arena::max_concurrency();
+}
+
+void vtk::detail::smp::vtkSMPTools_Impl_For_TBB(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  if (grain <= 0)
+  {
+    // Plan for a few batches per thread so one busy core doesn't stall the
+    // whole system, as the TBB implementation does.
+    const vtkIdType batches = 40 * 5;
+    vtkIdType range = last - first;
+    grain = range >= batches ? ((range - 1) / batches) + 1 : 1;
+  }
+
+  tbb::blocked_range<vtkIdType> range(first, last, grain);
+  FuncCall call = { functorExecuter, functor, last };
+  ParallelFor parallelFor = { range, call };
+  if (vtkTBBArena)
+  {
+    vtkTBBArena->execute(parallelFor);
+  }
+  else
+  {
+    parallelFor();
+  }
+}
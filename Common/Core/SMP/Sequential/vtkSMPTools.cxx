@@ -17,6 +17,8 @@
 
 #include "vtkSMP.h"
 
+#include <cstring>
+
 // Simple implementation that runs everything sequentially.
 
 const char* vtkSMPTools::GetBackend()
@@ -24,6 +26,13 @@ const char* vtkSMPTools::GetBackend()
   return VTK_SMP_BACKEND;
 }
 
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  // This implementation is selected at configure time.
+  return backend && !strcmp(backend, VTK_SMP_BACKEND);
+}
+
 //------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int) {}
 
@@ -29,6 +29,8 @@
 #pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
 #endif
 
+#include <cstring>
+
 struct vtkSMPToolsInit
 {
   tbb::task_scheduler_init Init;
@@ -49,6 +51,13 @@ const char* vtkSMPTools::GetBackend()
   return VTK_SMP_BACKEND;
 }
 
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  // This implementation is selected at configure time.
+  return backend && !strcmp(backend, VTK_SMP_BACKEND);
+}
+
 //------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int numThreads)
 {
@@ -0,0 +1,224 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the modes and the statistics of vtkDataArrayAllocator, and that the
+// arrays created while it is the default allocator use it.
+
+#include "vtkDataArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+
+#include <iostream>
+
+namespace
+{
+// Fill an array, grow it and check its values.
+bool CheckArray(vtkIntArray* array, const char* what)
+{
+  array->SetNumberOfTuples(1000);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    array->SetValue(i, static_cast<int>(i));
+  }
+  for (vtkIdType i = 1000; i < 100000; ++i)
+  {
+    array->InsertNextValue(static_cast<int>(i));
+  }
+  for (vtkIdType i = 0; i < 100000; ++i)
+  {
+    if (array->GetValue(i) != i)
+    {
+      std::cerr << what << ": wrong value " << array->GetValue(i) << " at " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int TestMode(int mode, const char* what)
+{
+  vtkNew<vtkDataArrayAllocator> allocator;
+  allocator->SetMode(mode);
+  allocator->SetArenaChunkSize(1 << 20);
+  allocator->FirstTouchOn();
+  allocator->SetLargeAllocationSize(100000);
+  {
+    vtkDataArrayAllocator::vtkDefaultRAII scope(allocator);
+    vtkNew<vtkIntArray> array;
+    if (array->GetAllocator() != allocator || !CheckArray(array, what))
+    {
+      std::cerr << what << ": the array does not use the allocator" << std::endl;
+      return EXIT_FAILURE;
+    }
+    // Heap allocations grow in place, so the peak is the current size.
+    if (allocator->GetAllocatedSize() != array->GetSize() * sizeof(int) ||
+      allocator->GetPeakAllocatedSize() < allocator->GetAllocatedSize() ||
+      (mode == vtkDataArrayAllocator::HEAP &&
+        allocator->GetPeakAllocatedSize() != allocator->GetAllocatedSize()) ||
+      allocator->GetNumberOfAllocations() < 2)
+    {
+      std::cerr << what << ": wrong statistics" << std::endl;
+      allocator->Print(std::cerr);
+      return EXIT_FAILURE;
+    }
+
+    // First touched allocations are zeroed.
+    vtkNew<vtkDoubleArray> zeros;
+    zeros->SetNumberOfTuples(100000);
+    for (vtkIdType i = 0; i < 100000; ++i)
+    {
+      if (zeros->GetValue(i) != 0.0)
+      {
+        std::cerr << what << ": first touched values are not zero" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (vtkDataArrayAllocator::GetDefault() != nullptr)
+  {
+    std::cerr << what << ": the default allocator is not restored" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (allocator->GetAllocatedSize() != 0 ||
+    allocator->GetNumberOfAllocations() != allocator->GetNumberOfFrees())
+  {
+    std::cerr << what << ": leaked allocations" << std::endl;
+    allocator->Print(std::cerr);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Reallocating in place counts the new size instead of the old one, while
+// moving a block counts both until the old one is freed.
+int TestPeak()
+{
+  vtkNew<vtkDataArrayAllocator> allocator;
+  void* block = allocator->Allocate(1000);
+  block = allocator->Reallocate(block, 5000);
+  block = allocator->Reallocate(block, 2000);
+  if (allocator->GetAllocatedSize() != 2000 || allocator->GetPeakAllocatedSize() != 5000)
+  {
+    std::cerr << "Heap: wrong peak after reallocating in place" << std::endl;
+    allocator->Print(std::cerr);
+    return EXIT_FAILURE;
+  }
+  allocator->Free(block);
+  allocator->ResetStatistics();
+
+  allocator->SetModeToPool();
+  block = allocator->Allocate(50000);
+  block = allocator->Reallocate(block, 60000);
+  if (allocator->GetAllocatedSize() != 60000 || allocator->GetPeakAllocatedSize() != 110000)
+  {
+    std::cerr << "Pool: wrong peak after moving a block" << std::endl;
+    allocator->Print(std::cerr);
+    return EXIT_FAILURE;
+  }
+  allocator->Free(block);
+  return EXIT_SUCCESS;
+}
+
+int TestPool()
+{
+  vtkNew<vtkDataArrayAllocator> allocator;
+  allocator->SetModeToPool();
+  void* block = allocator->Allocate(50000);
+  allocator->Free(block);
+  if (allocator->GetReservedSize() < 50000)
+  {
+    std::cerr << "Pool: the freed block is not cached" << std::endl;
+    return EXIT_FAILURE;
+  }
+  void* reused = allocator->Allocate(52000);
+  if (reused != block || allocator->GetReservedSize() != 0)
+  {
+    std::cerr << "Pool: the freed block is not reused" << std::endl;
+    return EXIT_FAILURE;
+  }
+  allocator->Free(reused);
+  allocator->ReleaseCachedMemory();
+  if (allocator->GetReservedSize() != 0)
+  {
+    std::cerr << "Pool: the cached blocks are not released" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestArena()
+{
+  vtkNew<vtkDataArrayAllocator> allocator;
+  allocator->SetModeToArena();
+  allocator->SetArenaChunkSize(1 << 20);
+  char* first = static_cast<char*>(allocator->Allocate(1000));
+  char* last = static_cast<char*>(allocator->Allocate(1000));
+  for (int i = 0; i < 1000; ++i)
+  {
+    last[i] = static_cast<char>(i);
+  }
+  // The last allocation grows in place.
+  char* grown = static_cast<char*>(allocator->Reallocate(last, 100000));
+  if (grown != last || grown[999] != static_cast<char>(999) ||
+    allocator->GetReservedSize() != (1 << 20) || allocator->GetPeakAllocatedSize() != 101000)
+  {
+    std::cerr << "Arena: the last allocation does not grow in place" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Filling the chunk starts a new one, and the first chunk is freed with
+  // its last allocation.
+  void* others[5];
+  for (int i = 0; i < 5; ++i)
+  {
+    others[i] = allocator->Allocate(200000);
+  }
+  if (allocator->GetReservedSize() != (2 << 20))
+  {
+    std::cerr << "Arena: wrong number of chunks" << std::endl;
+    return EXIT_FAILURE;
+  }
+  allocator->Free(first);
+  allocator->Free(grown);
+  for (int i = 0; i < 4; ++i)
+  {
+    if (allocator->GetReservedSize() != (2 << 20))
+    {
+      std::cerr << "Arena: a chunk holding allocations was freed" << std::endl;
+      return EXIT_FAILURE;
+    }
+    allocator->Free(others[i]);
+  }
+  allocator->Free(others[4]);
+  if (allocator->GetReservedSize() != (1 << 20))
+  {
+    std::cerr << "Arena: the full chunk was not freed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestDataArrayAllocator(int, char*[])
+{
+  if (TestMode(vtkDataArrayAllocator::HEAP, "Heap") != EXIT_SUCCESS ||
+    TestMode(vtkDataArrayAllocator::POOL, "Pool") != EXIT_SUCCESS ||
+    TestMode(vtkDataArrayAllocator::ARENA, "Arena") != EXIT_SUCCESS ||
+    TestPeak() != EXIT_SUCCESS || TestPool() != EXIT_SUCCESS || TestArena() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
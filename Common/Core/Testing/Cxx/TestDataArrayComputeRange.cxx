@@ -0,0 +1,213 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayComputeRange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the ranges computed on the contiguous values of AOS arrays match
+// those of SOA arrays, for the sizes around the blocks of the kernels and the
+// serial threshold, and check the caching of the ranges.
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <iostream>
+
+// A 64-bit integer array that exposes the modification time of its cached
+// component ranges.
+class vtkRangeCacheArray : public vtkAOSDataArrayTemplate<vtkTypeInt64>
+{
+public:
+  static vtkRangeCacheArray* New();
+  vtkTypeMacro(vtkRangeCacheArray, vtkAOSDataArrayTemplate<vtkTypeInt64>);
+
+  vtkMTimeType GetCachedRangeMTime() const { return this->LegacyValueRangeFullMTime; }
+
+protected:
+  vtkRangeCacheArray() = default;
+  ~vtkRangeCacheArray() override = default;
+
+private:
+  vtkRangeCacheArray(const vtkRangeCacheArray&) = delete;
+  void operator=(const vtkRangeCacheArray&) = delete;
+};
+
+vtkStandardNewMacro(vtkRangeCacheArray);
+
+namespace
+{
+template <typename T>
+T Value(vtkIdType valueIdx, int comp)
+{
+  // Values going up and down, with the extrema away from the ends.
+  const vtkIdType x = (valueIdx * 7919 + comp * 31) % 1000;
+  return static_cast<T>(x - 500) / static_cast<T>(comp + 1);
+}
+
+template <typename T>
+int CheckRanges(vtkIdType numTuples, int numComps, bool special)
+{
+  vtkNew<vtkAOSDataArrayTemplate<T>> aos;
+  vtkNew<vtkSOADataArrayTemplate<T>> soa;
+  aos->SetNumberOfComponents(numComps);
+  soa->SetNumberOfComponents(numComps);
+  aos->SetNumberOfTuples(numTuples);
+  soa->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      const T value = Value<T>(t * numComps + c, c);
+      aos->SetTypedComponent(t, c, value);
+      soa->SetTypedComponent(t, c, value);
+    }
+  }
+  if (special && numTuples > 2)
+  {
+    aos->SetTypedComponent(numTuples / 2, 0, static_cast<T>(vtkMath::Nan()));
+    soa->SetTypedComponent(numTuples / 2, 0, static_cast<T>(vtkMath::Nan()));
+    aos->SetTypedComponent(numTuples - 1, 0, static_cast<T>(vtkMath::Inf()));
+    soa->SetTypedComponent(numTuples - 1, 0, static_cast<T>(vtkMath::Inf()));
+  }
+
+  for (int c = -1; c < numComps; ++c)
+  {
+    double aosRange[2];
+    double soaRange[2];
+    aos->GetRange(aosRange, c);
+    soa->GetRange(soaRange, c);
+    double aosFinite[2];
+    double soaFinite[2];
+    aos->GetFiniteRange(aosFinite, c);
+    soa->GetFiniteRange(soaFinite, c);
+    if (aosRange[0] != soaRange[0] || aosRange[1] != soaRange[1] ||
+      aosFinite[0] != soaFinite[0] || aosFinite[1] != soaFinite[1])
+    {
+      std::cerr << aos->GetDataTypeAsString() << ", " << numTuples << " tuples, " << numComps
+                << " components, component " << c << ": AOS range [" << aosRange[0] << ", "
+                << aosRange[1] << "] finite [" << aosFinite[0] << ", " << aosFinite[1]
+                << "], SOA range [" << soaRange[0] << ", " << soaRange[1] << "] finite ["
+                << soaFinite[0] << ", " << soaFinite[1] << "]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (special && numTuples > 2 && c == 0 &&
+      (aosRange[1] != vtkMath::Inf() || aosFinite[1] == vtkMath::Inf()))
+    {
+      std::cerr << aos->GetDataTypeAsString() << ": infinity is not handled" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename T>
+int CheckSizes(bool special)
+{
+  const vtkIdType sizes[] = { 1, 7, 8, 9, 17, 1000, 70001 };
+  const int comps[] = { 1, 2, 3, 4, 9, 10 };
+  for (vtkIdType numTuples : sizes)
+  {
+    for (int numComps : comps)
+    {
+      if (CheckRanges<T>(numTuples, numComps, special) != EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int CheckCaching()
+{
+  // The range of integers is also their finite range.
+  vtkNew<vtkIntArray> ints;
+  ints->SetNumberOfComponents(2);
+  ints->InsertNextTuple2(1, 4);
+  ints->InsertNextTuple2(3, -2);
+  double range[2];
+  ints->GetRange(range, 1);
+  if (!ints->GetInformation()->Has(vtkAbstractArray::PER_FINITE_COMPONENT()))
+  {
+    std::cerr << "The range of an integer array is not cached as its finite range" << std::endl;
+    return EXIT_FAILURE;
+  }
+  ints->GetFiniteRange(range, 1);
+  if (range[0] != -2 || range[1] != 4)
+  {
+    std::cerr << "Wrong finite range [" << range[0] << ", " << range[1] << "]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The ranges of the 64-bit integers are cached by the array, shared by
+  // the range and the finite range, and recomputed once the array is
+  // modified.
+  vtkNew<vtkRangeCacheArray> longs;
+  longs->InsertNextValue(VTK_TYPE_INT64_MAX);
+  longs->InsertNextValue(-3);
+  vtkTypeInt64 longRange[2];
+  longs->GetValueRange(longRange);
+  const vtkMTimeType cachedMTime = longs->GetCachedRangeMTime();
+  if (cachedMTime != longs->GetMTime())
+  {
+    std::cerr << "The range of the 64-bit integers is not cached" << std::endl;
+    return EXIT_FAILURE;
+  }
+  longs->GetFiniteValueRange(longRange);
+  if (longRange[0] != -3 || longRange[1] != VTK_TYPE_INT64_MAX ||
+    longs->GetCachedRangeMTime() != cachedMTime)
+  {
+    std::cerr << "The cached range of the 64-bit integers is not reused" << std::endl;
+    return EXIT_FAILURE;
+  }
+  longs->SetValue(1, -5);
+  longs->Modified();
+  longs->GetFiniteValueRange(longRange);
+  if (longRange[0] != -5 || longRange[1] != VTK_TYPE_INT64_MAX ||
+    longs->GetCachedRangeMTime() != longs->GetMTime() ||
+    longs->GetCachedRangeMTime() == cachedMTime)
+  {
+    std::cerr << "The finite range of the 64-bit integers is not updated" << std::endl;
+    return EXIT_FAILURE;
+  }
+  longs->GetValueRange(longRange);
+  if (longRange[0] != -5)
+  {
+    std::cerr << "The range of the 64-bit integers is not updated" << std::endl;
+    return EXIT_FAILURE;
+  }
+  longs->InsertNextValue(-7);
+  longs->GetValueRange(longRange);
+  if (longRange[0] != -7)
+  {
+    std::cerr << "The range of the 64-bit integers is not updated on insertion" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestDataArrayComputeRange(int, char*[])
+{
+  if (CheckSizes<float>(true) != EXIT_SUCCESS || CheckSizes<double>(true) != EXIT_SUCCESS ||
+    CheckSizes<int>(false) != EXIT_SUCCESS || CheckSizes<unsigned char>(false) != EXIT_SUCCESS ||
+    CheckSizes<vtkTypeInt64>(false) != EXIT_SUCCESS || CheckCaching() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the values of the constant, affine, composite and indexed implicit
+// arrays through the vtkDataArray, vtkGenericDataArray and range APIs, and
+// that copies and new instances behave like regular arrays.
+
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeArray.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIndexedArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+struct SumWorker
+{
+  double Sum = 0.0;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    for (auto value : vtk::DataArrayValueRange(array))
+    {
+      this->Sum += static_cast<double>(value);
+    }
+  }
+};
+
+double Sum(vtkDataArray* array)
+{
+  SumWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker))
+  {
+    worker(array);
+  }
+  return worker.Sum;
+}
+
+int TestConstant()
+{
+  vtkNew<vtkConstantArray<float>> array;
+  array->ConstructBackend(2.5f);
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(1000000);
+  double range[2];
+  array->GetRange(range, 1);
+  float tuple[3];
+  array->GetTypedTuple(999999, tuple);
+  if (array->GetValue(123456) != 2.5f || tuple[0] != 2.5f || tuple[2] != 2.5f ||
+    array->GetComponent(17, 1) != 2.5 || range[0] != 2.5 || range[1] != 2.5)
+  {
+    std::cerr << "Wrong values in the constant array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (array->GetActualMemorySize() > 1)
+  {
+    std::cerr << "Constant array uses " << array->GetActualMemorySize() << " KiB" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestAffine()
+{
+  vtkNew<vtkAffineArray<vtkIdType>> ids;
+  ids->ConstructBackend(1, 0);
+  ids->SetNumberOfTuples(10000);
+  vtkNew<vtkAffineArray<double>> ramp;
+  ramp->ConstructBackend(0.5, -1.0);
+  ramp->SetNumberOfComponents(2);
+  ramp->SetNumberOfTuples(50);
+
+  if (ids->GetValue(9999) != 9999 || Sum(ids) != 9999.0 * 10000.0 / 2.0 ||
+    ramp->GetTypedComponent(10, 1) != 0.5 * 21 - 1.0)
+  {
+    std::cerr << "Wrong values in the affine arrays" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Writing does nothing but warn.
+  vtkNew<vtkTest::ErrorObserver> observer;
+  ids->AddObserver(vtkCommand::WarningEvent, observer);
+  ids->AddObserver(vtkCommand::ErrorEvent, observer);
+  ids->SetValue(10, 42);
+  if (observer->CheckWarningMessage("read-only"))
+  {
+    return EXIT_FAILURE;
+  }
+  ids->SetComponent(11, 0, 42.0);
+  if (observer->CheckWarningMessage("read-only"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (ids->GetValue(10) != 10 || ids->GetValue(11) != 11)
+  {
+    std::cerr << "Affine array was modified" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without a backend, reading reports an error.
+  vtkNew<vtkAffineArray<vtkIdType>> empty;
+  empty->AddObserver(vtkCommand::ErrorEvent, observer);
+  empty->ConstructBackend(1, 0);
+  empty->Initialize();
+  empty->SetNumberOfTuples(3);
+  if (empty->GetValue(2) != 0 || observer->CheckErrorMessage("No backend"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The values are materialized by copies into regular arrays, and new
+  // instances are regular arrays.
+  vtkNew<vtkIdTypeArray> copy;
+  copy->DeepCopy(ids);
+  vtkSmartPointer<vtkDataArray> instance = vtk::TakeSmartPointer(ids->NewInstance());
+  if (copy->GetNumberOfTuples() != 10000 || copy->GetValue(1234) != 1234 ||
+    !vtkArrayDownCast<vtkAOSDataArrayTemplate<vtkIdType>>(instance))
+  {
+    std::cerr << "Wrong copy or new instance of an affine array" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Copies of implicit arrays share the backend.
+  vtkNew<vtkAffineArray<vtkIdType>> idsCopy;
+  idsCopy->DeepCopy(ids);
+  if (idsCopy->GetBackend() != ids->GetBackend() || idsCopy->GetNumberOfTuples() != 10000)
+  {
+    std::cerr << "Wrong copy of an affine array" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Down casts tell the backends apart.
+  if (vtkArrayDownCast<vtkAffineArray<vtkIdType>>(ids.GetPointer()) != ids.GetPointer() ||
+    vtkArrayDownCast<vtkConstantArray<vtkIdType>>(ids.GetPointer()) ||
+    vtkArrayDownCast<vtkAffineArray<double>>(ids.GetPointer()) ||
+    vtkDataArray::FastDownCast(ids.GetPointer()) != ids.GetPointer())
+  {
+    std::cerr << "Wrong down cast of an affine array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestComposite()
+{
+  vtkNew<vtkFloatArray> first;
+  first->SetNumberOfComponents(2);
+  first->SetNumberOfTuples(3);
+  vtkNew<vtkIntArray> second;
+  second->SetNumberOfComponents(2);
+  second->SetNumberOfTuples(5);
+  for (vtkIdType i = 0; i < 6; ++i)
+  {
+    first->SetValue(i, static_cast<float>(i));
+  }
+  for (vtkIdType i = 0; i < 10; ++i)
+  {
+    second->SetValue(i, static_cast<int>(6 + i));
+  }
+
+  std::vector<vtkDataArray*> arrays = { first, nullptr, second };
+  vtkNew<vtkCompositeArray<double>> array;
+  array->ConstructBackend(arrays);
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(8);
+  vtkIdType i = 0;
+  for (auto value : vtk::DataArrayValueRange<2>(array))
+  {
+    if (value != static_cast<double>(i++))
+    {
+      std::cerr << "Wrong value " << value << " in the composite array" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (i != 16 || array->GetComponent(7, 1) != 15.0)
+  {
+    std::cerr << "Wrong size of the composite array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestIndexed()
+{
+  vtkNew<vtkDoubleArray> values;
+  values->SetNumberOfComponents(3);
+  values->SetNumberOfTuples(100);
+  for (vtkIdType i = 0; i < 300; ++i)
+  {
+    values->SetValue(i, 0.1 * i);
+  }
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType i = 99; i >= 0; i -= 3)
+  {
+    ids->InsertNextId(i);
+  }
+
+  vtkNew<vtkIndexedArray<double>> array;
+  array->ConstructBackend(ids, values);
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(ids->GetNumberOfIds());
+  for (vtkIdType t = 0; t < ids->GetNumberOfIds(); ++t)
+  {
+    double tuple[3];
+    array->GetTuple(t, tuple);
+    for (int c = 0; c < 3; ++c)
+    {
+      if (tuple[c] != values->GetComponent(ids->GetId(t), c))
+      {
+        std::cerr << "Wrong value in the indexed array at tuple " << t << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestImplicitArrays(int, char*[])
+{
+  if (TestConstant() != EXIT_SUCCESS || TestAffine() != EXIT_SUCCESS ||
+    TestComposite() != EXIT_SUCCESS || TestIndexed() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryMappedArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkAOSDataArrayTemplate can keep its values in mapped files and
+// in anonymous memory maps.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMemoryMap.h"
+#include "vtkNew.h"
+
+#include "vtksys/FStream.hxx"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfTuples = 10000;
+const int HeaderLength = 13;
+
+float Expected(vtkIdType valueIdx)
+{
+  return static_cast<float>(valueIdx) * 0.5f;
+}
+
+bool CheckValues(vtkFloatArray* array, vtkIdType numValues, const char* what)
+{
+  if (array->GetNumberOfValues() != numValues)
+  {
+    std::cerr << what << ": wrong number of values " << array->GetNumberOfValues() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (array->GetValue(i) != Expected(i))
+    {
+      std::cerr << what << ": wrong value " << array->GetValue(i) << " at " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int TestMappedFile(const char* fileName)
+{
+  // A raw file with values after an unaligned header, like appended data.
+  {
+    vtksys::ofstream file(fileName, std::ios::out | std::ios::binary);
+    file << std::string(HeaderLength, '_');
+    for (vtkIdType i = 0; i < 3 * NumberOfTuples; ++i)
+    {
+      const float value = Expected(i);
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+  }
+
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfComponents(3);
+  if (!array->MapFile(fileName, NumberOfTuples, HeaderLength) || !array->GetMemoryMap() ||
+    !array->GetMemoryMap()->GetFileBacked() || array->GetNumberOfTuples() != NumberOfTuples ||
+    !CheckValues(array, 3 * NumberOfTuples, "Mapped file"))
+  {
+    std::cerr << "Cannot map the file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Shallow copies share the mapped values.
+  vtkNew<vtkFloatArray> copy;
+  copy->ShallowCopy(array);
+  if (copy->GetPointer(0) != array->GetPointer(0))
+  {
+    std::cerr << "Shallow copy does not share the mapped values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Changes are private to the array, and growing the array copies the
+  // values out of the file.
+  array->SetValue(0, -1.0f);
+  array->InsertNextTuple3(0.0, 0.0, 0.0);
+  if (array->GetMemoryMap() || array->GetValue(0) != -1.0f ||
+    array->GetNumberOfTuples() != NumberOfTuples + 1)
+  {
+    std::cerr << "Wrong values after resizing a mapped array" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkFloatArray> reread;
+  reread->SetNumberOfComponents(3);
+  reread->MapFile(fileName, NumberOfTuples, HeaderLength);
+  if (!CheckValues(reread, 3 * NumberOfTuples, "Unmodified file"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The file is too small.
+  vtkNew<vtkFloatArray> tooLarge;
+  tooLarge->SetNumberOfComponents(3);
+  vtkObject::GlobalWarningDisplayOff();
+  const bool mapped = tooLarge->MapFile(fileName, NumberOfTuples + 1, HeaderLength + 8);
+  vtkObject::GlobalWarningDisplayOn();
+  if (mapped)
+  {
+    std::cerr << "Mapped beyond the end of the file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestAnonymousMap()
+{
+  vtkNew<vtkFloatArray> array;
+  array->SetUseMemoryMap(true);
+  array->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType i = 0; i < NumberOfTuples; ++i)
+  {
+    array->SetValue(i, Expected(i));
+  }
+  if (!array->GetMemoryMap() || array->GetMemoryMap()->GetFileBacked())
+  {
+    std::cerr << "The values are not in an anonymous map" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Anonymous maps grow in place and keep their values.
+  for (vtkIdType i = NumberOfTuples; i < 4 * NumberOfTuples; ++i)
+  {
+    array->InsertNextValue(Expected(i));
+  }
+  array->Squeeze();
+  if (!array->GetMemoryMap() || !CheckValues(array, 4 * NumberOfTuples, "Anonymous map"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Deep copies are regular arrays.
+  vtkNew<vtkDoubleArray> copy;
+  copy->DeepCopy(array);
+  if (copy->GetValue(4 * NumberOfTuples - 1) != Expected(4 * NumberOfTuples - 1))
+  {
+    std::cerr << "Wrong deep copy" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestMemoryMappedArray(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cout << "Usage: " << argv[0] << " outputFilename" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (TestMappedFile(argv[1]) != EXIT_SUCCESS || TestAnonymousMap() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
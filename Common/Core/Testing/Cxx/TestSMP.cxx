@@ -12,13 +12,19 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
+#include "vtkDataArrayRange.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <numeric>
 #include <vector>
 
 static const int Target = 10000;
@@ -78,16 +84,160 @@ public:
   void Reduce() {}
 };
 
+class InnerFunctor
+{
+public:
+  std::atomic<int>& Counter;
+
+  InnerFunctor(std::atomic<int>& counter)
+    : Counter(counter)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+      this->Counter++;
+  }
+};
+
+// Each chunk of the outer loop runs a parallel inner loop
+class NestedFunctor
+{
+public:
+  std::atomic<int> Counter;
+
+  NestedFunctor()
+    : Counter(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      InnerFunctor inner(this->Counter);
+      vtkSMPTools::For(0, 100, 10, inner);
+    }
+  }
+};
+
+// Each chunk of the outer loop keeps thread local state across a parallel
+// inner loop, which must not be overwritten by another chunk of the outer
+// loop running on the same thread meanwhile.
+class NestedLocalFunctor
+{
+public:
+  vtkSMPThreadLocal<vtkIdType> Current;
+  std::atomic<int> Counter;
+  std::atomic<int> Errors;
+
+  NestedLocalFunctor()
+    : Current(-1)
+    , Counter(0)
+    , Errors(0)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      vtkIdType& current = this->Current.Local();
+      current = i;
+      InnerFunctor inner(this->Counter);
+      vtkSMPTools::For(0, 100, 1, inner);
+      if (this->Current.Local() != i)
+      {
+        this->Errors++;
+      }
+    }
+  }
+};
+
+// Check the parallel algorithms against their serial counterparts
+static int TestAlgorithms()
+{
+  const vtkIdType size = 100003;
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetNumberOfValues(size);
+  auto idRange = vtk::DataArrayValueRange<1>(ids);
+  vtkSMPTools::Fill(idRange.begin(), idRange.end(), 3);
+  if (std::count(idRange.begin(), idRange.end(), 3) != size)
+  {
+    cerr << "Error: Bad fill!" << endl;
+    return 1;
+  }
+
+  // Exclusive scan in place of the array of 3s: 0, 3, 6...
+  vtkSMPTools::ExclusiveScan(idRange.begin(), idRange.end(), idRange.begin(), vtkIdType(0));
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (idRange[i] != 3 * i)
+    {
+      cerr << "Error: Bad exclusive scan!" << endl;
+      return 1;
+    }
+  }
+
+  vtkNew<vtkFloatArray> values;
+  values->SetNumberOfValues(size);
+  auto valueRange = vtk::DataArrayValueRange<1>(values);
+  std::vector<double> doubles(size);
+  vtkSMPTools::Transform(idRange.begin(), idRange.end(), valueRange.begin(),
+    [](vtkIdType id) { return static_cast<float>(id % 7); });
+  vtkSMPTools::Transform(valueRange.begin(), valueRange.end(), idRange.begin(), doubles.begin(),
+    [](float value, vtkIdType id) { return value + id; });
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (valueRange[i] != (3 * i) % 7 || doubles[i] != 3 * i + (3 * i) % 7)
+    {
+      cerr << "Error: Bad transform!" << endl;
+      return 1;
+    }
+  }
+
+  // The reductions and the scans of integers are exact
+  std::vector<vtkIdType> scan(size);
+  std::partial_sum(idRange.begin(), idRange.end(), scan.begin());
+  vtkSMPTools::InclusiveScan(idRange.begin(), idRange.end(), idRange.begin());
+  if (!std::equal(scan.begin(), scan.end(), idRange.begin()) ||
+    vtkSMPTools::Reduce(scan.begin(), scan.end(), vtkIdType(1)) !=
+      std::accumulate(scan.begin(), scan.end(), vtkIdType(1)))
+  {
+    cerr << "Error: Bad inclusive scan or reduction!" << endl;
+    return 1;
+  }
+  vtkIdType maxValue = vtkSMPTools::TransformReduce(valueRange.begin(), valueRange.end(),
+    vtkIdType(-1), [](vtkIdType a, vtkIdType b) { return std::max(a, b); },
+    [](float value) { return static_cast<vtkIdType>(value); });
+  if (maxValue != 6)
+  {
+    cerr << "Error: Bad transform reduction!" << endl;
+    return 1;
+  }
+
+  // Non commutative scan: the last value of the sequence
+  auto last = [](vtkIdType, vtkIdType b) { return b; };
+  std::vector<vtkIdType> lasts(size);
+  vtkSMPTools::InclusiveScan(scan.begin(), scan.end(), lasts.begin(), last, vtkIdType(-1));
+  if (lasts != scan)
+  {
+    cerr << "Error: Bad non commutative scan!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
 // For sorting comparison
 bool myComp(double a, double b)
 {
   return (a < b);
 }
 
-int TestSMP(int, char*[])
+static int TestSMPBackend()
 {
-  // vtkSMPTools::Initialize(8);
-
   ARangeFunctor functor1;
 
   vtkSMPTools::For(0, Target, functor1);
@@ -130,6 +280,31 @@ int TestSMP(int, char*[])
     return 1;
   }
 
+  NestedFunctor functor3;
+
+  vtkSMPTools::For(0, 100, 1, functor3);
+
+  if (functor3.Counter != 100 * 100)
+  {
+    cerr << "Error: NestedFunctor did not generate " << 100 * 100 << endl;
+    return 1;
+  }
+
+  NestedLocalFunctor functor4;
+
+  vtkSMPTools::For(0, 100, 1, functor4);
+
+  if (functor4.Counter != 100 * 100 || functor4.Errors != 0)
+  {
+    cerr << "Error: NestedLocalFunctor overwrote its thread local state" << endl;
+    return 1;
+  }
+
+  if (TestAlgorithms())
+  {
+    return 1;
+  }
+
   // Test sorting
   double data0[] = { 2, 1, 0, 3, 9, 6, 7, 3, 8, 4, 5 };
   std::vector<double> myvector(data0, data0 + 11);
@@ -157,5 +332,48 @@ int TestSMP(int, char*[])
     }
   }
 
+  // Large enough to be sorted in chunks by several threads
+  std::vector<int> values(1000003);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<int>((i * 7919) % 100003);
+  }
+  std::vector<int> sortedValues = values;
+  std::sort(sortedValues.begin(), sortedValues.end());
+  std::vector<int> parallelValues = values;
+  vtkSMPTools::Sort(parallelValues.begin(), parallelValues.end());
+  if (parallelValues != sortedValues)
+  {
+    cerr << "Error: Bad large vector sort!" << endl;
+    return 1;
+  }
+  vtkSMPTools::Sort(values.begin(), values.end(), std::greater<int>());
+  if (!std::equal(values.begin(), values.end(), sortedValues.rbegin()))
+  {
+    cerr << "Error: Bad large comparison sort!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int TestSMP(int, char*[])
+{
+  // vtkSMPTools::Initialize(8);
+
+  // Run the tests with each backend available at runtime
+  const char* backends[] = { "Sequential", "STDThread", "OpenMP", "TBB" };
+  for (const char* backend : backends)
+  {
+    if (vtkSMPTools::SetBackend(backend))
+    {
+      cout << "Testing backend " << vtkSMPTools::GetBackend() << endl;
+      if (TestSMPBackend())
+      {
+        return 1;
+      }
+    }
+  }
+
   return 0;
 }
@@ -182,6 +182,52 @@ public:
   void SetVoidArray(void* array, vtkIdType size, int save, int deleteMethod) override;
   //@}
 
+  /**
+   * Use the @a numTuples tuples stored at byte @a offset of the file
+   * @a fileName, e.g. a raw file or the appended data of a VTK XML file, as
+   * the values of the array. The file is mapped in memory rather than read,
+   * so that its pages are only loaded when they are accessed. The values
+   * must be in the byte order of the machine. If @a writable is true,
+   * changes to the values are written to the file, otherwise they are
+   * private to the array. Return false on failure.
+   */
+  bool MapFile(const char* fileName, vtkIdType numTuples, vtkTypeUInt64 offset = 0,
+    bool writable = false);
+
+  //@{
+  /**
+   * Set/Get the memory map holding the values of the array, see
+   * vtkMemoryMap. Setting a map uses its data without copying it, as many
+   * tuples as fit in the mapped region. The map is shared by the arrays
+   * shallow copied from this one. GetMemoryMap() returns nullptr if the
+   * values are not mapped.
+   */
+  void SetMemoryMap(vtkMemoryMap* map);
+  vtkMemoryMap* GetMemoryMap() const { return this->Buffer->GetMemoryMap(); }
+  //@}
+
+  //@{
+  /**
+   * If true, the values are allocated in anonymous memory, see
+   * vtkMemoryMap::MapAnonymous(). Where no swap space is reserved for it,
+   * arrays larger than the physical memory can be allocated as long as only
+   * a part of them is used at a time. This applies to the following
+   * allocations. Default is false.
+   */
+  void SetUseMemoryMap(bool use) { this->Buffer->SetUseMemoryMap(use); }
+  bool GetUseMemoryMap() const { return this->Buffer->GetUseMemoryMap(); }
+  //@}
+
+  //@{
+  /**
+   * Set/Get the allocator of the values, see vtkDataArrayAllocator. This
+   * applies to the following allocations. Default is
+   * vtkDataArrayAllocator::GetDefault() at the creation of the array.
+   */
+  void SetAllocator(vtkDataArrayAllocator* allocator) { this->Buffer->SetAllocator(allocator); }
+  vtkDataArrayAllocator* GetAllocator() const { return this->Buffer->GetAllocator(); }
+  //@}
+
   /**
    * This method allows the user to specify a custom free function to be
    * called when the array is deallocated. Calling this method will implicitly
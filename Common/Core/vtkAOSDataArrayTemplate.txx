@@ -92,6 +92,40 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::SetVoidArray(
   this->SetArray(static_cast<ValueType*>(array), size, save, deleteMethod);
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>::MapFile(
+  const char* fileName, vtkIdType numTuples, vtkTypeUInt64 offset, bool writable)
+{
+  const size_t length =
+    static_cast<size_t>(numTuples) * this->NumberOfComponents * sizeof(ValueType);
+  if (length == 0)
+  {
+    vtkErrorMacro("Cannot map an empty array.");
+    return false;
+  }
+
+  vtkMemoryMap* map = vtkMemoryMap::New();
+  const bool mapped = map->MapFile(fileName, offset, length, writable);
+  if (mapped)
+  {
+    this->SetMemoryMap(map);
+  }
+  map->Delete();
+  return mapped;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAOSDataArrayTemplate<ValueTypeT>::SetMemoryMap(vtkMemoryMap* map)
+{
+  this->Buffer->SetMemoryMap(map);
+  // Only whole tuples are used.
+  this->Size = this->Buffer->GetSize() - this->Buffer->GetSize() % this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueType>
 void vtkAOSDataArrayTemplate<ValueType>::SetArrayFreeFunction(void (*callback)(void*))
@@ -639,6 +639,8 @@ public:
     TypedDataArray,
     MappedDataArray,
     ScaleSoADataArrayTemplate,
+    ImplicitArray,
+    CompressedDataArray,
 
     DataArrayTemplate = AoSDataArrayTemplate //! Legacy
   };
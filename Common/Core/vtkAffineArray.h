@@ -0,0 +1,65 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   An implicit array whose values are an affine function of their
+ * index.
+ *
+ *
+ * vtkAffineArray is a vtkImplicitArray using vtkAffineImplicitBackend, which
+ * returns slope * valueIdx + intercept. It replaces ramps such as point or
+ * cell ids (slope 1, intercept 0) and the coordinates of uniform grids:
+ *
+ * \code
+ * vtkNew<vtkAffineArray<vtkIdType>> ids;
+ * ids->ConstructBackend(1, 0);
+ * ids->SetNumberOfTuples(numPoints);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueType>
+class vtkAffineImplicitBackend
+{
+public:
+  vtkAffineImplicitBackend(ValueType slope, ValueType intercept)
+    : Slope(slope)
+    , Intercept(intercept)
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    return static_cast<ValueType>(this->Slope * static_cast<ValueType>(valueIdx) + this->Intercept);
+  }
+
+protected:
+  ValueType Slope;
+  ValueType Intercept;
+};
+
+template <typename ValueType>
+using vtkAffineArray = vtkImplicitArray<vtkAffineImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
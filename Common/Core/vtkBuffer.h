@@ -20,11 +20,20 @@
  * vtkBuffer makes it easier to keep data pointers in vtkDataArray subclasses.
  * This is an internal class and not intended for direct use expect when writing
  * new types of vtkDataArray subclasses.
+ *
+ * The buffer can also keep its data in a vtkMemoryMap, either a mapped file
+ * or anonymous memory for which no swap space is reserved, so that arrays
+ * larger than the physical memory are paged in by the operating system.
+ *
+ * The data is allocated by a vtkDataArrayAllocator when one is set, which
+ * is by default the allocator returned by vtkDataArrayAllocator::GetDefault().
  */
 
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkDataArrayAllocator.h" // For SetAllocator
+#include "vtkMemoryMap.h"          // For SetMemoryMap
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
@@ -53,8 +62,44 @@ public:
    */
   void SetBuffer(ScalarType* array, vtkIdType size);
 
+  /**
+   * Use the data of the memory map @a map, which is kept alive by the buffer,
+   * without copying it. The buffer holds as many elements as fit in the
+   * mapped region. Passing nullptr releases the current data.
+   */
+  void SetMemoryMap(vtkMemoryMap* map);
+
+  /**
+   * Return the memory map holding the data, or nullptr if the data is not
+   * mapped.
+   */
+  vtkMemoryMap* GetMemoryMap() const { return this->MemoryMap; }
+
+  //@{
+  /**
+   * Set/Get the allocator used by Allocate() and Reallocate(). If nullptr,
+   * the malloc functions are used. Data allocated before changing the
+   * allocator is still freed by the allocator that allocated it. New buffers
+   * use the default allocator, unless they are created while memkind is in
+   * use (see vtkObjectBase::GetUsingMemkind()).
+   */
+  void SetAllocator(vtkDataArrayAllocator* allocator);
+  vtkDataArrayAllocator* GetAllocator() const { return this->Allocator; }
+  //@}
+
+  //@{
+  /**
+   * If true, Allocate() and Reallocate() map anonymous memory instead of
+   * using the malloc function, see vtkMemoryMap::MapAnonymous(). Default is
+   * false.
+   */
+  void SetUseMemoryMap(bool use) { this->UseMemoryMap = use; }
+  bool GetUseMemoryMap() const { return this->UseMemoryMap; }
+  //@}
+
   /**
    * Set the malloc function to be used when allocating space inside this object.
+   * This unsets the allocator, see SetAllocator().
    **/
   void SetMallocFunction(vtkMallocingFunction mallocFunction = malloc);
 
@@ -83,7 +128,9 @@ public:
 
   /**
    * Allocate a new buffer that holds @a newsize elements. Old data is
-   * preserved.
+   * preserved. Anonymous memory maps only used by this buffer are resized in
+   * place, other memory maps are kept when they shrink and are copied when
+   * they grow.
    */
   bool Reallocate(vtkIdType newsize);
 
@@ -91,21 +138,47 @@ protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
+    , MemoryMap(nullptr)
+    , UseMemoryMap(false)
+    , Allocator(nullptr)
+    , PointerAllocator(nullptr)
   {
     this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
     this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
     this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    // Buffers created to use memkind keep using it.
+    if (!vtkObjectBase::GetUsingMemkind())
+    {
+      this->SetAllocator(vtkDataArrayAllocator::GetDefault());
+    }
   }
 
-  ~vtkBuffer() override { this->SetBuffer(nullptr, 0); }
+  ~vtkBuffer() override
+  {
+    this->SetBuffer(nullptr, 0);
+    this->SetAllocator(nullptr);
+  }
 
   ScalarType* Pointer;
   vtkIdType Size;
   vtkMallocingFunction MallocFunction;
   vtkReallocingFunction ReallocFunction;
   vtkFreeingFunction DeleteFunction;
+  vtkMemoryMap* MemoryMap;
+  bool UseMemoryMap;
+  vtkDataArrayAllocator* Allocator;
+  // The allocator that allocated Pointer, if any.
+  vtkDataArrayAllocator* PointerAllocator;
 
 private:
+  // Map anonymous memory for @a size elements, copy the first @a numCopied
+  // elements of the current data to it and use it.
+  bool MapAnonymous(vtkIdType size, vtkIdType numCopied);
+
+  // Reallocate the data with the allocator, copying it if it was not
+  // allocated by the allocator.
+  bool AllocatorReallocate(vtkIdType newsize);
+
   vtkBuffer(const vtkBuffer&) = delete;
   void operator=(const vtkBuffer&) = delete;
 };
@@ -129,7 +202,19 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
 {
   if (this->Pointer != array)
   {
-    if (this->DeleteFunction)
+    if (this->MemoryMap)
+    {
+      // Mapped data is released with the last reference to its map.
+      this->MemoryMap->UnRegister(this);
+      this->MemoryMap = nullptr;
+    }
+    else if (this->PointerAllocator)
+    {
+      this->PointerAllocator->Free(this->Pointer);
+      this->PointerAllocator->UnRegister(this);
+      this->PointerAllocator = nullptr;
+    }
+    else if (this->DeleteFunction)
     {
       this->DeleteFunction(this->Pointer);
     }
@@ -137,11 +222,97 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
   }
   this->Size = size;
 }
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+void vtkBuffer<ScalarT>::SetMemoryMap(vtkMemoryMap* map)
+{
+  if (map && map == this->MemoryMap && map->GetData() == this->Pointer)
+  {
+    this->Size = static_cast<vtkIdType>(map->GetLength() / sizeof(ScalarType));
+    return;
+  }
+
+  this->SetBuffer(nullptr, 0);
+  if (map && map->GetData())
+  {
+    map->Register(this);
+    this->Pointer = static_cast<ScalarType*>(map->GetData());
+    this->Size = static_cast<vtkIdType>(map->GetLength() / sizeof(ScalarType));
+    this->MemoryMap = map;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+void vtkBuffer<ScalarT>::SetAllocator(vtkDataArrayAllocator* allocator)
+{
+  if (allocator != this->Allocator)
+  {
+    if (allocator)
+    {
+      allocator->Register(this);
+    }
+    if (this->Allocator)
+    {
+      this->Allocator->UnRegister(this);
+    }
+    this->Allocator = allocator;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::AllocatorReallocate(vtkIdType newsize)
+{
+  const size_t numBytes = static_cast<size_t>(newsize) * sizeof(ScalarType);
+  if (this->PointerAllocator == this->Allocator)
+  {
+    void* newArray = this->Allocator->Reallocate(this->Pointer, numBytes);
+    if (!newArray)
+    {
+      return false;
+    }
+    this->Pointer = static_cast<ScalarType*>(newArray);
+    this->Size = newsize;
+    return true;
+  }
+
+  ScalarType* newArray = static_cast<ScalarType*>(this->Allocator->Allocate(numBytes));
+  if (!newArray)
+  {
+    return false;
+  }
+  if (this->Pointer)
+  {
+    std::copy(this->Pointer, this->Pointer + std::min(this->Size, newsize), newArray);
+  }
+  this->SetBuffer(newArray, newsize);
+  this->Allocator->Register(this);
+  this->PointerAllocator = this->Allocator;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::MapAnonymous(vtkIdType size, vtkIdType numCopied)
+{
+  vtkMemoryMap* map = vtkMemoryMap::New();
+  const bool mapped = map->MapAnonymous(static_cast<size_t>(size) * sizeof(ScalarType));
+  if (mapped)
+  {
+    std::copy(this->Pointer, this->Pointer + numCopied, static_cast<ScalarType*>(map->GetData()));
+    this->SetMemoryMap(map);
+  }
+  map->Delete();
+  return mapped;
+}
 //------------------------------------------------------------------------------
 template <typename ScalarT>
 void vtkBuffer<ScalarT>::SetMallocFunction(vtkMallocingFunction mallocFunction)
 {
   this->MallocFunction = mallocFunction;
+  this->SetAllocator(nullptr);
 }
 //------------------------------------------------------------------------------
 template <typename ScalarT>
@@ -172,6 +343,15 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
   this->SetBuffer(nullptr, 0);
   if (size > 0)
   {
+    if (this->UseMemoryMap)
+    {
+      return this->MapAnonymous(size, 0);
+    }
+    if (this->Allocator)
+    {
+      return this->AllocatorReallocate(size);
+    }
+
     ScalarType* newArray;
     if (this->MallocFunction)
     {
@@ -204,7 +384,38 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     return this->Allocate(0);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  if (this->MemoryMap)
+  {
+    if (!this->MemoryMap->GetFileBacked() && this->MemoryMap->GetReferenceCount() == 1)
+    {
+      // The pages are moved rather than copied.
+      if (!this->MemoryMap->Resize(static_cast<size_t>(newsize) * sizeof(ScalarType)))
+      {
+        return false;
+      }
+      this->Pointer = static_cast<ScalarType*>(this->MemoryMap->GetData());
+      this->Size = newsize;
+      return true;
+    }
+    if (newsize <= this->Size)
+    {
+      // Mapped files and shared maps keep their length.
+      this->Size = newsize;
+      return true;
+    }
+  }
+
+  if (this->UseMemoryMap)
+  {
+    return this->MapAnonymous(newsize, std::min(this->Size, newsize));
+  }
+  if (this->Allocator)
+  {
+    return this->AllocatorReallocate(newsize);
+  }
+
+  if (this->Pointer &&
+    (this->MemoryMap || this->PointerAllocator || this->DeleteFunction != free))
   {
     ScalarType* newArray;
     if (this->MallocFunction)
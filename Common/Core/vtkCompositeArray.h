@@ -0,0 +1,97 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeArray
+ * @brief   An implicit array concatenating other arrays.
+ *
+ *
+ * vtkCompositeArray is a vtkImplicitArray using vtkCompositeImplicitBackend,
+ * which reads its values from a list of arrays put end to end, without
+ * copying them. The arrays may have any type but must have the same number of
+ * components as the composite array; the values of AOS and SOA arrays are
+ * read through their typed accessors, see vtkImplicitArrayValueReader().
+ *
+ * \code
+ * std::vector<vtkDataArray*> arrays = { pieceA, pieceB };
+ * vtkNew<vtkCompositeArray<float>> all;
+ * all->ConstructBackend(arrays);
+ * all->SetNumberOfComponents(3);
+ * all->SetNumberOfTuples(pieceA->GetNumberOfTuples() + pieceB->GetNumberOfTuples());
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkCompositeArray_h
+#define vtkCompositeArray_h
+
+#include "vtkDataArray.h"
+#include "vtkImplicitArray.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
+
+#include <algorithm>  // for std::upper_bound
+#include <functional> // for std::function
+#include <vector>     // for std::vector
+
+template <typename ValueType>
+class vtkCompositeImplicitBackend
+{
+public:
+  explicit vtkCompositeImplicitBackend(const std::vector<vtkDataArray*>& arrays)
+  {
+    this->Offsets.push_back(0);
+    for (vtkDataArray* array : arrays)
+    {
+      if (array && array->GetNumberOfValues() > 0)
+      {
+        this->Arrays.push_back(array);
+        this->Readers.push_back(vtkImplicitArrayValueReader<ValueType>(array));
+        this->Offsets.push_back(this->Offsets.back() + array->GetNumberOfValues());
+      }
+    }
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    // Offsets[i] is the index of the first value of Arrays[i].
+    const std::size_t arrayIdx = static_cast<std::size_t>(
+      std::upper_bound(this->Offsets.begin() + 1, this->Offsets.end(), valueIdx) -
+      this->Offsets.begin() - 1);
+    return this->Readers[arrayIdx](valueIdx - this->Offsets[arrayIdx]);
+  }
+
+  unsigned long GetActualMemorySize() const
+  {
+    unsigned long size = 1;
+    for (const auto& array : this->Arrays)
+    {
+      size += array->GetActualMemorySize();
+    }
+    return size;
+  }
+
+protected:
+  std::vector<vtkSmartPointer<vtkDataArray>> Arrays;
+  std::vector<std::function<ValueType(vtkIdType)>> Readers;
+  std::vector<vtkIdType> Offsets;
+};
+
+template <typename ValueType>
+using vtkCompositeArray = vtkImplicitArray<vtkCompositeImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkCompositeArray.h
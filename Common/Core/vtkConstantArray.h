@@ -0,0 +1,58 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   An implicit array with the same value everywhere.
+ *
+ *
+ * vtkConstantArray is a vtkImplicitArray using vtkConstantImplicitBackend:
+ *
+ * \code
+ * vtkNew<vtkConstantArray<float>> ones;
+ * ones->ConstructBackend(1.0f);
+ * ones->SetNumberOfComponents(3);
+ * ones->SetNumberOfTuples(numPoints);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueType>
+class vtkConstantImplicitBackend
+{
+public:
+  explicit vtkConstantImplicitBackend(ValueType value)
+    : Value(value)
+  {
+  }
+
+  ValueType operator()(vtkIdType) const { return this->Value; }
+
+protected:
+  ValueType Value;
+};
+
+template <typename ValueType>
+using vtkConstantArray = vtkImplicitArray<vtkConstantImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
@@ -15,6 +15,10 @@
 #   Include vtkTypedDataArray<ValueType> for the basic types supported
 #   by VTK. This enables the old-style in-situ vtkMappedDataArray subclasses
 #   to be used.
+# - VTK_DISPATCH_IMPLICIT_ARRAYS (default: OFF)
+#   Include vtkConstantArray, vtkAffineArray, vtkCompositeArray and
+#   vtkIndexedArray (see vtkImplicitArray) for the basic types supported by
+#   VTK, so that workers use them without expanding them into memory.
 #
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
@@ -146,6 +150,16 @@ if (VTK_DISPATCH_TYPED_ARRAYS)
   )
 endif()
 
+if (VTK_DISPATCH_IMPLICIT_ARRAYS)
+  foreach(container vtkConstantArray vtkAffineArray vtkCompositeArray vtkIndexedArray)
+    list(APPEND vtkArrayDispatch_containers ${container})
+    set(vtkArrayDispatch_${container}_header ${container}.h)
+    set(vtkArrayDispatch_${container}_types
+      ${vtkArrayDispatch_all_types}
+    )
+  endforeach()
+endif()
+
 endmacro()
 
 # Concatenates a list of strings into a single string, since string(CONCAT ...)
@@ -375,14 +375,47 @@ bool hasValidKey(InfoType info, KeyType key, double range[2])
 template <typename InfoType, typename KeyType, typename ComponentKeyType>
 bool hasValidKey(InfoType info, KeyType key, ComponentKeyType ckey, double range[2], int comp)
 {
+  // The per-component information may exist without range, e.g. when only
+  // the discrete values of the components were computed.
   if (info->Has(key))
   {
-    info->Get(key)->GetInformationObject(comp)->Get(ckey, range);
-    return true;
+    vtkInformation* compInfo = info->Get(key)->GetInformationObject(comp);
+    if (compInfo && compInfo->Has(ckey))
+    {
+      compInfo->Get(ckey, range);
+      return true;
+    }
   }
   return false;
 }
 
+// Store the ranges of all the components in the per-component information
+// of key, keeping the other per-component keys.
+void setComponentRanges(vtkInformation* info, vtkInformationInformationVectorKey* key,
+  vtkInformationDoubleVectorKey* ckey, const double* ranges, int numComps)
+{
+  vtkInformationVector* infoVec = info->Get(key);
+  if (!infoVec || infoVec->GetNumberOfInformationObjects() < numComps)
+  {
+    infoVec = vtkInformationVector::New();
+    infoVec->SetNumberOfInformationObjects(numComps);
+    info->Set(key, infoVec);
+    infoVec->FastDelete();
+  }
+  for (int i = 0; i < numComps; ++i)
+  {
+    infoVec->GetInformationObject(i)->Set(ckey, ranges + (i * 2), 2);
+  }
+}
+
+// Integer values are all finite: the range of an integer array is also its
+// finite range, and computing either one caches both.
+bool hasOnlyFiniteValues(vtkDataArray* array)
+{
+  const int type = array->GetDataType();
+  return type != VTK_FLOAT && type != VTK_DOUBLE;
+}
+
 } // end anon namespace
 
 vtkInformationKeyRestrictedMacro(vtkDataArray, COMPONENT_RANGE, DoubleVector, 2);
@@ -1461,10 +1494,8 @@ int vtkDataArray::CopyInformation(vtkInformation* infoFrom, int deep)
   // Remove any keys we own that are not to be copied here.
   vtkInformation* myInfo = this->GetInformation();
   // Range:
-  if (myInfo->Has(L2_NORM_RANGE()))
-  {
-    myInfo->Remove(L2_NORM_RANGE());
-  }
+  myInfo->Remove(L2_NORM_RANGE());
+  myInfo->Remove(L2_NORM_FINITE_RANGE());
 
   return 1;
 }
@@ -1495,9 +1526,12 @@ void vtkDataArray::ComputeFiniteRange(double range[2], int comp)
     // hasValidKey will update range to the cached value if it exists.
     if (!hasValidKey(info, rkey, range))
     {
-
       this->ComputeFiniteVectorRange(range);
       info->Set(rkey, range, 2);
+      if (hasOnlyFiniteValues(this))
+      {
+        info->Set(L2_NORM_RANGE(), range, 2);
+      }
     }
     return;
   }
@@ -1512,16 +1546,13 @@ void vtkDataArray::ComputeFiniteRange(double range[2], int comp)
       const bool computed = this->ComputeFiniteScalarRange(allCompRanges);
       if (computed)
       {
-        // construct the keys and add them to the info object
-        vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set(PER_FINITE_COMPONENT(), infoVec);
-
-        infoVec->SetNumberOfInformationObjects(this->NumberOfComponents);
-        for (int i = 0; i < this->NumberOfComponents; ++i)
+        // add the ranges to the info object
+        setComponentRanges(
+          info, PER_FINITE_COMPONENT(), rkey, allCompRanges, this->NumberOfComponents);
+        if (hasOnlyFiniteValues(this))
         {
-          infoVec->GetInformationObject(i)->Set(rkey, allCompRanges + (i * 2), 2);
+          setComponentRanges(info, PER_COMPONENT(), rkey, allCompRanges, this->NumberOfComponents);
         }
-        infoVec->FastDelete();
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -1560,6 +1591,10 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
     {
       this->ComputeVectorRange(range);
       info->Set(rkey, range, 2);
+      if (hasOnlyFiniteValues(this))
+      {
+        info->Set(L2_NORM_FINITE_RANGE(), range, 2);
+      }
     }
     return;
   }
@@ -1574,16 +1609,13 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
       const bool computed = this->ComputeScalarRange(allCompRanges);
       if (computed)
       {
-        // construct the keys and add them to the info object
-        vtkInformationVector* infoVec = vtkInformationVector::New();
-        info->Set(PER_COMPONENT(), infoVec);
-
-        infoVec->SetNumberOfInformationObjects(this->NumberOfComponents);
-        for (int i = 0; i < this->NumberOfComponents; ++i)
+        // add the ranges to the info object
+        setComponentRanges(info, PER_COMPONENT(), rkey, allCompRanges, this->NumberOfComponents);
+        if (hasOnlyFiniteValues(this))
         {
-          infoVec->GetInformationObject(i)->Set(rkey, allCompRanges + (i * 2), 2);
+          setComponentRanges(
+          info, PER_FINITE_COMPONENT(), rkey, allCompRanges, this->NumberOfComponents);
         }
-        infoVec->FastDelete();
 
         // update the range passed in since we have a valid range.
         range[0] = allCompRanges[comp * 2];
@@ -585,6 +585,8 @@ inline vtkDataArray* vtkDataArray::FastDownCast(vtkAbstractArray* source)
       case TypedDataArray:
       case DataArray:
       case MappedDataArray:
+      case ImplicitArray:
+      case CompressedDataArray:
         return static_cast<vtkDataArray*>(source);
       default:
         break;
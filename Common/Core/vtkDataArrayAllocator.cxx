@@ -0,0 +1,533 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+vtkStandardNewMacro(vtkDataArrayAllocator);
+
+namespace
+{
+std::atomic<vtkDataArrayAllocator*> DefaultAllocator(nullptr);
+
+enum BlockKind
+{
+  HeapBlock,  // malloc'd, may be realloc'd
+  HugeBlock,  // aligned on huge pages
+  PoolBlock,  // of the capacity of a size class of the pool
+  ArenaBlock, // in an arena chunk
+};
+
+struct ArenaChunk
+{
+  char* Data;
+  size_t Size;
+  size_t Used;
+  size_t Live;
+};
+
+// Each allocation is preceded by this header, padded to keep the alignment
+// of malloc.
+struct BlockHeader
+{
+  size_t Size;
+  size_t Capacity;
+  ArenaChunk* Chunk;
+  int Kind;
+};
+const size_t HeaderSize = 64;
+static_assert(sizeof(BlockHeader) <= HeaderSize, "Block header too large.");
+
+const size_t HugePageSize = 2 << 20;
+const size_t PageSize = 4096;
+
+BlockHeader* GetHeader(void* ptr)
+{
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - HeaderSize);
+}
+
+void* GetData(BlockHeader* header)
+{
+  return reinterpret_cast<char*>(header) + HeaderSize;
+}
+
+// Allocate raw memory, on huge pages if requested and supported.
+void* AllocateRaw(size_t size, bool huge)
+{
+#ifdef __linux__
+  if (huge)
+  {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, HugePageSize, size) != 0)
+    {
+      return nullptr;
+    }
+#ifdef MADV_HUGEPAGE
+    // Only advise the huge pages within the allocation.
+    const size_t hugeSize = size / HugePageSize * HugePageSize;
+    if (hugeSize > 0)
+    {
+      madvise(ptr, hugeSize, MADV_HUGEPAGE);
+    }
+#endif
+    return ptr;
+  }
+#else
+  (void)huge;
+#endif
+  return malloc(size);
+}
+
+// Zero the pages of a new allocation in parallel, so that each page is
+// first touched by the thread that will likely process it.
+void TouchPages(void* ptr, size_t size)
+{
+  char* data = static_cast<char*>(ptr);
+  const vtkIdType numPages = static_cast<vtkIdType>((size + PageSize - 1) / PageSize);
+  vtkSMPTools::For(0, numPages, [data, size](vtkIdType begin, vtkIdType end) {
+    const size_t first = static_cast<size_t>(begin) * PageSize;
+    const size_t last = std::min(static_cast<size_t>(end) * PageSize, size);
+    memset(data + first, 0, last - first);
+  });
+}
+
+// Size classes of the pool: four classes per power of two from 4 KiB to
+// 1 TiB, so that at most a fifth of a block is wasted.
+const int MinimumClassExponent = 12;
+const int MaximumClassExponent = 40;
+const int NumberOfClasses = 4 * (MaximumClassExponent - MinimumClassExponent);
+const int NumberOfShards = 8;
+
+// Return the size class of an allocation of size bytes and its capacity,
+// or -1 if the allocation is not pooled.
+int GetSizeClass(size_t size, size_t& capacity)
+{
+  if (size < (size_t(1) << MinimumClassExponent) || size >= (size_t(1) << MaximumClassExponent))
+  {
+    return -1;
+  }
+  int exponent = MinimumClassExponent;
+  while ((size >> (exponent + 1)) != 0)
+  {
+    ++exponent;
+  }
+  const size_t step = size_t(1) << (exponent - 2);
+  capacity = (size + step - 1) / step * step;
+  const int sizeClass =
+    4 * (exponent - MinimumClassExponent) + static_cast<int>(capacity / step) - 4;
+  return sizeClass < NumberOfClasses ? sizeClass : -1;
+}
+}
+
+struct vtkDataArrayAllocator::vtkInternals
+{
+  struct Shard
+  {
+    std::mutex Mutex;
+    std::vector<BlockHeader*> FreeBlocks[NumberOfClasses];
+  };
+  Shard Shards[NumberOfShards];
+
+  std::mutex ArenaMutex;
+  ArenaChunk* CurrentChunk = nullptr;
+
+  Shard& GetShard()
+  {
+    return this->Shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % NumberOfShards];
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkDataArrayAllocator::vtkDataArrayAllocator()
+  : Mode(HEAP)
+  , HugePages(false)
+  , FirstTouch(false)
+  , LargeAllocationSize(2 << 20)
+  , MaximumCachedSize(size_t(1) << 30)
+  , ArenaChunkSize(64 << 20)
+  , NumberOfAllocations(0)
+  , NumberOfFrees(0)
+  , AllocatedSize(0)
+  , PeakAllocatedSize(0)
+  , TotalAllocatedSize(0)
+  , ReservedSize(0)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkDataArrayAllocator::~vtkDataArrayAllocator()
+{
+  // Buffers keep their allocator alive, so that nothing is allocated anymore.
+  this->ReleaseCachedMemory();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void* vtkDataArrayAllocator::Allocate(size_t size)
+{
+  const bool large = size >= this->LargeAllocationSize;
+  const bool huge = this->HugePages && large;
+  BlockHeader* header = nullptr;
+  bool fresh = true;
+
+  size_t capacity = size;
+  int sizeClass;
+  if (this->Mode == POOL && (sizeClass = GetSizeClass(size, capacity)) >= 0)
+  {
+    vtkInternals::Shard& shard = this->Internals->GetShard();
+    {
+      std::lock_guard<std::mutex> lock(shard.Mutex);
+      std::vector<BlockHeader*>& freeBlocks = shard.FreeBlocks[sizeClass];
+      if (!freeBlocks.empty())
+      {
+        header = freeBlocks.back();
+        freeBlocks.pop_back();
+      }
+    }
+    if (header)
+    {
+      this->ReservedSize -= header->Capacity;
+      fresh = false;
+    }
+    else
+    {
+      header = static_cast<BlockHeader*>(AllocateRaw(HeaderSize + capacity, huge));
+      if (!header)
+      {
+        return nullptr;
+      }
+      header->Kind = PoolBlock;
+      header->Capacity = capacity;
+    }
+  }
+  else if (this->Mode == ARENA && size <= std::max(this->ArenaChunkSize, PageSize) / 4)
+  {
+    const size_t chunkSize = std::max(this->ArenaChunkSize, PageSize);
+    const size_t needed = (HeaderSize + size + HeaderSize - 1) / HeaderSize * HeaderSize;
+    std::unique_lock<std::mutex> lock(this->Internals->ArenaMutex);
+    ArenaChunk* chunk = this->Internals->CurrentChunk;
+    if (!chunk || chunk->Used + needed > chunk->Size)
+    {
+      // Allocate and touch the new chunk without blocking the other threads.
+      lock.unlock();
+      const bool largeChunk = chunkSize >= this->LargeAllocationSize;
+      char* data = static_cast<char*>(AllocateRaw(chunkSize, this->HugePages && largeChunk));
+      if (!data)
+      {
+        return nullptr;
+      }
+      if (this->FirstTouch && largeChunk)
+      {
+        TouchPages(data, chunkSize);
+      }
+      lock.lock();
+
+      // A chunk still holding allocations is freed with its last one.
+      chunk = this->Internals->CurrentChunk;
+      if (chunk && chunk->Live == 0)
+      {
+        free(chunk->Data);
+        this->ReservedSize -= chunk->Size;
+        delete chunk;
+      }
+      chunk = new ArenaChunk{ data, chunkSize, 0, 0 };
+      this->Internals->CurrentChunk = chunk;
+      this->ReservedSize += chunkSize;
+    }
+    header = reinterpret_cast<BlockHeader*>(chunk->Data + chunk->Used);
+    chunk->Used += needed;
+    ++chunk->Live;
+    header->Kind = ArenaBlock;
+    header->Capacity = needed - HeaderSize;
+    header->Chunk = chunk;
+    // Chunks are touched as a whole.
+    fresh = false;
+  }
+  else
+  {
+    header = static_cast<BlockHeader*>(AllocateRaw(HeaderSize + size, huge));
+    if (!header)
+    {
+      return nullptr;
+    }
+    header->Kind = huge ? HugeBlock : HeapBlock;
+    header->Capacity = size;
+  }
+
+  header->Size = size;
+  void* data = GetData(header);
+  if (fresh && this->FirstTouch && large)
+  {
+    TouchPages(data, size);
+  }
+
+  ++this->NumberOfAllocations;
+  this->TotalAllocatedSize += size;
+  const vtkTypeUInt64 allocated = (this->AllocatedSize += size);
+  vtkTypeUInt64 peak = this->PeakAllocatedSize;
+  while (allocated > peak && !this->PeakAllocatedSize.compare_exchange_weak(peak, allocated))
+  {
+  }
+  return data;
+}
+
+//------------------------------------------------------------------------------
+void* vtkDataArrayAllocator::Reallocate(void* ptr, size_t size)
+{
+  if (!ptr)
+  {
+    return this->Allocate(size);
+  }
+
+  BlockHeader* header = GetHeader(ptr);
+  const size_t oldSize = header->Size;
+  bool inPlace = false;
+  if (header->Kind == HeapBlock && !(this->HugePages && size >= this->LargeAllocationSize))
+  {
+    // Let realloc avoid the copy if it can.
+    BlockHeader* newHeader = static_cast<BlockHeader*>(realloc(header, HeaderSize + size));
+    if (!newHeader)
+    {
+      return nullptr;
+    }
+    header = newHeader;
+    header->Capacity = size;
+    inPlace = true;
+  }
+  else if (header->Kind == PoolBlock)
+  {
+    // Keep the block if its size class does not change.
+    size_t capacity;
+    inPlace = size <= header->Capacity && GetSizeClass(size, capacity) >= 0 &&
+      capacity == header->Capacity;
+  }
+  else if (header->Kind == ArenaBlock)
+  {
+    // The last allocation of the current chunk grows or shrinks in place.
+    std::lock_guard<std::mutex> lock(this->Internals->ArenaMutex);
+    ArenaChunk* chunk = header->Chunk;
+    char* end = static_cast<char*>(ptr) + header->Capacity;
+    const size_t capacity = (size + HeaderSize - 1) / HeaderSize * HeaderSize;
+    if (chunk == this->Internals->CurrentChunk && end == chunk->Data + chunk->Used &&
+      chunk->Used - header->Capacity + capacity <= chunk->Size)
+    {
+      chunk->Used = chunk->Used - header->Capacity + capacity;
+      header->Capacity = capacity;
+      inPlace = true;
+    }
+  }
+
+  if (!inPlace)
+  {
+    void* newPtr = this->Allocate(size);
+    if (!newPtr)
+    {
+      return nullptr;
+    }
+    memcpy(newPtr, ptr, std::min(size, oldSize));
+    this->Free(ptr);
+    return newPtr;
+  }
+
+  header->Size = size;
+  ++this->NumberOfAllocations;
+  ++this->NumberOfFrees;
+  this->TotalAllocatedSize += size;
+  // Apply the change of size at once (modulo 2^64 when shrinking), so that
+  // the old size is not counted twice.
+  const vtkTypeUInt64 delta = static_cast<vtkTypeUInt64>(size) - oldSize;
+  const vtkTypeUInt64 allocated = (this->AllocatedSize += delta);
+  vtkTypeUInt64 peak = this->PeakAllocatedSize;
+  while (allocated > peak && !this->PeakAllocatedSize.compare_exchange_weak(peak, allocated))
+  {
+  }
+  return GetData(header);
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayAllocator::Free(void* ptr)
+{
+  if (!ptr)
+  {
+    return;
+  }
+
+  BlockHeader* header = GetHeader(ptr);
+  ++this->NumberOfFrees;
+  this->AllocatedSize -= header->Size;
+
+  switch (header->Kind)
+  {
+    case PoolBlock:
+    {
+      size_t capacity;
+      const int sizeClass = GetSizeClass(header->Capacity, capacity);
+      // Reserve the room in the cache before caching the block, so that
+      // concurrent frees do not exceed MaximumCachedSize.
+      vtkTypeUInt64 reserved = this->ReservedSize;
+      bool cache;
+      do
+      {
+        cache = reserved + header->Capacity <= this->MaximumCachedSize;
+      } while (
+        cache && !this->ReservedSize.compare_exchange_weak(reserved, reserved + header->Capacity));
+      if (cache)
+      {
+        vtkInternals::Shard& shard = this->Internals->GetShard();
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        shard.FreeBlocks[sizeClass].push_back(header);
+      }
+      else
+      {
+        free(header);
+      }
+      break;
+    }
+    case ArenaBlock:
+    {
+      std::lock_guard<std::mutex> lock(this->Internals->ArenaMutex);
+      ArenaChunk* chunk = header->Chunk;
+      if (--chunk->Live == 0)
+      {
+        if (chunk == this->Internals->CurrentChunk)
+        {
+          // Reuse the whole chunk.
+          chunk->Used = 0;
+        }
+        else
+        {
+          free(chunk->Data);
+          this->ReservedSize -= chunk->Size;
+          delete chunk;
+        }
+      }
+      break;
+    }
+    default:
+      free(header);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayAllocator::ReleaseCachedMemory()
+{
+  for (vtkInternals::Shard& shard : this->Internals->Shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    for (std::vector<BlockHeader*>& freeBlocks : shard.FreeBlocks)
+    {
+      for (BlockHeader* header : freeBlocks)
+      {
+        this->ReservedSize -= header->Capacity;
+        free(header);
+      }
+      std::vector<BlockHeader*>().swap(freeBlocks);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->ArenaMutex);
+  ArenaChunk* chunk = this->Internals->CurrentChunk;
+  if (chunk && chunk->Live == 0)
+  {
+    free(chunk->Data);
+    this->ReservedSize -= chunk->Size;
+    delete chunk;
+    this->Internals->CurrentChunk = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayAllocator::ResetStatistics()
+{
+  this->NumberOfAllocations = 0;
+  this->NumberOfFrees = 0;
+  this->PeakAllocatedSize = this->AllocatedSize.load();
+  this->TotalAllocatedSize = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayAllocator::SetDefault(vtkDataArrayAllocator* allocator)
+{
+  if (allocator)
+  {
+    allocator->Register(nullptr);
+  }
+  vtkDataArrayAllocator* previous = DefaultAllocator.exchange(allocator);
+  if (previous)
+  {
+    previous->UnRegister(nullptr);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkDataArrayAllocator* vtkDataArrayAllocator::GetDefault()
+{
+  return DefaultAllocator;
+}
+
+//------------------------------------------------------------------------------
+vtkDataArrayAllocator::vtkDefaultRAII::vtkDefaultRAII(vtkDataArrayAllocator* allocator)
+  : Previous(vtkDataArrayAllocator::GetDefault())
+{
+  if (this->Previous)
+  {
+    this->Previous->Register(nullptr);
+  }
+  vtkDataArrayAllocator::SetDefault(allocator);
+}
+
+//------------------------------------------------------------------------------
+vtkDataArrayAllocator::vtkDefaultRAII::~vtkDefaultRAII()
+{
+  vtkDataArrayAllocator::SetDefault(this->Previous);
+  if (this->Previous)
+  {
+    this->Previous->UnRegister(nullptr);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Mode: "
+     << (this->Mode == HEAP ? "HEAP" : (this->Mode == POOL ? "POOL" : "ARENA")) << endl;
+  os << indent << "HugePages: " << (this->HugePages ? "On" : "Off") << endl;
+  os << indent << "FirstTouch: " << (this->FirstTouch ? "On" : "Off") << endl;
+  os << indent << "LargeAllocationSize: " << this->LargeAllocationSize << endl;
+  os << indent << "MaximumCachedSize: " << this->MaximumCachedSize << endl;
+  os << indent << "ArenaChunkSize: " << this->ArenaChunkSize << endl;
+  os << indent << "NumberOfAllocations: " << this->NumberOfAllocations << endl;
+  os << indent << "NumberOfFrees: " << this->NumberOfFrees << endl;
+  os << indent << "AllocatedSize: " << this->AllocatedSize << endl;
+  os << indent << "PeakAllocatedSize: " << this->PeakAllocatedSize << endl;
+  os << indent << "TotalAllocatedSize: " << this->TotalAllocatedSize << endl;
+  os << indent << "ReservedSize: " << this->ReservedSize << endl;
+}
@@ -0,0 +1,228 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDataArrayAllocator
+ * @brief   allocator of the memory of data arrays, with allocation statistics.
+ *
+ * vtkDataArrayAllocator allocates the values of the arrays whose vtkBuffer
+ * uses it, see vtkBuffer::SetAllocator(). New buffers use the default
+ * allocator, which is nullptr unless set with SetDefault() or with a
+ * vtkDefaultRAII on the stack, e.g. around a pipeline update. Without
+ * allocator, buffers use the malloc functions of vtkObjectBase.
+ *
+ * The allocator works in one of the following modes:
+ * - HEAP: every allocation is made with malloc.
+ * - POOL: freed blocks are cached, by size class, in a few shards selected
+ *   by the calling thread, and reused by the following allocations of the
+ *   same size class. This avoids returning the memory of the many temporary
+ *   arrays of filters to the system only to ask for it again.
+ * - ARENA: allocations are carved out of large chunks, and a chunk is freed
+ *   in bulk when all the allocations it holds have been freed. Growing the
+ *   last allocation of a chunk is done in place.
+ *
+ * In every mode, large allocations can be backed by huge pages where the
+ * system supports them (transparent huge pages on Linux), and their pages
+ * can be first touched in parallel by vtkSMPTools, so that on NUMA systems
+ * each page lives close to the thread that will most likely process it.
+ *
+ * The allocator counts the allocations, the frees and the allocated bytes,
+ * including their peak. Changing the mode only affects the following
+ * allocations. The allocator is thread safe.
+ *
+ * @sa
+ * vtkBuffer vtkAOSDataArrayTemplate
+ */
+
+#ifndef vtkDataArrayAllocator_h
+#define vtkDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <atomic>  // For std::atomic
+#include <cstddef> // For size_t
+
+class VTKCOMMONCORE_EXPORT vtkDataArrayAllocator : public vtkObject
+{
+public:
+  static vtkDataArrayAllocator* New();
+  vtkTypeMacro(vtkDataArrayAllocator, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum Modes
+  {
+    HEAP,
+    POOL,
+    ARENA
+  };
+
+  //@{
+  /**
+   * Set/Get the allocation mode. Default is HEAP.
+   */
+  vtkSetClampMacro(Mode, int, HEAP, ARENA);
+  vtkGetMacro(Mode, int);
+  void SetModeToHeap() { this->SetMode(HEAP); }
+  void SetModeToPool() { this->SetMode(POOL); }
+  void SetModeToArena() { this->SetMode(ARENA); }
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether allocations of at least LargeAllocationSize bytes are
+   * backed by huge pages. This is ignored where not supported. Default is
+   * false.
+   */
+  vtkSetMacro(HugePages, bool);
+  vtkGetMacro(HugePages, bool);
+  vtkBooleanMacro(HugePages, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the pages of new allocations of at least
+   * LargeAllocationSize bytes are first touched, i.e. zeroed, in parallel
+   * with vtkSMPTools. Default is false.
+   */
+  vtkSetMacro(FirstTouch, bool);
+  vtkGetMacro(FirstTouch, bool);
+  vtkBooleanMacro(FirstTouch, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size in bytes from which allocations use huge pages and are
+   * first touched in parallel. Default is 2 MiB.
+   */
+  vtkSetMacro(LargeAllocationSize, size_t);
+  vtkGetMacro(LargeAllocationSize, size_t);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the maximum number of bytes of freed blocks kept by the POOL
+   * mode. Default is 1 GiB.
+   */
+  vtkSetMacro(MaximumCachedSize, size_t);
+  vtkGetMacro(MaximumCachedSize, size_t);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size in bytes of the chunks of the ARENA mode, at least
+   * 4 KiB. Allocations larger than a quarter of a chunk are made with malloc.
+   * Default is 64 MiB.
+   */
+  vtkSetMacro(ArenaChunkSize, size_t);
+  vtkGetMacro(ArenaChunkSize, size_t);
+  //@}
+
+  /**
+   * Allocate @a size bytes, aligned like malloc. Return nullptr on failure.
+   */
+  void* Allocate(size_t size);
+
+  /**
+   * Change the size of the allocation @a ptr to @a size bytes, preserving
+   * its data. @a ptr may be nullptr. Return nullptr on failure, in which case
+   * @a ptr is left untouched.
+   */
+  void* Reallocate(void* ptr, size_t size);
+
+  /**
+   * Free the allocation @a ptr, which may be nullptr.
+   */
+  void Free(void* ptr);
+
+  /**
+   * Return the memory cached by the POOL mode, and the unused chunks of the
+   * ARENA mode, to the system.
+   */
+  void ReleaseCachedMemory();
+
+  //@{
+  /**
+   * Allocation statistics: number of allocations and frees, including those
+   * made by Reallocate(), number of bytes currently allocated, peak and
+   * total number of allocated bytes, number of bytes cached by the POOL
+   * mode or held by the chunks of the ARENA mode.
+   */
+  vtkTypeUInt64 GetNumberOfAllocations() const { return this->NumberOfAllocations; }
+  vtkTypeUInt64 GetNumberOfFrees() const { return this->NumberOfFrees; }
+  vtkTypeUInt64 GetAllocatedSize() const { return this->AllocatedSize; }
+  vtkTypeUInt64 GetPeakAllocatedSize() const { return this->PeakAllocatedSize; }
+  vtkTypeUInt64 GetTotalAllocatedSize() const { return this->TotalAllocatedSize; }
+  vtkTypeUInt64 GetReservedSize() const { return this->ReservedSize; }
+  //@}
+
+  /**
+   * Reset the statistics, except the number of currently allocated bytes
+   * which becomes the peak.
+   */
+  void ResetStatistics();
+
+  //@{
+  /**
+   * Set/Get the allocator used by new vtkBuffer objects. Default is nullptr,
+   * for the malloc functions of vtkObjectBase. Buffers keep a reference to
+   * their allocator, which must not be changed while other threads create
+   * arrays.
+   */
+  static void SetDefault(vtkDataArrayAllocator* allocator);
+  static vtkDataArrayAllocator* GetDefault();
+  //@}
+
+  /**
+   * A class to set the default allocator while it is on the stack, e.g.
+   * during a pipeline update, and to restore the previous one afterwards.
+   */
+  class VTKCOMMONCORE_EXPORT vtkDefaultRAII
+  {
+    vtkDataArrayAllocator* Previous;
+
+  public:
+    vtkDefaultRAII(vtkDataArrayAllocator* allocator);
+    ~vtkDefaultRAII();
+    vtkDefaultRAII(const vtkDefaultRAII&) = delete;
+    void operator=(const vtkDefaultRAII&) = delete;
+  };
+
+protected:
+  vtkDataArrayAllocator();
+  ~vtkDataArrayAllocator() override;
+
+  int Mode;
+  bool HugePages;
+  bool FirstTouch;
+  size_t LargeAllocationSize;
+  size_t MaximumCachedSize;
+  size_t ArenaChunkSize;
+
+  std::atomic<vtkTypeUInt64> NumberOfAllocations;
+  std::atomic<vtkTypeUInt64> NumberOfFrees;
+  std::atomic<vtkTypeUInt64> AllocatedSize;
+  std::atomic<vtkTypeUInt64> PeakAllocatedSize;
+  std::atomic<vtkTypeUInt64> TotalAllocatedSize;
+  std::atomic<vtkTypeUInt64> ReservedSize;
+
+private:
+  vtkDataArrayAllocator(const vtkDataArrayAllocator&) = delete;
+  void operator=(const vtkDataArrayAllocator&) = delete;
+
+  struct vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -15,6 +15,7 @@
 #ifndef vtkDataArrayPrivate_txx
 #define vtkDataArrayPrivate_txx
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkAssume.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
@@ -24,6 +25,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert> // for assert()
+#include <type_traits>
 #include <vector>
 
 namespace vtkDataArrayPrivate
@@ -98,6 +100,134 @@ bool isinf(T x)
 }
 }
 
+namespace detail
+{
+// Arrays with fewer values than this are scanned by the calling thread:
+// starting the threads would cost more than the scan itself.
+const vtkIdType SerialRangeThreshold = 65536;
+
+template <typename ArrayT, typename Functor>
+void ForAllTuples(ArrayT* array, Functor& functor)
+{
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  if (numTuples * array->GetNumberOfComponents() < SerialRangeThreshold)
+  {
+    vtkSMPTools::For(0, numTuples, numTuples, functor);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numTuples, functor);
+  }
+}
+
+// Whether a value takes part in the range. For the finite range of floating
+// point values, x - x is 0 for finite values and NaN for infinities and NaN.
+template <typename T, bool Finite, bool IsFloat = std::is_floating_point<T>::value>
+struct RangeFilter
+{
+  static bool Keep(T) { return true; }
+};
+
+template <typename T>
+struct RangeFilter<T, true, true>
+{
+  static bool Keep(T x) { return x - x == T(0); }
+};
+
+// Update the ranges of the components with the tuples [begin, end) of an
+// array, using its tuple range.
+template <int NumComps, bool Finite, typename ArrayT, typename APIType>
+void UpdateTupleRanges(ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range)
+{
+  const auto tuples = vtk::DataArrayTupleRange<NumComps>(array, begin, end);
+  for (const auto tuple : tuples)
+  {
+    size_t j = 0;
+    for (const APIType value : tuple)
+    {
+      if (!Finite || !isinf(value))
+      {
+        range[j] = min(range[j], value);
+        range[j + 1] = max(range[j + 1], value);
+      }
+      j += 2;
+    }
+  }
+}
+
+// The values of vtkAOSDataArrayTemplate are contiguous. They are scanned by
+// blocks of Lanes tuples, with one pair of accumulators per value of a block,
+// which are updated without branches so that compilers turn the loop into
+// packed min/max instructions for float, double and integer values. NaN
+// values are skipped like above since comparisons with NaN are false.
+template <int NumComps, bool Finite, typename T>
+void UpdateContiguousRanges(
+  vtkAOSDataArrayTemplate<T>* array, vtkIdType begin, vtkIdType end, T* range)
+{
+  const int Lanes = 8;
+  const int Width = NumComps * Lanes;
+  T lo[Width];
+  T hi[Width];
+  for (int k = 0; k < Width; ++k)
+  {
+    lo[k] = range[(k % NumComps) * 2];
+    hi[k] = range[(k % NumComps) * 2 + 1];
+  }
+
+  const T* values = array->GetPointer(begin * NumComps);
+  const T* blocksEnd = values + ((end - begin) / Lanes) * Width;
+  const T* valuesEnd = values + (end - begin) * NumComps;
+  for (; values != blocksEnd; values += Width)
+  {
+    for (int k = 0; k < Width; ++k)
+    {
+      const T value = values[k];
+      const bool keep = RangeFilter<T, Finite>::Keep(value);
+      lo[k] = (keep & (value < lo[k])) ? value : lo[k];
+      hi[k] = (keep & (value > hi[k])) ? value : hi[k];
+    }
+  }
+  for (int k = 0; values != valuesEnd; ++values, k = (k + 1 == NumComps) ? 0 : k + 1)
+  {
+    const T value = *values;
+    const bool keep = RangeFilter<T, Finite>::Keep(value);
+    lo[k] = (keep & (value < lo[k])) ? value : lo[k];
+    hi[k] = (keep & (value > hi[k])) ? value : hi[k];
+  }
+
+  for (int k = 0; k < Width; ++k)
+  {
+    const int j = (k % NumComps) * 2;
+    range[j] = min(range[j], lo[k]);
+    range[j + 1] = max(range[j + 1], hi[k]);
+  }
+}
+
+template <int NumComps, bool Finite, typename ArrayT, typename APIType>
+void UpdateRanges(
+  ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range, std::true_type /* AOS */)
+{
+  UpdateContiguousRanges<NumComps, Finite>(
+    static_cast<vtkAOSDataArrayTemplate<APIType>*>(array), begin, end, range);
+}
+
+template <int NumComps, bool Finite, typename ArrayT, typename APIType>
+void UpdateRanges(
+  ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range, std::false_type /* AOS */)
+{
+  UpdateTupleRanges<NumComps, Finite>(array, begin, end, range);
+}
+
+// Scan the values of vtkAOSDataArrayTemplate and of its subclasses, such as
+// vtkFloatArray, contiguously.
+template <int NumComps, bool Finite, typename ArrayT, typename APIType>
+void UpdateRanges(ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range)
+{
+  UpdateRanges<NumComps, Finite>(array, begin, end, range,
+    std::is_base_of<vtkAOSDataArrayTemplate<APIType>, ArrayT>());
+}
+}
+
 template <typename APIType, int NumComps>
 class MinAndMax
 {
@@ -158,18 +288,8 @@ public:
   void Reduce() { MinAndMaxT::Reduce(); }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
-    for (const auto tuple : tuples)
-    {
-      size_t j = 0;
-      for (const APIType value : tuple)
-      {
-        range[j] = detail::min(range[j], value);
-        range[j + 1] = detail::max(range[j + 1], value);
-        j += 2;
-      }
-    }
+    detail::UpdateRanges<NumComps, false>(this->Array, begin, end, range.data());
   }
 };
 
@@ -191,21 +311,8 @@ public:
   void Reduce() { MinAndMaxT::Reduce(); }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
-    for (const auto tuple : tuples)
-    {
-      size_t j = 0;
-      for (const APIType value : tuple)
-      {
-        if (!detail::isinf(value))
-        {
-          range[j] = detail::min(range[j], value);
-          range[j + 1] = detail::max(range[j + 1], value);
-        }
-        j += 2;
-      }
-    }
+    detail::UpdateRanges<NumComps, true>(this->Array, begin, end, range.data());
   }
 };
 
@@ -304,7 +411,7 @@ struct ComputeScalarRange
   bool operator()(ArrayT* array, RangeValueType* ranges, AllValues)
   {
     AllValuesMinAndMax<NumComps, ArrayT> minmax(array);
-    vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
+    detail::ForAllTuples(array, minmax);
     minmax.CopyRanges(ranges);
     return true;
   }
@@ -312,7 +419,7 @@ struct ComputeScalarRange
   bool operator()(ArrayT* array, RangeValueType* ranges, FiniteValues)
   {
     FiniteMinAndMax<NumComps, ArrayT> minmax(array);
-    vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
+    detail::ForAllTuples(array, minmax);
     minmax.CopyRanges(ranges);
     return true;
   }
@@ -438,7 +545,7 @@ template <class ArrayT, typename RangeValueType>
 bool GenericComputeScalarRange(ArrayT* array, RangeValueType* ranges, AllValues)
 {
   AllValuesGenericMinAndMax<ArrayT> minmax(array);
-  vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
+  detail::ForAllTuples(array, minmax);
   minmax.CopyRanges(ranges);
   return true;
 }
@@ -447,7 +554,7 @@ template <class ArrayT, typename RangeValueType>
 bool GenericComputeScalarRange(ArrayT* array, RangeValueType* ranges, FiniteValues)
 {
   FiniteGenericMinAndMax<ArrayT> minmax(array);
-  vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
+  detail::ForAllTuples(array, minmax);
   minmax.CopyRanges(ranges);
   return true;
 }
@@ -534,7 +641,7 @@ bool DoComputeVectorRange(ArrayT* array, RangeValueType range[2], AllValues)
   // give precision errors on large 64-bit ints, but magnitudes aren't usually
   // computed for those.
   MagnitudeAllValuesMinAndMax<ArrayT, double> MinAndMax(array);
-  vtkSMPTools::For(0, numTuples, MinAndMax);
+  detail::ForAllTuples(array, MinAndMax);
   MinAndMax.CopyRanges(range);
   return true;
 }
@@ -558,7 +665,7 @@ bool DoComputeVectorRange(ArrayT* array, RangeValueType range[2], FiniteValues)
   // give precision errors on large 64-bit ints, but magnitudes aren't usually
   // computed for those.
   MagnitudeFiniteMinAndMax<ArrayT, double> MinAndMax(array);
-  vtkSMPTools::For(0, numTuples, MinAndMax);
+  detail::ForAllTuples(array, MinAndMax);
   MinAndMax.CopyRanges(range);
   return true;
 }
@@ -397,9 +397,18 @@ protected:
    */
   bool ComputeFiniteVectorValueRange(ValueType range[2]);
 
+  /**
+   * Get the range of a component, or of the L2 norm if comp is -1, for the
+   * value types whose ranges are computed in vtkGenericDataArray.cxx. The
+   * component ranges are computed once per modification of the array.
+   */
+  void GetCachedValueRange(ValueType range[2], int comp);
+
   std::vector<double> LegacyTuple;
   std::vector<ValueType> LegacyValueRange;
   std::vector<ValueType> LegacyValueRangeFull;
+  vtkMTimeType LegacyValueRangeFullMTime = 0;
+  vtkIdType LegacyValueRangeFullMaxId = -1;
 
   vtkGenericDataArrayLookupHelper<SelfType> Lookup;
 
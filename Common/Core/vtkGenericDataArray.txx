@@ -1048,7 +1048,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::ComputeValueRange(ValueType rang
   range[0] = vtkTypeTraits<ValueType>::Max();
   range[1] = vtkTypeTraits<ValueType>::Min();
 
-  if (comp > this->NumberOfComponents)
+  if (comp >= this->NumberOfComponents)
   {
     return;
   }
@@ -1058,21 +1058,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::ComputeValueRange(ValueType rang
     comp = 0;
   }
 
-  // TODO this should eventually cache the results, but we do not have support
-  // for all of the information keys we need to cover all possible value types.
-  if (comp < 0)
-  {
-    this->ComputeVectorValueRange(range);
-  }
-  else
-  {
-    this->LegacyValueRangeFull.resize(this->NumberOfComponents * 2);
-    if (this->ComputeScalarValueRange(this->LegacyValueRangeFull.data()))
-    {
-      range[0] = this->LegacyValueRangeFull[comp * 2];
-      range[1] = this->LegacyValueRangeFull[comp * 2 + 1];
-    }
-  }
+  this->GetCachedValueRange(range, comp);
 }
 
 //-----------------------------------------------------------------------------
@@ -1102,7 +1088,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::ComputeFiniteValueRange(
   range[0] = vtkTypeTraits<ValueType>::Max();
   range[1] = vtkTypeTraits<ValueType>::Min();
 
-  if (comp > this->NumberOfComponents)
+  if (comp >= this->NumberOfComponents)
   {
     return;
   }
@@ -1112,21 +1098,39 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::ComputeFiniteValueRange(
     comp = 0;
   }
 
-  // TODO this should eventually cache the results, but we do not have support
-  // for all of the information keys we need to cover all possible value types.
+  // The values are integers, so that their finite range is their range.
+  this->GetCachedValueRange(range, comp);
+}
+
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkGenericDataArray<DerivedT, ValueTypeT>::GetCachedValueRange(ValueType range[2], int comp)
+{
   if (comp < 0)
   {
-    this->ComputeFiniteVectorValueRange(range);
+    this->ComputeVectorValueRange(range);
+    return;
   }
-  else
+
+  // The component ranges cannot be cached in the information keys of
+  // vtkDataArray, which hold doubles, so they are cached here. They are
+  // computed again when the array is modified or resized.
+  const vtkMTimeType mtime = this->GetMTime();
+  const size_t numRanges = static_cast<size_t>(this->NumberOfComponents) * 2;
+  if (this->LegacyValueRangeFullMTime != mtime || this->LegacyValueRangeFullMaxId != this->MaxId ||
+    this->LegacyValueRangeFull.size() != numRanges)
   {
-    this->LegacyValueRangeFull.resize(this->NumberOfComponents * 2);
-    if (this->ComputeFiniteScalarValueRange(this->LegacyValueRangeFull.data()))
+    this->LegacyValueRangeFull.resize(numRanges);
+    if (!this->ComputeScalarValueRange(this->LegacyValueRangeFull.data()))
     {
-      range[0] = this->LegacyValueRangeFull[comp * 2];
-      range[1] = this->LegacyValueRangeFull[comp * 2 + 1];
+      this->LegacyValueRangeFullMTime = 0;
+      return;
     }
+    this->LegacyValueRangeFullMTime = mtime;
+    this->LegacyValueRangeFullMaxId = this->MaxId;
   }
+  range[0] = this->LegacyValueRangeFull[comp * 2];
+  range[1] = this->LegacyValueRangeFull[comp * 2 + 1];
 }
 
 namespace vtk_GDA_detail
@@ -0,0 +1,328 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   A read-only vtkGenericDataArray whose values are computed on
+ * access.
+ *
+ *
+ * vtkImplicitArray stores no values: the value at a given index is returned
+ * by a backend, which is any copyable object with a const call operator
+ * taking the index of the value in AOS ordering:
+ *
+ * \code
+ * struct HalfIndex
+ * {
+ *   float operator()(vtkIdType valueIdx) const { return 0.5f * valueIdx; }
+ * };
+ * vtkNew<vtkImplicitArray<HalfIndex>> array;
+ * array->ConstructBackend();
+ * array->SetNumberOfTuples(1000000000);
+ * \endcode
+ *
+ * The value type of the array is the return type of the call operator. The
+ * shape of the array (number of components and tuples) is set as usual and
+ * costs no memory. Backends are shared by copies of the array and are
+ * expected not to change once the array is in use.
+ *
+ * The Set methods do nothing. NewInstance() returns a regular
+ * vtkAOSDataArrayTemplate of the same value type, so that filters copying or
+ * interpolating these arrays produce arrays they can modify. GetVoidPointer()
+ * is supported but expands the array into memory: use vtkArrayDispatch, the
+ * vtkDataArrayRange API or the Get methods instead.
+ *
+ * vtkConstantArray, vtkAffineArray, vtkCompositeArray and vtkIndexedArray
+ * are ready-made implicit arrays.
+ *
+ * @sa
+ * vtkGenericDataArray vtkConstantArray vtkAffineArray vtkCompositeArray
+ * vtkIndexedArray
+ */
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkAOSDataArrayTemplate.h" // For GetVoidPointer
+#include "vtkGenericDataArray.h"
+#include "vtkSOADataArrayTemplate.h" // For vtkImplicitArrayValueReader
+#include "vtkSmartPointer.h"         // For GetVoidPointer
+
+#include <algorithm>   // for std::fill
+#include <functional>  // for std::function
+#include <memory>      // for std::shared_ptr
+#include <type_traits> // for std::decay
+#include <utility>     // for std::declval
+
+template <class BackendT>
+struct vtkImplicitArrayTraits
+{
+  typedef typename std::decay<decltype(std::declval<const BackendT&>()(vtkIdType(0)))>::type
+    ValueType;
+};
+
+template <class BackendT>
+class vtkImplicitArray
+  : public vtkGenericDataArray<vtkImplicitArray<BackendT>,
+      typename vtkImplicitArrayTraits<BackendT>::ValueType>
+{
+  typedef vtkGenericDataArray<vtkImplicitArray<BackendT>,
+    typename vtkImplicitArrayTraits<BackendT>::ValueType>
+    GenericDataArrayType;
+
+public:
+  typedef vtkImplicitArray<BackendT> SelfType;
+  vtkAbstractTypeMacroWithNewInstanceType(
+    SelfType, GenericDataArrayType, vtkDataArray, typeid(SelfType).name());
+  vtkAOSArrayNewInstanceMacro(SelfType);
+  typedef typename Superclass::ValueType ValueType;
+  typedef BackendT BackendType;
+
+  static vtkImplicitArray* New();
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   * Without a backend, report an error and return 0.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const
+  {
+    if (!this->Backend)
+    {
+      this->ReportMissingBackend();
+      return ValueType();
+    }
+    return (*this->Backend)(valueIdx);
+  }
+
+  /**
+   * Report a warning: implicit arrays are read-only.
+   */
+  inline void SetValue(vtkIdType, ValueType) { this->ReportReadOnly(); }
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   * Without a backend, report an error and set the tuple to 0.
+   */
+  inline void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    if (!this->Backend)
+    {
+      this->ReportMissingBackend();
+      std::fill(tuple, tuple + this->NumberOfComponents, ValueType());
+      return;
+    }
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+      tuple[comp] = (*this->Backend)(valueIdx + comp);
+    }
+  }
+
+  /**
+   * Report a warning: implicit arrays are read-only.
+   */
+  inline void SetTypedTuple(vtkIdType, const ValueType*) { this->ReportReadOnly(); }
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   * Without a backend, report an error and return 0.
+   */
+  inline ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+  {
+    if (!this->Backend)
+    {
+      this->ReportMissingBackend();
+      return ValueType();
+    }
+    return (*this->Backend)(tupleIdx * this->NumberOfComponents + comp);
+  }
+
+  /**
+   * Report a warning: implicit arrays are read-only.
+   */
+  inline void SetTypedComponent(vtkIdType, int, ValueType) { this->ReportReadOnly(); }
+
+  //@{
+  /**
+   * Set/Get the backend computing the values. ConstructBackend() creates a
+   * new backend from the given constructor arguments.
+   */
+  void SetBackend(std::shared_ptr<BackendT> backend)
+  {
+    this->Backend = std::move(backend);
+    this->DataChanged();
+  }
+  std::shared_ptr<BackendT> GetBackend() const { return this->Backend; }
+  template <typename... Args>
+  void ConstructBackend(Args&&... args)
+  {
+    this->SetBackend(std::make_shared<BackendT>(std::forward<Args>(args)...));
+  }
+  //@}
+
+  /**
+   * Use of this method is discouraged, it expands the whole array into a
+   * contiguous AoS-ordered buffer owned by this array and prints a warning.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Compute all values in AoS ordering into the preallocated memory buffer.
+   * Without a backend, report an error and leave the buffer unchanged.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  /**
+   * Release the backend and reset the array to an empty state. A new
+   * backend must be set before the values are read again.
+   */
+  void Initialize() override;
+
+  /**
+   * Nothing to squeeze: implicit arrays do not allocate their values.
+   */
+  void Squeeze() override {}
+
+  /**
+   * Return the memory used by the backend in kibibytes (1024 bytes). Backends
+   * referencing large data report it through an optional
+   * `unsigned long GetActualMemorySize() const` method; the others count as
+   * 1 KiB.
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  /**
+   * Copy another implicit array of the same type by sharing its backend.
+   * Other arrays cannot be copied into an implicit array.
+   */
+  void DeepCopy(vtkDataArray* other) override;
+  // MSVC doesn't like 'using' here (error C2487). Just forward instead:
+  // using Superclass::DeepCopy;
+  void DeepCopy(vtkAbstractArray* other) override { this->Superclass::DeepCopy(other); }
+
+#ifndef __VTK_WRAP__
+  //@{
+  /**
+   * Perform a fast, safe cast from a vtkAbstractArray to a vtkImplicitArray.
+   * Since all implicit arrays share the same array type, this method falls
+   * back on a dynamic_cast to tell the backends apart.
+   */
+  static vtkImplicitArray<BackendT>* FastDownCast(vtkAbstractArray* source)
+  {
+    if (source && source->GetArrayType() == vtkAbstractArray::ImplicitArray)
+    {
+      return dynamic_cast<vtkImplicitArray<BackendT>*>(source);
+    }
+    return nullptr;
+  }
+  //@}
+#endif
+
+  int GetArrayType() const override { return vtkAbstractArray::ImplicitArray; }
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() override;
+
+  /**
+   * Nothing to allocate: any number of tuples is valid.
+   */
+  bool AllocateTuples(vtkIdType) { return true; }
+
+  /**
+   * Nothing to allocate: any number of tuples is valid.
+   */
+  bool ReallocateTuples(vtkIdType) { return true; }
+
+  /**
+   * Report that the values are read without a backend.
+   */
+  void ReportMissingBackend() const;
+
+  /**
+   * Report that values are written, which implicit arrays ignore.
+   */
+  void ReportReadOnly();
+
+  std::shared_ptr<BackendT> Backend;
+
+  // Expanded values returned by GetVoidPointer.
+  vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>> Sandbox;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) = delete;
+  void operator=(const vtkImplicitArray&) = delete;
+
+  friend class vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueType>;
+};
+
+// Declare vtkArrayDownCast implementations for implicit arrays:
+template <typename BackendT>
+struct vtkArrayDownCast_impl<vtkImplicitArray<BackendT>>
+{
+  inline vtkImplicitArray<BackendT>* operator()(vtkAbstractArray* array)
+  {
+    return vtkImplicitArray<BackendT>::FastDownCast(array);
+  }
+};
+
+namespace vtkImplicitArrayDetail
+{
+template <typename ValueType, typename ArrayValueType>
+std::function<ValueType(vtkIdType)> TypedValueReader(vtkDataArray* array)
+{
+  if (auto aos = vtkAOSDataArrayTemplate<ArrayValueType>::FastDownCast(array))
+  {
+    return [aos](vtkIdType valueIdx) { return static_cast<ValueType>(aos->GetValue(valueIdx)); };
+  }
+  if (auto soa = vtkSOADataArrayTemplate<ArrayValueType>::FastDownCast(array))
+  {
+    return [soa](vtkIdType valueIdx) { return static_cast<ValueType>(soa->GetValue(valueIdx)); };
+  }
+  return nullptr;
+}
+}
+
+/**
+ * Return a function reading the value of @a array at a given index, in AOS
+ * ordering, as a ValueType. The concrete type of the array is resolved
+ * once, so that AOS and SOA arrays are read through their typed accessors
+ * rather than vtkDataArray::GetComponent(); other arrays fall back to the
+ * latter. The array must outlive the function. This is meant for the
+ * backends reading other arrays, like vtkCompositeImplicitBackend.
+ */
+template <typename ValueType>
+std::function<ValueType(vtkIdType)> vtkImplicitArrayValueReader(vtkDataArray* array)
+{
+  std::function<ValueType(vtkIdType)> reader;
+  switch (array->GetDataType())
+  {
+    // The parentheses protect the comma from the macro.
+    vtkTemplateMacro(reader = (vtkImplicitArrayDetail::TypedValueReader<ValueType, VTK_TT>(array)));
+  }
+  if (!reader)
+  {
+    const int numComps = array->GetNumberOfComponents();
+    reader = [array, numComps](vtkIdType valueIdx) {
+      return static_cast<ValueType>(array->GetComponent(valueIdx / numComps, valueIdx % numComps));
+    };
+  }
+  return reader;
+}
+
+#include "vtkImplicitArray.txx"
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+#include "vtkObjectFactory.h"
+
+#include <cstdlib>
+
+namespace vtkImplicitArrayDetail
+{
+// Memory reported by the backends which know it, 1 KiB for the others.
+template <class BackendT>
+auto GetBackendMemorySize(const BackendT& backend, int) -> decltype(
+  static_cast<unsigned long>(backend.GetActualMemorySize()))
+{
+  return static_cast<unsigned long>(backend.GetActualMemorySize());
+}
+
+template <class BackendT>
+unsigned long GetBackendMemorySize(const BackendT&, long)
+{
+  return 1;
+}
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkImplicitArray<BackendT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::vtkImplicitArray() = default;
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::~vtkImplicitArray() = default;
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  // Allow warnings to be silenced:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "implicit arrays, as all the values must be computed "
+                       "and stored. Using the vtkGenericDataArray API with "
+                       "vtkArrayDispatch are preferred. Define the environment "
+                       "variable VTK_SILENCE_GET_VOID_POINTER_WARNINGS to "
+                       "silence this warning.");
+  }
+
+  if (!this->Sandbox)
+  {
+    this->Sandbox = vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>>::New();
+  }
+  this->Sandbox->SetNumberOfComponents(this->NumberOfComponents);
+  this->Sandbox->SetNumberOfTuples(this->GetNumberOfTuples());
+  this->ExportToVoidPointer(this->Sandbox->GetPointer(0));
+  return this->Sandbox->GetPointer(valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ExportToVoidPointer(void* ptr)
+{
+  if (!this->Backend)
+  {
+    this->ReportMissingBackend();
+    return;
+  }
+  ValueType* values = static_cast<ValueType*>(ptr);
+  const vtkIdType numValues = this->GetNumberOfValues();
+  for (vtkIdType valueIdx = 0; valueIdx < numValues; ++valueIdx)
+  {
+    values[valueIdx] = (*this->Backend)(valueIdx);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::Initialize()
+{
+  this->Backend.reset();
+  this->Sandbox = nullptr;
+  this->Superclass::Initialize();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ReportMissingBackend() const
+{
+  vtkErrorMacro("No backend to compute the values, see SetBackend().");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ReportReadOnly()
+{
+  vtkWarningMacro("Implicit arrays are read-only, the value is not written.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+unsigned long vtkImplicitArray<BackendT>::GetActualMemorySize() const
+{
+  return this->Backend ? vtkImplicitArrayDetail::GetBackendMemorySize(*this->Backend, 0) : 1;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkDataArray* other)
+{
+  if (other == nullptr || other == this)
+  {
+    return;
+  }
+
+  SelfType* o = SelfType::FastDownCast(other);
+  if (!o)
+  {
+    vtkErrorMacro("Cannot copy a " << other->GetClassName() << " into an implicit array.");
+    return;
+  }
+
+  this->vtkAbstractArray::DeepCopy(other); // copy Information object and names
+  this->SetNumberOfComponents(o->GetNumberOfComponents());
+  this->SetNumberOfTuples(o->GetNumberOfTuples());
+  this->SetBackend(o->Backend);
+}
+
+#endif // header guard
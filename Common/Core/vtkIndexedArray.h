@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIndexedArray
+ * @brief   An implicit array gathering the tuples of another array.
+ *
+ *
+ * vtkIndexedArray is a vtkImplicitArray using vtkIndexedImplicitBackend:
+ * tuple i of the array is tuple ids->GetId(i) of the indexed array, which
+ * may have any type; AOS and SOA arrays are read through their typed
+ * accessors, see vtkImplicitArrayValueReader(). This
+ * replaces copying a subset or a permutation of an array, e.g. when
+ * extracting cells, by storing only the ids.
+ *
+ * \code
+ * vtkNew<vtkIndexedArray<double>> subset;
+ * subset->ConstructBackend(ids, array);
+ * subset->SetNumberOfComponents(array->GetNumberOfComponents());
+ * subset->SetNumberOfTuples(ids->GetNumberOfIds());
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkIndexedArray_h
+#define vtkIndexedArray_h
+
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkImplicitArray.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
+
+#include <functional> // for std::function
+
+template <typename ValueType>
+class vtkIndexedImplicitBackend
+{
+public:
+  vtkIndexedImplicitBackend(vtkIdList* ids, vtkDataArray* array)
+    : Ids(ids)
+    , Array(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , Reader(vtkImplicitArrayValueReader<ValueType>(array))
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    const vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+    const int comp = static_cast<int>(valueIdx % this->NumberOfComponents);
+    return this->Reader(this->Ids->GetId(tupleIdx) * this->NumberOfComponents + comp);
+  }
+
+  unsigned long GetActualMemorySize() const
+  {
+    return 1 + static_cast<unsigned long>(this->Ids->GetNumberOfIds() * sizeof(vtkIdType) / 1024) +
+      this->Array->GetActualMemorySize();
+  }
+
+protected:
+  vtkSmartPointer<vtkIdList> Ids;
+  vtkSmartPointer<vtkDataArray> Array;
+  int NumberOfComponents;
+  std::function<ValueType(vtkIdType)> Reader;
+};
+
+template <typename ValueType>
+using vtkIndexedArray = vtkImplicitArray<vtkIndexedImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkIndexedArray.h
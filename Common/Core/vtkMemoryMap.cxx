@@ -0,0 +1,287 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMap.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMap.h"
+
+#include "vtkObjectFactory.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include "vtksys/Encoding.hxx"
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+#if !defined(_WIN32) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+vtkStandardNewMacro(vtkMemoryMap);
+
+namespace
+{
+// Map anonymous memory, return nullptr on failure.
+void* MapAnonymousMemory(size_t length)
+{
+#ifdef _WIN32
+  // Physical pages are only used when they are touched, but the commit
+  // charge is taken for the whole length.
+  return VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+  void* mapping = mmap(
+    nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return mapping == MAP_FAILED ? nullptr : mapping;
+#endif
+}
+}
+
+//------------------------------------------------------------------------------
+vtkMemoryMap::vtkMemoryMap()
+  : Mapping(nullptr)
+  , MappingLength(0)
+  , Data(nullptr)
+  , Length(0)
+  , FileBacked(false)
+  , Writable(false)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkMemoryMap::~vtkMemoryMap()
+{
+  this->Unmap();
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMap::MapFile(
+  const char* fileName, vtkTypeUInt64 offset, size_t length, bool writable)
+{
+  this->Unmap();
+  if (!fileName)
+  {
+    vtkErrorMacro("No file name given.");
+    return false;
+  }
+
+#ifdef _WIN32
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWide(fileName).c_str(),
+    writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    vtkErrorMacro("Cannot open " << fileName << ".");
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  GetFileSizeEx(file, &fileSize);
+  const vtkTypeUInt64 size = static_cast<vtkTypeUInt64>(fileSize.QuadPart);
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const vtkTypeUInt64 alignment = info.dwAllocationGranularity;
+#else
+  int file = open(fileName, writable ? O_RDWR : O_RDONLY);
+  if (file < 0)
+  {
+    vtkErrorMacro("Cannot open " << fileName << ": " << strerror(errno));
+    return false;
+  }
+  struct stat fileStat;
+  fstat(file, &fileStat);
+  const vtkTypeUInt64 size = static_cast<vtkTypeUInt64>(fileStat.st_size);
+  const vtkTypeUInt64 alignment = static_cast<vtkTypeUInt64>(sysconf(_SC_PAGESIZE));
+#endif
+
+  if (length == 0 && offset < size)
+  {
+    length = static_cast<size_t>(size - offset);
+  }
+  if (length == 0 || offset + length > size)
+  {
+    vtkErrorMacro("Cannot map " << length << " bytes at offset " << offset << " of " << fileName
+                                << " of " << size << " bytes.");
+#ifdef _WIN32
+    CloseHandle(file);
+#else
+    close(file);
+#endif
+    return false;
+  }
+
+  // Mappings start on a page boundary.
+  const vtkTypeUInt64 start = offset - offset % alignment;
+  const size_t mappingLength = static_cast<size_t>(offset - start) + length;
+#ifdef _WIN32
+  HANDLE fileMapping = CreateFileMappingW(
+    file, nullptr, writable ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+  void* mapping = nullptr;
+  if (fileMapping)
+  {
+    mapping = MapViewOfFile(fileMapping, writable ? FILE_MAP_WRITE : FILE_MAP_COPY,
+      static_cast<DWORD>(start >> 32), static_cast<DWORD>(start & 0xffffffff), mappingLength);
+    // The view keeps the mapping alive.
+    CloseHandle(fileMapping);
+  }
+  CloseHandle(file);
+#else
+  // Private mappings of read-only files can be written to, the modified
+  // pages are copied.
+  void* mapping = mmap(nullptr, mappingLength, PROT_READ | PROT_WRITE,
+    writable ? MAP_SHARED : MAP_PRIVATE, file, static_cast<off_t>(start));
+  if (mapping == MAP_FAILED)
+  {
+    mapping = nullptr;
+  }
+  // The mapping keeps the file alive.
+  close(file);
+#endif
+  if (!mapping)
+  {
+    vtkErrorMacro("Cannot map " << length << " bytes at offset " << offset << " of " << fileName
+                                << ".");
+    return false;
+  }
+
+  this->Mapping = mapping;
+  this->MappingLength = mappingLength;
+  this->Data = static_cast<char*>(mapping) + (offset - start);
+  this->Length = length;
+  this->FileBacked = true;
+  this->Writable = writable;
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMap::MapAnonymous(size_t length)
+{
+  this->Unmap();
+  if (length == 0)
+  {
+    return true;
+  }
+
+  void* mapping = MapAnonymousMemory(length);
+  if (!mapping)
+  {
+    vtkErrorMacro("Cannot map " << length << " bytes of anonymous memory.");
+    return false;
+  }
+
+  this->Mapping = mapping;
+  this->MappingLength = length;
+  this->Data = mapping;
+  this->Length = length;
+  this->FileBacked = false;
+  this->Writable = true;
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMap::Resize(size_t length)
+{
+  if (this->FileBacked)
+  {
+    vtkErrorMacro("Mapped files cannot be resized.");
+    return false;
+  }
+  if (!this->Mapping || length == 0)
+  {
+    return this->MapAnonymous(length);
+  }
+  if (length == this->Length)
+  {
+    return true;
+  }
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+  // The kernel moves the pages instead of copying them.
+  void* mapping = mremap(this->Mapping, this->MappingLength, length, MREMAP_MAYMOVE);
+  if (mapping == MAP_FAILED)
+  {
+    mapping = nullptr;
+  }
+#else
+  void* mapping = MapAnonymousMemory(length);
+  if (mapping)
+  {
+    memcpy(mapping, this->Mapping, length < this->Length ? length : this->Length);
+#ifdef _WIN32
+    VirtualFree(this->Mapping, 0, MEM_RELEASE);
+#else
+    munmap(this->Mapping, this->MappingLength);
+#endif
+  }
+#endif
+  if (!mapping)
+  {
+    vtkErrorMacro("Cannot resize the mapping to " << length << " bytes.");
+    return false;
+  }
+
+  this->Mapping = mapping;
+  this->MappingLength = length;
+  this->Data = mapping;
+  this->Length = length;
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMap::Unmap()
+{
+  if (!this->Mapping)
+  {
+    return;
+  }
+
+#ifdef _WIN32
+  if (this->FileBacked)
+  {
+    UnmapViewOfFile(this->Mapping);
+  }
+  else
+  {
+    VirtualFree(this->Mapping, 0, MEM_RELEASE);
+  }
+#else
+  munmap(this->Mapping, this->MappingLength);
+#endif
+  this->Mapping = nullptr;
+  this->MappingLength = 0;
+  this->Data = nullptr;
+  this->Length = 0;
+  this->FileBacked = false;
+  this->Writable = false;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMap::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Data: " << this->Data << endl;
+  os << indent << "Length: " << this->Length << endl;
+  os << indent << "FileBacked: " << (this->FileBacked ? "true" : "false") << endl;
+  os << indent << "Writable: " << (this->Writable ? "true" : "false") << endl;
+}
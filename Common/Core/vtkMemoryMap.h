@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMap.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkMemoryMap
+ * @brief   a region of a file, or of anonymous memory, mapped in memory.
+ *
+ * vtkMemoryMap maps a region of a file in the address space of the process,
+ * so that its content is paged in by the operating system when it is
+ * accessed instead of being read in memory, or maps anonymous memory. On
+ * systems supporting MAP_NORESERVE, no swap space is reserved for anonymous
+ * memory, so that arrays larger than the physical memory can be allocated
+ * as long as only a part of them is used at a time. On Windows, anonymous
+ * memory is committed, and counts against the commit limit, when mapped.
+ *
+ * The region is unmapped when the vtkMemoryMap is deleted. vtkBuffer, and
+ * therefore vtkAOSDataArrayTemplate, can keep their values in a vtkMemoryMap
+ * without copying them, see vtkAOSDataArrayTemplate::SetMemoryMap(). The
+ * data of mapped files is in the byte order of the file.
+ *
+ * @sa
+ * vtkBuffer vtkAOSDataArrayTemplate
+ */
+
+#ifndef vtkMemoryMap_h
+#define vtkMemoryMap_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <cstddef> // For size_t
+
+class VTKCOMMONCORE_EXPORT vtkMemoryMap : public vtkObject
+{
+public:
+  static vtkMemoryMap* New();
+  vtkTypeMacro(vtkMemoryMap, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Map @a length bytes of the file @a fileName, starting at byte @a offset,
+   * which does not need to be aligned. If @a length is 0, the file is mapped
+   * up to its end. If @a writable is true, changes to the data are written
+   * to the file, otherwise they are private to the process (copy on write).
+   * Any previous mapping is unmapped. Return false on failure.
+   */
+  bool MapFile(
+    const char* fileName, vtkTypeUInt64 offset = 0, size_t length = 0, bool writable = false);
+
+  /**
+   * Map @a length bytes of anonymous, zero-initialized and writable memory.
+   * No swap space is reserved where MAP_NORESERVE is supported, so that the
+   * memory is only committed when it is touched. On Windows, the whole
+   * length is committed. Any previous mapping is unmapped. Return false on
+   * failure.
+   */
+  bool MapAnonymous(size_t length);
+
+  /**
+   * Change the length of an anonymous mapping, preserving its data. The
+   * data may move, so pointers to it are invalidated. Mapped files cannot be
+   * resized. Return false on failure.
+   */
+  bool Resize(size_t length);
+
+  /**
+   * Unmap the region.
+   */
+  void Unmap();
+
+  /**
+   * Return the first byte of the region, or nullptr if nothing is mapped.
+   */
+  void* GetData() const { return this->Data; }
+
+  /**
+   * Return the length of the region in bytes.
+   */
+  size_t GetLength() const { return this->Length; }
+
+  /**
+   * Return true if the region maps a file, false if it is anonymous memory
+   * or if nothing is mapped.
+   */
+  bool GetFileBacked() const { return this->FileBacked; }
+
+  /**
+   * Return true if changes to the data of a mapped file are written to the
+   * file, or if the region is anonymous memory.
+   */
+  bool GetWritable() const { return this->Writable; }
+
+protected:
+  vtkMemoryMap();
+  ~vtkMemoryMap() override;
+
+  // The mapping, which starts before Data when the offset of a file mapping
+  // is not aligned on a page.
+  void* Mapping;
+  size_t MappingLength;
+
+  void* Data;
+  size_t Length;
+  bool FileBacked;
+  bool Writable;
+
+private:
+  vtkMemoryMap(const vtkMemoryMap&) = delete;
+  void operator=(const vtkMemoryMap&) = delete;
+};
+
+#endif
@@ -1,11 +1,12 @@
 set(VTK_SMP_IMPLEMENTATION_TYPE "Sequential"
-  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, OpenMP or TBB")
+  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, OpenMP, TBB or STDThread")
 set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
   PROPERTY
-    STRINGS Sequential OpenMP TBB)
+    STRINGS Sequential OpenMP TBB STDThread)
 
 if (NOT (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP" OR
-         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB"))
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB" OR
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread"))
   set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
     PROPERTY
       VALUE "Sequential")
@@ -14,6 +15,8 @@ endif ()
 set(vtk_smp_headers_to_configure)
 set(vtk_smp_defines)
 set(vtk_smp_use_default_atomics ON)
+set(vtk_smp_enable_openmp 0)
+set(vtk_smp_enable_tbb 0)
 
 if (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB")
   vtk_module_find_package(PACKAGE TBB)
@@ -51,6 +54,41 @@ elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
       "atomics implementation.")
   endif()
 
+elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread")
+  # The backend is selected at runtime among Sequential, STDThread and the
+  # optional OpenMP and TBB ones.
+  option(VTK_SMP_ENABLE_OPENMP "Make the OpenMP backend available to the STDThread implementation" OFF)
+  option(VTK_SMP_ENABLE_TBB "Make the TBB backend available to the STDThread implementation" OFF)
+  mark_as_advanced(VTK_SMP_ENABLE_OPENMP VTK_SMP_ENABLE_TBB)
+
+  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/STDThread")
+  list(APPEND vtk_smp_sources
+    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.cxx"
+    "${vtk_smp_implementation_dir}/vtkSMPThreadPool.cxx")
+  list(APPEND vtk_smp_headers_to_configure
+    vtkSMPThreadLocal.h
+    vtkSMPThreadLocalImpl.h
+    vtkSMPToolsInternal.h)
+
+  if (VTK_SMP_ENABLE_OPENMP)
+    vtk_module_find_package(PACKAGE OpenMP)
+    list(APPEND vtk_smp_libraries
+      OpenMP::OpenMP_CXX)
+    list(APPEND vtk_smp_sources
+      "${vtk_smp_implementation_dir}/vtkSMPToolsOpenMP.cxx")
+    set(vtk_smp_enable_openmp 1)
+  endif ()
+
+  if (VTK_SMP_ENABLE_TBB)
+    vtk_module_find_package(PACKAGE TBB)
+    list(APPEND vtk_smp_libraries
+      TBB::tbb)
+    list(APPEND vtk_smp_sources
+      "${vtk_smp_implementation_dir}/vtkSMPToolsTBB.cxx")
+    set(vtk_smp_enable_tbb 1)
+  endif ()
+
 elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "Sequential")
   set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
   list(APPEND vtk_smp_sources
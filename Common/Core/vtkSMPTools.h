@@ -19,8 +19,13 @@
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
  * There are several back-end implementations of parallel functionality
- * (currently Sequential, TBB and X-Kaapi) that actual execution is
- * delegated to.
+ * (currently Sequential, OpenMP, TBB and STDThread) that actual execution is
+ * delegated to. The first three are selected at configure time. STDThread
+ * selects the backend at runtime, either with SetBackend() or with the
+ * VTK_SMP_BACKEND_IN_USE environment variable, among Sequential, STDThread
+ * (a work stealing pool of std::thread) and OpenMP and TBB when they were
+ * enabled with VTK_SMP_ENABLE_OPENMP and VTK_SMP_ENABLE_TBB. A For() called
+ * from the functor of another For() runs on the same pool of threads.
  */
 
 #ifndef vtkSMPTools_h
@@ -32,6 +37,11 @@
 #include "vtkSMPThreadLocal.h" // For Initialized
 #include "vtkSMPToolsInternal.h"
 
+#include <algorithm>  // For std::transform, std::fill
+#include <functional> // For std::plus
+#include <iterator>   // For std::distance, std::iterator_traits
+#include <vector>     // For the partial results of reductions and scans
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __VTK_WRAP__
 namespace vtk
@@ -144,6 +154,139 @@ class vtkSMPTools_Lookup_For<Functor const>
 public:
   typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
 };
+
+// Partition of a range into chunks used by the reductions and scans. It only
+// depends on the size of the range so that the results do not depend on the
+// number of threads, even for operations that are only associative (e.g.,
+// floating point additions).
+struct vtkSMPTools_Partition
+{
+  vtkIdType Size;
+  vtkIdType NumberOfChunks;
+
+  vtkSMPTools_Partition(vtkIdType size)
+    : Size(size)
+    , NumberOfChunks(std::min<vtkIdType>((size + 1023) / 1024, 256))
+  {
+  }
+  vtkIdType Begin(vtkIdType chunk) const { return chunk * this->Size / this->NumberOfChunks; }
+};
+
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+struct vtkSMPTools_Transform
+{
+  InputIt In;
+  OutputIt Out;
+  UnaryOp& Op;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::transform(this->In + begin, this->In + end, this->Out + begin, this->Op);
+  }
+};
+
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOp>
+struct vtkSMPTools_Transform2
+{
+  InputIt1 In1;
+  InputIt2 In2;
+  OutputIt Out;
+  BinaryOp& Op;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::transform(
+      this->In1 + begin, this->In1 + end, this->In2 + begin, this->Out + begin, this->Op);
+  }
+};
+
+template <typename Iterator, typename T>
+struct vtkSMPTools_Fill
+{
+  Iterator Begin;
+  const T& Value;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::fill(this->Begin + begin, this->Begin + end, this->Value);
+  }
+};
+
+// Reduce each chunk of the partition, transforming the values first.
+template <typename Iterator, typename T, typename ReduceOp, typename TransformOp>
+struct vtkSMPTools_TransformReduce
+{
+  Iterator Begin;
+  const vtkSMPTools_Partition& Partition;
+  ReduceOp& Reduce;
+  TransformOp& Transform;
+  std::vector<T>& Partials;
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    for (; chunk < endChunk; ++chunk)
+    {
+      Iterator it = this->Begin + this->Partition.Begin(chunk);
+      Iterator end = this->Begin + this->Partition.Begin(chunk + 1);
+      T value = this->Transform(*it);
+      for (++it; it != end; ++it)
+      {
+        value = this->Reduce(value, this->Transform(*it));
+      }
+      this->Partials[chunk] = value;
+    }
+  }
+};
+
+// Identity used to reduce the chunks of a scan.
+template <typename T>
+struct vtkSMPTools_Identity
+{
+  template <typename U>
+  T operator()(const U& value) const
+  {
+    return static_cast<T>(value);
+  }
+};
+
+// Scan each chunk of the partition starting from the reduction of the
+// previous chunks. The input is read before the output is written so that
+// the scan can be done in place.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp, bool Inclusive>
+struct vtkSMPTools_Scan
+{
+  InputIt In;
+  OutputIt Out;
+  const vtkSMPTools_Partition& Partition;
+  BinaryOp& Op;
+  const std::vector<T>& Starts;
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    for (; chunk < endChunk; ++chunk)
+    {
+      vtkIdType begin = this->Partition.Begin(chunk);
+      vtkIdType end = this->Partition.Begin(chunk + 1);
+      InputIt in = this->In + begin;
+      OutputIt out = this->Out + begin;
+      T value = this->Starts[chunk];
+      for (vtkIdType i = begin; i < end; ++i, ++in, ++out)
+      {
+        T x = *in;
+        if (Inclusive)
+        {
+          value = this->Op(value, x);
+          *out = value;
+        }
+        else
+        {
+          *out = value;
+          value = this->Op(value, x);
+        }
+      }
+    }
+  }
+};
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -219,20 +362,160 @@ public:
     vtkSMPTools::For(first, last, 0, f);
   }
 
+  /**
+   * A parallel drop in replacement for std::transform(): write op applied to
+   * each value of [inBegin, inEnd) to the range starting at outBegin. The
+   * iterators must be random access iterators (e.g., pointers or the
+   * iterators of vtk::DataArrayValueRange) and op must be thread safe.
+   */
+  template <typename InputIt, typename OutputIt, typename UnaryOp>
+  static void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, UnaryOp op)
+  {
+    vtk::detail::smp::vtkSMPTools_Transform<InputIt, OutputIt, UnaryOp> transform = { inBegin,
+      outBegin, op };
+    vtkSMPTools::For(0, std::distance(inBegin, inEnd), transform);
+  }
+
+  /**
+   * A parallel drop in replacement for the binary std::transform(): write
+   * op(*in1, *in2) for the values of [inBegin1, inEnd) and of the range
+   * starting at inBegin2 to the range starting at outBegin.
+   */
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOp>
+  static void Transform(
+    InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2, OutputIt outBegin, BinaryOp op)
+  {
+    vtk::detail::smp::vtkSMPTools_Transform2<InputIt1, InputIt2, OutputIt, BinaryOp> transform = {
+      inBegin1, inBegin2, outBegin, op
+    };
+    vtkSMPTools::For(0, std::distance(inBegin1, inEnd), transform);
+  }
+
+  /**
+   * A parallel drop in replacement for std::fill().
+   */
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_Fill<Iterator, T> fill = { begin, value };
+    vtkSMPTools::For(0, std::distance(begin, end), fill);
+  }
+
+  //@{
+  /**
+   * A parallel equivalent of std::transform_reduce() and std::reduce():
+   * combine init and the (transformed) values of [begin, end) with reduce,
+   * which must be associative but need not be commutative. The values are
+   * combined in chunks that only depend on the size of the range, so the
+   * result does not depend on the number of threads.
+   */
+  template <typename Iterator, typename T, typename ReduceOp, typename TransformOp>
+  static T TransformReduce(
+    Iterator begin, Iterator end, T init, ReduceOp reduce, TransformOp transform)
+  {
+    vtkIdType size = std::distance(begin, end);
+    if (size <= 0)
+    {
+      return init;
+    }
+    vtk::detail::smp::vtkSMPTools_Partition partition(size);
+    std::vector<T> partials(partition.NumberOfChunks, init);
+    vtk::detail::smp::vtkSMPTools_TransformReduce<Iterator, T, ReduceOp, TransformOp> functor = {
+      begin, partition, reduce, transform, partials
+    };
+    vtkSMPTools::For(0, partition.NumberOfChunks, 1, functor);
+    for (const T& partial : partials)
+    {
+      init = reduce(init, partial);
+    }
+    return init;
+  }
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    return vtkSMPTools::TransformReduce(
+      begin, end, init, op, vtk::detail::smp::vtkSMPTools_Identity<T>());
+  }
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  //@}
+
+  //@{
+  /**
+   * A parallel equivalent of std::inclusive_scan(): write to the range
+   * starting at outBegin the reductions of init (if given) and the values of
+   * [begin, end) up to and including the current one. op defaults to
+   * addition and must be associative. The scan can be done in place
+   * (outBegin == begin). Return the end of the output range.
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op, T init)
+  {
+    return vtkSMPTools::Scan<true>(begin, end, outBegin, init, op);
+  }
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, BinaryOp op)
+  {
+    if (begin == end)
+    {
+      return outBegin;
+    }
+    typename std::iterator_traits<InputIt>::value_type first = *begin;
+    *outBegin = first;
+    return vtkSMPTools::Scan<true>(begin + 1, end, outBegin + 1, first, op);
+  }
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt begin, InputIt end, OutputIt outBegin)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type T;
+    return vtkSMPTools::InclusiveScan(begin, end, outBegin, std::plus<T>());
+  }
+  //@}
+
+  //@{
+  /**
+   * A parallel equivalent of std::exclusive_scan(): write to the range
+   * starting at outBegin the reductions of init and the values of [begin,
+   * end) before the current one. op defaults to addition and must be
+   * associative. The scan can be done in place (outBegin == begin). Return
+   * the end of the output range.
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp op)
+  {
+    return vtkSMPTools::Scan<false>(begin, end, outBegin, init, op);
+  }
+  template <typename InputIt, typename OutputIt, typename T>
+  static OutputIt ExclusiveScan(InputIt begin, InputIt end, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(begin, end, outBegin, init, std::plus<T>());
+  }
+  //@}
+
   /**
    * Get the backend in use.
    */
   static const char* GetBackend();
 
+  /**
+   * Change the backend in use to the given one ("Sequential", "STDThread",
+   * "OpenMP" or "TBB"). Return false, and keep the current backend, if it is
+   * not available. Only the STDThread implementation can change backend;
+   * the other ones only accept their own name. Must not be called during the
+   * execution of parallel code.
+   */
+  static bool SetBackend(const char* backend);
+
   /**
    * Initialize the underlying libraries for execution. This is
    * not required as it is automatically called before the first
    * execution of any parallel code. However, it can be used to
    * control the maximum number of threads used when the back-end
-   * supports it (currently Simple and TBB only). Make sure to call
+   * supports it (currently OpenMP, TBB and STDThread). Make sure to call
    * it before any other parallel operation.
-   * When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
-   * the number of threads used in the thread pool.
    */
   static void Initialize(int numThreads = 0);
 
@@ -247,7 +530,8 @@ public:
   /**
    * A convenience method for sorting data. It is a drop in replacement for
    * std::sort(). Under the hood different methods are used. For example,
-   * tbb::parallel_sort is used in TBB.
+   * tbb::parallel_sort is used in TBB, and STDThread sorts one chunk per
+   * thread and then merges the chunks in parallel.
    */
   template <typename RandomAccessIterator>
   static void Sort(RandomAccessIterator begin, RandomAccessIterator end)
@@ -266,6 +550,39 @@ public:
   {
     vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end, comp);
   }
+
+private:
+  // Scan of [begin, end) starting from init: the chunks are reduced in
+  // parallel, the reductions are scanned serially, and then the chunks are
+  // scanned in parallel starting from these.
+  template <bool Inclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt Scan(InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp& op)
+  {
+    vtkIdType size = std::distance(begin, end);
+    if (size <= 0)
+    {
+      return outBegin;
+    }
+    vtk::detail::smp::vtkSMPTools_Partition partition(size);
+    std::vector<T> starts(partition.NumberOfChunks, init);
+    if (partition.NumberOfChunks > 1)
+    {
+      std::vector<T> partials(partition.NumberOfChunks, init);
+      vtk::detail::smp::vtkSMPTools_Identity<T> identity;
+      vtk::detail::smp::vtkSMPTools_TransformReduce<InputIt, T, BinaryOp,
+        vtk::detail::smp::vtkSMPTools_Identity<T> >
+        reduce = { begin, partition, op, identity, partials };
+      vtkSMPTools::For(0, partition.NumberOfChunks, 1, reduce);
+      for (vtkIdType chunk = 1; chunk < partition.NumberOfChunks; ++chunk)
+      {
+        starts[chunk] = op(starts[chunk - 1], partials[chunk - 1]);
+      }
+    }
+    vtk::detail::smp::vtkSMPTools_Scan<InputIt, OutputIt, T, BinaryOp, Inclusive> scan = { begin,
+      outBegin, partition, op, starts };
+    vtkSMPTools::For(0, partition.NumberOfChunks, 1, scan);
+    return outBegin + size;
+  }
 };
 
 #endif
@@ -0,0 +1,214 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorBatchQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batched queries of the point and cell locators, both the
+// parallel ones of the static locators and the default ones, answer exactly
+// like the corresponding single queries.
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkAbstractPointLocator.h"
+
+#include "vtkCellLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Random positions in a box slightly larger than the given bounds, so that
+// some of the queries fall outside the dataset.
+void RandomPositions(const double bounds[6], vtkIdType numPositions, vtkDoubleArray* positions)
+{
+  positions->SetNumberOfComponents(3);
+  positions->SetNumberOfTuples(numPositions);
+  for (vtkIdType i = 0; i < numPositions; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      double pad = 0.1 * (bounds[2 * c + 1] - bounds[2 * c]);
+      positions->SetComponent(
+        i, c, vtkMath::Random(bounds[2 * c] - pad, bounds[2 * c + 1] + pad));
+    }
+  }
+}
+
+bool CheckPointLocator(vtkAbstractPointLocator* locator, vtkDataSet* input)
+{
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  double bounds[6];
+  input->GetBounds(bounds);
+  vtkNew<vtkDoubleArray> positions;
+  RandomPositions(bounds, 2000, positions);
+
+  vtkNew<vtkIdTypeArray> closestPointIds;
+  locator->FindClosestPoints(positions, closestPointIds);
+  const double radius = 0.05;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> pointIds;
+  locator->FindAllPointsWithinRadius(radius, positions, offsets, pointIds);
+  if (closestPointIds->GetNumberOfTuples() != 2000 || offsets->GetNumberOfTuples() != 2001 ||
+    offsets->GetValue(2000) != pointIds->GetNumberOfTuples() || pointIds->GetNumberOfTuples() == 0)
+  {
+    std::cerr << locator->GetClassName() << ": wrong sizes of the results" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> result;
+  for (vtkIdType i = 0; i < 2000; ++i)
+  {
+    double x[3];
+    positions->GetTuple(i, x);
+    if (locator->FindClosestPoint(x) != closestPointIds->GetValue(i))
+    {
+      std::cerr << locator->GetClassName() << ": closest point differs for query " << i
+                << std::endl;
+      return false;
+    }
+
+    locator->FindPointsWithinRadius(radius, x, result);
+    std::vector<vtkIdType> single(
+      result->GetPointer(0), result->GetPointer(0) + result->GetNumberOfIds());
+    std::vector<vtkIdType> batch(
+      pointIds->GetPointer(offsets->GetValue(i)), pointIds->GetPointer(offsets->GetValue(i + 1)));
+    std::sort(single.begin(), single.end());
+    std::sort(batch.begin(), batch.end());
+    if (single != batch)
+    {
+      std::cerr << locator->GetClassName() << ": points within radius differ for query " << i
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckCellLocator(vtkAbstractCellLocator* locator, vtkDataSet* input, bool findCell)
+{
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  double bounds[6];
+  input->GetBounds(bounds);
+  vtkNew<vtkDoubleArray> positions;
+  RandomPositions(bounds, 500, positions);
+  vtkNew<vtkDoubleArray> ends;
+  RandomPositions(bounds, 500, ends);
+
+  vtkNew<vtkDoubleArray> closestPoints;
+  vtkNew<vtkIdTypeArray> closestCellIds;
+  locator->FindClosestPoints(positions, closestPoints, closestCellIds);
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkIdTypeArray> hitCellIds;
+  locator->IntersectWithLines(positions, ends, 0.0, ts, hitCellIds);
+  vtkNew<vtkIdTypeArray> cellIds;
+  locator->FindCells(positions, 0.0, cellIds);
+
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < 500; ++i)
+  {
+    double x[3], closestPoint[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    positions->GetTuple(i, x);
+    locator->FindClosestPoint(x, closestPoint, cell, cellId, subId, dist2);
+    if (cellId != closestCellIds->GetValue(i) ||
+      closestPoint[0] != closestPoints->GetComponent(i, 0) ||
+      closestPoint[1] != closestPoints->GetComponent(i, 1) ||
+      closestPoint[2] != closestPoints->GetComponent(i, 2))
+    {
+      std::cerr << locator->GetClassName() << ": closest point differs for query " << i
+                << std::endl;
+      return false;
+    }
+
+    double p2[3], t, pcoords[3];
+    ends->GetTuple(i, p2);
+    cellId = -1;
+    if (!locator->IntersectWithLine(x, p2, 0.0, t, closestPoint, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+      t = 0.0;
+    }
+    if (cellId != hitCellIds->GetValue(i) || t != ts->GetValue(i))
+    {
+      std::cerr << locator->GetClassName() << ": intersection differs for query " << i
+                << std::endl;
+      return false;
+    }
+
+    double weights[8];
+    if (findCell && locator->FindCell(x, 0.0, cell, pcoords, weights) != cellIds->GetValue(i))
+    {
+      std::cerr << locator->GetClassName() << ": cell differs for query " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestLocatorBatchQueries(int, char*[])
+{
+  vtkMath::RandomSeed(31415);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(20000);
+  for (vtkIdType i = 0; i < 20000; ++i)
+  {
+    points->SetPoint(
+      i, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0), vtkMath::Random(-0.5, 0.5));
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkStaticPointLocator> staticPointLocator;
+  vtkNew<vtkPointLocator> pointLocator;
+  if (!CheckPointLocator(staticPointLocator, cloud) || !CheckPointLocator(pointLocator, cloud))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(60);
+  sphere->Update();
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 15, 10);
+  image->SetSpacing(0.1, 0.15, 0.2);
+
+  vtkNew<vtkStaticCellLocator> staticCellLocators[2];
+  vtkNew<vtkCellLocator> cellLocators[2];
+  if (!CheckCellLocator(staticCellLocators[0], sphere->GetOutput(), false) ||
+    !CheckCellLocator(staticCellLocators[1], image, true) ||
+    !CheckCellLocator(cellLocators[0], sphere->GetOutput(), false) ||
+    !CheckCellLocator(cellLocators[1], image, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
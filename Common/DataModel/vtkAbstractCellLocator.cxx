@@ -16,12 +16,37 @@
 #include "vtkAbstractCellLocator.h"
 
 #include "vtkCellArray.h"
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+// Compute the bounds of a range of cells.
+struct StoreCellBoundsFunctor
+{
+  vtkDataSet* DataSet;
+  double (*CellBounds)[6];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->DataSet->GetCellBounds(cellId, this->CellBounds[cellId]);
+    }
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -34,6 +59,7 @@ vtkAbstractCellLocator::vtkAbstractCellLocator()
   this->NumberOfCellsPerNode = 32;
   this->UseExistingSearchStructure = 0;
   this->LazyEvaluation = 0;
+  this->SequentialProcessing = false;
   this->GenericCell = vtkGenericCell::New();
 }
 //------------------------------------------------------------------------------
@@ -51,10 +77,17 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  StoreCellBoundsFunctor functor = { this->DataSet, this->CellBounds };
+  if (this->SequentialProcessing || numCells < 2)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    functor(0, numCells);
+    return true;
   }
+
+  // The first call may build internal structures of the dataset (e.g., the
+  // cells of polydata), which is not thread safe.
+  functor(0, 1);
+  vtkSMPTools::For(1, numCells, functor);
   return true;
 }
 //------------------------------------------------------------------------------
@@ -190,6 +223,72 @@ bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
   return false;
 }
 //------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkDataArray* positions, double tol2, vtkIdTypeArray* cellIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  if (numQueries == 0)
+  {
+    return;
+  }
+  this->BuildLocator();
+  double x[3], pcoords[3];
+  std::vector<double> weights(this->DataSet ? this->DataSet->GetMaxCellSize() : 0);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    positions->GetTuple(i, x);
+    cellIds->SetValue(i, this->FindCell(x, tol2, this->GenericCell, pcoords, weights.data()));
+  }
+}
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(
+  vtkDataArray* positions, vtkDoubleArray* closestPoints, vtkIdTypeArray* cellIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  closestPoints->SetNumberOfComponents(3);
+  closestPoints->SetNumberOfTuples(numQueries);
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  double x[3], closestPoint[3], dist2;
+  vtkIdType cellId;
+  int subId;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    positions->GetTuple(i, x);
+    this->FindClosestPoint(x, closestPoint, this->GenericCell, cellId, subId, dist2);
+    closestPoints->SetTypedTuple(i, closestPoint);
+    cellIds->SetValue(i, cellId);
+  }
+}
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkDataArray* p1s, vtkDataArray* p2s, double tol,
+  vtkDoubleArray* ts, vtkIdTypeArray* cellIds)
+{
+  vtkIdType numQueries = p1s->GetNumberOfTuples();
+  ts->SetNumberOfComponents(1);
+  ts->SetNumberOfTuples(numQueries);
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  double p1[3], p2[3], t, x[3], pcoords[3];
+  vtkIdType cellId;
+  int subId;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    p1s->GetTuple(i, p1);
+    p2s->GetTuple(i, p2);
+    cellId = -1;
+    if (!this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell))
+    {
+      t = 0.0;
+      cellId = -1;
+    }
+    ts->SetValue(i, t);
+    cellIds->SetValue(i, cellId);
+  }
+}
+//------------------------------------------------------------------------------
 void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -198,5 +297,6 @@ void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number of Cells Per Bucket: " << this->NumberOfCellsPerNode << "\n";
   os << indent << "UseExistingSearchStructure: " << this->UseExistingSearchStructure << "\n";
   os << indent << "LazyEvaluation: " << this->LazyEvaluation << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 //------------------------------------------------------------------------------
@@ -41,8 +41,11 @@
 #include "vtkLocator.h"
 
 class vtkCellArray;
+class vtkDataArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractCellLocator : public vtkLocator
@@ -111,6 +114,21 @@ public:
   vtkBooleanMacro(UseExistingSearchStructure, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when building the
+   * search structure. By default, sequential processing is off. Note this
+   * flag only applies if the class has been compiled with
+   * VTK_SMP_IMPLEMENTATION_TYPE set to something other than Sequential. (If
+   * set to Sequential, then the locator is always built in serial mode.)
+   * Locators which have no serial build (e.g., vtkStaticCellLocator) ignore
+   * it. This flag is typically used for benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
   /**
    * Return intersection point (if any) of finite line with cells contained
    * in cell locator. See vtkCell.h parameters documentation.
@@ -255,6 +273,26 @@ public:
    */
   virtual bool InsideCellBounds(double x[3], vtkIdType cell_ID);
 
+  //@{
+  /**
+   * Batched versions of FindCell(), FindClosestPoint() and
+   * IntersectWithLine(), answering the queries of all the tuples of
+   * 3-component arrays in one call. For each position, FindCells() stores
+   * the id of the cell containing it (or -1), and FindClosestPoints() the
+   * closest point on the cells with the id of its cell. For each segment
+   * (p1, p2), IntersectWithLines() stores the parametric coordinate along the
+   * segment of its first intersection with the cells, and the id of the
+   * intersected cell (or -1). The output arrays are resized as needed. The
+   * default implementations answer the queries one at a time; thread-safe
+   * locators (e.g., vtkStaticCellLocator) answer them in parallel.
+   */
+  virtual void FindCells(vtkDataArray* positions, double tol2, vtkIdTypeArray* cellIds);
+  virtual void FindClosestPoints(
+    vtkDataArray* positions, vtkDoubleArray* closestPoints, vtkIdTypeArray* cellIds);
+  virtual void IntersectWithLines(vtkDataArray* p1s, vtkDataArray* p2s, double tol,
+    vtkDoubleArray* ts, vtkIdTypeArray* cellIds);
+  //@}
+
 protected:
   vtkAbstractCellLocator();
   ~vtkAbstractCellLocator() override;
@@ -265,7 +303,8 @@ protected:
    * all cell Bounds into the internal CellBounds array. Subsequent
    * calls to InsideCellBounds(...) can make use of the data
    * A valid dataset must be present for this to work. Returns true
-   * if bounds wre copied, false otherwise.
+   * if bounds wre copied, false otherwise. The bounds are computed in
+   * parallel unless SequentialProcessing is on.
    */
   virtual bool StoreCellBounds();
   virtual void FreeCellBounds();
@@ -276,6 +315,7 @@ protected:
   vtkTypeBool CacheCellBounds;
   vtkTypeBool LazyEvaluation;
   vtkTypeBool UseExistingSearchStructure;
+  vtkTypeBool SequentialProcessing;
   vtkGenericCell* GenericCell;
   double (*CellBounds)[6];
 
@@ -14,8 +14,11 @@
 =========================================================================*/
 #include "vtkAbstractPointLocator.h"
 
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
 
 //------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -64,6 +67,45 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(
+  vtkDataArray* positions, vtkIdTypeArray* closestPointIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  closestPointIds->SetNumberOfComponents(1);
+  closestPointIds->SetNumberOfTuples(numQueries);
+  double x[3];
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    positions->GetTuple(i, x);
+    closestPointIds->SetValue(i, this->FindClosestPoint(x));
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindAllPointsWithinRadius(
+  double R, vtkDataArray* positions, vtkIdTypeArray* offsets, vtkIdTypeArray* pointIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueries + 1);
+  pointIds->SetNumberOfComponents(1);
+  pointIds->SetNumberOfTuples(0);
+  vtkNew<vtkIdList> result;
+  double x[3];
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    offsets->SetValue(i, pointIds->GetNumberOfTuples());
+    positions->GetTuple(i, x);
+    this->FindPointsWithinRadius(R, x, result);
+    for (vtkIdType j = 0; j < result->GetNumberOfIds(); ++j)
+    {
+      pointIds->InsertNextValue(result->GetId(j));
+    }
+  }
+  offsets->SetValue(numQueries, pointIds->GetNumberOfTuples());
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
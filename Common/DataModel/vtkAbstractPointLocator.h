@@ -33,7 +33,9 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkDataArray;
 class vtkIdList;
+class vtkIdTypeArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -89,6 +91,23 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   //@}
 
+  //@{
+  /**
+   * Batched versions of FindClosestPoint() and FindPointsWithinRadius(),
+   * answering the queries of all the tuples of a 3-component array of
+   * positions in one call. FindClosestPoints() stores the id of the point
+   * closest to each position in closestPointIds. FindAllPointsWithinRadius()
+   * stores the ids of the points found around the i-th position in pointIds,
+   * from offsets[i] to offsets[i+1] (excluded). The output arrays are
+   * resized as needed. The default implementations answer the queries one
+   * at a time; thread-safe locators (e.g., vtkStaticPointLocator) answer
+   * them in parallel.
+   */
+  virtual void FindClosestPoints(vtkDataArray* positions, vtkIdTypeArray* closestPointIds);
+  virtual void FindAllPointsWithinRadius(
+    double R, vtkDataArray* positions, vtkIdTypeArray* offsets, vtkIdTypeArray* pointIds);
+  //@}
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
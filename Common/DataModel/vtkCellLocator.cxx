@@ -20,8 +20,11 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -1272,6 +1275,13 @@ void vtkCellLocator::BuildLocatorInternal()
     hTol[i] = this->H[i] / 100.0;
   }
 
+  if (!this->SequentialProcessing && numCells > 1)
+  {
+    this->InsertCellsInParallel(numCells, hTol);
+    this->BuildTime.Modified();
+    return;
+  }
+
   //  Insert each cell into the appropriate octant.  Make sure cell
   //  falls within octant.
   //
@@ -1332,6 +1342,150 @@ void vtkCellLocator::BuildLocatorInternal()
   this->BuildTime.Modified();
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Find the range of leaf octants overlapped by the bounds of each cell,
+// padded by the tolerance exactly as the serial insertion does.
+struct ComputeLeafRanges
+{
+  vtkDataSet* DataSet;
+  double (*CellBounds)[6];
+  const double* Bounds;
+  const double* H;
+  const double* HTol;
+  int NumDivs;
+  std::vector<int>& Ranges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double cellBounds[6];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      const double* boundsPtr = cellBounds;
+      if (this->CellBounds)
+      {
+        boundsPtr = this->CellBounds[cellId];
+      }
+      else
+      {
+        this->DataSet->GetCellBounds(cellId, cellBounds);
+      }
+
+      int* range = this->Ranges.data() + 6 * cellId;
+      for (int i = 0; i < 3; i++)
+      {
+        int ijkMin =
+          static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - this->HTol[i]) / this->H[i]);
+        int ijkMax = static_cast<int>(
+          (boundsPtr[2 * i + 1] - this->Bounds[2 * i] + this->HTol[i]) / this->H[i]);
+        range[2 * i] = std::max(ijkMin, 0);
+        range[2 * i + 1] = std::min(ijkMax, this->NumDivs - 1);
+      }
+    }
+  }
+};
+
+// Insert the cells in the leaf octants of a range of slabs (the leaves
+// sharing the same k index). Each slab is filled by a single thread, with
+// its cells in increasing id order.
+struct InsertSlabCells
+{
+  const std::vector<int>& Ranges;
+  const std::vector<vtkIdType>& SlabOffsets;
+  const std::vector<vtkIdType>& SlabCells;
+  int NumDivs;
+  int NumCellsPerBucket;
+  vtkIdList** Leaves;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType product = static_cast<vtkIdType>(this->NumDivs) * this->NumDivs;
+    for (vtkIdType k = begin; k < end; ++k)
+    {
+      for (vtkIdType s = this->SlabOffsets[k]; s < this->SlabOffsets[k + 1]; ++s)
+      {
+        vtkIdType cellId = this->SlabCells[s];
+        const int* range = this->Ranges.data() + 6 * cellId;
+        for (int j = range[2]; j <= range[3]; j++)
+        {
+          for (int i = range[0]; i <= range[1]; i++)
+          {
+            vtkIdList*& octant = this->Leaves[i + j * this->NumDivs + k * product];
+            if (!octant)
+            {
+              octant = vtkIdList::New();
+              octant->Allocate(this->NumCellsPerBucket, this->NumCellsPerBucket / 2);
+            }
+            octant->InsertNextId(cellId);
+          }
+        }
+      }
+    }
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+// Insert the cells in the leaf octants slab by slab: the ranges of leaves
+// overlapped by the cells are computed in parallel, the cells are bucketed
+// by slab, then the slabs are filled in parallel.
+void vtkCellLocator::InsertCellsInParallel(vtkIdType numCells, const double hTol[3])
+{
+  int ndivs = this->NumberOfDivisions;
+  std::vector<int> ranges(6 * numCells);
+
+  // The first call may build internal structures of the dataset, which is
+  // not thread safe.
+  ComputeLeafRanges ranger = { this->DataSet, this->CellBounds, this->Bounds, this->H, hTol,
+    ndivs, ranges };
+  ranger(0, 1);
+  vtkSMPTools::For(1, numCells, ranger);
+
+  std::vector<vtkIdType> slabOffsets(ndivs + 1, 0);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    for (int k = ranges[6 * cellId + 4]; k <= ranges[6 * cellId + 5]; k++)
+    {
+      ++slabOffsets[k + 1];
+    }
+  }
+  for (int k = 0; k < ndivs; k++)
+  {
+    slabOffsets[k + 1] += slabOffsets[k];
+  }
+  std::vector<vtkIdType> slabCells(slabOffsets[ndivs]);
+  std::vector<vtkIdType> slabEnds(slabOffsets.begin(), slabOffsets.end() - 1);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    for (int k = ranges[6 * cellId + 4]; k <= ranges[6 * cellId + 5]; k++)
+    {
+      slabCells[slabEnds[k]++] = cellId;
+    }
+  }
+
+  int parentOffset = this->NumberOfOctants - (ndivs * ndivs * ndivs);
+  vtkIdList** leaves = this->Tree + parentOffset;
+  InsertSlabCells inserter = { ranges, slabOffsets, slabCells, ndivs, this->NumberOfCellsPerNode,
+    leaves };
+  vtkSMPTools::For(0, ndivs, 1, inserter);
+
+  // Mark the parents of the non-empty leaves.
+  for (int k = 0; k < ndivs; k++)
+  {
+    for (int j = 0; j < ndivs; j++)
+    {
+      for (int i = 0; i < ndivs; i++)
+      {
+        if (leaves[i + j * ndivs + k * ndivs * ndivs])
+        {
+          this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
+        }
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkCellLocator::MarkParents(void* a, int i, int j, int k, int ndivs, int level)
 {
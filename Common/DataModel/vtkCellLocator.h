@@ -32,6 +32,11 @@
  * for subclassing; so these locators can be derived if necessary.
  *
  * @warning
+ * The octree is built in parallel with vtkSMPTools unless
+ * SequentialProcessing is on. Either way the octants list their cells in
+ * increasing id order, so queries return the same results.
+ *
+ * @warning
  * Most of the methods of this class are not thread-safe. For a thread-safe,
  * more efficient generic implementation, please use vtkStaticCellLocator
  *
@@ -188,6 +193,7 @@ protected:
   vtkIdList** Tree;      // octree
 
   void MarkParents(void*, int, int, int, int, int);
+  void InsertCellsInParallel(vtkIdType numCells, const double hTol[3]);
   void GetChildren(int idx, int level, int children[8]);
   int GenerateIndex(int offset, int numDivs, int i, int j, int k, vtkIdType& idx);
   void GenerateFace(
@@ -157,7 +157,7 @@ void vtkHigherOrderCurve::Contour(double value, vtkDataArray* cellScalars,
     vtkLine* approx =
       this->GetApproximateLine(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Contour(value, this->Scalars.GetPointer(), locator, verts, lines, polys, this->ApproxPD,
-      outPd, this->ApproxCD, cellId, outCd);
+      outPd, this->ApproxCD, 0, outCd);
   }
 }
 
@@ -173,7 +173,7 @@ void vtkHigherOrderCurve::Clip(double value, vtkDataArray* cellScalars,
     vtkLine* approx =
       this->GetApproximateLine(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Clip(value, this->Scalars.GetPointer(), locator, polys, this->ApproxPD, outPd,
-      this->ApproxCD, cellId, outCd, insideOut);
+      this->ApproxCD, 0, outCd, insideOut);
   }
 }
 
@@ -394,7 +394,7 @@ void vtkHigherOrderHexahedron::Contour(double value, vtkDataArray* cellScalars,
     vtkHexahedron* approx =
       this->GetApproximateHex(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Contour(value, this->Scalars.GetPointer(), locator, verts, lines, polys, this->ApproxPD,
-      outPd, this->ApproxCD, cellId, outCd);
+      outPd, this->ApproxCD, 0, outCd);
   }
 }
 
@@ -410,7 +410,7 @@ void vtkHigherOrderHexahedron::Clip(double value, vtkDataArray* cellScalars,
     vtkHexahedron* approx =
       this->GetApproximateHex(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Clip(value, this->Scalars.GetPointer(), locator, polys, this->ApproxPD, outPd,
-      this->ApproxCD, cellId, outCd, insideOut);
+      this->ApproxCD, 0, outCd, insideOut);
   }
 }
 
@@ -217,7 +217,7 @@ void vtkHigherOrderQuadrilateral::Contour(double value, vtkDataArray* cellScalar
     vtkQuad* approx =
       this->GetApproximateQuad(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Contour(value, this->Scalars.GetPointer(), locator, verts, lines, polys, this->ApproxPD,
-      outPd, this->ApproxCD, cellId, outCd);
+      outPd, this->ApproxCD, 0, outCd);
   }
 }
 
@@ -233,7 +233,7 @@ void vtkHigherOrderQuadrilateral::Clip(double value, vtkDataArray* cellScalars,
     vtkQuad* approx =
       this->GetApproximateQuad(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Clip(value, this->Scalars.GetPointer(), locator, polys, this->ApproxPD, outPd,
-      this->ApproxCD, cellId, outCd, insideOut);
+      this->ApproxCD, 0, outCd, insideOut);
   }
 }
 
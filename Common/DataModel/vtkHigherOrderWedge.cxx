@@ -477,7 +477,7 @@ void vtkHigherOrderWedge::Contour(double value, vtkDataArray* cellScalars,
     vtkWedge* approx =
       this->GetApproximateWedge(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Contour(value, this->Scalars.GetPointer(), locator, verts, lines, polys, this->ApproxPD,
-      outPd, this->ApproxCD, cellId, outCd);
+      outPd, this->ApproxCD, 0, outCd);
   }
 }
 
@@ -493,7 +493,7 @@ void vtkHigherOrderWedge::Clip(double value, vtkDataArray* cellScalars,
     vtkWedge* approx =
       this->GetApproximateWedge(i, this->CellScalars.GetPointer(), this->Scalars.GetPointer());
     approx->Clip(value, this->Scalars.GetPointer(), locator, polys, this->ApproxPD, outPd,
-      this->ApproxCD, cellId, outCd, insideOut);
+      this->ApproxCD, 0, outCd, insideOut);
   }
 }
 
@@ -125,7 +125,7 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkDataSet* ds)
   // Traverse data to determine number of uses of each point. Also count the
   // number of links to allocate.
   this->Offsets = new TIds[this->NumPts + 1];
-  std::fill_n(this->Offsets, this->NumPts, 0);
+  vtkSMPTools::Fill(this->Offsets, this->Offsets + this->NumPts, 0);
 
   for (this->LinksSize = 0, cellId = 0; cellId < this->NumCells; cellId++)
   {
@@ -142,11 +142,7 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkDataSet* ds)
   this->Links = new TIds[this->LinksSize + 1];
   this->Links[this->LinksSize] = this->NumPts;
 
-  for (ptId = 0; ptId < this->NumPts; ++ptId)
-  {
-    npts = this->Offsets[ptId + 1];
-    this->Offsets[ptId + 1] = this->Offsets[ptId] + npts;
-  }
+  vtkSMPTools::InclusiveScan(this->Offsets, this->Offsets + this->NumPts, this->Offsets);
 
   // Now build the links. The summation from the prefix sum indicates where
   // the cells are to be inserted. Each time a cell is inserted, the offset
@@ -361,14 +357,8 @@ void vtkStaticCellLinksTemplate<TIds>::ThreadedBuildLinks(
   vtkSMPTools::For(0, numCells, count);
 
   // Perform prefix sum to determine offsets
-  vtkIdType ptId, npts;
   this->Offsets = new TIds[numPts + 1];
-  this->Offsets[0] = 0;
-  for (ptId = 1; ptId < numPts; ++ptId)
-  {
-    npts = counts[ptId - 1];
-    this->Offsets[ptId] = this->Offsets[ptId - 1] + npts;
-  }
+  vtkSMPTools::ExclusiveScan(counts, counts + numPts, this->Offsets, static_cast<TIds>(0));
   this->Offsets[numPts] = this->LinksSize;
 
   // Now insert cell ids into cell links.
@@ -458,25 +448,21 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkPolyData* pd)
   this->Links[this->LinksSize] = this->NumPts;
   this->Offsets = new TIds[this->NumPts + 1];
   this->Offsets[this->NumPts] = this->LinksSize;
-  std::fill_n(this->Offsets, this->NumPts + 1, 0);
+  vtkSMPTools::Fill(this->Offsets, this->Offsets + this->NumPts + 1, 0);
 
   // Now create the links.
-  vtkIdType npts, CellId, ptId;
+  vtkIdType CellId;
 
   // Visit the four arrays
-  for (CellId = 0, j = 0; j < 4; ++j)
+  for (j = 0; j < 4; ++j)
   {
-    // Count number of point uses
-    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j], CellId);
-    CellId += numCells[j];
+    // Count number of point uses. Note that point ids are not offset; only
+    // the cell ids stored in the links are.
+    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j]);
   } // for each of the four polydata cell arrays
 
   // Perform prefix sum (inclusive scan)
-  for (ptId = 0; ptId < this->NumPts; ++ptId)
-  {
-    npts = this->Offsets[ptId + 1];
-    this->Offsets[ptId + 1] = this->Offsets[ptId] + npts;
-  }
+  vtkSMPTools::InclusiveScan(this->Offsets, this->Offsets + this->NumPts, this->Offsets);
 
   // Now build the links. The summation from the prefix sum indicates where
   // the cells are to be inserted. Each time a cell is inserted, the offset
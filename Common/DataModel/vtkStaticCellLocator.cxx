@@ -17,9 +17,11 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkDataArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMergePoints.h"
@@ -235,6 +237,18 @@ struct CellFragments
   bool operator<(const CellFragments& tuple) const { return BinId < tuple.BinId; }
 };
 
+// The buffers of FindClosestPointWithinRadius(), which can be reused by
+// successive queries: the bins queued and the cells visited by a query are
+// recorded, so that only their flags are reset after it.
+struct vtkClosestPointBuffers
+{
+  std::vector<bool> BinHasBeenQueued;
+  std::vector<bool> CellHasBeenVisited;
+  std::vector<vtkIdType> QueuedBins;
+  std::vector<vtkIdType> VisitedCells;
+  std::vector<double> Weights;
+};
+
 // Perform locator operations like FindCell. Uses templated subclasses
 // to reduce memory and enhance speed.
 struct vtkCellProcessor
@@ -281,7 +295,7 @@ struct vtkCellProcessor
     double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) = 0;
   virtual vtkIdType FindClosestPointWithinRadius(const double x[3], double radius,
     double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
-    int& inside) = 0;
+    int& inside, vtkClosestPointBuffers& buffers) = 0;
 
   // Convenience for computing
   virtual int IsEmpty(vtkIdType binId) = 0;
@@ -359,7 +373,8 @@ struct CellProcessor : public vtkCellProcessor
   int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
   vtkIdType FindClosestPointWithinRadius(const double x[3], double radius, double closestPoint[3],
-    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside,
+    vtkClosestPointBuffers& buffers) override;
   int IsEmpty(vtkIdType binId) override
   {
     return (this->GetNumberOfIds(static_cast<T>(binId)) > 0 ? 0 : 1);
@@ -953,11 +968,21 @@ double Distance2ToBounds(const double x[3], double bounds[6])
 template <typename T>
 vtkIdType CellProcessor<T>::FindClosestPointWithinRadius(const double x[3], double radius,
   double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId, int& closestSubId,
-  double& minDist2, int& inside)
+  double& minDist2, int& inside, vtkClosestPointBuffers& buffers)
 {
-  std::vector<bool> binHasBeenQueued(this->NumBins, false);
-  std::vector<bool> cellHasBeenVisited(this->NumCells, false);
-  std::vector<double> weights(6);
+  std::vector<bool>& binHasBeenQueued = buffers.BinHasBeenQueued;
+  std::vector<bool>& cellHasBeenVisited = buffers.CellHasBeenVisited;
+  std::vector<double>& weights = buffers.Weights;
+  if (binHasBeenQueued.size() != static_cast<size_t>(this->NumBins) ||
+    cellHasBeenVisited.size() != static_cast<size_t>(this->NumCells))
+  {
+    binHasBeenQueued.assign(this->NumBins, false);
+    cellHasBeenVisited.assign(this->NumCells, false);
+  }
+  if (weights.size() < 6)
+  {
+    weights.resize(6);
+  }
   double pcoords[3], point[3], bds[6];
   double distance2ToCellBounds, dist2;
   int subId;
@@ -971,6 +996,7 @@ vtkIdType CellProcessor<T>::FindClosestPointWithinRadius(const double x[3], doub
   vtkIdType binId = this->Binner->GetBinIndex(x);
   queue.push(std::make_pair(0.0, binId));
   binHasBeenQueued[binId] = true;
+  buffers.QueuedBins.push_back(binId);
 
   // distance to closest point
   minDist2 = radius * radius;
@@ -1005,6 +1031,7 @@ vtkIdType CellProcessor<T>::FindClosestPointWithinRadius(const double x[3], doub
           continue;
         }
         cellHasBeenVisited[cellId] = true;
+        buffers.VisitedCells.push_back(cellId);
 
         // compute distance to cell bounding box
         bounds = this->CellBounds + 6 * cellId;
@@ -1061,11 +1088,12 @@ vtkIdType CellProcessor<T>::FindClosestPointWithinRadius(const double x[3], doub
           if (!binHasBeenQueued[binId])
           {
             binHasBeenQueued[binId] = true;
+            buffers.QueuedBins.push_back(binId);
 
             // get bin bounding box
             bds[0] = this->Binner->Bounds[0] + ijk[0] * this->Binner->hX;
             bds[2] = this->Binner->Bounds[2] + ijk[1] * this->Binner->hY;
-            bds[4] = this->Binner->Bounds[3] + ijk[2] * this->Binner->hZ;
+            bds[4] = this->Binner->Bounds[4] + ijk[2] * this->Binner->hZ;
             bds[1] = bds[0] + this->Binner->hX;
             bds[3] = bds[2] + this->Binner->hY;
             bds[5] = bds[4] + this->Binner->hZ;
@@ -1080,6 +1108,18 @@ vtkIdType CellProcessor<T>::FindClosestPointWithinRadius(const double x[3], doub
       }
     }
   }
+
+  // Leave the buffers ready for the next query.
+  for (vtkIdType bin : buffers.QueuedBins)
+  {
+    binHasBeenQueued[bin] = false;
+  }
+  for (vtkIdType cellId : buffers.VisitedCells)
+  {
+    cellHasBeenVisited[cellId] = false;
+  }
+  buffers.QueuedBins.clear();
+  buffers.VisitedCells.clear();
   return retVal;
 }
 
@@ -1255,6 +1295,168 @@ int CellProcessor<T>::IntersectWithLine(const double a0[3], const double a1[3],
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Support for batched queries. The queries are answered in the order of the
+// bins containing them (the bin of the first point for segments), so that
+// the queries processed by a thread visit neighboring bins whose cells are
+// already in cache. The results are stored at the original query ids.
+struct QueryTuple
+{
+  vtkIdType Bin;
+  vtkIdType Id;
+
+  bool operator<(const QueryTuple& tuple) const
+  {
+    return this->Bin < tuple.Bin || (this->Bin == tuple.Bin && this->Id < tuple.Id);
+  }
+};
+
+struct BinQueries
+{
+  const vtkCellBinner* Binner;
+  vtkDataArray* Positions;
+  QueryTuple* Queries;
+
+  void operator()(vtkIdType queryId, vtkIdType endQueryId)
+  {
+    double x[3];
+    for (; queryId < endQueryId; ++queryId)
+    {
+      this->Positions->GetTuple(queryId, x);
+      this->Queries[queryId].Bin = this->Binner->GetBinIndex(x);
+      this->Queries[queryId].Id = queryId;
+    }
+  }
+};
+
+void SortQueries(
+  const vtkCellBinner* binner, vtkDataArray* positions, std::vector<QueryTuple>& queries)
+{
+  queries.resize(positions->GetNumberOfTuples());
+  BinQueries bin = { binner, positions, queries.data() };
+  vtkSMPTools::For(0, positions->GetNumberOfTuples(), bin);
+  vtkSMPTools::Sort(queries.begin(), queries.end());
+}
+
+// Base of the batched queries, holding the per-thread cell and weights.
+struct BatchQueries
+{
+  vtkCellProcessor* Processor;
+  const QueryTuple* Queries;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+
+  BatchQueries(vtkCellProcessor* processor, const QueryTuple* queries)
+    : Processor(processor)
+    , Queries(queries)
+    , MaxCellSize(processor->DataSet->GetMaxCellSize())
+  {
+  }
+};
+
+struct FindCellsWorker : public BatchQueries
+{
+  vtkDataArray* Positions;
+  vtkIdType* CellIds;
+
+  FindCellsWorker(vtkCellProcessor* processor, const QueryTuple* queries,
+    vtkDataArray* positions, vtkIdType* cellIds)
+    : BatchQueries(processor, queries)
+    , Positions(positions)
+    , CellIds(cellIds)
+  {
+  }
+
+  void operator()(vtkIdType query, vtkIdType endQuery)
+  {
+    vtkGenericCell*& cell = this->Cell.Local();
+    std::vector<double>& weights = this->Weights.Local();
+    weights.resize(this->MaxCellSize);
+    double x[3], pcoords[3];
+    for (; query < endQuery; ++query)
+    {
+      vtkIdType queryId = this->Queries[query].Id;
+      this->Positions->GetTuple(queryId, x);
+      this->CellIds[queryId] = this->Processor->FindCell(x, cell, pcoords, weights.data());
+    }
+  }
+};
+
+struct FindClosestPointsWorker : public BatchQueries
+{
+  vtkDataArray* Positions;
+  double* ClosestPoints;
+  vtkIdType* CellIds;
+  vtkSMPThreadLocal<vtkClosestPointBuffers> Buffers;
+
+  FindClosestPointsWorker(vtkCellProcessor* processor, const QueryTuple* queries,
+    vtkDataArray* positions, double* closestPoints, vtkIdType* cellIds)
+    : BatchQueries(processor, queries)
+    , Positions(positions)
+    , ClosestPoints(closestPoints)
+    , CellIds(cellIds)
+  {
+  }
+
+  void operator()(vtkIdType query, vtkIdType endQuery)
+  {
+    vtkGenericCell*& cell = this->Cell.Local();
+    vtkClosestPointBuffers& buffers = this->Buffers.Local();
+    double x[3], dist2;
+    int subId, inside;
+    for (; query < endQuery; ++query)
+    {
+      vtkIdType queryId = this->Queries[query].Id;
+      this->Positions->GetTuple(queryId, x);
+      this->CellIds[queryId] = -1;
+      this->Processor->FindClosestPointWithinRadius(x, vtkMath::Inf(),
+        this->ClosestPoints + 3 * queryId, cell, this->CellIds[queryId], subId, dist2, inside,
+        buffers);
+    }
+  }
+};
+
+struct IntersectWithLinesWorker : public BatchQueries
+{
+  vtkDataArray* P1s;
+  vtkDataArray* P2s;
+  double Tol;
+  double* Ts;
+  vtkIdType* CellIds;
+
+  IntersectWithLinesWorker(vtkCellProcessor* processor, const QueryTuple* queries,
+    vtkDataArray* p1s, vtkDataArray* p2s, double tol, double* ts, vtkIdType* cellIds)
+    : BatchQueries(processor, queries)
+    , P1s(p1s)
+    , P2s(p2s)
+    , Tol(tol)
+    , Ts(ts)
+    , CellIds(cellIds)
+  {
+  }
+
+  void operator()(vtkIdType query, vtkIdType endQuery)
+  {
+    vtkGenericCell*& cell = this->Cell.Local();
+    double p1[3], p2[3], x[3], pcoords[3];
+    int subId;
+    for (; query < endQuery; ++query)
+    {
+      vtkIdType queryId = this->Queries[query].Id;
+      this->P1s->GetTuple(queryId, p1);
+      this->P2s->GetTuple(queryId, p2);
+      this->CellIds[queryId] = -1;
+      if (!this->Processor->IntersectWithLine(p1, p2, this->Tol, this->Ts[queryId], x, pcoords,
+            subId, this->CellIds[queryId], cell))
+      {
+        this->Ts[queryId] = 0.0;
+        this->CellIds[queryId] = -1;
+      }
+    }
+  }
+};
+
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -1334,8 +1536,9 @@ vtkIdType vtkStaticCellLocator::FindClosestPointWithinRadius(double x[3], double
   {
     return 0;
   }
+  vtkClosestPointBuffers buffers;
   return this->Processor->FindClosestPointWithinRadius(
-    x, radius, closestPoint, cell, cellId, subId, dist2, inside);
+    x, radius, closestPoint, cell, cellId, subId, dist2, inside, buffers);
 }
 
 //------------------------------------------------------------------------------
@@ -1385,6 +1588,73 @@ int vtkStaticCellLocator::IntersectWithLine(const double p1[3], const double p2[
   return this->Processor->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell);
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(vtkDataArray* positions, double, vtkIdTypeArray* cellIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    cellIds->Fill(-1);
+    return;
+  }
+
+  std::vector<QueryTuple> queries;
+  SortQueries(this->Processor->Binner, positions, queries);
+  FindCellsWorker worker(this->Processor, queries.data(), positions, cellIds->GetPointer(0));
+  vtkSMPTools::For(0, numQueries, worker);
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindClosestPoints(
+  vtkDataArray* positions, vtkDoubleArray* closestPoints, vtkIdTypeArray* cellIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  closestPoints->SetNumberOfComponents(3);
+  closestPoints->SetNumberOfTuples(numQueries);
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    closestPoints->Fill(0.0);
+    cellIds->Fill(-1);
+    return;
+  }
+
+  std::vector<QueryTuple> queries;
+  SortQueries(this->Processor->Binner, positions, queries);
+  FindClosestPointsWorker worker(this->Processor, queries.data(), positions,
+    closestPoints->GetPointer(0), cellIds->GetPointer(0));
+  vtkSMPTools::For(0, numQueries, worker);
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::IntersectWithLines(vtkDataArray* p1s, vtkDataArray* p2s, double tol,
+  vtkDoubleArray* ts, vtkIdTypeArray* cellIds)
+{
+  vtkIdType numQueries = p1s->GetNumberOfTuples();
+  ts->SetNumberOfComponents(1);
+  ts->SetNumberOfTuples(numQueries);
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  this->BuildLocator();
+  if (!this->Processor)
+  {
+    ts->Fill(0.0);
+    cellIds->Fill(-1);
+    return;
+  }
+
+  std::vector<QueryTuple> queries;
+  SortQueries(this->Processor->Binner, p1s, queries);
+  IntersectWithLinesWorker worker(this->Processor, queries.data(), p1s, p2s, tol,
+    ts->GetPointer(0), cellIds->GetPointer(0));
+  vtkSMPTools::For(0, numQueries, worker);
+}
+
 //------------------------------------------------------------------------------
 void vtkStaticCellLocator::BuildLocator()
 {
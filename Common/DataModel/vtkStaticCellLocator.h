@@ -184,6 +184,21 @@ public:
     return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);
   }
 
+  //@{
+  /**
+   * Batched versions of FindCell(), FindClosestPoint() and
+   * IntersectWithLine(); see vtkAbstractCellLocator. The queries are sorted
+   * by bin (the bin of the first point for segments) and answered in
+   * parallel in that order, so that nearby queries share the cached cells of
+   * their bins. The results do not depend on the number of threads.
+   */
+  void FindCells(vtkDataArray* positions, double tol2, vtkIdTypeArray* cellIds) override;
+  void FindClosestPoints(
+    vtkDataArray* positions, vtkDoubleArray* closestPoints, vtkIdTypeArray* cellIds) override;
+  void IntersectWithLines(vtkDataArray* p1s, vtkDataArray* p2s, double tol, vtkDoubleArray* ts,
+    vtkIdTypeArray* cellIds) override;
+  //@}
+
   //@{
   /**
    * Satisfy vtkLocator abstract interface.
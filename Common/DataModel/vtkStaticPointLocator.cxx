@@ -17,7 +17,9 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkDataArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
@@ -27,6 +29,7 @@
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkStaticPointLocator);
@@ -1639,6 +1642,124 @@ void BucketList<TIds>::GenerateRepresentation(int vtkNotUsed(level), vtkPolyData
   pd->Squeeze();
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Support for batched queries. The queries are answered in the order of the
+// buckets containing them, so that the queries processed by a thread visit
+// neighboring buckets whose point ids and coordinates are already in cache.
+// The results are stored at the original query ids.
+struct QueryTuple
+{
+  vtkIdType Bucket;
+  vtkIdType Id;
+
+  bool operator<(const QueryTuple& tuple) const
+  {
+    return this->Bucket < tuple.Bucket || (this->Bucket == tuple.Bucket && this->Id < tuple.Id);
+  }
+};
+
+struct BucketQueries
+{
+  const vtkBucketList* BList;
+  vtkDataArray* Positions;
+  QueryTuple* Queries;
+
+  void operator()(vtkIdType queryId, vtkIdType endQueryId)
+  {
+    double x[3];
+    for (; queryId < endQueryId; ++queryId)
+    {
+      this->Positions->GetTuple(queryId, x);
+      this->Queries[queryId].Bucket = this->BList->GetBucketIndex(x);
+      this->Queries[queryId].Id = queryId;
+    }
+  }
+};
+
+void SortQueries(
+  const vtkBucketList* bList, vtkDataArray* positions, std::vector<QueryTuple>& queries)
+{
+  queries.resize(positions->GetNumberOfTuples());
+  BucketQueries bucket = { bList, positions, queries.data() };
+  vtkSMPTools::For(0, positions->GetNumberOfTuples(), bucket);
+  vtkSMPTools::Sort(queries.begin(), queries.end());
+}
+
+template <typename TIds>
+struct FindClosestPointsWorker
+{
+  BucketList<TIds>* BList;
+  vtkDataArray* Positions;
+  const QueryTuple* Queries;
+  vtkIdType* ClosestPointIds;
+
+  void operator()(vtkIdType query, vtkIdType endQuery)
+  {
+    double x[3];
+    for (; query < endQuery; ++query)
+    {
+      vtkIdType queryId = this->Queries[query].Id;
+      this->Positions->GetTuple(queryId, x);
+      this->ClosestPointIds[queryId] = this->BList->FindClosestPoint(x);
+    }
+  }
+};
+
+template <typename TIds>
+struct FindAllPointsWithinRadiusWorker
+{
+  BucketList<TIds>* BList;
+  double Radius;
+  vtkDataArray* Positions;
+  const QueryTuple* Queries;
+  std::vector<std::vector<vtkIdType>>& Results;
+  vtkSMPThreadLocalObject<vtkIdList> Result;
+
+  FindAllPointsWithinRadiusWorker(BucketList<TIds>* bList, double radius, vtkDataArray* positions,
+    const QueryTuple* queries, std::vector<std::vector<vtkIdType>>& results)
+    : BList(bList)
+    , Radius(radius)
+    , Positions(positions)
+    , Queries(queries)
+    , Results(results)
+  {
+  }
+
+  void operator()(vtkIdType query, vtkIdType endQuery)
+  {
+    vtkIdList*& result = this->Result.Local();
+    double x[3];
+    for (; query < endQuery; ++query)
+    {
+      vtkIdType queryId = this->Queries[query].Id;
+      this->Positions->GetTuple(queryId, x);
+      this->BList->FindPointsWithinRadius(this->Radius, x, result);
+      this->Results[queryId].assign(
+        result->GetPointer(0), result->GetPointer(0) + result->GetNumberOfIds());
+    }
+  }
+};
+
+struct CopyPointsWithinRadius
+{
+  const std::vector<std::vector<vtkIdType>>& Results;
+  const vtkIdType* Offsets;
+  vtkIdType* PointIds;
+
+  void operator()(vtkIdType queryId, vtkIdType endQueryId)
+  {
+    for (; queryId < endQueryId; ++queryId)
+    {
+      std::copy(this->Results[queryId].begin(), this->Results[queryId].end(),
+        this->PointIds + this->Offsets[queryId]);
+    }
+  }
+};
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Here is the VTK class proper. It's implemented with the templated
 // BucketList class.
@@ -1958,6 +2079,80 @@ void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPoints(
+  vtkDataArray* positions, vtkIdTypeArray* closestPointIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  closestPointIds->SetNumberOfComponents(1);
+  closestPointIds->SetNumberOfTuples(numQueries);
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    closestPointIds->Fill(-1);
+    return;
+  }
+
+  std::vector<QueryTuple> queries;
+  SortQueries(this->Buckets, positions, queries);
+  if (this->LargeIds)
+  {
+    FindClosestPointsWorker<vtkIdType> worker = { static_cast<BucketList<vtkIdType>*>(
+                                                    this->Buckets),
+      positions, queries.data(), closestPointIds->GetPointer(0) };
+    vtkSMPTools::For(0, numQueries, worker);
+  }
+  else
+  {
+    FindClosestPointsWorker<int> worker = { static_cast<BucketList<int>*>(this->Buckets),
+      positions, queries.data(), closestPointIds->GetPointer(0) };
+    vtkSMPTools::For(0, numQueries, worker);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindAllPointsWithinRadius(
+  double R, vtkDataArray* positions, vtkIdTypeArray* offsets, vtkIdTypeArray* pointIds)
+{
+  vtkIdType numQueries = positions->GetNumberOfTuples();
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueries + 1);
+  pointIds->SetNumberOfComponents(1);
+  pointIds->SetNumberOfTuples(0);
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    offsets->Fill(0);
+    return;
+  }
+
+  std::vector<QueryTuple> queries;
+  SortQueries(this->Buckets, positions, queries);
+  std::vector<std::vector<vtkIdType>> results(numQueries);
+  if (this->LargeIds)
+  {
+    FindAllPointsWithinRadiusWorker<vtkIdType> worker(
+      static_cast<BucketList<vtkIdType>*>(this->Buckets), R, positions, queries.data(), results);
+    vtkSMPTools::For(0, numQueries, worker);
+  }
+  else
+  {
+    FindAllPointsWithinRadiusWorker<int> worker(
+      static_cast<BucketList<int>*>(this->Buckets), R, positions, queries.data(), results);
+    vtkSMPTools::For(0, numQueries, worker);
+  }
+
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+  for (vtkIdType queryId = 0; queryId < numQueries; ++queryId)
+  {
+    offsetsPtr[queryId + 1] = offsetsPtr[queryId] + static_cast<vtkIdType>(results[queryId].size());
+  }
+  pointIds->SetNumberOfTuples(offsetsPtr[numQueries]);
+  CopyPointsWithinRadius copy = { results, offsetsPtr, pointIds->GetPointer(0) };
+  vtkSMPTools::For(0, numQueries, copy);
+}
+
 //------------------------------------------------------------------------------
 // This method traverses the locator along the defined ray, finding the
 // closest point to a0 when projected onto the line (a0,a1) (i.e., min
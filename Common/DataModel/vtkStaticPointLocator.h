@@ -140,6 +140,19 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  //@{
+  /**
+   * Batched versions of FindClosestPoint() and FindPointsWithinRadius(); see
+   * vtkAbstractPointLocator for the layout of the results. The queries are
+   * sorted by bucket and answered in parallel in that order, so that nearby
+   * queries share the cached contents of their buckets. The results do not
+   * depend on the number of threads. These methods are not thread safe.
+   */
+  void FindClosestPoints(vtkDataArray* positions, vtkIdTypeArray* closestPointIds) override;
+  void FindAllPointsWithinRadius(
+    double R, vtkDataArray* positions, vtkIdTypeArray* offsets, vtkIdTypeArray* pointIds) override;
+  //@}
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
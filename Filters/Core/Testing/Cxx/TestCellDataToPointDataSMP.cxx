@@ -0,0 +1,264 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellDataToPointDataSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the threaded averaging of vtkCellDataToPointData over unstructured
+// grids and polydata mixing cells of several dimensions, for every
+// contributing cell option, and that the cached links follow changes of the
+// input topology.
+
+#include "vtkCellDataToPointData.h"
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Add cell data with a double and an integral array.
+void AddCellData(vtkDataSet* input, int seed)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numCells);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  ints->SetNumberOfComponents(2);
+  ints->SetNumberOfTuples(numCells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    scalars->SetValue(i, 0.1 * ((i * 37 + seed) % 101) + 1.0 / 3.0);
+    ints->SetTypedComponent(i, 0, static_cast<int>((i * 13 + seed) % 29));
+    ints->SetTypedComponent(i, 1, static_cast<int>(i % 7) - 3);
+  }
+  input->GetCellData()->AddArray(scalars);
+  input->GetCellData()->AddArray(ints);
+}
+
+// Hexahedra with triangles, lines and vertices sharing some of their points.
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(VTK_HEXAHEDRON);
+  source->SetBlocksDimensions(6, 5, 4);
+  source->Update();
+  grid->DeepCopy(source->GetOutput());
+  grid->GetCellData()->Initialize();
+
+  vtkIdType numPts = grid->GetNumberOfPoints();
+  for (vtkIdType i = 0; i + 12 < numPts; i += 9)
+  {
+    const vtkIdType triangle[3] = { i, i + 1, i + 7 };
+    const vtkIdType line[2] = { i + 1, i + 12 };
+    grid->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+    grid->InsertNextCell(VTK_LINE, 2, line);
+    grid->InsertNextCell(VTK_VERTEX, 1, triangle + 2);
+  }
+  // A point only used by a vertex, and a point not used at all.
+  vtkIdType ptId = grid->GetPoints()->InsertNextPoint(-1.0, -1.0, -1.0);
+  grid->GetPoints()->InsertNextPoint(-2.0, -2.0, -2.0);
+  grid->InsertNextCell(VTK_VERTEX, 1, &ptId);
+}
+
+// Triangles of a sphere with lines and vertices on its points.
+void MakePolyData(vtkPolyData* polyData)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(12);
+  sphere->SetPhiResolution(10);
+  sphere->Update();
+  polyData->DeepCopy(sphere->GetOutput());
+  polyData->GetPointData()->Initialize();
+
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i + 5 < polyData->GetNumberOfPoints(); i += 4)
+  {
+    lines->InsertNextCell({ i, i + 5 });
+    verts->InsertNextCell({ i + 1 });
+  }
+  polyData->SetLines(lines);
+  polyData->SetVerts(verts);
+}
+
+// The expected average of a cell array at each point, summing the cells in
+// increasing id order like the filter does.
+template <typename TArray, typename T>
+void ComputeReference(vtkDataSet* input, TArray* cellArray, int option, std::vector<T>& result)
+{
+  int numComps = cellArray->GetNumberOfComponents();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  int highestDimension = 0;
+  for (vtkIdType cellId = 0; option == vtkCellDataToPointData::DataSetMax &&
+       cellId < input->GetNumberOfCells();
+       ++cellId)
+  {
+    highestDimension = std::max(highestDimension, input->GetCell(cellId)->GetCellDimension());
+  }
+
+  result.assign(numPts * numComps, T(0));
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    input->GetPointCells(ptId, cellIds);
+    std::sort(cellIds->begin(), cellIds->end());
+    if (option == vtkCellDataToPointData::Patch)
+    {
+      for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+      {
+        highestDimension =
+          std::max(highestDimension, input->GetCell(cellIds->GetId(i))->GetCellDimension());
+      }
+    }
+    for (int c = 0; c < numComps; ++c)
+    {
+      T sum = 0;
+      T count = 0;
+      for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+      {
+        if (input->GetCell(cellIds->GetId(i))->GetCellDimension() >= highestDimension)
+        {
+          sum += cellArray->GetTypedComponent(cellIds->GetId(i), c);
+          ++count;
+        }
+      }
+      result[ptId * numComps + c] = count ? sum / count : T(0);
+    }
+    if (option == vtkCellDataToPointData::Patch)
+    {
+      highestDimension = 0;
+    }
+  }
+}
+
+template <typename TArray>
+bool CheckArray(vtkDataSet* input, vtkDataSet* output, const char* name, int option)
+{
+  TArray* cellArray = TArray::SafeDownCast(input->GetCellData()->GetArray(name));
+  TArray* pointArray = TArray::SafeDownCast(output->GetPointData()->GetArray(name));
+  if (!pointArray || pointArray->GetNumberOfTuples() != input->GetNumberOfPoints())
+  {
+    std::cerr << "Missing point array " << name << std::endl;
+    return false;
+  }
+
+  std::vector<typename TArray::ValueType> expected;
+  ComputeReference(input, cellArray, option, expected);
+  for (vtkIdType i = 0; i < static_cast<vtkIdType>(expected.size()); ++i)
+  {
+    if (pointArray->GetValue(i) != expected[i])
+    {
+      std::cerr << name << ": value " << i << " is " << pointArray->GetValue(i) << " instead of "
+                << expected[i] << " for option " << option << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckOutput(vtkCellDataToPointData* filter, vtkDataSet* input)
+{
+  filter->SetInputData(input);
+  filter->Update();
+  vtkDataSet* output = filter->GetOutput();
+  int option = filter->GetContributingCellOption();
+  return CheckArray<vtkDoubleArray>(input, output, "Scalars", option) &&
+    CheckArray<vtkIntArray>(input, output, "Ints", option);
+}
+}
+
+int TestCellDataToPointDataSMP(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+  AddCellData(grid, 0);
+  vtkNew<vtkPolyData> polyData;
+  MakePolyData(polyData);
+  AddCellData(polyData, 0);
+
+  const int options[] = { vtkCellDataToPointData::All, vtkCellDataToPointData::Patch,
+    vtkCellDataToPointData::DataSetMax };
+  for (int option : options)
+  {
+    vtkNew<vtkCellDataToPointData> filter;
+    filter->SetContributingCellOption(option);
+    if (!CheckOutput(filter, grid))
+    {
+      std::cerr << "Wrong output for the grid" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // New data on the same topology reuses the links.
+    AddCellData(grid, 5);
+    if (!CheckOutput(filter, grid))
+    {
+      std::cerr << "Wrong output for new data on the grid" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A different input, then a change of the grid topology.
+    if (!CheckOutput(filter, polyData))
+    {
+      std::cerr << "Wrong output for the polydata" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vtkNew<vtkUnstructuredGrid> smaller;
+    smaller->SetPoints(grid->GetPoints());
+    smaller->Allocate(grid->GetNumberOfCells() / 2);
+    vtkNew<vtkIdList> pts;
+    for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); cellId += 2)
+    {
+      grid->GetCellPoints(cellId, pts);
+      smaller->InsertNextCell(grid->GetCellType(cellId), pts);
+    }
+    AddCellData(smaller, 3);
+    if (!CheckOutput(filter, smaller))
+    {
+      std::cerr << "Wrong output for the smaller grid" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Replace the polygons of the polydata in place.
+    vtkNew<vtkCellArray> polys;
+    polys->DeepCopy(polyData->GetPolys());
+    polys->ReplaceCellAtId(0, { 0, 2, 3 });
+    polys->Modified();
+    vtkNew<vtkPolyData> edited;
+    edited->SetPoints(polyData->GetPoints());
+    edited->SetVerts(polyData->GetVerts());
+    edited->SetLines(polyData->GetLines());
+    edited->SetPolys(polys);
+    edited->GetCellData()->ShallowCopy(polyData->GetCellData());
+    if (!CheckOutput(filter, polyData) || !CheckOutput(filter, edited))
+    {
+      std::cerr << "Wrong output for the edited polydata" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
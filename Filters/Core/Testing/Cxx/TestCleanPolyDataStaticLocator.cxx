@@ -0,0 +1,258 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCleanPolyDataStaticLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the threaded point merging of vtkCleanPolyData against
+// vtkStaticCleanPolyData and against the incremental merging.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCylinderSource.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdFilter.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCleanPolyData.h"
+#include "vtkTestDataSetComparison.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Both filters must produce exactly the same output when all the points are
+// used and no cell degenerates.
+int CompareWithStaticClean(vtkAlgorithmOutput* input)
+{
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputConnection(input);
+  clean->UseStaticLocatorOn();
+  clean->Update();
+
+  vtkNew<vtkStaticCleanPolyData> staticClean;
+  staticClean->SetInputConnection(input);
+  staticClean->Update();
+
+  vtkPolyData* a = clean->GetOutput();
+  vtkPolyData* b = staticClean->GetOutput();
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints())
+  {
+    std::cerr << "Expected " << b->GetNumberOfPoints() << " points, got "
+              << a->GetNumberOfPoints() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkTest::SamePolyDataGeometry(a, b) ||
+    !vtkTest::SameArrays(a->GetPointData()->GetArray("Elevation"),
+      b->GetPointData()->GetArray("Elevation"), "Point data") ||
+    !vtkTest::SameArrays(a->GetCellData()->GetArray("vtkIdFilter_Ids"),
+      b->GetCellData()->GetArray("vtkIdFilter_Ids"), "Cell data"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+// Make a grid of quads whose points are clusters of copies closer to each
+// other than the tolerance. The copies of a point have distant ids, so that
+// the threaded merging may chain them, and the first copy is at the grid
+// point. When exact is true, all the copies are at the grid point.
+void MakeClusters(vtkPolyData* data, bool exact)
+{
+  const int res = 30;
+  const int numCopies = 4;
+  const vtkIdType numGridPts = res * res;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int copy = 0; copy < numCopies; ++copy)
+  {
+    const double offset = exact ? 0.0 : copy * 1.0e-4;
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        points->InsertNextPoint(i + offset, j, offset);
+      }
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j + 1 < res; ++j)
+  {
+    for (int i = 0; i + 1 < res; ++i)
+    {
+      // Each corner uses another copy of its point.
+      const vtkIdType corners[4] = { j * res + i, j * res + i + 1, (j + 1) * res + i + 1,
+        (j + 1) * res + i };
+      vtkIdType quad[4];
+      for (vtkIdType k = 0; k < 4; ++k)
+      {
+        quad[k] = corners[k] + ((corners[0] + k) % numCopies) * numGridPts;
+      }
+      polys->InsertNextCell(4, quad);
+    }
+  }
+  data->SetPoints(points);
+  data->SetPolys(polys);
+}
+
+// Merging clusters within a tolerance must give the same cells as merging
+// the exact copies with vtkMergePoints, which may number the points in a
+// different order.
+int CompareWithMergePoints()
+{
+  vtkNew<vtkPolyData> clusters;
+  MakeClusters(clusters, false);
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputData(clusters);
+  clean->UseStaticLocatorOn();
+  clean->ToleranceIsAbsoluteOn();
+  clean->SetAbsoluteTolerance(0.01);
+  clean->Update();
+
+  vtkNew<vtkPolyData> copies;
+  MakeClusters(copies, true);
+  vtkNew<vtkCleanPolyData> merge;
+  merge->SetInputData(copies);
+  merge->Update();
+
+  vtkPolyData* a = clean->GetOutput();
+  vtkPolyData* b = merge->GetOutput();
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetPolys()->GetNumberOfConnectivityIds() != b->GetPolys()->GetNumberOfConnectivityIds())
+  {
+    std::cerr << "Expected " << b->GetNumberOfPoints() << " points, got "
+              << a->GetNumberOfPoints() << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* connA = a->GetPolys()->GetConnectivityArray();
+  vtkDataArray* connB = b->GetPolys()->GetConnectivityArray();
+  for (vtkIdType i = 0; i < connA->GetNumberOfTuples(); ++i)
+  {
+    const vtkIdType ptA = static_cast<vtkIdType>(connA->GetComponent(i, 0));
+    const vtkIdType ptB = static_cast<vtkIdType>(connB->GetComponent(i, 0));
+    if (ptA < 0 || ptA >= a->GetNumberOfPoints())
+    {
+      std::cerr << "Invalid point id " << ptA << std::endl;
+      return EXIT_FAILURE;
+    }
+    double pA[3], pB[3];
+    a->GetPoint(ptA, pA);
+    b->GetPoint(ptB, pB);
+    if (pA[0] != pB[0] || pA[1] != pB[1] || pA[2] != pB[2])
+    {
+      std::cerr << "Connectivity " << i << " differs" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestCleanPolyDataStaticLocator(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // The cylinder duplicates the points shared by its side and its caps.
+  vtkNew<vtkCylinderSource> cylinder;
+  cylinder->SetResolution(64);
+  cylinder->CappingOn();
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(cylinder->GetOutputPort());
+
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(elevation->GetOutputPort());
+  ids->PointIdsOff();
+  ids->CellIdsOn();
+  ids->FieldDataOff();
+
+  if (CompareWithStaticClean(ids->GetOutputPort()) != EXIT_SUCCESS)
+  {
+    std::cerr << "Cylinder cleaned with a static locator differs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Exact merging: same counts as the incremental merging.
+  vtkNew<vtkCleanPolyData> serial;
+  serial->SetInputConnection(ids->GetOutputPort());
+  serial->Update();
+
+  vtkNew<vtkCleanPolyData> threaded;
+  threaded->SetInputConnection(ids->GetOutputPort());
+  threaded->UseStaticLocatorOn();
+  threaded->Update();
+
+  if (serial->GetOutput()->GetNumberOfPoints() != threaded->GetOutput()->GetNumberOfPoints() ||
+    serial->GetOutput()->GetNumberOfCells() != threaded->GetOutput()->GetNumberOfCells())
+  {
+    std::cerr << "Static and incremental merging differ" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (CompareWithMergePoints() != EXIT_SUCCESS)
+  {
+    std::cerr << "Clusters merged within a tolerance differ" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Merging within a large tolerance degenerates cells, which are converted
+  // to lines and vertices. Unused points must be removed.
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(40, 40);
+
+  vtkNew<vtkCleanPolyData> coarse;
+  coarse->SetInputConnection(plane->GetOutputPort());
+  coarse->UseStaticLocatorOn();
+  coarse->SetTolerance(0.02);
+  coarse->Update();
+
+  vtkPolyData* output = coarse->GetOutput();
+  vtkIdType numPts = output->GetNumberOfPoints();
+  if (numPts == 0 || numPts >= plane->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "No points merged" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<bool> used(numPts, false);
+  vtkCellArray* cellArrays[4] = { output->GetVerts(), output->GetLines(), output->GetPolys(),
+    output->GetStrips() };
+  for (vtkCellArray* cells : cellArrays)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        if (pts[i] < 0 || pts[i] >= numPts)
+        {
+          std::cerr << "Invalid point id " << pts[i] << std::endl;
+          return EXIT_FAILURE;
+        }
+        used[pts[i]] = true;
+      }
+    }
+  }
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (!used[i])
+    {
+      std::cerr << "Unused point " << i << " in output" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterUnionFind.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the union-find labeling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter extracts the same regions as the wave
+// traversal for every extraction mode.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// Several spheres of different sizes (two of them the same size), plus a few
+// vertices and lines, with the polygons shuffled so that regions interleave.
+void MakeInput(vtkPolyData* input)
+{
+  const int resolutions[] = { 8, 16, 12, 16, 6 };
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < 5; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * i, 0.0, 0.0);
+    sphere->SetThetaResolution(resolutions[i]);
+    sphere->SetPhiResolution(resolutions[i]);
+    sphere->Update();
+    append->AddInputData(sphere->GetOutput());
+  }
+  append->Update();
+  input->SetPoints(append->GetOutput()->GetPoints());
+
+  vtkCellArray* polys = append->GetOutput()->GetPolys();
+  vtkIdType numPolys = polys->GetNumberOfCells();
+  vtkNew<vtkCellArray> shuffled;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType i = 0; i < numPolys; ++i)
+  {
+    polys->GetCellAtId((i * 7919) % numPolys, pts);
+    shuffled->InsertNextCell(pts);
+  }
+  input->SetPolys(shuffled);
+
+  // Vertices and lines on the last and first spheres, and an isolated line.
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ numPts - 1 });
+  verts->InsertNextCell({ numPts - 2 });
+  input->SetVerts(verts);
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 0, 1 });
+  vtkIdType p0 = input->GetPoints()->InsertNextPoint(0.0, 5.0, 0.0);
+  vtkIdType p1 = input->GetPoints()->InsertNextPoint(1.0, 5.0, 0.0);
+  lines->InsertNextCell({ p0, p1 });
+  input->SetLines(lines);
+}
+
+// Compare two outputs cell by cell. The point numbering may differ, so
+// points are compared through their coordinates and data, which include the
+// region ids.
+bool SameOutputs(vtkPointSet* a, vtkPointSet* b)
+{
+  vtkDataArray* aCellRegions = a->GetCellData()->GetArray("RegionId");
+  vtkDataArray* bCellRegions = b->GetCellData()->GetArray("RegionId");
+  if (!a->GetPointData()->GetArray("RegionId") || !b->GetPointData()->GetArray("RegionId") ||
+    !aCellRegions != !bCellRegions ||
+    (aCellRegions &&
+      (aCellRegions->GetNumberOfTuples() != a->GetNumberOfCells() ||
+        bCellRegions->GetNumberOfTuples() != b->GetNumberOfCells())))
+  {
+    std::cerr << "Missing region ids" << std::endl;
+    return false;
+  }
+  return vtkTest::SameCellsByPoints(a, b);
+}
+
+template <typename TFilter>
+bool CompareLabeling(vtkDataSet* input, int mode)
+{
+  vtkNew<TFilter> filters[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    filters[i]->SetInputData(input);
+    filters[i]->SetExtractionMode(mode);
+    filters[i]->ColorRegionsOn();
+    filters[i]->AddSeed(3);
+    filters[i]->AddSeed(mode == VTK_EXTRACT_CELL_SEEDED_REGIONS ? 1 : 150);
+    filters[i]->AddSpecifiedRegion(1);
+    filters[i]->AddSpecifiedRegion(3);
+    filters[i]->SetClosestPoint(6.0, 0.6, 0.0);
+    filters[i]->SetUnionFindLabeling(i);
+    filters[i]->Update();
+  }
+
+  if (filters[0]->GetNumberOfExtractedRegions() != filters[1]->GetNumberOfExtractedRegions())
+  {
+    std::cerr << "Number of regions differs: " << filters[0]->GetNumberOfExtractedRegions()
+              << " vs " << filters[1]->GetNumberOfExtractedRegions() << std::endl;
+    return false;
+  }
+  vtkPointSet* serial = vtkPointSet::SafeDownCast(filters[0]->GetOutputDataObject(0));
+  vtkPointSet* threaded = vtkPointSet::SafeDownCast(filters[1]->GetOutputDataObject(0));
+  if (serial->GetNumberOfCells() == 0)
+  {
+    std::cerr << "Empty output" << std::endl;
+    return false;
+  }
+  // vtkConnectivityFilter also colors the output cells by region.
+  if (vtkConnectivityFilter::SafeDownCast(filters[0]) &&
+    !serial->GetCellData()->GetArray("RegionId"))
+  {
+    std::cerr << "Missing cell region ids" << std::endl;
+    return false;
+  }
+  return SameOutputs(serial, threaded);
+}
+}
+
+int TestConnectivityFilterUnionFind(int, char*[])
+{
+  const int modes[] = { VTK_EXTRACT_ALL_REGIONS, VTK_EXTRACT_LARGEST_REGION,
+    VTK_EXTRACT_SPECIFIED_REGIONS, VTK_EXTRACT_CELL_SEEDED_REGIONS,
+    VTK_EXTRACT_POINT_SEEDED_REGIONS, VTK_EXTRACT_CLOSEST_POINT_REGION };
+
+  vtkNew<vtkPolyData> polyData;
+  MakeInput(polyData);
+
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(polyData);
+  toGrid->Update();
+  vtkUnstructuredGrid* grid = toGrid->GetOutput();
+
+  for (int mode : modes)
+  {
+    if (!CompareLabeling<vtkPolyDataConnectivityFilter>(polyData, mode))
+    {
+      std::cerr << "vtkPolyDataConnectivityFilter differs for mode " << mode << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!CompareLabeling<vtkConnectivityFilter>(polyData, mode))
+    {
+      std::cerr << "vtkConnectivityFilter differs on polydata for mode " << mode << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!CompareLabeling<vtkConnectivityFilter>(grid, mode))
+    {
+      std::cerr << "vtkConnectivityFilter differs on grid for mode " << mode << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCutterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded cutting of unstructured grids produces the same
+// cells, in the same order and with the same data, as the serial path.
+
+#include "vtkCutter.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkElevationFilter.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphere.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// A grid mixing linear, quadratic and higher order cells of all
+// dimensionalities, with point and cell data.
+void MakeInput(vtkUnstructuredGrid* input)
+{
+  const int cellTypes[] = { VTK_LINE, VTK_QUADRATIC_EDGE, VTK_TRIANGLE, VTK_QUADRATIC_QUAD,
+    VTK_TETRA, VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID, VTK_QUADRATIC_TETRA,
+    VTK_LAGRANGE_HEXAHEDRON };
+
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(9, 8, 7);
+    source->Update();
+    append->AddInputData(source->GetOutput());
+  }
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(append->GetOutputPort());
+  elevation->SetLowPoint(0, 0, 0);
+  elevation->SetHighPoint(9, 8, 7);
+  elevation->Update();
+  input->ShallowCopy(elevation->GetOutput());
+
+  // The grids of the different cell types overlap, so coincident output
+  // points may come from different cells. Only keep a linear point field, on
+  // which all the cells agree.
+  input->GetPointData()->RemoveArray("DistanceToCenter");
+  input->GetPointData()->RemoveArray("Polynomial");
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellIds->SetValue(i, static_cast<int>(i));
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+}
+
+int TestCutterSMP(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> input;
+  MakeInput(input);
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(4.1, 1.3, 0.7);
+  sphere->SetRadius(2.5);
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(4.3, 4.1, 3.7);
+  plane->SetNormal(1.0, 0.5, 0.25);
+  vtkImplicitFunction* functions[] = { sphere, plane };
+
+  for (vtkImplicitFunction* function : functions)
+  {
+    for (int numContours = 1; numContours <= 3; ++numContours)
+    {
+      vtkNew<vtkCutter> cutters[2];
+      for (int i = 0; i < 2; ++i)
+      {
+        cutters[i]->SetInputData(input);
+        cutters[i]->SetCutFunction(function);
+        cutters[i]->GenerateValues(numContours, 0.0, 1.5);
+        cutters[i]->SetGenerateCutScalars(function == sphere);
+        cutters[i]->SetSequentialProcessing(i == 0);
+        cutters[i]->Update();
+      }
+
+      vtkPolyData* serial = cutters[0]->GetOutput();
+      if (serial->GetNumberOfVerts() == 0 || serial->GetNumberOfLines() == 0 ||
+        serial->GetNumberOfPolys() == 0)
+      {
+        std::cerr << "Missing output cells for " << function->GetClassName() << std::endl;
+        return EXIT_FAILURE;
+      }
+      // The threaded path numbers the points in order of first use.
+      if (!vtkTest::SameCellsByPoints(serial, cutters[1]->GetOutput(), 1e-6))
+      {
+        std::cerr << "Threaded output differs for " << function->GetClassName() << " with "
+                  << numContours << " contours" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
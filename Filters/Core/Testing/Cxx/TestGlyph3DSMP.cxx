@@ -0,0 +1,162 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded glyphing produces the same output as the serial
+// path for the scaling, coloring and orientation modes.
+
+#include "vtkGlyph3D.h"
+
+#include "vtkConeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkTexturedSphereSource.h"
+#include "vtkTransform.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Points on a helix, with scalars, vectors (some along the x axis, some
+// null), normals, colors and ghost points.
+void MakeInput(vtkPolyData* input)
+{
+  const vtkIdType numPts = 2000;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  normals->SetNumberOfTuples(numPts);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("Colors");
+  colors->SetNumberOfComponents(3);
+  colors->SetNumberOfTuples(numPts);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(numPts);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(numPts);
+
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double t = 0.05 * i;
+    points->SetPoint(i, std::cos(t) * 10.0, std::sin(t) * 10.0, 0.01 * i);
+    scalars->SetValue(i, static_cast<float>(0.5 + 0.5 * std::sin(0.3 * t)));
+    switch (i % 5)
+    {
+      case 0:
+        vectors->SetTuple3(i, 1.5, 0.0, 0.0);
+        break;
+      case 1:
+        vectors->SetTuple3(i, -0.5, 0.0, 0.0);
+        break;
+      case 2:
+        vectors->SetTuple3(i, 0.0, 0.0, 0.0);
+        break;
+      default:
+        vectors->SetTuple3(i, std::sin(t), std::cos(2.0 * t), 0.3 * std::sin(3.0 * t));
+    }
+    normals->SetTuple3(i, std::cos(t), std::sin(t), 0.0);
+    colors->SetTuple3(i, i % 256, (7 * i) % 256, (13 * i) % 256);
+    ids->SetValue(i, static_cast<int>(i));
+    ghosts->SetValue(i, i % 17 == 3 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetNormals(normals);
+  input->GetPointData()->AddArray(colors);
+  input->GetPointData()->AddArray(ids);
+  input->GetPointData()->AddArray(ghosts);
+}
+}
+
+int TestGlyph3DSMP(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeInput(input);
+
+  vtkNew<vtkTexturedSphereSource> sphere; // polygons with normals and texture coordinates
+  sphere->SetThetaResolution(6);
+  sphere->SetPhiResolution(5);
+  sphere->Update();
+  vtkNew<vtkConeSource> cone; // polygons only
+  cone->Update();
+  vtkPolyData* sources[] = { sphere->GetOutput(), cone->GetOutput(), nullptr };
+
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateZ(30.0);
+  sourceTransform->Scale(1.0, 2.0, 0.5);
+
+  for (int config = 0; config < 72; ++config)
+  {
+    const int scaleMode = config % 4;
+    const int colorMode = (config / 4) % 3;
+    const int vectorMode = (config / 12) % 3;
+    vtkNew<vtkGlyph3D> glyphs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+      glyphs[i]->SetInputData(input);
+      glyphs[i]->SetSourceData(sources[config % 3]);
+      glyphs[i]->SetScaleMode(scaleMode);
+      glyphs[i]->SetColorMode(colorMode);
+      glyphs[i]->SetVectorMode(vectorMode);
+      glyphs[i]->SetInputArrayToProcess(
+        3, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, colorMode == 1 ? "Colors" : "Scalars");
+      glyphs[i]->SetScaling(config % 7 != 0);
+      glyphs[i]->SetScaleFactor(0.75);
+      glyphs[i]->SetClamping((config / 36) % 2);
+      glyphs[i]->SetRange(0.2, 1.2);
+      glyphs[i]->SetFillCellData(config % 2);
+      glyphs[i]->SetGeneratePointIds((config / 2) % 2);
+      glyphs[i]->SetSourceTransform(config % 5 == 0 ? sourceTransform.GetPointer() : nullptr);
+      glyphs[i]->SetOutputPointsPrecision(
+        config % 3 == 1 ? vtkAlgorithm::DOUBLE_PRECISION : vtkAlgorithm::DEFAULT_PRECISION);
+      glyphs[i]->SetSequentialProcessing(i == 0);
+      glyphs[i]->Update();
+    }
+
+    if (glyphs[0]->GetOutput()->GetNumberOfCells() == 0)
+    {
+      std::cerr << "Empty output for configuration " << config << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (glyphs[0]->GetOutput()->GetPoints()->GetDataType() !=
+        glyphs[1]->GetOutput()->GetPoints()->GetDataType() ||
+      !vtkTest::SamePolyData(glyphs[0]->GetOutput(), glyphs[1]->GetOutput(), 1e-5))
+    {
+      std::cerr << "Threaded output differs for configuration " << config << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormalsSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded computation of normals produces exactly the same
+// output as the sequential one.
+
+#include "vtkCellData.h"
+#include "vtkCylinderSource.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSphereSource.h"
+#include "vtkTestDataSetComparison.h"
+
+#include <iostream>
+
+namespace
+{
+int CompareNormals(vtkPolyData* input, bool flip, bool splitting)
+{
+  vtkNew<vtkPolyDataNormals> normals[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    normals[i]->SetInputData(input);
+    normals[i]->SetFeatureAngle(20.0);
+    normals[i]->SetSplitting(splitting);
+    normals[i]->SetFlipNormals(flip);
+    normals[i]->ComputeCellNormalsOn();
+    normals[i]->SetSequentialProcessing(i == 0);
+    normals[i]->Update();
+  }
+  vtkPolyData* a = normals[0]->GetOutput();
+  vtkPolyData* b = normals[1]->GetOutput();
+
+  if (a->GetNumberOfPoints() == 0 || !a->GetPointData()->GetNormals() ||
+    !a->GetCellData()->GetNormals() || !vtkTest::SamePolyData(a, b))
+  {
+    std::cerr << "Threaded normals differ (flip " << flip << ", splitting " << splitting << ")"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int CompareAll(vtkPolyData* input)
+{
+  for (int flip = 0; flip < 2; ++flip)
+  {
+    for (int splitting = 0; splitting < 2; ++splitting)
+    {
+      if (CompareNormals(input, flip != 0, splitting != 0) != EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestPolyDataNormalsSMP(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Consistently ordered triangles, split along the many edges sharper than
+  // the feature angle.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(24);
+  sphere->SetPhiResolution(12);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->Update();
+
+  vtkNew<vtkPolyData> consistent;
+  consistent->DeepCopy(elevation->GetOutput());
+  if (CompareAll(consistent) != EXIT_SUCCESS)
+  {
+    std::cerr << "Consistent sphere failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Reorder some of the triangles: the ordering has to be fixed by the
+  // traversal.
+  vtkNew<vtkPolyData> inconsistent;
+  inconsistent->DeepCopy(elevation->GetOutput());
+  for (vtkIdType cellId = 0; cellId < inconsistent->GetNumberOfPolys(); cellId += 3)
+  {
+    inconsistent->GetPolys()->ReverseCellAtId(cellId);
+  }
+  if (CompareAll(inconsistent) != EXIT_SUCCESS)
+  {
+    std::cerr << "Inconsistent sphere failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Quads and polygons.
+  vtkNew<vtkCylinderSource> cylinder;
+  cylinder->SetResolution(16);
+
+  vtkNew<vtkElevationFilter> elevation2;
+  elevation2->SetInputConnection(cylinder->GetOutputPort());
+  elevation2->Update();
+  if (CompareAll(elevation2->GetPolyDataOutput()) != EXIT_SUCCESS)
+  {
+    std::cerr << "Cylinder failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded thresholding produces exactly the same output as
+// the serial path, for point and cell scalars and all the evaluation modes.
+
+#include "vtkThreshold.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// A grid mixing cells of all dimensionalities, with a multi-component point
+// array and a multi-component cell array.
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  const int cellTypes[] = { VTK_LINE, VTK_TRIANGLE, VTK_QUAD, VTK_TETRA, VTK_HEXAHEDRON,
+    VTK_WEDGE, VTK_PYRAMID, VTK_QUADRATIC_TETRA };
+
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(11, 9, 7);
+    source->Update();
+    append->AddInputData(source->GetOutput());
+  }
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(append->GetOutputPort());
+  elevation->SetLowPoint(0, 0, 0);
+  elevation->SetHighPoint(11, 9, 7);
+  elevation->Update();
+  grid->ShallowCopy(elevation->GetOutput());
+}
+
+// Add a 3-component point array and a 2-component cell array to threshold
+// on, plus an unnamed point array which must be carried along.
+void AddArrays(vtkDataSet* input)
+{
+  vtkNew<vtkDoubleArray> waves;
+  waves->SetName("Waves");
+  waves->SetNumberOfComponents(3);
+  waves->SetNumberOfTuples(input->GetNumberOfPoints());
+  vtkNew<vtkIntArray> unnamed;
+  unnamed->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    input->GetPoint(i, x);
+    waves->SetTuple3(
+      i, std::sin(0.4 * x[0]), std::cos(0.3 * (x[1] + x[2])), std::sin(0.05 * x[0] * x[1]));
+    unnamed->SetValue(i, static_cast<int>(i % 17));
+  }
+  input->GetPointData()->AddArray(waves);
+  input->GetPointData()->AddArray(unnamed);
+
+  vtkNew<vtkDoubleArray> cellWaves;
+  cellWaves->SetName("CellWaves");
+  cellWaves->SetNumberOfComponents(2);
+  cellWaves->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellWaves->SetTuple2(i, std::sin(0.01 * i), std::cos(0.003 * i));
+  }
+  input->GetCellData()->AddArray(cellWaves);
+}
+
+// Threshold the input with every combination of options, serially and in
+// parallel.
+bool CompareThresholds(vtkDataSet* input, const char* pointArray, const char* cellArray,
+  double lower, double upper)
+{
+  for (int association = 0; association < 2; ++association)
+  {
+    for (int mode = VTK_COMPONENT_MODE_USE_SELECTED; mode <= VTK_COMPONENT_MODE_USE_ANY; ++mode)
+    {
+      for (int options = 0; options < 8; ++options)
+      {
+        vtkNew<vtkThreshold> filters[2];
+        for (int i = 0; i < 2; ++i)
+        {
+          filters[i]->SetInputData(input);
+          if (association == 0)
+          {
+            filters[i]->SetInputArrayToProcess(
+              0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, pointArray);
+          }
+          else
+          {
+            filters[i]->SetInputArrayToProcess(
+              0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, cellArray);
+          }
+          filters[i]->ThresholdBetween(lower, upper);
+          filters[i]->SetComponentMode(mode);
+          filters[i]->SetSelectedComponent(1);
+          filters[i]->SetAllScalars(options & 1);
+          filters[i]->SetUseContinuousCellRange((options >> 1) & 1);
+          filters[i]->SetInvert(((options >> 2) & 1) != 0);
+          filters[i]->SetSequentialProcessing(i == 0);
+          filters[i]->Update();
+        }
+        if (filters[0]->GetOutput()->GetNumberOfCells() == 0)
+        {
+          std::cerr << "Empty output for association " << association << ", mode " << mode
+                    << " and options " << options << std::endl;
+          return false;
+        }
+        if (!vtkTest::SameUnstructuredGrids(filters[0]->GetOutput(), filters[1]->GetOutput()))
+        {
+          std::cerr << "Threaded output differs for association " << association << ", mode "
+                    << mode << " and options " << options << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestThresholdSMP(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+  AddArrays(grid);
+  if (!CompareThresholds(grid, "Waves", "CellWaves", -0.3, 0.4))
+  {
+    std::cerr << "Unstructured grid failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-12, 12, -10, 10, -8, 8);
+  source->Update();
+  vtkNew<vtkImageData> image;
+  image->ShallowCopy(source->GetOutput());
+  AddArrays(image);
+  if (!CompareThresholds(image, "Waves", "CellWaves", -0.3, 0.4))
+  {
+    std::cerr << "Image data failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
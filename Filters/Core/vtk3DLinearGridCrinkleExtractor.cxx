@@ -367,8 +367,9 @@ struct ExtractPointsAndCells : public ExtractCellsBase
     vtkUnstructuredGrid* grid, vtkCellArray* cells, bool copyPtData, bool copyCellData)
     : ExtractCellsBase(inNumPts, c, inout, grid, cells, copyPtData, copyCellData)
   {
+    // Until Reduce(), used points are marked with 1
     this->PointMap = new vtkIdType[inNumPts];
-    std::fill_n(this->PointMap, inNumPts, (-1));
+    vtkSMPTools::Fill(this->PointMap, this->PointMap + inNumPts, 0);
   }
 
   void Initialize() { this->ExtractCellsBase::Initialize(); }
@@ -414,17 +415,16 @@ struct ExtractPointsAndCells : public ExtractCellsBase
   // Composite local thread data. Basically build the output unstructured grid.
   void Reduce()
   {
-    // Generate point map
-    vtkIdType globalPtId = 0;
+    // Generate point map: the prefix sum of the marks numbers the used
+    // points, unused points are mapped to -1.
     vtkIdType* ptMap = this->PointMap;
-    for (auto ptId = 0; ptId < this->InputNumPts; ++ptId)
-    {
-      if (this->PointMap[ptId] > 0)
-      {
-        ptMap[ptId] = globalPtId++;
-      }
-    }
-    this->OutputNumPts = globalPtId;
+    std::vector<vtkIdType> ptIds(this->InputNumPts);
+    vtkSMPTools::ExclusiveScan(
+      ptMap, ptMap + this->InputNumPts, ptIds.begin(), static_cast<vtkIdType>(0));
+    this->OutputNumPts =
+      (this->InputNumPts > 0 ? ptIds.back() + ptMap[this->InputNumPts - 1] : 0);
+    vtkSMPTools::Transform(ptMap, ptMap + this->InputNumPts, ptIds.begin(), ptMap,
+      [](vtkIdType used, vtkIdType ptId) -> vtkIdType { return used ? ptId : -1; });
 
     // Count the number of cells, and the number of threads used. Figure out the total
     // length of the cell array.
@@ -507,14 +507,18 @@ struct ProduceMergedTriangles
     {
       using ValueType = typename CellStateT::ValueType;
 
+      // All the cells are triangles, so offset i is 3*i.
       auto offsets = vtk::DataArrayValueRange<1>(state.GetOffsets(), 0, numTris + 1);
-      ValueType offset = -3; // +=3 on first access
-      std::generate(offsets.begin(), offsets.end(), [&]() -> ValueType { return offset += 3; });
+      vtkSMPTools::For(0, numTris + 1, [&offsets](vtkIdType i, vtkIdType end) {
+        for (; i < end; ++i)
+        {
+          offsets[i] = static_cast<ValueType>(3 * i);
+        }
+      });
     }
   };
 
-  // Update the triangle connectivity (numPts for each triangle. This could
-  // be done in parallel but it's probably not faster.
+  // Update the triangle offsets (numPts for each triangle).
   void Reduce() { this->Tris->Visit(ReduceImpl{}, this->NumTris); }
 };
 
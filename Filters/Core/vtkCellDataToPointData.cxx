@@ -16,23 +16,32 @@
 
 #include "vtkArrayDispatch.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellType.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGrid.h"
-#include "vtkUnsignedIntArray.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <set>
+#include <vector>
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
@@ -41,95 +50,146 @@ vtkStandardNewMacro(vtkCellDataToPointData);
 namespace
 {
 
+using CellLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+//------------------------------------------------------------------------------
+// Sort the cells using each point by increasing cell id. The threaded build
+// of the links leaves them in arbitrary order, and the averages are summed
+// in cell order so that they do not depend on the number of threads.
+void SortLinks(CellLinks* links, vtkIdType npoints)
+{
+  vtkSMPTools::For(0, npoints, [links](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = links->GetCells(ptId);
+      std::sort(cells, cells + links->GetNcells(ptId));
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// The topological dimension of each cell type, computed once.
+struct CellTypeDimensions
+{
+  unsigned char Dimensions[VTK_NUMBER_OF_CELL_TYPES];
+
+  CellTypeDimensions()
+  {
+    for (int type = 0; type < VTK_NUMBER_OF_CELL_TYPES; ++type)
+    {
+      vtkCell* cell = vtkGenericCell::InstantiateCell(type);
+      this->Dimensions[type] = static_cast<unsigned char>(cell ? cell->GetCellDimension() : 0);
+      if (cell)
+      {
+        cell->Delete();
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// The topological dimension of each cell of the dataset.
+void ComputeCellDimensions(vtkDataSet* src, vtkIdType ncells, unsigned char* cellDims)
+{
+  static const CellTypeDimensions typeDims;
+
+  // Make sure the cell types can be queried from several threads.
+  src->GetCellType(0);
+  vtkSMPTools::For(0, ncells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellDims[cellId] = typeDims.Dimensions[src->GetCellType(cellId)];
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 // Helper template function that implement the major part of the algorighm
 // which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
+// provided so that coverage test can cover this function. Each point gathers
+// the data of the cells using it, so points are processed in parallel.
 struct Spread
 {
   template <typename SrcArrayT, typename DstArrayT>
-  void operator()(SrcArrayT* const srcarray, DstArrayT* const dstarray, vtkDataSet* const src,
-    vtkUnsignedIntArray* const num, vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps,
+  void operator()(SrcArrayT* const srcarray, DstArrayT* const dstarray, CellLinks* const links,
+    const unsigned char* const cellDims, vtkIdType npoints, vtkIdType ncomps,
     int highestCellDimension, int contributingCellOption) const
   {
     // Both arrays will have the same value type:
     using T = vtk::GetAPIType<SrcArrayT>;
 
-    // zero initialization
-    std::fill_n(vtk::DataArrayValueRange(dstarray).begin(), npoints * ncomps, T(0));
-
     const auto srcTuples = vtk::DataArrayTupleRange(srcarray);
     auto dstTuples = vtk::DataArrayTupleRange(dstarray);
 
-    // accumulate
     if (contributingCellOption != vtkCellDataToPointData::Patch)
     {
-      for (vtkIdType cid = 0; cid < ncells; ++cid)
-      {
-        vtkCell* cell = src->GetCell(cid);
-        if (cell->GetCellDimension() >= highestCellDimension)
+      vtkSMPTools::For(0, npoints, [&](vtkIdType pid, vtkIdType endPid) {
+        for (; pid < endPid; ++pid)
         {
-          const auto srcTuple = srcTuples[cid];
-          vtkIdList* pids = cell->GetPointIds();
-          for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+          auto dstTuple = dstTuples[pid];
+          std::fill(dstTuple.begin(), dstTuple.end(), T(0));
+
+          // accumulate cell data to point data <==> point_data += cell_data
+          const vtkIdType* cells = links->GetCells(pid);
+          unsigned int denom = 0;
+          for (vtkIdType i = 0, I = links->GetNcells(pid); i < I; ++i)
           {
-            const vtkIdType ptId = pids->GetId(i);
-            auto dstTuple = dstTuples[ptId];
-            // accumulate cell data to point data <==> point_data += cell_data
-            std::transform(srcTuple.cbegin(), srcTuple.cend(), dstTuple.cbegin(), dstTuple.begin(),
-              std::plus<T>());
+            if (cellDims[cells[i]] >= highestCellDimension)
+            {
+              const auto srcTuple = srcTuples[cells[i]];
+              std::transform(srcTuple.cbegin(), srcTuple.cend(), dstTuple.cbegin(),
+                dstTuple.begin(), std::plus<T>());
+              ++denom;
+            }
+          }
+
+          // guard against divide by zero
+          if (denom)
+          {
+            // divide point data by the number of cells using it <==>
+            // point_data /= denum
+            std::transform(dstTuple.cbegin(), dstTuple.cend(), dstTuple.begin(),
+              std::bind(std::divides<T>(), std::placeholders::_1, denom));
           }
         }
-      }
-      // average
-      for (vtkIdType pid = 0; pid < npoints; ++pid)
-      {
-        // guard against divide by zero
-        if (unsigned int const denom = num->GetValue(pid))
-        {
-          // divide point data by the number of cells using it <==>
-          // point_data /= denum
-          auto dstTuple = dstTuples[pid];
-          std::transform(dstTuple.cbegin(), dstTuple.cend(), dstTuple.begin(),
-            std::bind(std::divides<T>(), std::placeholders::_1, denom));
-        }
-      }
+      });
     }
     else
     { // compute over cell patches
-      vtkNew<vtkIdList> cellsOnPoint;
-      std::vector<T> data(4 * ncomps);
-      for (vtkIdType pid = 0; pid < npoints; ++pid)
-      {
-        std::fill(data.begin(), data.end(), 0);
-        T numPointCells[4] = { 0, 0, 0, 0 };
-        // Get all cells touching this point.
-        src->GetPointCells(pid, cellsOnPoint);
-        vtkIdType numPatchCells = cellsOnPoint->GetNumberOfIds();
-        for (vtkIdType pc = 0; pc < numPatchCells; pc++)
+      vtkSMPTools::For(0, npoints, [&](vtkIdType pid, vtkIdType endPid) {
+        std::vector<T> data(4 * ncomps);
+        for (; pid < endPid; ++pid)
         {
-          vtkIdType cellId = cellsOnPoint->GetId(pc);
-          int cellDimension = src->GetCell(cellId)->GetCellDimension();
-          numPointCells[cellDimension] += 1;
-          const auto srcTuple = srcTuples[cellId];
-          for (int comp = 0; comp < ncomps; comp++)
+          std::fill(data.begin(), data.end(), 0);
+          T numPointCells[4] = { 0, 0, 0, 0 };
+          // Get all cells touching this point.
+          const vtkIdType* cells = links->GetCells(pid);
+          for (vtkIdType pc = 0, numPatchCells = links->GetNcells(pid); pc < numPatchCells; pc++)
           {
-            data[comp + ncomps * cellDimension] += srcTuple[comp];
+            vtkIdType cellId = cells[pc];
+            int cellDimension = cellDims[cellId];
+            numPointCells[cellDimension] += 1;
+            const auto srcTuple = srcTuples[cellId];
+            for (int comp = 0; comp < ncomps; comp++)
+            {
+              data[comp + ncomps * cellDimension] += srcTuple[comp];
+            }
           }
-        }
-        auto dstTuple = dstTuples[pid];
-        for (int dimension = 3; dimension >= 0; dimension--)
-        {
-          if (numPointCells[dimension])
+          auto dstTuple = dstTuples[pid];
+          std::fill(dstTuple.begin(), dstTuple.end(), T(0));
+          for (int dimension = 3; dimension >= 0; dimension--)
           {
-            for (int comp = 0; comp < ncomps; comp++)
+            if (numPointCells[dimension])
             {
-              dstTuple[comp] = data[comp + dimension * ncomps] / numPointCells[dimension];
+              for (int comp = 0; comp < ncomps; comp++)
+              {
+                dstTuple[comp] = data[comp + dimension * ncomps] / numPointCells[dimension];
+              }
+              break;
             }
-            break;
           }
         }
-      }
+      });
     }
   }
 };
@@ -141,6 +201,46 @@ class vtkCellDataToPointData::Internals
 public:
   std::set<std::string> CellDataArrays;
 
+  // Point to cell links of the last unstructured input, and the topology
+  // they were built for: the number of points, then the modification time
+  // and size of each cell array.
+  std::unique_ptr<CellLinks> Links;
+  std::vector<vtkIdType> LinksTopology;
+
+  // Return links for the input, with the cells of each point sorted by cell
+  // id. They are only rebuilt when the topology has changed since the
+  // previous execution.
+  CellLinks* GetLinks(vtkDataSet* src)
+  {
+    std::vector<vtkIdType> topology(1, src->GetNumberOfPoints());
+    auto addCells = [&topology](vtkCellArray* cells) {
+      topology.push_back(cells ? static_cast<vtkIdType>(cells->GetMTime()) : 0);
+      topology.push_back(cells ? cells->GetNumberOfConnectivityIds() : 0);
+    };
+    if (vtkUnstructuredGrid* ugrid = vtkUnstructuredGrid::SafeDownCast(src))
+    {
+      addCells(ugrid->GetCells());
+      vtkUnsignedCharArray* types = ugrid->GetCellTypesArray();
+      topology.push_back(types ? static_cast<vtkIdType>(types->GetMTime()) : 0);
+    }
+    else if (vtkPolyData* pd = vtkPolyData::SafeDownCast(src))
+    {
+      addCells(pd->GetVerts());
+      addCells(pd->GetLines());
+      addCells(pd->GetPolys());
+      addCells(pd->GetStrips());
+    }
+
+    if (!this->Links || topology != this->LinksTopology)
+    {
+      this->Links.reset(new CellLinks);
+      this->Links->BuildLinks(src);
+      SortLinks(this->Links.get(), src->GetNumberOfPoints());
+      this->LinksTopology = topology;
+    }
+    return this->Links.get();
+  }
+
   // Special traversal algorithm for vtkUniformGrid and vtkRectilinearGrid to support blanking
   // points will not have more than 8 cells for either of these data sets
   template <typename T>
@@ -375,45 +475,17 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
     return 1;
   }
 
-  // count the number of cells associated with each point. if we are doing patches
-  // though we will do that later on.
-  vtkSmartPointer<vtkUnsignedIntArray> num;
+  // Links from each point to the cells using it, reused from the previous
+  // execution if the topology has not changed.
+  CellLinks* const links = this->Implementation->GetLinks(src);
+
+  // Find which cells contribute to the points.
+  std::vector<unsigned char> cellDims(ncells);
+  ComputeCellDimensions(src, ncells, cellDims.data());
   int highestCellDimension = 0;
-  if (this->ContributingCellOption != vtkCellDataToPointData::Patch)
+  if (this->ContributingCellOption == vtkCellDataToPointData::DataSetMax)
   {
-    num = vtkSmartPointer<vtkUnsignedIntArray>::New();
-    num->SetNumberOfComponents(1);
-    num->SetNumberOfTuples(npoints);
-    std::fill_n(num->GetPointer(0), npoints, 0u);
-    if (this->ContributingCellOption == vtkCellDataToPointData::DataSetMax)
-    {
-      int maxDimension = src->IsA("vtkPolyData") == 1 ? 2 : 3;
-      for (vtkIdType i = 0; i < src->GetNumberOfCells(); i++)
-      {
-        int dim = src->GetCell(i)->GetCellDimension();
-        if (dim > highestCellDimension)
-        {
-          highestCellDimension = dim;
-          if (highestCellDimension == maxDimension)
-          {
-            break;
-          }
-        }
-      }
-    }
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-      if (src->GetCell(cid)->GetCellDimension() >= highestCellDimension)
-      {
-        src->GetCellPoints(cid, pids);
-        for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-        {
-          vtkIdType const pid = pids->GetId(i);
-          num->SetValue(pid, num->GetValue(pid) + 1);
-        }
-      }
-    }
+    highestCellDimension = *std::max_element(cellDims.begin(), cellDims.end());
   }
 
   // First, copy the input to the output as a starting point
@@ -467,7 +539,7 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
 
   const auto nfields = processedCellData->GetNumberOfArrays();
   int fid = 0;
-  auto f = [this, &fid, nfields, npoints, src, num, ncells, highestCellDimension](
+  auto f = [this, &fid, nfields, npoints, links, &cellDims, highestCellDimension](
              vtkAbstractArray* aa_srcarray, vtkAbstractArray* aa_dstarray) {
     // update progress and check for an abort request.
     this->UpdateProgress((fid + 1.0) / nfields);
@@ -487,10 +559,10 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData(
 
       Spread worker;
       using Dispatcher = vtkArrayDispatch::Dispatch2SameValueType;
-      if (!Dispatcher::Execute(srcarray, dstarray, worker, src, num, ncells, npoints, ncomps,
-            highestCellDimension, this->ContributingCellOption))
+      if (!Dispatcher::Execute(srcarray, dstarray, worker, links, cellDims.data(), npoints,
+            ncomps, highestCellDimension, this->ContributingCellOption))
       { // fallback for unknown arrays:
-        worker(srcarray, dstarray, src, num, ncells, npoints, ncomps, highestCellDimension,
+        worker(srcarray, dstarray, links, cellDims.data(), npoints, ncomps, highestCellDimension,
           this->ContributingCellOption);
       }
     }
@@ -30,6 +30,14 @@
  * cells attached to a point. DataSetMax uses the highest cell dimension in
  * the entire data set.
  *
+ * For unstructured grids and polydata, the points are processed in parallel
+ * with vtkSMPTools: each point averages the data of the cells listed in
+ * static point to cell links. The links are kept by the filter and reused by
+ * later executions as long as the topology of the input (its number of points
+ * and the modification time of its cell arrays) is unchanged, so that
+ * repeatedly mapping time-varying cell data over a fixed mesh only pays for
+ * building them once.
+ *
  * @warning
  * This filter is an abstract filter, that is, the output is an abstract type
  * (i.e., vtkDataSet). Use the convenience methods (e.g.,
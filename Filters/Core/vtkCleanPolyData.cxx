@@ -14,19 +14,298 @@
 =========================================================================*/
 #include "vtkCleanPolyData.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 vtkStandardNewMacro(vtkCleanPolyData);
 
+namespace
+{ // anonymous
+
+//------------------------------------------------------------------------------
+// The static (threaded) merge path processes cells in blocks of this size.
+const vtkIdType StaticMergeBlockSize = 8192;
+
+// The cell arrays of a vtkPolyData, in the order their cells are numbered.
+enum
+{
+  CleanVerts = 0,
+  CleanLines = 1,
+  CleanPolys = 2,
+  CleanStrips = 3,
+  CleanNumberOfCellTypes = 4
+};
+
+//------------------------------------------------------------------------------
+// Renumber the points of a cell, dropping repeated points, and decide where
+// the cleaned cell ends up. This follows exactly the rules of the serial
+// path in vtkCleanPolyData::RequestData(). Returns the cell array receiving
+// the cleaned cell, or -1 if the cell is discarded.
+int CleanCell(int type, vtkIdType npts, const vtkIdType* pts, const vtkIdType* pointMap,
+  bool linesToPoints, bool polysToLines, bool stripsToPolys, vtkIdType* updatedPts,
+  vtkIdType& numNewPts)
+{
+  numNewPts = 0;
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    vtkIdType ptId = pointMap[pts[i]];
+    if (type == CleanVerts || i == 0 || ptId != updatedPts[numNewPts - 1])
+    {
+      updatedPts[numNewPts++] = ptId;
+    }
+  }
+  if (((type == CleanPolys && numNewPts > 2) || (type == CleanStrips && numNewPts > 1)) &&
+    updatedPts[0] == updatedPts[numNewPts - 1])
+  {
+    numNewPts--;
+  }
+
+  if (numNewPts == 0)
+  {
+    return -1;
+  }
+  // Lines, polygons and strips need at least type+1 points
+  if (type == CleanVerts || numNewPts > type)
+  {
+    // Cell is a proper vertex, line, polygon or triangle strip
+    return type;
+  }
+  if (numNewPts == 3 && (npts == numNewPts || stripsToPolys))
+  {
+    return CleanPolys;
+  }
+  if (numNewPts == 2 && (npts == numNewPts || polysToLines))
+  {
+    return CleanLines;
+  }
+  if (numNewPts == 1 && (npts == numNewPts || linesToPoints))
+  {
+    return CleanVerts;
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Apply OperateOnPoint() to all the input points. The operated points are
+// what is merged, and they become the output points.
+struct OperateOnPoints
+{
+  vtkCleanPolyData* Self;
+  vtkPoints* InPts;
+  double* OutPts;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->InPts->GetPoint(ptId, x);
+      this->Self->OperateOnPoint(x, this->OutPts + 3 * ptId);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Mark the merged points (i.e., the point each input point is merged to)
+// used by the cells. Points not used by any cell are not sent to the output.
+// Cells processed by different threads may share points, hence the atomic
+// flags. Every thread stores the same value, so relaxed stores are enough.
+struct MarkUsedPoints
+{
+  vtkCellArray* Cells;
+  const vtkIdType* MergeMap;
+  std::atomic<unsigned char>* Used;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  MarkUsedPoints(vtkCellArray* cells, const vtkIdType* mergeMap, std::atomic<unsigned char>* used)
+    : Cells(cells)
+    , MergeMap(mergeMap)
+    , Used(used)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Cells->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        this->Used[this->MergeMap[pts[i]]].store(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Copy the merged points and their point data to the output. Each output
+// point takes the (operated) coordinates and the attributes of the input
+// point it was merged to.
+struct CopyMergedPoints
+{
+  const vtkIdType* OutToIn;
+  const double* MappedPts;
+  vtkDataArray* OutPts;
+  ArrayList Arrays;
+
+  CopyMergedPoints(const vtkIdType* outToIn, const double* mappedPts, vtkDataArray* outPts,
+    vtkPointData* inPD, vtkPointData* outPD)
+    : OutToIn(outToIn)
+    , MappedPts(mappedPts)
+    , OutPts(outPts)
+  {
+    this->Arrays.AddArrays(outPts->GetNumberOfTuples(), inPD, outPD);
+  }
+
+  void operator()(vtkIdType outId, vtkIdType endOutId)
+  {
+    for (; outId < endOutId; ++outId)
+    {
+      const vtkIdType inId = this->OutToIn[outId];
+      this->OutPts->SetTuple(outId, this->MappedPts + 3 * inId);
+      this->Arrays.Copy(inId, outId);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// A contiguous range of cells of one of the input cell arrays.
+struct CellBlock
+{
+  int Type;
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType FirstCellId; // id of the first cell of the block in the input
+};
+
+//------------------------------------------------------------------------------
+// Remap the cells in two passes over the cell blocks. The first pass counts,
+// for each block, the number of cells and connectivity entries sent to each
+// output cell array. Once these counts are turned into offsets, the second
+// pass writes the cells and copies the cell data. Output cells keep the
+// order of the serial path.
+struct CleanCells
+{
+  vtkCellArray** InCells;
+  const vtkIdType* PointMap;
+  const std::vector<CellBlock>& Blocks;
+  // The cell counts of each output cell array, then its connectivity counts,
+  // each stored as Blocks.size()+1 values (one per block, plus the total).
+  vtkIdType* BlockCounts;
+  int MaxCellSize;
+  bool LinesToPoints;
+  bool PolysToLines;
+  bool StripsToPolys;
+
+  // Only used when filling the output
+  vtkIdType** Offsets;
+  vtkIdType** Connectivity;
+  const vtkIdType* FirstOutCellId; // per output cell array
+  ArrayList* CellArrays;
+
+  vtkSMPThreadLocal<std::vector<vtkSmartPointer<vtkCellArrayIterator>>> Iterators;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> UpdatedPts;
+
+  CleanCells(vtkCellArray** inCells, const vtkIdType* pointMap,
+    const std::vector<CellBlock>& blocks, vtkIdType* blockCounts, int maxCellSize,
+    bool linesToPoints, bool polysToLines, bool stripsToPolys)
+    : InCells(inCells)
+    , PointMap(pointMap)
+    , Blocks(blocks)
+    , BlockCounts(blockCounts)
+    , MaxCellSize(maxCellSize)
+    , LinesToPoints(linesToPoints)
+    , PolysToLines(polysToLines)
+    , StripsToPolys(stripsToPolys)
+    , Offsets(nullptr)
+    , Connectivity(nullptr)
+    , FirstOutCellId(nullptr)
+    , CellArrays(nullptr)
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<vtkSmartPointer<vtkCellArrayIterator>>& iters = this->Iterators.Local();
+    iters.resize(CleanNumberOfCellTypes);
+    for (int type = 0; type < CleanNumberOfCellTypes; ++type)
+    {
+      iters[type].TakeReference(this->InCells[type]->NewIterator());
+    }
+    this->UpdatedPts.Local().resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+  }
+
+  void operator()(vtkIdType blockId, vtkIdType endBlockId)
+  {
+    std::vector<vtkSmartPointer<vtkCellArrayIterator>>& iters = this->Iterators.Local();
+    vtkIdType* updatedPts = this->UpdatedPts.Local().data();
+    vtkIdType npts, numNewPts;
+    const vtkIdType* pts;
+    const vtkIdType stride = static_cast<vtkIdType>(this->Blocks.size()) + 1;
+
+    for (; blockId < endBlockId; ++blockId)
+    {
+      const CellBlock& block = this->Blocks[blockId];
+      vtkCellArrayIterator* iter = iters[block.Type];
+      vtkIdType inCellId = block.FirstCellId;
+
+      for (vtkIdType cellId = block.Begin; cellId < block.End; ++cellId, ++inCellId)
+      {
+        iter->GetCellAtId(cellId, npts, pts);
+        int outType = CleanCell(block.Type, npts, pts, this->PointMap, this->LinesToPoints,
+          this->PolysToLines, this->StripsToPolys, updatedPts, numNewPts);
+        if (outType < 0)
+        {
+          continue;
+        }
+        vtkIdType& cellCount = this->BlockCounts[outType * stride + blockId];
+        vtkIdType& connCount =
+          this->BlockCounts[(CleanNumberOfCellTypes + outType) * stride + blockId];
+        if (this->Offsets)
+        {
+          this->Offsets[outType][cellCount] = connCount;
+          std::copy(updatedPts, updatedPts + numNewPts, this->Connectivity[outType] + connCount);
+          this->CellArrays->Copy(inCellId, this->FirstOutCellId[outType] + cellCount);
+        }
+        cellCount++;
+        connCount += numNewPts;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Specify a spatial locator for speeding the search process. By
 // default an instance of vtkPointLocator is used.
@@ -46,6 +325,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->Locator = nullptr;
   this->PieceInvariant = 1;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->UseStaticLocator = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -129,6 +409,10 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->PointMerging && this->UseStaticLocator)
+  {
+    return this->MergeWithStaticLocator(input, output);
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -610,6 +894,231 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Threaded alternative to the locator based merging of RequestData(). The
+// operated points are merged with vtkStaticPointLocator::MergePoints(),
+// which sorts them into buckets and merges them in parallel, the same way
+// vtkStaticCleanPolyData does. Used merged points are then renumbered in
+// increasing order of input id, and the cells are remapped in parallel.
+int vtkCleanPolyData::MergeWithStaticLocator(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  // Merge the operated points. The static locator is built over a temporary
+  // dataset holding them.
+  vtkNew<vtkDoubleArray> mappedArray;
+  mappedArray->SetNumberOfComponents(3);
+  mappedArray->SetNumberOfTuples(numPts);
+  double* mappedPts = mappedArray->GetPointer(0);
+  OperateOnPoints operate{ this, inPts, mappedPts };
+  vtkSMPTools::For(0, numPts, operate);
+
+  vtkNew<vtkPoints> locatorPts;
+  locatorPts->SetData(mappedArray);
+  vtkNew<vtkPolyData> locatorData;
+  locatorData->SetPoints(locatorPts);
+
+  double tol =
+    (this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength());
+  std::vector<vtkIdType> mergeMap(numPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(locatorData);
+  locator->BuildLocator();
+  locator->MergePoints(tol, mergeMap.data());
+  locator->Initialize(); // release memory
+
+  // Merging within a tolerance in parallel may leave chains of merged
+  // points (e.g. 2->1->0): map each point directly to the end of its chain.
+  vtkIdType* merge = mergeMap.data();
+  if (tol > 0.0)
+  {
+    for (vtkIdType id = 0; id < numPts; ++id)
+    {
+      vtkIdType root = merge[id];
+      while (merge[root] != root)
+      {
+        root = merge[root];
+      }
+      merge[id] = root;
+    }
+  }
+  this->UpdateProgress(0.25);
+
+  // Mark the merged points used by cells.
+  vtkCellArray* inCells[CleanNumberOfCellTypes] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+  std::vector<std::atomic<unsigned char>> used(numPts);
+  for (int type = 0; type < CleanNumberOfCellTypes; ++type)
+  {
+    MarkUsedPoints mark(inCells[type], merge, used.data());
+    vtkSMPTools::For(0, inCells[type]->GetNumberOfCells(), mark);
+  }
+
+  // Number the used merged points in increasing order of input id: flag
+  // them, scan the flags into ids (the extra last entry receives the number
+  // of new points), then assign the ids. The points merged to another point
+  // take the id of that point.
+  std::vector<vtkIdType> pointMap(numPts + 1, 0);
+  const std::atomic<unsigned char>* isUsed = used.data();
+  auto isNewPoint = [merge, isUsed](vtkIdType id) {
+    return merge[id] == id && isUsed[id].load(std::memory_order_relaxed);
+  };
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      pointMap[id] = isNewPoint(id) ? 1 : 0;
+    }
+  });
+  vtkSMPTools::ExclusiveScan(pointMap.begin(), pointMap.end(), pointMap.begin(), vtkIdType(0));
+  vtkIdType numNewPts = pointMap[numPts];
+  std::vector<vtkIdType> outToIn(numNewPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      if (isNewPoint(id))
+      {
+        outToIn[pointMap[id]] = id;
+      }
+      else if (merge[id] == id)
+      {
+        pointMap[id] = -1;
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      if (merge[id] != id)
+      {
+        pointMap[id] = pointMap[merge[id]];
+      }
+    }
+  });
+  std::vector<std::atomic<unsigned char>>().swap(used); // atomics cannot be moved
+  mergeMap.clear();
+  mergeMap.shrink_to_fit();
+
+  // Copy the merged points and their data.
+  vtkPoints* newPts = inPts->NewInstance();
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  CopyMergedPoints copyPoints(outToIn.data(), mappedPts, newPts->GetData(), inputPD, outputPD);
+  vtkSMPTools::For(0, numNewPts, copyPoints);
+  this->UpdateProgress(0.5);
+
+  // Remap the cells. Count the cleaned cells of each block, then turn the
+  // counts into offsets (in the order verts, lines, polys, strips of the
+  // input cells, as the serial path does), and finally fill the output.
+  std::vector<CellBlock> blocks;
+  vtkIdType firstCellId = 0;
+  for (int type = 0; type < CleanNumberOfCellTypes; ++type)
+  {
+    vtkIdType numCells = inCells[type]->GetNumberOfCells();
+    for (vtkIdType begin = 0; begin < numCells; begin += StaticMergeBlockSize)
+    {
+      blocks.push_back(CellBlock{ type, begin, std::min(numCells, begin + StaticMergeBlockSize),
+        firstCellId + begin });
+    }
+    firstCellId += numCells;
+  }
+  vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkIdType> blockCounts(2 * CleanNumberOfCellTypes * (numBlocks + 1), 0);
+  CleanCells clean(inCells, pointMap.data(), blocks, blockCounts.data(), input->GetMaxCellSize(),
+    this->ConvertLinesToPoints != 0, this->ConvertPolysToLines != 0,
+    this->ConvertStripsToPolys != 0);
+  vtkSMPTools::For(0, numBlocks, clean);
+
+  vtkIdType numOutCells[CleanNumberOfCellTypes];
+  vtkIdType numOutConn[CleanNumberOfCellTypes];
+  for (int type = 0; type < CleanNumberOfCellTypes; ++type)
+  {
+    vtkIdType* cellCounts = blockCounts.data() + type * (numBlocks + 1);
+    vtkIdType* connCounts = cellCounts + CleanNumberOfCellTypes * (numBlocks + 1);
+    vtkSMPTools::ExclusiveScan(cellCounts, cellCounts + numBlocks + 1, cellCounts, vtkIdType(0));
+    vtkSMPTools::ExclusiveScan(connCounts, connCounts + numBlocks + 1, connCounts, vtkIdType(0));
+    numOutCells[type] = cellCounts[numBlocks];
+    numOutConn[type] = connCounts[numBlocks];
+  }
+
+  vtkIdType firstOutCellId[CleanNumberOfCellTypes];
+  vtkIdType* offsets[CleanNumberOfCellTypes];
+  vtkIdType* connectivity[CleanNumberOfCellTypes];
+  vtkSmartPointer<vtkIdTypeArray> offsetsArrays[CleanNumberOfCellTypes];
+  vtkSmartPointer<vtkIdTypeArray> connArrays[CleanNumberOfCellTypes];
+  vtkIdType numCells = 0;
+  for (int type = 0; type < CleanNumberOfCellTypes; ++type)
+  {
+    firstOutCellId[type] = numCells;
+    numCells += numOutCells[type];
+    offsetsArrays[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsetsArrays[type]->SetNumberOfValues(numOutCells[type] + 1);
+    offsets[type] = offsetsArrays[type]->GetPointer(0);
+    offsets[type][numOutCells[type]] = numOutConn[type];
+    connArrays[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+    connArrays[type]->SetNumberOfValues(numOutConn[type]);
+    connectivity[type] = connArrays[type]->GetPointer(0);
+  }
+
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD, numCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numCells, inputCD, outputCD);
+
+  clean.Offsets = offsets;
+  clean.Connectivity = connectivity;
+  clean.FirstOutCellId = firstOutCellId;
+  clean.CellArrays = &cellArrays;
+  vtkSMPTools::For(0, numBlocks, clean);
+  this->UpdateProgress(0.75);
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  for (int type = 0; type < CleanNumberOfCellTypes; ++type)
+  {
+    if (numOutCells[type] > 0)
+    {
+      vtkNew<vtkCellArray> newCells;
+      newCells->SetData(offsetsArrays[type], connArrays[type]);
+      switch (type)
+      {
+        case CleanVerts:
+          output->SetVerts(newCells);
+          break;
+        case CleanLines:
+          output->SetLines(newCells);
+          break;
+        case CleanPolys:
+          output->SetPolys(newCells);
+          break;
+        default:
+          output->SetStrips(newCells);
+          break;
+      }
+    }
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -682,6 +1191,7 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "PieceInvariant: " << (this->PieceInvariant ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Use Static Locator: " << (this->UseStaticLocator ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
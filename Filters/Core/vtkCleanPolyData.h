@@ -50,6 +50,15 @@
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
  *
+ * If UseStaticLocator is on, points are merged in parallel with a
+ * vtkStaticPointLocator instead of being inserted one by one into the
+ * Locator. The operated points are binned and sorted, and points within
+ * tolerance are merged exactly as vtkStaticCleanPolyData does; the cells are
+ * then remapped in parallel. The output differs from the incremental
+ * merging in the numbering of points only: merged points are numbered in
+ * increasing order of the input point they are merged to, instead of in
+ * order of first use.
+ *
  * @warning
  * Merging points can alter topology, including introducing non-manifold
  * forms. The tolerance should be chosen carefully to avoid these problems.
@@ -148,6 +157,19 @@ public:
   vtkBooleanMacro(PointMerging, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Set/Get a boolean value that controls whether point merging is
+   * performed in parallel with a vtkStaticPointLocator rather than with the
+   * (serial) incremental Locator. Note that in this case OperateOnPoint() is
+   * invoked concurrently, and OperateOnBounds() is not used. By default this
+   * is off.
+   */
+  vtkSetMacro(UseStaticLocator, vtkTypeBool);
+  vtkGetMacro(UseStaticLocator, vtkTypeBool);
+  vtkBooleanMacro(UseStaticLocator, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
@@ -209,6 +231,9 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  // Threaded point merging and cell remapping used when UseStaticLocator is on
+  int MergeWithStaticLocator(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
@@ -220,6 +245,7 @@ protected:
 
   vtkTypeBool PieceInvariant;
   int OutputPointsPrecision;
+  vtkTypeBool UseStaticLocator;
 
 private:
   vtkCleanPolyData(const vtkCleanPolyData&) = delete;
@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityLabelingInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -31,6 +32,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <map>
+#include <vector>
 
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
 
@@ -45,6 +47,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->ScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
   this->ScalarRange[1] = 1.0;
+  this->UnionFindLabeling = 0;
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
@@ -237,7 +240,11 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (this->UnionFindLabeling && !this->InScalars)
+  { // threaded labeling of all regions, then selection
+    this->LabelRegions(input, largestRegionId);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -344,19 +351,6 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  // if coloring regions; send down new scalar data
-  if (this->ColorRegions)
-  {
-    this->OrderRegionIds(this->NewScalars, this->NewCellScalars);
-
-    int idx = outputPD->AddArray(this->NewScalars);
-    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    idx = outputCD->AddArray(this->NewCellScalars);
-    outputCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-  }
-  this->NewScalars->Delete();
-  this->NewCellScalars->Delete();
-
   output->SetPoints(newPts);
   newPts->Delete();
 
@@ -399,6 +393,7 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
         if (newCellId >= 0)
         {
           outputCD->CopyData(cd, cellId, newCellId);
+          this->NewCellScalars->SetValue(newCellId, this->NewCellScalars->GetValue(cellId));
         }
       }
     }
@@ -448,6 +443,7 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
           if (newCellId >= 0)
           {
             outputCD->CopyData(cd, cellId, newCellId);
+            this->NewCellScalars->SetValue(newCellId, this->NewCellScalars->GetValue(cellId));
           }
         }
       }
@@ -487,11 +483,29 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
         if (newCellId >= 0)
         {
           outputCD->CopyData(cd, cellId, newCellId);
+          this->NewCellScalars->SetValue(newCellId, this->NewCellScalars->GetValue(cellId));
         }
       }
     }
   }
 
+  // The cell region ids were moved to the output cells, which are a subset
+  // of the input cells in the same order.
+  this->NewCellScalars->SetNumberOfTuples(output->GetNumberOfCells());
+
+  // if coloring regions; send down new scalar data
+  if (this->ColorRegions)
+  {
+    this->OrderRegionIds(this->NewScalars, this->NewCellScalars);
+
+    int idx = outputPD->AddArray(this->NewScalars);
+    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    idx = outputCD->AddArray(this->NewCellScalars);
+    outputCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+  this->NewScalars->Delete();
+  this->NewCellScalars->Delete();
+
   delete[] this->Visited;
   delete[] this->PointMap;
   this->PointIds->Delete();
@@ -516,6 +530,108 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+// Label all regions with a threaded union-find over static cell links, then
+// keep the regions requested by the extraction mode. This produces the same
+// visited cells, region ids and region sizes as the wave traversal; points
+// are numbered in increasing input id order.
+void vtkConnectivityFilter::LabelRegions(vtkDataSet* input, vtkIdType& largestRegionId)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  ConnectivityLinks links;
+  links.BuildLinks(input);
+  this->UpdateProgress(0.3);
+
+  std::vector<vtkIdType> regionSizes;
+  vtkIdType numRegions =
+    LabelConnectedRegions(links, numPts, numCells, this->Visited, regionSizes);
+  this->UpdateProgress(0.6);
+
+  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    vtkIdType maxCellsInRegion = 0;
+    this->RegionSizes->SetNumberOfValues(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+    {
+      if (regionSizes[regionId] > maxCellsInRegion)
+      {
+        maxCellsInRegion = regionSizes[regionId];
+        largestRegionId = regionId;
+      }
+      this->RegionSizes->SetValue(regionId, regionSizes[regionId]);
+    }
+    this->RegionNumber = numRegions;
+  }
+  else // regions have been seeded, everything considered in same region
+  {
+    std::vector<vtkIdType> seedCells;
+    vtkIdType i, pt;
+    if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    {
+      for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        pt = this->Seeds->GetId(i);
+        if (pt >= 0 && pt < numPts)
+        {
+          seedCells.insert(
+            seedCells.end(), links.GetCells(pt), links.GetCells(pt) + links.GetNcells(pt));
+        }
+      }
+    }
+    else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        vtkIdType cellId = this->Seeds->GetId(i);
+        if (cellId >= 0 && cellId < numCells)
+        {
+          seedCells.push_back(cellId);
+        }
+      }
+    }
+    else if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+    { // loop over points, find closest one
+      double minDist2, dist2, x[3];
+      vtkIdType minId = 0;
+      for (minDist2 = VTK_DOUBLE_MAX, i = 0; i < numPts; i++)
+      {
+        input->GetPoint(i, x);
+        dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
+        if (dist2 < minDist2)
+        {
+          minId = i;
+          minDist2 = dist2;
+        }
+      }
+      seedCells.insert(
+        seedCells.end(), links.GetCells(minId), links.GetCells(minId) + links.GetNcells(minId));
+    }
+
+    this->NumCellsInRegion =
+      SelectSeededRegions(numCells, numRegions, this->Visited, regionSizes, seedCells);
+    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+  }
+
+  this->PointNumber = MapRegionPoints(
+    links, numPts, this->Visited, this->PointMap, this->NewScalars->GetPointer(0));
+
+  vtkIdType* cellScalars = this->NewCellScalars->GetPointer(0);
+  const vtkIdType* visited = this->Visited;
+  vtkSMPTools::For(0, numCells, [cellScalars, visited](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (visited[cellId] >= 0)
+      {
+        cellScalars[cellId] = visited[cellId];
+      }
+    }
+  });
+  this->UpdateProgress(0.9);
+}
+
 // Mark current cell as visited and assign region number.  Note:
 // traversal occurs across shared vertices.
 //
@@ -751,6 +867,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Color Regions: " << (this->ColorRegions ? "On\n" : "Off\n");
 
   os << indent << "Scalar Connectivity: " << (this->ScalarConnectivity ? "On\n" : "Off\n");
+  os << indent << "Union Find Labeling: " << (this->UnionFindLabeling ? "On\n" : "Off\n");
 
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
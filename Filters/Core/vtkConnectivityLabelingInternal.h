@@ -0,0 +1,300 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityLabelingInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectivityLabelingInternal
+ * @brief   threaded labeling of connected cell regions
+ *
+ * vtkConnectivityLabelingInternal labels the connected regions of a dataset
+ * (cells that share points) with a concurrent union-find over the point to
+ * cell links of a vtkStaticCellLinksTemplate. Unions always attach the root
+ * with the larger cell id below the root with the smaller one, so once all
+ * unions are done the root of each region is its lowest cell id. Regions are
+ * then numbered in increasing order of their root, which is exactly the order
+ * in which the serial wave traversal of vtkConnectivityFilter and
+ * vtkPolyDataConnectivityFilter discovers them.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityLabelingInternal_h
+#define vtkConnectivityLabelingInternal_h
+
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+using ConnectivityLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+// Lock-free disjoint set forest over cell ids. A parent id is never larger
+// than its child, and a parent only ever moves closer to the root, so stale
+// reads are harmless and path halving can use a single weak exchange.
+class CellUnionFind
+{
+public:
+  explicit CellUnionFind(vtkIdType numCells)
+    : Parent(new std::atomic<vtkIdType>[numCells])
+  {
+    std::atomic<vtkIdType>* parent = this->Parent.get();
+    vtkSMPTools::For(0, numCells, [parent](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        parent[cellId].store(cellId, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  vtkIdType Find(vtkIdType id)
+  {
+    for (;;)
+    {
+      vtkIdType parent = this->Parent[id].load(std::memory_order_relaxed);
+      if (parent == id)
+      {
+        return id;
+      }
+      vtkIdType grandParent = this->Parent[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        this->Parent[id].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      id = grandParent;
+    }
+  }
+
+  void Unite(vtkIdType a, vtkIdType b)
+  {
+    for (;;)
+    {
+      a = this->Find(a);
+      b = this->Find(b);
+      if (a == b)
+      {
+        return;
+      }
+      if (a < b)
+      {
+        std::swap(a, b);
+      }
+      // Attach the larger root below the smaller one. This fails only if
+      // another thread attached a first, in which case we retry from the
+      // new roots.
+      vtkIdType expected = a;
+      if (this->Parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parent;
+};
+
+// Union the cells using each point.
+struct UniteCells
+{
+  ConnectivityLinks* Links;
+  CellUnionFind* Sets;
+
+  UniteCells(ConnectivityLinks* links, CellUnionFind* sets)
+    : Links(links)
+    , Sets(sets)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      for (vtkIdType i = 1; i < ncells; ++i)
+      {
+        this->Sets->Unite(cells[0], cells[i]);
+      }
+    }
+  }
+};
+
+// Count the cells of each region. Consecutive cells usually belong to the
+// same region, so runs are accumulated locally to keep contention on the
+// shared counters low even when a single region dominates.
+struct CountRegionSizes
+{
+  const vtkIdType* Regions;
+  std::atomic<vtkIdType>* Sizes;
+
+  CountRegionSizes(const vtkIdType* regions, std::atomic<vtkIdType>* sizes)
+    : Regions(regions)
+    , Sizes(sizes)
+  {
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdType region = -1;
+    vtkIdType count = 0;
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (this->Regions[cellId] != region)
+      {
+        if (count > 0)
+        {
+          this->Sizes[region].fetch_add(count, std::memory_order_relaxed);
+        }
+        region = this->Regions[cellId];
+        count = 0;
+      }
+      count += (region >= 0 ? 1 : 0);
+    }
+    if (count > 0)
+    {
+      this->Sizes[region].fetch_add(count, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Label each cell with the id of its connected region. Regions are numbered
+// in increasing order of their lowest cell id, and regionSizes is set to the
+// number of cells of each region. Returns the number of regions.
+vtkIdType LabelConnectedRegions(ConnectivityLinks& links, vtkIdType numPts, vtkIdType numCells,
+  vtkIdType* regions, std::vector<vtkIdType>& regionSizes)
+{
+  CellUnionFind sets(numCells);
+  UniteCells unite(&links, &sets);
+  vtkSMPTools::For(0, numPts, unite);
+
+  // Find the root of every cell and flag the roots. An exclusive scan of
+  // the flags numbers the roots in increasing order; the extra last entry
+  // receives the number of regions.
+  std::vector<vtkIdType> rootIds(numCells + 1, 0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      regions[cellId] = sets.Find(cellId);
+      rootIds[cellId] = (regions[cellId] == cellId ? 1 : 0);
+    }
+  });
+  vtkSMPTools::ExclusiveScan(rootIds.begin(), rootIds.end(), rootIds.begin(), vtkIdType(0));
+  const vtkIdType numRegions = rootIds[numCells];
+
+  // The region id of a cell is the number of its root.
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      regions[cellId] = rootIds[regions[cellId]];
+    }
+  });
+  rootIds.clear();
+  rootIds.shrink_to_fit();
+
+  std::unique_ptr<std::atomic<vtkIdType>[]> sizes(new std::atomic<vtkIdType>[numRegions] {});
+  CountRegionSizes count(regions, sizes.get());
+  vtkSMPTools::For(0, numCells, count);
+  regionSizes.resize(numRegions);
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    regionSizes[regionId] = sizes[regionId].load(std::memory_order_relaxed);
+  }
+  return numRegions;
+}
+
+// Keep only the regions containing one of the seed cells, relabeling their
+// cells as region 0 and all other cells as -1 (unvisited). Returns the number
+// of cells kept.
+vtkIdType SelectSeededRegions(vtkIdType numCells, vtkIdType numRegions, vtkIdType* regions,
+  const std::vector<vtkIdType>& regionSizes, const std::vector<vtkIdType>& seedCells)
+{
+  std::vector<char> selected(numRegions, 0);
+  vtkIdType numSelected = 0;
+  for (vtkIdType cellId : seedCells)
+  {
+    vtkIdType regionId = regions[cellId];
+    if (!selected[regionId])
+    {
+      selected[regionId] = 1;
+      numSelected += regionSizes[regionId];
+    }
+  }
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      regions[cellId] = selected[regions[cellId]] ? 0 : -1;
+    }
+  });
+  return numSelected;
+}
+
+// Number the points used by labeled cells (region >= 0) in increasing point
+// id order. All cells using a point belong to the same region, which is
+// recorded in pointRegions (indexed by the new point id). Returns the number
+// of points kept.
+vtkIdType MapRegionPoints(ConnectivityLinks& links, vtkIdType numPts, const vtkIdType* regions,
+  vtkIdType* pointMap, vtkIdType* pointRegions)
+{
+  auto pointRegion = [&links, regions](vtkIdType ptId) -> vtkIdType {
+    return links.GetNcells(ptId) > 0 ? regions[links.GetCells(ptId)[0]] : -1;
+  };
+
+  // Flag the kept points in pointMap, then scan the flags into new ids.
+  if (numPts <= 0)
+  {
+    return 0;
+  }
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      pointMap[ptId] = (pointRegion(ptId) >= 0 ? 1 : 0);
+    }
+  });
+  const vtkIdType lastFlag = pointMap[numPts - 1];
+  vtkSMPTools::ExclusiveScan(pointMap, pointMap + numPts, pointMap, vtkIdType(0));
+  const vtkIdType numNewPts = pointMap[numPts - 1] + lastFlag;
+
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType region = pointRegion(ptId);
+      if (region >= 0)
+      {
+        pointRegions[pointMap[ptId]] = region;
+      }
+      else
+      {
+        pointMap[ptId] = -1;
+      }
+    }
+  });
+  return numNewPts;
+}
+
+} // anonymous namespace
+
+#endif // vtkConnectivityLabelingInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectivityLabelingInternal.h
@@ -823,15 +823,19 @@ struct ProduceMergedTriangles
     {
       using ValueType = typename CellStateT::ValueType;
 
+      // All the cells are triangles, so offset i is 3*i.
       auto offsets =
         vtk::DataArrayValueRange<1>(state.GetOffsets(), totalTris, totalTris + nTris + 1);
-      ValueType offset = 3 * (totalTris - 1); // +=3 on first access
-      std::generate(offsets.begin(), offsets.end(), [&]() -> ValueType { return offset += 3; });
+      vtkSMPTools::For(0, nTris + 1, [&offsets, totalTris](vtkIdType i, vtkIdType end) {
+        for (; i < end; ++i)
+        {
+          offsets[i] = static_cast<ValueType>(3 * (totalTris + i));
+        }
+      });
     }
   };
 
-  // Update the triangle connectivity (numPts for each triangle. This could
-  // be done in parallel but it's probably not faster.
+  // Update the triangle offsets (numPts for each triangle).
   void Reduce() { this->Tris->Visit(ReduceImpl{}, this->TotalTris, this->NumTris); }
 };
 
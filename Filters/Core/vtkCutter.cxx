@@ -16,6 +16,7 @@
 
 #include "vtk3DLinearGridPlaneCutter.h"
 #include "vtkArrayDispatch.h"
+#include "vtkArrayListTemplate.h"
 #include "vtkAssume.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
@@ -28,6 +29,8 @@
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
 #include "vtkGridSynchronizedTemplates3D.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkImplicitFunction.h"
 #include "vtkIncrementalPointLocator.h"
@@ -41,16 +44,24 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkSynchronizedTemplates3D.h"
 #include "vtkSynchronizedTemplatesCutter3D.h"
 #include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkCutter);
 vtkCxxSetObjectMacro(vtkCutter, CutFunction, vtkImplicitFunction);
@@ -68,6 +79,7 @@ vtkCutter::vtkCutter(vtkImplicitFunction* cf)
   this->Locator = nullptr;
   this->GenerateTriangles = 1;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->SynchronizedTemplatesCutter3D = vtkSynchronizedTemplatesCutter3D::New();
@@ -723,6 +735,455 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   output->Squeeze();
 }
 
+//------------------------------------------------------------------------------
+// Threaded cutting of unstructured grids.
+namespace
+{
+
+// The cells are contoured in blocks of this size. The thread outputs are
+// merged in block order, so the result does not depend on the scheduling.
+const vtkIdType CutBlockSize = 1024;
+
+// Implicit functions whose EvaluateFunction() only reads their parameters,
+// and can therefore be evaluated concurrently.
+bool IsThreadSafeCutFunction(vtkImplicitFunction* function)
+{
+  return function->GetTransform() == nullptr &&
+    (function->IsA("vtkPlane") || function->IsA("vtkSphere") || function->IsA("vtkBox") ||
+      function->IsA("vtkCylinder") || function->IsA("vtkCone") || function->IsA("vtkQuadric"));
+}
+
+// Pair the arrays of two attribute data allocated from the same input. The
+// arrays are matched by index since they may not be named.
+void AddArrayPairs(
+  ArrayList& list, vtkIdType numOut, vtkDataSetAttributes* in, vtkDataSetAttributes* out)
+{
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* inArray = in->GetArray(i);
+    vtkDataArray* outArray = out->GetArray(i);
+    outArray->SetNumberOfTuples(numOut);
+    void* inData = inArray->GetVoidPointer(0);
+    void* outData = outArray->GetVoidPointer(0);
+    switch (outArray->GetDataType())
+    {
+      vtkTemplateMacro(CreateArrayPair(&list, static_cast<VTK_TT*>(inData),
+        static_cast<VTK_TT*>(outData), numOut, outArray->GetNumberOfComponents(), outArray,
+        static_cast<VTK_TT>(0)));
+    }
+  }
+}
+
+// The output of one thread for one pass over the cells. Points are merged
+// locally while contouring, and merged again across threads afterwards. A
+// pass only processes cells of one dimensionality, so all the cells it
+// produces are of one kind (verts, lines or polys), and the local cell data
+// is indexed by the local cell id.
+struct LocalCutOutput
+{
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkMergePoints> Locator;
+  vtkSmartPointer<vtkCellArray> Cells[3]; // verts, lines, polys
+  vtkSmartPointer<vtkPointData> PD;
+  vtkSmartPointer<vtkCellData> CD;
+  std::shared_ptr<vtkContourHelper> Helper;
+  vtkSmartPointer<vtkGenericCell> Cell;
+  vtkSmartPointer<vtkIdList> PointIds;
+  vtkSmartPointer<vtkDoubleArray> CellScalars;
+  vtkIdType PieceId;
+  vtkIdType PointOffset;
+};
+
+// The cells produced by a block of input cells, in the output of the thread
+// that processed it.
+struct CutBlock
+{
+  LocalCutOutput* Output;
+  vtkIdType CellBegin;
+  vtkIdType CellEnd;
+};
+
+// Contour the cells of one dimensionality.
+struct CutCells
+{
+  vtkUnstructuredGrid* Input;
+  vtkDoubleArray* CutScalars;
+  vtkPointData* InPD;
+  vtkCellData* InCD;
+  const unsigned char* CellTypeDimensions;
+  int Dimensionality;
+  const double* ContourValues;
+  int NumberOfContours;
+  int PointsType;
+  const double* Bounds;
+  vtkIdType EstimatedSize;
+  bool GenerateTriangles;
+  vtkIdType NumberOfCells;
+  std::vector<CutBlock> Blocks;
+  vtkSMPThreadLocal<LocalCutOutput> Local;
+
+  CutCells(vtkUnstructuredGrid* input, vtkDoubleArray* cutScalars, vtkPointData* inPD,
+    vtkCellData* inCD, const unsigned char* cellTypeDimensions, int dimensionality,
+    const double* contourValues, int numContours, int pointsType, const double* bounds,
+    vtkIdType estimatedSize, bool generateTriangles)
+    : Input(input)
+    , CutScalars(cutScalars)
+    , InPD(inPD)
+    , InCD(inCD)
+    , CellTypeDimensions(cellTypeDimensions)
+    , Dimensionality(dimensionality)
+    , ContourValues(contourValues)
+    , NumberOfContours(numContours)
+    , PointsType(pointsType)
+    , Bounds(bounds)
+    , EstimatedSize(estimatedSize)
+    , GenerateTriangles(generateTriangles)
+    , NumberOfCells(input->GetNumberOfCells())
+  {
+    this->Blocks.resize((this->NumberOfCells + CutBlockSize - 1) / CutBlockSize);
+  }
+
+  void Initialize()
+  {
+    LocalCutOutput& local = this->Local.Local();
+    local.Points = vtkSmartPointer<vtkPoints>::New();
+    local.Points->SetDataType(this->PointsType);
+    local.Points->Allocate(this->EstimatedSize, this->EstimatedSize / 2);
+    local.Locator = vtkSmartPointer<vtkMergePoints>::New();
+    local.Locator->InitPointInsertion(local.Points, this->Bounds);
+    for (auto& cells : local.Cells)
+    {
+      cells = vtkSmartPointer<vtkCellArray>::New();
+      cells->Use64BitStorage();
+    }
+    local.PD = vtkSmartPointer<vtkPointData>::New();
+    local.PD->InterpolateAllocate(this->InPD, this->EstimatedSize, this->EstimatedSize / 2);
+    local.CD = vtkSmartPointer<vtkCellData>::New();
+    local.CD->CopyAllocate(this->InCD, this->EstimatedSize, this->EstimatedSize / 2);
+    local.Helper = std::make_shared<vtkContourHelper>(local.Locator, local.Cells[0],
+      local.Cells[1], local.Cells[2], this->InPD, this->InCD, local.PD, local.CD,
+      static_cast<int>(this->EstimatedSize), this->GenerateTriangles);
+    local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    local.PointIds = vtkSmartPointer<vtkIdList>::New();
+    local.CellScalars = vtkSmartPointer<vtkDoubleArray>::New();
+    local.CellScalars->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType blockId, vtkIdType endBlockId)
+  {
+    LocalCutOutput& local = this->Local.Local();
+    vtkCellArray* cells = local.Cells[this->Dimensionality - 1];
+    const double* scalars = this->CutScalars->GetPointer(0);
+    const double* contourValuesEnd = this->ContourValues + this->NumberOfContours;
+
+    for (; blockId < endBlockId; ++blockId)
+    {
+      CutBlock& block = this->Blocks[blockId];
+      block.Output = &local;
+      block.CellBegin = cells->GetNumberOfCells();
+      vtkIdType endCellId = std::min(this->NumberOfCells, (blockId + 1) * CutBlockSize);
+      for (vtkIdType cellId = blockId * CutBlockSize; cellId < endCellId; ++cellId)
+      {
+        int cellType = this->Input->GetCellType(cellId);
+        if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+          this->CellTypeDimensions[cellType] != this->Dimensionality)
+        {
+          continue;
+        }
+
+        this->Input->GetCellPoints(cellId, local.PointIds);
+        vtkIdType numCellPts = local.PointIds->GetNumberOfIds();
+        const vtkIdType* ptIds = local.PointIds->GetPointer(0);
+        if (numCellPts == 0)
+        {
+          continue;
+        }
+        double range[2];
+        range[0] = range[1] = scalars[ptIds[0]];
+        for (vtkIdType i = 1; i < numCellPts; ++i)
+        {
+          range[0] = std::min(range[0], scalars[ptIds[i]]);
+          range[1] = std::max(range[1], scalars[ptIds[i]]);
+        }
+
+        const double* contourIter = this->ContourValues;
+        for (; contourIter != contourValuesEnd; ++contourIter)
+        {
+          if (*contourIter >= range[0] && *contourIter <= range[1])
+          {
+            break;
+          }
+        }
+        if (contourIter == contourValuesEnd)
+        {
+          continue;
+        }
+
+        this->Input->GetCell(cellId, local.Cell);
+        this->CutScalars->GetTuples(local.PointIds, local.CellScalars);
+        for (contourIter = this->ContourValues; contourIter != contourValuesEnd; ++contourIter)
+        {
+          local.Helper->Contour(local.Cell, *contourIter, local.CellScalars, cellId);
+        }
+      }
+      block.CellEnd = cells->GetNumberOfCells();
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Merge the thread outputs of the three passes. The cells are appended block
+// by block, verts then lines then polys, which is the order of the serial
+// algorithm. Coincident points are merged exactly, as vtkMergePoints does,
+// and numbered in the order in which the output cells first use them.
+void MergeCutOutputs(CutCells* passes[3], vtkPoints* newPoints, vtkCellArray* newCells[3],
+  vtkPointData* outPD, vtkCellData* outCD)
+{
+  // Gather the points of all the thread outputs.
+  std::vector<LocalCutOutput*> pieces;
+  std::vector<vtkIdType> pieceOffsets(1, 0);
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    for (auto& local : passes[pass]->Local)
+    {
+      local.PieceId = static_cast<vtkIdType>(pieces.size());
+      local.PointOffset = pieceOffsets.back();
+      pieces.push_back(&local);
+      pieceOffsets.push_back(local.PointOffset + local.Points->GetNumberOfPoints());
+    }
+  }
+  const vtkIdType numPieces = static_cast<vtkIdType>(pieces.size());
+  const vtkIdType numStaged = pieceOffsets.back();
+
+  vtkNew<vtkPoints> stagedPoints;
+  stagedPoints->SetDataType(newPoints->GetDataType());
+  stagedPoints->SetNumberOfPoints(numStaged);
+  vtkDataArray* stagedData = stagedPoints->GetData();
+  vtkSMPTools::For(0, numPieces, [&](vtkIdType piece, vtkIdType endPiece) {
+    for (; piece < endPiece; ++piece)
+    {
+      vtkDataArray* localData = pieces[piece]->Points->GetData();
+      if (localData->GetNumberOfTuples() > 0)
+      {
+        memcpy(stagedData->GetVoidPointer(3 * pieceOffsets[piece]), localData->GetVoidPointer(0),
+          3 * localData->GetNumberOfTuples() * localData->GetDataTypeSize());
+      }
+    }
+  });
+
+  std::vector<vtkIdType> mergeMap(numStaged);
+  if (numStaged > 0)
+  {
+    vtkNew<vtkPolyData> stagedSet;
+    stagedSet->SetPoints(stagedPoints);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(stagedSet);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, mergeMap.data());
+  }
+
+  // Lay out the cells block by block. Blocks are listed pass after pass, and
+  // every pass has the same number of blocks.
+  std::vector<const CutBlock*> blocks;
+  std::vector<int> blockPasses;
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    for (const CutBlock& block : passes[pass]->Blocks)
+    {
+      blocks.push_back(&block);
+      blockPasses.push_back(pass);
+    }
+  }
+  const vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+  const vtkIdType blocksPerPass = numBlocks / 3;
+  std::vector<vtkIdType> cellOffsets(numBlocks + 1, 0);
+  std::vector<vtkIdType> connOffsets(numBlocks + 1, 0);
+  for (vtkIdType blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    const CutBlock* block = blocks[blockId];
+    const vtkTypeInt64* offsets =
+      block->Output->Cells[blockPasses[blockId]]->GetOffsetsArray64()->GetPointer(0);
+    cellOffsets[blockId + 1] = cellOffsets[blockId] + block->CellEnd - block->CellBegin;
+    connOffsets[blockId + 1] =
+      connOffsets[blockId] + offsets[block->CellEnd] - offsets[block->CellBegin];
+  }
+  vtkIdType cellBase[4];
+  vtkIdType connBase[4];
+  for (int pass = 0; pass <= 3; ++pass)
+  {
+    cellBase[pass] = cellOffsets[pass * blocksPerPass];
+    connBase[pass] = connOffsets[pass * blocksPerPass];
+  }
+  const vtkIdType numCells = cellBase[3];
+  const vtkIdType connSize = connBase[3];
+
+  // Copy the cells, referring to the staged points, and their data.
+  vtkSmartPointer<vtkIdTypeArray> offsetArrays[3];
+  vtkSmartPointer<vtkIdTypeArray> connArrays[3];
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    offsetArrays[pass] = vtkSmartPointer<vtkIdTypeArray>::New();
+    const vtkIdType numPassCells = cellBase[pass + 1] - cellBase[pass];
+    offsetArrays[pass]->SetNumberOfValues(numPassCells + 1);
+    offsetArrays[pass]->SetValue(numPassCells, connBase[pass + 1] - connBase[pass]);
+    connArrays[pass] = vtkSmartPointer<vtkIdTypeArray>::New();
+    connArrays[pass]->SetNumberOfValues(connBase[pass + 1] - connBase[pass]);
+  }
+  std::vector<ArrayList> cellArrays(numPieces);
+  for (vtkIdType piece = 0; piece < numPieces; ++piece)
+  {
+    AddArrayPairs(cellArrays[piece], numCells, pieces[piece]->CD, outCD);
+  }
+  std::vector<vtkIdType> refs(connSize);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      const CutBlock* block = blocks[blockId];
+      const int pass = blockPasses[blockId];
+      vtkCellArray* cells = block->Output->Cells[pass];
+      const vtkTypeInt64* offsets = cells->GetOffsetsArray64()->GetPointer(0);
+      const vtkTypeInt64* conn = cells->GetConnectivityArray64()->GetPointer(0);
+      vtkIdType* outOffsets = offsetArrays[pass]->GetPointer(0);
+      ArrayList& cellData = cellArrays[block->Output->PieceId];
+
+      const vtkIdType connShift = connOffsets[blockId] - offsets[block->CellBegin];
+      vtkIdType cellId = cellOffsets[blockId];
+      for (vtkIdType localId = block->CellBegin; localId < block->CellEnd; ++localId, ++cellId)
+      {
+        outOffsets[cellId - cellBase[pass]] = offsets[localId] + connShift - connBase[pass];
+        cellData.Copy(localId, cellId);
+      }
+      for (vtkTypeInt64 i = offsets[block->CellBegin]; i < offsets[block->CellEnd]; ++i)
+      {
+        refs[i + connShift] = block->Output->PointOffset + conn[i];
+      }
+    }
+  });
+
+  // Find the first use of each merged point.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numStaged]);
+  vtkSMPTools::For(0, numStaged, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(connSize, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, connSize, [&](vtkIdType i, vtkIdType endI) {
+    for (; i < endI; ++i)
+    {
+      std::atomic<vtkIdType>& first = firstUse[mergeMap[refs[i]]];
+      vtkIdType current = first.load(std::memory_order_relaxed);
+      while (i < current && !first.compare_exchange_weak(current, i, std::memory_order_relaxed))
+      {
+      }
+    }
+  });
+
+  // Number the merged points in order of first use: count the first uses per
+  // block of connectivity, scan the counts, then assign the ids and copy the
+  // points and their data.
+  auto isFirstUse = [&](vtkIdType i) {
+    return firstUse[mergeMap[refs[i]]].load(std::memory_order_relaxed) == i;
+  };
+  const vtkIdType numUseBlocks = (connSize + CutBlockSize - 1) / CutBlockSize;
+  std::vector<vtkIdType> useOffsets(numUseBlocks + 1, 0);
+  vtkSMPTools::For(0, numUseBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      vtkIdType endI = std::min(connSize, (blockId + 1) * CutBlockSize);
+      vtkIdType count = 0;
+      for (vtkIdType i = blockId * CutBlockSize; i < endI; ++i)
+      {
+        count += (isFirstUse(i) ? 1 : 0);
+      }
+      useOffsets[blockId + 1] = count;
+    }
+  });
+  for (vtkIdType blockId = 0; blockId < numUseBlocks; ++blockId)
+  {
+    useOffsets[blockId + 1] += useOffsets[blockId];
+  }
+  const vtkIdType numNewPts = useOffsets[numUseBlocks];
+
+  newPoints->SetNumberOfPoints(numNewPts);
+  vtkDataArray* newData = newPoints->GetData();
+  std::vector<ArrayList> pointArrays(numPieces);
+  for (vtkIdType piece = 0; piece < numPieces; ++piece)
+  {
+    AddArrayPairs(pointArrays[piece], numNewPts, pieces[piece]->PD, outPD);
+  }
+  std::vector<vtkIdType> newIds(numStaged);
+  vtkSMPTools::For(0, numUseBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      vtkIdType endI = std::min(connSize, (blockId + 1) * CutBlockSize);
+      vtkIdType newId = useOffsets[blockId];
+      for (vtkIdType i = blockId * CutBlockSize; i < endI; ++i)
+      {
+        if (isFirstUse(i))
+        {
+          const vtkIdType stagedId = refs[i];
+          const vtkIdType piece = static_cast<vtkIdType>(
+            std::upper_bound(pieceOffsets.begin(), pieceOffsets.end(), stagedId) -
+            pieceOffsets.begin() - 1);
+          newIds[mergeMap[stagedId]] = newId;
+          newData->SetTuple(newId, stagedId, stagedData);
+          pointArrays[piece].Copy(stagedId - pieceOffsets[piece], newId);
+          ++newId;
+        }
+      }
+    }
+  });
+
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    vtkIdType* outConn = connArrays[pass]->GetPointer(0);
+    const vtkIdType base = connBase[pass];
+    vtkSMPTools::For(base, connBase[pass + 1], [&](vtkIdType i, vtkIdType endI) {
+      for (; i < endI; ++i)
+      {
+        outConn[i - base] = newIds[mergeMap[refs[i]]];
+      }
+    });
+    newCells[pass]->SetData(offsetArrays[pass], connArrays[pass]);
+  }
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The threaded path merges points exactly, like vtkMergePoints, and copies
+// attribute values directly between arrays, so it is only used with the
+// default locator and data arrays. Cells must also be processed by value, as
+// the per-thread outputs are merged in cell order. Finally the polygons built
+// from the triangles of 3D cells when GenerateTriangles is off start at their
+// lowest point id, which would make them depend on the thread numbering.
+bool vtkCutter::CanCutInParallel(vtkDataSet* input, vtkPointData* outPD, vtkCellData* outCD)
+{
+  if (this->SequentialProcessing || this->SortBy != VTK_SORT_BY_VALUE ||
+    !this->GenerateTriangles || !vtkUnstructuredGrid::SafeDownCast(input) ||
+    (this->Locator && !this->Locator->IsA("vtkMergePoints")))
+  {
+    return false;
+  }
+  for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+  {
+    if (!outPD->GetArray(i))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+  {
+    if (!outCD->GetArray(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
 {
@@ -804,6 +1265,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   outPD = output->GetPointData();
   outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
   outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
+  bool threaded = this->CanCutInParallel(input, outPD, outCD);
 
   // locator used to merge potentially duplicate points
   if (this->Locator == nullptr)
@@ -816,7 +1278,23 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   if (inputPointSet)
   {
     vtkDataArray* dataArrayInput = inputPointSet->GetPoints()->GetData();
-    this->CutFunction->FunctionValue(dataArrayInput, cutScalars);
+    if (threaded && IsThreadSafeCutFunction(this->CutFunction))
+    {
+      vtkImplicitFunction* function = this->CutFunction;
+      double* cutValues = cutScalars->GetPointer(0);
+      vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+        double x[3];
+        for (; ptId < endPtId; ++ptId)
+        {
+          dataArrayInput->GetTuple(ptId, x);
+          cutValues[ptId] = function->EvaluateFunction(x);
+        }
+      });
+    }
+    else
+    {
+      this->CutFunction->FunctionValue(dataArrayInput, cutScalars);
+    }
   }
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
@@ -830,7 +1308,33 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
 
   vtkContourHelper helper(this->Locator, newVerts, newLines, newPolys, inPD, inCD, outPD, outCD,
     estimatedSize, this->GenerateTriangles != 0);
-  if (this->SortBy == VTK_SORT_BY_CELL)
+  if (threaded)
+  {
+    // Same passes over the cell dimensionalities as when sorting by value
+    // below, with the cells contoured in parallel. The thread outputs are
+    // merged once all the passes are done.
+    unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+    vtkUnstructuredGrid* grid = static_cast<vtkUnstructuredGrid*>(input);
+    std::unique_ptr<CutCells> passes[3];
+    for (int dimensionality = 1; dimensionality <= 3 && !abortExecute; ++dimensionality)
+    {
+      CutCells* pass = new CutCells(grid, cutScalars, inPD, inCD, cellTypeDimensions,
+        dimensionality, contourValues, numContours, newPoints->GetDataType(), input->GetBounds(),
+        estimatedSize, this->GenerateTriangles != 0);
+      passes[dimensionality - 1].reset(pass);
+      vtkSMPTools::For(0, static_cast<vtkIdType>(pass->Blocks.size()), *pass);
+      this->UpdateProgress(0.3 * dimensionality);
+      abortExecute = this->GetAbortExecute();
+    }
+    if (!abortExecute)
+    {
+      CutCells* passPtrs[3] = { passes[0].get(), passes[1].get(), passes[2].get() };
+      vtkCellArray* newCells[3] = { newVerts, newLines, newPolys };
+      MergeCutOutputs(passPtrs, newPoints, newCells, outPD, outCD);
+    }
+  }
+  else if (this->SortBy == VTK_SORT_BY_CELL)
   {
     // Compute some information for progress methods
     //
@@ -1082,4 +1586,5 @@ void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Generate Cut Scalars: " << (this->GenerateCutScalars ? "On\n" : "Off\n");
 
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
@@ -38,6 +38,13 @@
  * By default, if an implicit function is set it is used to clip the data
  * set, otherwise the dataset scalars are used to perform the clipping.
  *
+ * When cutting a vtkUnstructuredGrid into triangles, sorted by value and with
+ * the default point merging, the cells are contoured in parallel, and the
+ * per-thread outputs are merged afterwards. The cells and cell data are then
+ * produced in the same order as in serial, while the points are numbered in
+ * the order in which the cells first use them, and take their data from that
+ * first use.
+ *
  * @sa
  * vtkImplicitFunction vtkClipPolyData
  */
@@ -219,6 +226,20 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when cutting
+   * unstructured grids. By default, sequential processing is off. Note this
+   * flag only applies if the class has been compiled with
+   * VTK_SMP_IMPLEMENTATION_TYPE set to something other than Sequential. (If
+   * set to Sequential, then the filter always runs in serial mode.) This flag
+   * is typically used for benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkCutter(vtkImplicitFunction* cf = nullptr);
   ~vtkCutter() override;
@@ -227,6 +248,7 @@ protected:
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
   void UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output);
+  bool CanCutInParallel(vtkDataSet* input, vtkPointData* outPD, vtkCellData* outCD);
   void DataSetCutter(vtkDataSet* input, vtkPolyData* output);
   void StructuredPointsCutter(
     vtkDataSet*, vtkPolyData*, vtkInformation*, vtkInformationVector**, vtkInformationVector*);
@@ -245,6 +267,7 @@ protected:
   vtkContourValues* ContourValues;
   vtkTypeBool GenerateCutScalars;
   int OutputPointsPrecision;
+  vtkTypeBool SequentialProcessing;
 
 private:
   vtkCutter(const vtkCutter&) = delete;
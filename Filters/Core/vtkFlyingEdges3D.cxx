@@ -32,6 +32,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkFlyingEdges3D);
 
@@ -383,6 +384,57 @@ public:
     }
   };
 
+  // Number of points and triangles generated along an x-row. Prefix summing
+  // them partitions the output among the x-rows.
+  struct RowCounts
+  {
+    vtkIdType NumPts;
+    vtkIdType NumTris;
+  };
+  struct AddRowCounts
+  {
+    RowCounts operator()(const RowCounts& a, const RowCounts& b) const
+    {
+      return RowCounts{ a.NumPts + b.NumPts, a.NumTris + b.NumTris };
+    }
+  };
+
+  // Gather the counts of the x-rows from their edge meta data.
+  struct GatherRowCounts
+  {
+    const vtkIdType* EdgeMetaData;
+    RowCounts* Counts;
+    void operator()(vtkIdType row, vtkIdType endRow)
+    {
+      for (; row < endRow; ++row)
+      {
+        const vtkIdType* eMD = this->EdgeMetaData + 6 * row;
+        this->Counts[row] = RowCounts{ eMD[0] + eMD[1] + eMD[2], eMD[3] };
+      }
+    }
+  };
+
+  // Write the starting points and triangles of the x-rows (i.e., the prefix
+  // sum of the counts) into their edge meta data.
+  struct ScatterRowStarts
+  {
+    vtkIdType* EdgeMetaData;
+    const RowCounts* Starts;
+    void operator()(vtkIdType row, vtkIdType endRow)
+    {
+      for (; row < endRow; ++row)
+      {
+        vtkIdType* eMD = this->EdgeMetaData + 6 * row;
+        const vtkIdType numXPts = eMD[0];
+        const vtkIdType numYPts = eMD[1];
+        eMD[0] = this->Starts[row].NumPts;
+        eMD[1] = eMD[0] + numXPts;
+        eMD[2] = eMD[1] + numYPts;
+        eMD[3] = this->Starts[row].NumTris;
+      }
+    }
+  };
+
   // Interface between VTK and templated functions
   static void Contour(vtkFlyingEdges3D* self, vtkImageData* input, vtkDataArray* inScalars,
     int extent[6], vtkIdType* incs, T* scalars, vtkPolyData* output, vtkPoints* newPts,
@@ -1112,11 +1164,8 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
 {
   double value, *values = self->GetValues();
   vtkIdType numContours = self->GetNumberOfContours();
-  vtkIdType vidx, row, slice, *eMD, zInc;
-  vtkIdType numOutXPts, numOutYPts, numOutZPts, numOutTris;
-  vtkIdType numXPts = 0, numYPts = 0, numZPts = 0, numTris = 0;
-  vtkIdType startXPts, startYPts, startZPts, startTris;
-  startXPts = startYPts = startZPts = startTris = 0;
+  vtkIdType vidx;
+  RowCounts start = { 0, 0 };
 
   // This may be subvolume of the total 3D image. Capture information for
   // subsequent processing.
@@ -1175,42 +1224,25 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
 
     // PASS 3: Now allocate and generate output. First we have to update the
     // edge meta data to partition the output into separate pieces so
-    // independent threads can write without collisions. Once allocation is
-    // complete, the volume is processed on a voxel row by row basis to
-    // produce output points and triangles, and interpolate point attribute
-    // data (as necessary). NOTE: This implementation is serial. It is
-    // possible to use a threaded prefix sum to make it even faster. Since
-    // this pass usually takes a small amount of time, we choose simplicity
-    // over performance.
-    numOutXPts = startXPts;
-    numOutYPts = startYPts;
-    numOutZPts = startZPts;
-    numOutTris = startTris;
-
-    // Count number of points and tris generate along each cell row
-    for (slice = 0; slice < algo.Dims[2]; ++slice)
-    {
-      zInc = slice * algo.Dims[1];
-      for (row = 0; row < algo.Dims[1]; ++row)
-      {
-        eMD = algo.EdgeMetaData + (zInc + row) * 6;
-        numXPts = eMD[0];
-        numYPts = eMD[1];
-        numZPts = eMD[2];
-        numTris = eMD[3];
-        eMD[0] = numOutXPts + numOutYPts + numOutZPts;
-        eMD[1] = eMD[0] + numXPts;
-        eMD[2] = eMD[1] + numYPts;
-        eMD[3] = numOutTris;
-        numOutXPts += numXPts;
-        numOutYPts += numYPts;
-        numOutZPts += numZPts;
-        numOutTris += numTris;
-      }
-    }
+    // independent threads can write without collisions. This is a prefix sum
+    // of the number of points and triangles generated along each x-row. Once
+    // allocation is complete, the volume is processed on a voxel row by row
+    // basis to produce output points and triangles, and interpolate point
+    // attribute data (as necessary).
+    const vtkIdType numRows = algo.Dims[1] * algo.Dims[2];
+    std::vector<RowCounts> rowCounts(numRows);
+    GatherRowCounts gather = { algo.EdgeMetaData, rowCounts.data() };
+    vtkSMPTools::For(0, numRows, gather);
+    const RowCounts lastRowCounts = rowCounts.back();
+    vtkSMPTools::ExclusiveScan(
+      rowCounts.begin(), rowCounts.end(), rowCounts.begin(), start, AddRowCounts());
+    ScatterRowStarts scatter = { algo.EdgeMetaData, rowCounts.data() };
+    vtkSMPTools::For(0, numRows, scatter);
+    const RowCounts total = AddRowCounts()(rowCounts.back(), lastRowCounts);
+    const vtkIdType numOutTris = total.NumTris;
 
     // Output can now be allocated.
-    vtkIdType totalPts = numOutXPts + numOutYPts + numOutZPts;
+    vtkIdType totalPts = total.NumPts;
     if (totalPts > 0)
     {
       newPts->GetData()->WriteVoidPointer(0, 3 * totalPts);
@@ -1262,10 +1294,7 @@ void vtkFlyingEdges3DAlgorithm<T>::Contour(vtkFlyingEdges3D* self, vtkImageData*
     } // if anything generated
 
     // Handle multiple contours
-    startXPts = numOutXPts;
-    startYPts = numOutYPts;
-    startZPts = numOutZPts;
-    startTris = numOutTris;
+    start = total;
   } // for all contour values
 
   // Clean up and return
@@ -14,7 +14,9 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -26,6 +28,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,9 +36,331 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
+namespace
+{
+
+// Everything read and written by the threaded glyphing, except the output
+// points. The output is laid out glyph after glyph, so the points, cells and
+// connectivity of glyph k start at k times the corresponding source size.
+struct GlyphData
+{
+  // Parameters of the filter
+  vtkTypeBool Scaling;
+  int ScaleMode;
+  int ColorMode;
+  double ScaleFactor;
+  double Range[2];
+  double Den;
+  vtkTypeBool Clamping;
+  vtkTypeBool Orient;
+
+  // Input
+  vtkDataSet* Input;
+  std::vector<vtkIdType> GlyphIds; // input points to glyph, in order
+  vtkDataArray* ScaleScalars;
+  vtkDataArray* ColorScalars;
+  vtkDataArray* Vectors;
+
+  // Source, with its points already transformed by the SourceTransform
+  std::vector<double> SourcePoints;
+  std::vector<double> SourceNormals;
+  std::vector<double> SourceTCoords;
+  int NumberOfTCoordComponents;
+  std::vector<vtkIdType> SourceOffsets;
+  std::vector<vtkIdType> SourceConnectivity;
+  vtkIdType NumberOfSourcePoints;
+  vtkIdType NumberOfSourceCells;
+
+  // Output
+  vtkDataArray* NewScalars;
+  float* NewVectors;
+  float* NewNormals;
+  float* NewTCoords;
+  vtkIdType* PointIds;
+  vtkIdType* Offsets;
+  vtkIdType* Connectivity;
+  ArrayList PointArrays;
+  ArrayList CellArrays;
+};
+
+// Generate the glyphs of a range of glyph ids. The glyph transform is the
+// translation to the input point, then the orientation along the vector (a
+// rotation of 180 degrees around the bisector of the vector and the x axis),
+// then the scaling, applied here as a plain 3x3 matrix.
+template <typename TPoints>
+struct GlyphPoints
+{
+  GlyphData* Data;
+  TPoints* Points;
+
+  void operator()(vtkIdType glyphId, vtkIdType endGlyphId)
+  {
+    GlyphData& d = *this->Data;
+    const vtkIdType numSourcePts = d.NumberOfSourcePoints;
+    const vtkIdType numSourceCells = d.NumberOfSourceCells;
+    const vtkIdType connSize = static_cast<vtkIdType>(d.SourceConnectivity.size());
+    double x[3], v[3], scale[3], rotation[3][3], matrix[3][3];
+
+    for (; glyphId < endGlyphId; ++glyphId)
+    {
+      const vtkIdType inPtId = d.GlyphIds[glyphId];
+      const vtkIdType ptIncr = glyphId * numSourcePts;
+      const vtkIdType cellIncr = glyphId * numSourceCells;
+      double s = 0.0;
+      double vMag = 0.0;
+      scale[0] = scale[1] = scale[2] = 1.0;
+
+      // Get the scalar and vector data
+      if (d.ScaleScalars)
+      {
+        s = d.ScaleScalars->GetComponent(inPtId, 0);
+        if (d.ScaleMode == VTK_SCALE_BY_SCALAR || d.ScaleMode == VTK_DATA_SCALING_OFF)
+        {
+          scale[0] = scale[1] = scale[2] = s;
+        }
+      }
+      if (d.Vectors)
+      {
+        v[0] = v[1] = v[2] = 0.0;
+        d.Vectors->GetTuple(inPtId, v);
+        vMag = vtkMath::Norm(v);
+        if (d.ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
+        }
+        else if (d.ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = vMag;
+        }
+      }
+
+      // Clamp data scale if enabled
+      if (d.Clamping)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          scale[i] = (std::min(std::max(scale[i], d.Range[0]), d.Range[1]) - d.Range[0]) / d.Den;
+        }
+      }
+
+      // Copy the topology, offset to the points of this glyph
+      for (vtkIdType i = 0; i < numSourceCells; ++i)
+      {
+        d.Offsets[cellIncr + i] = glyphId * connSize + d.SourceOffsets[i];
+      }
+      vtkIdType* conn = d.Connectivity + glyphId * connSize;
+      for (vtkIdType i = 0; i < connSize; ++i)
+      {
+        conn[i] = d.SourceConnectivity[i] + ptIncr;
+      }
+
+      // Copy the vector, and orient the glyph along it
+      rotation[0][0] = rotation[1][1] = rotation[2][2] = 1.0;
+      rotation[0][1] = rotation[0][2] = rotation[1][0] = 0.0;
+      rotation[1][2] = rotation[2][0] = rotation[2][1] = 0.0;
+      if (d.Vectors)
+      {
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+        {
+          float* vOut = d.NewVectors + 3 * (ptIncr + i);
+          vOut[0] = static_cast<float>(v[0]);
+          vOut[1] = static_cast<float>(v[1]);
+          vOut[2] = static_cast<float>(v[2]);
+        }
+        if (d.Orient && vMag > 0.0)
+        {
+          if (v[1] == 0.0 && v[2] == 0.0)
+          {
+            if (v[0] < 0.0) // just flip x if we need to
+            {
+              rotation[0][0] = rotation[2][2] = -1.0;
+            }
+          }
+          else
+          {
+            double axis[3] = { (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0 };
+            vtkMath::Normalize(axis);
+            for (int i = 0; i < 3; ++i)
+            {
+              for (int j = 0; j < 3; ++j)
+              {
+                rotation[i][j] = 2.0 * axis[i] * axis[j] - (i == j ? 1.0 : 0.0);
+              }
+            }
+          }
+        }
+      }
+
+      for (vtkIdType i = 0; i < numSourcePts * d.NumberOfTCoordComponents; ++i)
+      {
+        d.NewTCoords[ptIncr * d.NumberOfTCoordComponents + i] =
+          static_cast<float>(d.SourceTCoords[i]);
+      }
+
+      // Copy the scalar value
+      if (d.NewScalars)
+      {
+        if (d.ColorMode == VTK_COLOR_BY_SCALAR)
+        {
+          for (vtkIdType i = 0; i < numSourcePts; ++i)
+          {
+            d.NewScalars->SetTuple(ptIncr + i, inPtId, d.ColorScalars);
+          }
+        }
+        else
+        {
+          float* newScalars = static_cast<vtkFloatArray*>(d.NewScalars)->GetPointer(ptIncr);
+          std::fill(newScalars, newScalars + numSourcePts,
+            static_cast<float>(d.ColorMode == VTK_COLOR_BY_SCALE ? scale[0] : vMag));
+        }
+      }
+
+      // Scale data if appropriate
+      if (d.Scaling)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          scale[i] =
+            (d.ScaleMode == VTK_DATA_SCALING_OFF ? d.ScaleFactor : scale[i] * d.ScaleFactor);
+          scale[i] = (scale[i] == 0.0 ? 1.0e-10 : scale[i]);
+        }
+      }
+      else
+      {
+        scale[0] = scale[1] = scale[2] = 1.0;
+      }
+
+      // Transform the points, and the normals by the inverse transpose
+      d.Input->GetPoint(inPtId, x);
+      for (int i = 0; i < 3; ++i)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          matrix[i][j] = rotation[i][j] * scale[j];
+        }
+      }
+      for (vtkIdType i = 0; i < numSourcePts; ++i)
+      {
+        const double* p = d.SourcePoints.data() + 3 * i;
+        TPoints* pOut = this->Points + 3 * (ptIncr + i);
+        for (int j = 0; j < 3; ++j)
+        {
+          pOut[j] = static_cast<TPoints>(
+            matrix[j][0] * p[0] + matrix[j][1] * p[1] + matrix[j][2] * p[2] + x[j]);
+        }
+      }
+      if (d.NewNormals)
+      {
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+        {
+          const double* n = d.SourceNormals.data() + 3 * i;
+          double n0 = n[0] / scale[0];
+          double n1 = n[1] / scale[1];
+          double n2 = n[2] / scale[2];
+          double nOut[3];
+          for (int j = 0; j < 3; ++j)
+          {
+            nOut[j] = rotation[j][0] * n0 + rotation[j][1] * n1 + rotation[j][2] * n2;
+          }
+          vtkMath::Normalize(nOut);
+          float* normal = d.NewNormals + 3 * (ptIncr + i);
+          normal[0] = static_cast<float>(nOut[0]);
+          normal[1] = static_cast<float>(nOut[1]);
+          normal[2] = static_cast<float>(nOut[2]);
+        }
+      }
+
+      // Copy point data from the input point
+      for (vtkIdType i = 0; i < numSourcePts; ++i)
+      {
+        d.PointArrays.Copy(inPtId, ptIncr + i);
+      }
+      for (vtkIdType i = 0; i < numSourceCells && !d.CellArrays.Arrays.empty(); ++i)
+      {
+        d.CellArrays.Copy(inPtId, cellIncr + i);
+      }
+      if (d.PointIds)
+      {
+        std::fill(d.PointIds + ptIncr, d.PointIds + ptIncr + numSourcePts, inPtId);
+      }
+    }
+  }
+};
+
+// Whether every output array, other than the skipped one, can be paired
+// with the input array of the same name by ArrayList::AddArrays().
+bool ArraysMatchByName(vtkDataSetAttributes* in, vtkDataSetAttributes* out, vtkDataArray* skip)
+{
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* outArray = out->GetArray(i);
+    if (outArray == skip)
+    {
+      continue;
+    }
+    vtkDataArray* inArray =
+      outArray && outArray->GetName() ? in->GetArray(outArray->GetName()) : nullptr;
+    if (!inArray || inArray->GetDataType() != outArray->GetDataType() ||
+      inArray->GetNumberOfComponents() != outArray->GetNumberOfComponents())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The cell array holding all the cells of the source, or nullptr if the
+// source mixes cells of different kinds.
+vtkCellArray* GetSourceCells(vtkPolyData* source)
+{
+  const vtkIdType numCells = source->GetNumberOfCells();
+  vtkCellArray* cellArrays[] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+    source->GetStrips() };
+  for (vtkCellArray* cells : cellArrays)
+  {
+    if (cells && cells->GetNumberOfCells() == numCells)
+    {
+      return cells;
+    }
+  }
+  return nullptr;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The threaded path handles a single source, whose cells are all stored in
+// one cell array so that the output cells keep their serial ids. In the
+// follow camera mode the serial path copies the vector of the previous glyph,
+// which is not reproduced. Point data is copied between arrays of the same
+// name, so it must be named.
+bool vtkGlyph3D::CanGlyphInParallel(vtkPolyData* source, vtkDataArray* inVectors,
+  vtkDataSet* input, vtkPolyData* output, vtkDataArray* pointIds)
+{
+  if (this->SequentialProcessing || this->IndexMode != VTK_INDEXING_OFF ||
+    this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION || !GetSourceCells(source) ||
+    (inVectors && inVectors->GetNumberOfComponents() > 3))
+  {
+    return false;
+  }
+  vtkDataArray* sourceTCoords = source->GetPointData()->GetTCoords();
+  if (sourceTCoords && sourceTCoords->GetNumberOfComponents() > 3)
+  {
+    return false;
+  }
+  return ArraysMatchByName(input->GetPointData(), output->GetPointData(), pointIds) &&
+    (!this->FillCellData ||
+      ArraysMatchByName(input->GetPointData(), output->GetCellData(), nullptr));
+}
+
 //------------------------------------------------------------------------------
 // Construct object with scaling on, scaling mode is by scalar value,
 // scale factor = 1.0, the range is (0,1), orient geometry is on, and
@@ -65,6 +390,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->FillCellData = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -401,12 +727,168 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   transformedSourcePts->SetDataTypeToDouble();
   transformedSourcePts->Allocate(numSourcePts);
 
+  // Glyph the points in parallel when possible: the points to glyph are
+  // selected first, which sets the size of the output, and the glyphs are
+  // then written directly into the output arrays. The serial traversal below
+  // is skipped in that case.
+  vtkDataArray* array3D = (this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors);
+  const bool threaded = this->CanGlyphInParallel(
+    source, haveVectors ? array3D : nullptr, input, output, pointIds);
+  if (threaded)
+  {
+    GlyphData data;
+    data.Scaling = this->Scaling;
+    data.ScaleMode = this->ScaleMode;
+    data.ColorMode = this->ColorMode;
+    data.ScaleFactor = this->ScaleFactor;
+    data.Range[0] = this->Range[0];
+    data.Range[1] = this->Range[1];
+    data.Den = den;
+    data.Clamping = this->Clamping;
+    data.Orient = this->Orient;
+
+    data.Input = input;
+    for (inPtId = 0; inPtId < numPts; inPtId++)
+    {
+      if ((inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT) ||
+        (inputUG && !inputUG->IsPointVisible(inPtId)) || !this->IsPointVisible(input, inPtId))
+      {
+        continue;
+      }
+      data.GlyphIds.push_back(inPtId);
+    }
+    const vtkIdType numGlyphs = static_cast<vtkIdType>(data.GlyphIds.size());
+    data.ScaleScalars = inSScalars;
+    data.ColorScalars = inCScalars;
+    data.Vectors = (haveVectors ? array3D : nullptr);
+    input->GetPoint(0, x); // GetPoint() is thread safe once called from a single thread
+
+    // Gather the source once
+    if (this->SourceTransform)
+    {
+      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
+      sourcePts = transformedSourcePts;
+    }
+    data.NumberOfSourcePoints = numSourcePts;
+    data.NumberOfSourceCells = numSourceCells;
+    data.SourcePoints.resize(3 * numSourcePts);
+    for (i = 0; i < numSourcePts; i++)
+    {
+      sourcePts->GetPoint(i, &data.SourcePoints[3 * i]);
+    }
+    if (haveNormals)
+    {
+      data.SourceNormals.resize(3 * numSourcePts);
+      for (i = 0; i < numSourcePts; i++)
+      {
+        sourceNormals->GetTuple(i, &data.SourceNormals[3 * i]);
+      }
+    }
+    data.NumberOfTCoordComponents = (haveTCoords ? sourceTCoords->GetNumberOfComponents() : 0);
+    data.SourceTCoords.resize(data.NumberOfTCoordComponents * numSourcePts);
+    for (i = 0; i < numSourcePts && haveTCoords; i++)
+    {
+      sourceTCoords->GetTuple(i, tc);
+      std::copy(tc, tc + data.NumberOfTCoordComponents,
+        data.SourceTCoords.begin() + data.NumberOfTCoordComponents * i);
+    }
+    vtkCellArray* sourceCells = GetSourceCells(source);
+    data.SourceOffsets.resize(numSourceCells);
+    for (cellId = 0; cellId < numSourceCells; cellId++)
+    {
+      sourceCells->GetCellAtId(cellId, pointIdList);
+      data.SourceOffsets[cellId] = static_cast<vtkIdType>(data.SourceConnectivity.size());
+      for (i = 0; i < pointIdList->GetNumberOfIds(); i++)
+      {
+        data.SourceConnectivity.push_back(pointIdList->GetId(i));
+      }
+    }
+    const vtkIdType connSize = static_cast<vtkIdType>(data.SourceConnectivity.size());
+
+    // Size the output
+    const vtkIdType numNewPts = numGlyphs * numSourcePts;
+    const vtkIdType numNewCells = numGlyphs * numSourceCells;
+    newPts->SetNumberOfPoints(numNewPts);
+    data.NewScalars = newScalars;
+    if (newScalars)
+    {
+      newScalars->SetNumberOfTuples(numNewPts);
+    }
+    data.NewVectors = nullptr;
+    if (newVectors)
+    {
+      newVectors->SetNumberOfTuples(numNewPts);
+      data.NewVectors = static_cast<vtkFloatArray*>(newVectors)->GetPointer(0);
+    }
+    data.NewNormals = nullptr;
+    if (newNormals)
+    {
+      newNormals->SetNumberOfTuples(numNewPts);
+      data.NewNormals = static_cast<vtkFloatArray*>(newNormals)->GetPointer(0);
+    }
+    data.NewTCoords = nullptr;
+    if (newTCoords)
+    {
+      newTCoords->SetNumberOfTuples(numNewPts);
+      data.NewTCoords = static_cast<vtkFloatArray*>(newTCoords)->GetPointer(0);
+    }
+    data.PointIds = nullptr;
+    if (pointIds)
+    {
+      pointIds->SetNumberOfValues(numNewPts);
+      data.PointIds = pointIds->GetPointer(0);
+      data.PointArrays.ExcludeArray(pointIds);
+    }
+    data.PointArrays.AddArrays(numNewPts, pd, outputPD, 0.0, false);
+    if (this->FillCellData)
+    {
+      data.CellArrays.AddArrays(numNewCells, pd, outputCD, 0.0, false);
+    }
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numNewCells + 1);
+    offsets->SetValue(numNewCells, numGlyphs * connSize);
+    data.Offsets = offsets->GetPointer(0);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(numGlyphs * connSize);
+    data.Connectivity = connectivity->GetPointer(0);
+
+    if (newPts->GetDataType() == VTK_FLOAT)
+    {
+      GlyphPoints<float> glyphPoints{ &data, static_cast<float*>(newPts->GetVoidPointer(0)) };
+      vtkSMPTools::For(0, numGlyphs, glyphPoints);
+    }
+    else
+    {
+      GlyphPoints<double> glyphPoints{ &data, static_cast<double*>(newPts->GetVoidPointer(0)) };
+      vtkSMPTools::For(0, numGlyphs, glyphPoints);
+    }
+
+    vtkNew<vtkCellArray> newCells;
+    newCells->SetData(offsets, connectivity);
+    if (sourceCells == source->GetVerts())
+    {
+      output->SetVerts(newCells);
+    }
+    else if (sourceCells == source->GetLines())
+    {
+      output->SetLines(newCells);
+    }
+    else if (sourceCells == source->GetPolys())
+    {
+      output->SetPolys(newCells);
+    }
+    else
+    {
+      output->SetStrips(newCells);
+    }
+  }
+
   // Traverse all Input points, transforming Source points and copying
   // point attributes.
   //
   ptIncr = 0;
   cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  for (inPtId = 0; !threaded && inPtId < numPts; inPtId++)
   {
     scalex = scaley = scalez = 1.0;
     if (!(inPtId % 10000))
@@ -902,6 +1384,7 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
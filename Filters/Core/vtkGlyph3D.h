@@ -73,6 +73,13 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * With a single source whose cells are all of one kind (vertices, lines,
+ * polygons or strips), the glyphs are generated in parallel, unless the
+ * glyphs follow the camera direction. The points to glyph are selected
+ * first, which sets the size of the output, and each glyph is then written
+ * directly into the output arrays, in the same order as in serial.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -330,6 +337,20 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when generating the
+   * glyphs. By default, sequential processing is off. Note this flag only
+   * applies if the class has been compiled with VTK_SMP_IMPLEMENTATION_TYPE
+   * set to something other than Sequential. (If set to Sequential, then the
+   * filter always runs in serial mode.) This flag is typically used for
+   * benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkGlyph3D();
   ~vtkGlyph3D() override;
@@ -351,6 +372,9 @@ protected:
     vtkDataArray* inSScalars, vtkDataArray* inVectors);
   //@}
 
+  bool CanGlyphInParallel(vtkPolyData* source, vtkDataArray* inVectors, vtkDataSet* input,
+    vtkPolyData* output, vtkDataArray* pointIds);
+
   vtkPolyData** Source; // Geometry to copy to each point
   vtkTypeBool Scaling;  // Determine whether scaling of geometry is performed
   int ScaleMode;        // Scale by scalar value or vector magnitude
@@ -369,6 +393,7 @@ protected:
   char* PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
+  vtkTypeBool SequentialProcessing;
 
 private:
   vtkGlyph3D(const vtkGlyph3D&) = delete;
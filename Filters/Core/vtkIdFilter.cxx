@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkIdFilter.h"
 
+#include "vtkAffineArray.h"
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkIdTypeArray.h"
@@ -24,6 +25,30 @@
 
 vtkStandardNewMacro(vtkIdFilter);
 
+namespace
+{
+// Create an array holding the ids 0 to numIds - 1, either stored or computed
+// on access.
+vtkDataArray* NewIdsArray(vtkIdType numIds, bool implicit)
+{
+  if (implicit)
+  {
+    vtkAffineArray<vtkIdType>* ids = vtkAffineArray<vtkIdType>::New();
+    ids->ConstructBackend(1, 0);
+    ids->SetNumberOfTuples(numIds);
+    return ids;
+  }
+
+  vtkIdTypeArray* ids = vtkIdTypeArray::New();
+  ids->SetNumberOfValues(numIds);
+  for (vtkIdType id = 0; id < numIds; id++)
+  {
+    ids->SetValue(id, id);
+  }
+  return ids;
+}
+}
+
 // Construct object with PointIds and CellIds on; and ids being generated
 // as scalars.
 vtkIdFilter::vtkIdFilter()
@@ -31,6 +56,7 @@ vtkIdFilter::vtkIdFilter()
   this->PointIds = 1;
   this->CellIds = 1;
   this->FieldData = 0;
+  this->ImplicitIds = 0;
   this->PointIdsArrayName = nullptr;
   this->CellIdsArrayName = nullptr;
 
@@ -59,9 +85,9 @@ int vtkIdFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDataSet* input = vtkDataSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkDataSet* output = vtkDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, id;
-  vtkIdTypeArray* ptIds;
-  vtkIdTypeArray* cellIds;
+  vtkIdType numPts, numCells;
+  vtkDataArray* ptIds;
+  vtkDataArray* cellIds;
   vtkPointData *inPD = input->GetPointData(), *outPD = output->GetPointData();
   vtkCellData *inCD = input->GetCellData(), *outCD = output->GetCellData();
 
@@ -79,14 +105,7 @@ int vtkIdFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   if (this->PointIds && numPts > 0)
   {
-    ptIds = vtkIdTypeArray::New();
-    ptIds->SetNumberOfValues(numPts);
-
-    for (id = 0; id < numPts; id++)
-    {
-      ptIds->SetValue(id, id);
-    }
-
+    ptIds = NewIdsArray(numPts, this->ImplicitIds != 0);
     ptIds->SetName(this->PointIdsArrayName);
     if (!this->FieldData)
     {
@@ -106,14 +125,7 @@ int vtkIdFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   if (this->CellIds && numCells > 0)
   {
-    cellIds = vtkIdTypeArray::New();
-    cellIds->SetNumberOfValues(numCells);
-
-    for (id = 0; id < numCells; id++)
-    {
-      cellIds->SetValue(id, id);
-    }
-
+    cellIds = NewIdsArray(numCells, this->ImplicitIds != 0);
     cellIds->SetName(this->CellIdsArrayName);
     if (!this->FieldData)
     {
@@ -142,6 +154,7 @@ void vtkIdFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Point Ids: " << (this->PointIds ? "On\n" : "Off\n");
   os << indent << "Cell Ids: " << (this->CellIds ? "On\n" : "Off\n");
   os << indent << "Field Data: " << (this->FieldData ? "On\n" : "Off\n");
+  os << indent << "Implicit Ids: " << (this->ImplicitIds ? "On\n" : "Off\n");
   os << indent
      << "PointIdsArrayName: " << (this->PointIdsArrayName ? this->PointIdsArrayName : "(none)")
      << "\n";
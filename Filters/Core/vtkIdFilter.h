@@ -75,6 +75,17 @@ public:
   vtkBooleanMacro(FieldData, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Set/Get the flag which controls whether the ids are stored in
+   * vtkIdTypeArray or computed on access by vtkAffineArray<vtkIdType>, which
+   * uses no memory whatever the number of points and cells. Default is off.
+   */
+  vtkSetMacro(ImplicitIds, vtkTypeBool);
+  vtkGetMacro(ImplicitIds, vtkTypeBool);
+  vtkBooleanMacro(ImplicitIds, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * @deprecated use SetPointIdsArrayName/GetPointIdsArrayName or
@@ -112,6 +123,7 @@ protected:
   vtkTypeBool PointIds;
   vtkTypeBool CellIds;
   vtkTypeBool FieldData;
+  vtkTypeBool ImplicitIds;
   char* PointIdsArrayName;
   char* CellIdsArrayName;
 
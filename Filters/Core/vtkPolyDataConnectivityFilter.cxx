@@ -17,6 +17,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityLabelingInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -28,6 +29,7 @@
 #include "vtkPolyData.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
 
@@ -42,6 +44,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->FullScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
   this->ScalarRange[1] = 1.0;
+  this->UnionFindLabeling = 0;
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
@@ -129,11 +132,15 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     }
   }
 
-  // Build cell structure
+  // Build cell structure. The threaded labeling builds its own static links.
   //
+  const bool unionFind = this->UnionFindLabeling && !this->InScalars;
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (!unionFind)
+  {
+    this->Mesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -184,7 +191,11 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (unionFind)
+  { // threaded labeling of all regions, then selection
+    this->LabelRegions(input, largestRegionId);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -439,6 +450,97 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   return 1;
 }
 
+// Label all regions with a threaded union-find over static cell links, then
+// keep the regions requested by the extraction mode. This produces the same
+// visited cells, region ids and region sizes as the wave traversal; points
+// are numbered in increasing input id order.
+void vtkPolyDataConnectivityFilter::LabelRegions(vtkPolyData* input, vtkIdType& largestRegionId)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  ConnectivityLinks links;
+  links.BuildLinks(input);
+  this->UpdateProgress(0.3);
+
+  std::vector<vtkIdType> regionSizes;
+  vtkIdType numRegions =
+    LabelConnectedRegions(links, numPts, numCells, this->Visited, regionSizes);
+  this->UpdateProgress(0.6);
+
+  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    vtkIdType maxCellsInRegion = 0;
+    this->RegionSizes->SetNumberOfValues(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+    {
+      if (regionSizes[regionId] > maxCellsInRegion)
+      {
+        maxCellsInRegion = regionSizes[regionId];
+        largestRegionId = regionId;
+      }
+      this->RegionSizes->SetValue(regionId, regionSizes[regionId]);
+    }
+    this->RegionNumber = numRegions;
+  }
+  else // regions have been seeded, everything considered in same region
+  {
+    std::vector<vtkIdType> seedCells;
+    vtkIdType i, pt;
+    if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    {
+      for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        pt = this->Seeds->GetId(i);
+        if (pt >= 0 && pt < numPts)
+        {
+          seedCells.insert(
+            seedCells.end(), links.GetCells(pt), links.GetCells(pt) + links.GetNcells(pt));
+        }
+      }
+    }
+    else if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      for (i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        vtkIdType cellId = this->Seeds->GetId(i);
+        if (cellId >= 0 && cellId < numCells)
+        {
+          seedCells.push_back(cellId);
+        }
+      }
+    }
+    else if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+    { // loop over points, find closest one
+      vtkPoints* inPts = input->GetPoints();
+      double minDist2, dist2, x[3];
+      vtkIdType minId = 0;
+      for (minDist2 = VTK_DOUBLE_MAX, i = 0; i < numPts; i++)
+      {
+        inPts->GetPoint(i, x);
+        dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
+        if (dist2 < minDist2)
+        {
+          minId = i;
+          minDist2 = dist2;
+        }
+      }
+      seedCells.insert(
+        seedCells.end(), links.GetCells(minId), links.GetCells(minId) + links.GetNcells(minId));
+    }
+
+    this->NumCellsInRegion =
+      SelectSeededRegions(numCells, numRegions, this->Visited, regionSizes, seedCells);
+    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+  }
+
+  this->PointNumber = MapRegionPoints(links, numPts, this->Visited, this->PointMap,
+    vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars)->GetPointer(0));
+  this->UpdateProgress(0.9);
+}
+
 // Mark current cell as visited and assign region number.  Note:
 // traversal occurs across shared vertices.
 //
@@ -615,6 +717,7 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Color Regions: " << (this->ColorRegions ? "On\n" : "Off\n");
 
   os << indent << "Scalar Connectivity: " << (this->ScalarConnectivity ? "On\n" : "Off\n");
+  os << indent << "Union Find Labeling: " << (this->UnionFindLabeling ? "On\n" : "Off\n");
 
   if (this->ScalarConnectivity)
   {
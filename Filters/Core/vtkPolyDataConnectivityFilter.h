@@ -117,6 +117,22 @@ public:
   vtkGetVector2Macro(ScalarRange, double);
   //@}
 
+  //@{
+  /**
+   * Turn on/off threaded labeling of the connected regions. If on, regions
+   * are labeled with a concurrent union-find over the point to cell links
+   * (see vtkStaticCellLinks) rather than with the serial wave traversal.
+   * Region ids, region sizes and the extracted cells are identical for every
+   * extraction mode; only the output points are numbered differently (in
+   * increasing input point id order instead of traversal order). Scalar
+   * connectivity depends on the traversal order, so the wave traversal is
+   * always used when ScalarConnectivity is on. By default this is off.
+   */
+  vtkSetMacro(UnionFindLabeling, vtkTypeBool);
+  vtkGetMacro(UnionFindLabeling, vtkTypeBool);
+  vtkBooleanMacro(UnionFindLabeling, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Control the extraction of connected surfaces.
@@ -250,7 +266,10 @@ protected:
 
   double ScalarRange[2];
 
+  vtkTypeBool UnionFindLabeling;
+
   void TraverseAndMark();
+  void LabelRegions(vtkPolyData* input, vtkIdType& largestRegionId);
 
   // used to support algorithm execution
   vtkDataArray* CellScalars;
@@ -14,7 +14,9 @@
 =========================================================================*/
 #include "vtkPolyDataNormals.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -27,12 +29,547 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangleStrip.h"
 
 #include "vtkNew.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+namespace
+{ // anonymous
+
+//------------------------------------------------------------------------------
+// The threaded path works on static cell links, with the cells using a point
+// sorted by id so that they are visited in the same order as with the
+// vtkCellLinks of the serial path.
+using PolyLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+void BuildSortedLinks(PolyLinks& links, vtkIdType numPts, vtkCellArray* polys)
+{
+  links.ThreadedBuildLinks(numPts, polys->GetNumberOfCells(), polys);
+  vtkSMPTools::For(0, numPts, [&links](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = links.GetCells(ptId);
+      std::sort(cells, cells + links.GetNcells(ptId));
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Thread safe equivalent of vtkPolyData::GetCellEdgeNeighbors(). Returns the
+// cell (other than cellId) using both p1 and p2, -1 if there is none, and -2
+// if there are several (non-manifold edge).
+vtkIdType GetEdgeNeighbor(PolyLinks& links, vtkIdType cellId, vtkIdType p1, vtkIdType p2)
+{
+  const vtkIdType* cells1 = links.GetCells(p1);
+  const vtkIdType* cells1End = cells1 + links.GetNcells(p1);
+  const vtkIdType* cells2 = links.GetCells(p2);
+  const vtkIdType* cells2End = cells2 + links.GetNcells(p2);
+
+  vtkIdType neighbor = -1;
+  for (; cells1 != cells1End; ++cells1)
+  {
+    if (*cells1 != cellId && std::binary_search(cells2, cells2End, *cells1))
+    {
+      if (neighbor >= 0)
+      {
+        return -2;
+      }
+      neighbor = *cells1;
+    }
+  }
+  return neighbor;
+}
+
+//------------------------------------------------------------------------------
+// Build the edge neighbor table: for the edge (pts[j],pts[j+1]) of each
+// polygon, the polygon on the other side of the edge (see GetEdgeNeighbor()).
+// The table is laid out like the polygon connectivity. Polygons using a
+// point more than once are flagged: the threaded path does not handle them.
+struct BuildEdgeTable
+{
+  vtkCellArray* Polys;
+  PolyLinks* Links;
+  vtkIdType* Offsets;
+  vtkIdType* Neighbors;
+  bool RepeatedPoints;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocal<unsigned char> Repeated;
+
+  BuildEdgeTable(vtkCellArray* polys, PolyLinks* links, vtkIdType* offsets, vtkIdType* neighbors)
+    : Polys(polys)
+    , Links(links)
+    , Offsets(offsets)
+    , Neighbors(neighbors)
+    , RepeatedPoints(false)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Iterator.Local().TakeReference(this->Polys->NewIterator());
+    this->Repeated.Local() = 0;
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    unsigned char& repeated = this->Repeated.Local();
+    vtkIdType offset =
+      static_cast<vtkIdType>(this->Polys->GetOffsetsArray()->GetComponent(cellId, 0));
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      this->Offsets[cellId] = offset;
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        vtkIdType j1 = (j + 1 < npts ? j + 1 : 0);
+        this->Neighbors[offset + j] = GetEdgeNeighbor(*this->Links, cellId, pts[j], pts[j1]);
+        for (vtkIdType k = 0; k < j; ++k)
+        {
+          repeated |= (pts[k] == pts[j] ? 1 : 0);
+        }
+      }
+      offset += npts;
+    }
+  }
+
+  void Reduce()
+  {
+    for (auto repeated : this->Repeated)
+    {
+      this->RepeatedPoints |= (repeated != 0);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Check whether the polygons are already consistently ordered, i.e. whether
+// the traversal of the serial path would not reorder any of them. Edges used
+// by more than two polygons are only traversed if NonManifoldTraversal is
+// on; in that case the outcome depends on the order of the traversal, and
+// the mesh is reported as not consistent.
+struct CheckConsistency
+{
+  vtkCellArray* Polys;
+  const vtkIdType* Offsets;
+  const vtkIdType* Neighbors;
+  bool NonManifoldTraversal;
+  bool Consistent;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> NeighborIterator;
+  vtkSMPThreadLocal<unsigned char> Inconsistent;
+
+  CheckConsistency(vtkCellArray* polys, const vtkIdType* offsets, const vtkIdType* neighbors,
+    bool nonManifoldTraversal)
+    : Polys(polys)
+    , Offsets(offsets)
+    , Neighbors(neighbors)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , Consistent(true)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Iterator.Local().TakeReference(this->Polys->NewIterator());
+    this->NeighborIterator.Local().TakeReference(this->Polys->NewIterator());
+    this->Inconsistent.Local() = 0;
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkCellArrayIterator* neiIter = this->NeighborIterator.Local();
+    unsigned char& inconsistent = this->Inconsistent.Local();
+    vtkIdType npts, numNeiPts;
+    const vtkIdType *pts, *neiPts;
+
+    for (; cellId < endCellId && !inconsistent; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      const vtkIdType* neighbors = this->Neighbors + this->Offsets[cellId];
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        if (neighbors[j] == -2 && this->NonManifoldTraversal)
+        {
+          inconsistent = 1;
+          break;
+        }
+        if (neighbors[j] < 0)
+        {
+          continue;
+        }
+        // The neighbor should go n2->n1 if we go n1->n2
+        vtkIdType j1 = (j + 1 < npts ? j + 1 : 0);
+        neiIter->GetCellAtId(neighbors[j], numNeiPts, neiPts);
+        vtkIdType l;
+        for (l = 0; l < numNeiPts; l++)
+        {
+          if (neiPts[l] == pts[j1])
+          {
+            break;
+          }
+        }
+        if (neiPts[(l + 1) % numNeiPts] != pts[j])
+        {
+          inconsistent = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (auto inconsistent : this->Inconsistent)
+    {
+      this->Consistent &= (inconsistent == 0);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Compute the polygon normals.
+struct ComputePolyNormals
+{
+  vtkCellArray* Polys;
+  vtkPoints* Points;
+  float* Normals;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  ComputePolyNormals(vtkCellArray* polys, vtkPoints* points, float* normals)
+    : Polys(polys)
+    , Points(points)
+    , Normals(normals)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double n[3];
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float* normal = this->Normals + 3 * cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Threaded version of vtkPolyDataNormals::MarkAndSplit(). For each point,
+// label the polygons using the point with the region (set of polygons
+// connected across edges that are not feature edges) they belong to. The
+// labels are stored alongside the cell links. All the polygons not in the
+// first region are later given a duplicate of the point.
+struct MarkRegions
+{
+  vtkCellArray* Polys;
+  PolyLinks* Links;
+  const vtkIdType* Offsets;
+  const vtkIdType* Neighbors;
+  vtkFloatArray* PolyNormals;
+  double CosAngle;
+  int* Regions;
+  vtkIdType* NumSplits;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  MarkRegions(vtkCellArray* polys, PolyLinks* links, const vtkIdType* offsets,
+    const vtkIdType* neighbors, vtkFloatArray* polyNormals, double cosAngle, int* regions,
+    vtkIdType* numSplits)
+    : Polys(polys)
+    , Links(links)
+    , Offsets(offsets)
+    , Neighbors(neighbors)
+    , PolyNormals(polyNormals)
+    , CosAngle(cosAngle)
+    , Regions(regions)
+    , NumSplits(numSplits)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  // Edge neighbor of cellId (with points pts) across the edge (p1,p2)
+  vtkIdType GetNeighbor(
+    vtkIdType cellId, vtkIdType npts, const vtkIdType* pts, vtkIdType p1, vtkIdType p2)
+  {
+    for (vtkIdType j = 0; j < npts; ++j)
+    {
+      vtkIdType j1 = (j + 1 < npts ? j + 1 : 0);
+      if ((pts[j] == p1 && pts[j1] == p2) || (pts[j] == p2 && pts[j1] == p1))
+      {
+        return this->Neighbors[this->Offsets[cellId] + j];
+      }
+    }
+    return -1;
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    const vtkIdType* allCells = this->Links->GetCells(0);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      int* visited = this->Regions + (cells - allCells);
+      this->NumSplits[ptId] = 0;
+      std::fill_n(visited, ncells, (ncells <= 1 ? 0 : -1));
+      if (ncells <= 1)
+      {
+        continue; // point does not need to be further disconnected
+      }
+
+      vtkIdType numPts;
+      const vtkIdType* pts;
+      int numRegions = 0;
+      vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+      double thisNormal[3], neiNormal[3];
+      for (vtkIdType j = 0; j < ncells; j++) // for all cells connected to point
+      {
+        if (visited[j] >= 0)
+        {
+          continue;
+        }
+        visited[j] = numRegions;
+        iter->GetCellAtId(cells[j], numPts, pts);
+
+        // find the two edges
+        for (spot = 0; spot < numPts; spot++)
+        {
+          if (pts[spot] == ptId)
+          {
+            break;
+          }
+        }
+        if (spot == 0)
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[numPts - 1];
+        }
+        else if (spot == (numPts - 1))
+        {
+          neiPt[0] = pts[spot - 1];
+          neiPt[1] = pts[0];
+        }
+        else
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[spot - 1];
+        }
+
+        for (int i = 0; i < 2; i++) // for each of the two edges of the seed cell
+        {
+          cellId = cells[j];
+          nei = neiPt[i];
+          iter->GetCellAtId(cellId, numPts, pts);
+          while (cellId >= 0) // while we can grow this region
+          {
+            neiCellId = this->GetNeighbor(cellId, numPts, pts, ptId, nei);
+            vtkIdType k = ncells;
+            if (neiCellId >= 0)
+            {
+              k = std::lower_bound(cells, cells + ncells, neiCellId) - cells;
+            }
+            if (k < ncells && visited[k] < 0)
+            {
+              this->PolyNormals->GetTuple(cellId, thisNormal);
+              this->PolyNormals->GetTuple(neiCellId, neiNormal);
+              if (vtkMath::Dot(thisNormal, neiNormal) > this->CosAngle)
+              {
+                // visit and arrange to visit next edge neighbor
+                visited[k] = numRegions;
+                cellId = neiCellId;
+                iter->GetCellAtId(cellId, numPts, pts);
+
+                for (spot = 0; spot < numPts; spot++)
+                {
+                  if (pts[spot] == ptId)
+                  {
+                    break;
+                  }
+                }
+                if (spot == 0)
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+                }
+                else if (spot == (numPts - 1))
+                {
+                  nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+                }
+                else
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+                }
+              }
+              else
+              {
+                cellId = -1; // separated by edge angle
+              }
+            }
+            else
+            {
+              cellId = -1; // separated by previous visit, boundary, or non-manifold
+            }
+          }
+        }
+        numRegions++;
+      }
+
+      this->NumSplits[ptId] = numRegions - 1;
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Replace the points of the polygons not in the first region around them by
+// their duplicates.
+struct SplitPolys
+{
+  vtkCellArray* Polys;
+  PolyLinks* Links;
+  const int* Regions;
+  const vtkIdType* FirstNewId;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> CellPoints;
+
+  SplitPolys(vtkCellArray* polys, PolyLinks* links, const int* regions, const vtkIdType* firstNewId)
+    : Polys(polys)
+    , Links(links)
+    , Regions(regions)
+    , FirstNewId(firstNewId)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    std::vector<vtkIdType>& cellPts = this->CellPoints.Local();
+    const vtkIdType* allCells = this->Links->GetCells(0);
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      cellPts.assign(pts, pts + npts);
+      bool split = false;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        vtkIdType ptId = cellPts[i];
+        const vtkIdType* cells = this->Links->GetCells(ptId);
+        const vtkIdType* cell =
+          std::lower_bound(cells, cells + this->Links->GetNcells(ptId), cellId);
+        int region = this->Regions[cell - allCells];
+        if (region > 0)
+        {
+          cellPts[i] = this->FirstNewId[ptId] + region - 1;
+          split = true;
+        }
+      }
+      if (split)
+      {
+        this->Polys->ReplaceCellAtId(cellId, npts, cellPts.data());
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Copy the points, and their data, duplicated by the split points.
+struct CopySplitPoints
+{
+  const vtkIdType* PointMap;
+  vtkPoints* InPts;
+  vtkPoints* OutPts;
+  ArrayList* Arrays;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType oldId = this->PointMap[ptId];
+      this->InPts->GetPoint(oldId, x);
+      this->OutPts->SetPoint(ptId, x);
+      if (this->Arrays)
+      {
+        this->Arrays->Copy(oldId, ptId);
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Average the normals of the polygons using each point. The polygons are
+// visited in increasing order of id, and the sums are done in single
+// precision, like in the serial path, so that both give the same normals.
+struct AveragePointNormals
+{
+  PolyLinks* Links;
+  const float* PolyNormals;
+  float* Normals;
+  double FlipDirection;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      float* n = this->Normals + 3 * ptId;
+      n[0] = n[1] = n[2] = 0.0f;
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        const float* polyNormal = this->PolyNormals + 3 * cells[i];
+        n[0] += polyNormal[0];
+        n[1] += polyNormal[1];
+        n[2] += polyNormal[2];
+      }
+      const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * this->FlipDirection;
+      if (length != 0.0)
+      {
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -45,6 +582,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   this->ComputeCellNormals = 0;
   this->NonManifoldTraversal = 1;
   this->AutoOrientNormals = 0;
+  this->SequentialProcessing = false;
   // some internal data
   this->NumFlips = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
@@ -175,7 +713,43 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
   }
-  this->OldMesh->BuildLinks();
+
+  // The threaded path works on static links and on an edge neighbor table,
+  // both built in parallel. It does not handle the automatic orientation of
+  // normals, nor polygons using a point more than once.
+  bool threaded = !this->SequentialProcessing && !this->AutoOrientNormals;
+  PolyLinks links;
+  std::vector<vtkIdType> cellOffsets;
+  std::vector<vtkIdType> edgeNeighbors;
+  if (threaded)
+  {
+    BuildSortedLinks(links, numPts, polys);
+    if (this->Consistency || this->Splitting)
+    {
+      cellOffsets.resize(numPolys + 1);
+      cellOffsets[numPolys] = polys->GetNumberOfConnectivityIds();
+      edgeNeighbors.resize(polys->GetNumberOfConnectivityIds());
+      BuildEdgeTable buildTable(polys, &links, cellOffsets.data(), edgeNeighbors.data());
+      vtkSMPTools::For(0, numPolys, buildTable);
+      threaded = !buildTable.RepeatedPoints;
+    }
+  }
+
+  // Polygons produced by contouring are usually consistently ordered
+  // already, in which case the traversal below is skipped.
+  bool consistent = false;
+  if (threaded && this->Consistency)
+  {
+    CheckConsistency check(
+      polys, cellOffsets.data(), edgeNeighbors.data(), this->NonManifoldTraversal != 0);
+    vtkSMPTools::For(0, numPolys, check);
+    consistent = check.Consistent;
+  }
+  bool traverse = this->AutoOrientNormals || (this->Consistency && !consistent);
+  if (!threaded || traverse)
+  {
+    this->OldMesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
@@ -191,7 +765,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   // The visited array keeps track of which polygons have been visited.
   //
-  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
+  if (traverse || (this->Splitting && !threaded))
   {
     this->Visited = new int[numPolys];
     memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys * sizeof(int));
@@ -310,6 +884,22 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     leftmostPoints->Delete();
     vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
   } // automatically orient normals
+  else if (consistent)
+  {
+    // The traversal would reverse all the polygons if the normals are
+    // flipped, and none otherwise.
+    if (this->FlipNormals)
+    {
+      vtkSMPTools::For(0, numPolys, [newPolys](vtkIdType cellId, vtkIdType endCellId) {
+        for (; cellId < endCellId; ++cellId)
+        {
+          newPolys->ReverseCellAtId(cellId);
+        }
+      });
+      this->NumFlips = numPolys;
+    }
+    vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
+  } // already consistent ordering
   else
   {
     if (this->Consistency)
@@ -362,18 +952,27 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->PolyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
+  if (threaded)
   {
-    if ((cellId % 1000) == 0)
+    ComputePolyNormals computeNormals(
+      newPolys, inPts, this->PolyNormals->GetPointer(3 * offsetCells));
+    vtkSMPTools::For(0, numPolys, computeNormals);
+  }
+  else
+  {
+    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
     {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
+      if ((cellId % 1000) == 0)
       {
-        break;
+        this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
+        if (this->GetAbortExecute())
+        {
+          break;
+        }
       }
+      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
+      this->PolyNormals->SetTuple(offsetCells + cellId, n);
     }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
   }
 
   // Split mesh if sharp features
@@ -387,19 +986,58 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     //  Splitting will create new points.  We have to create index array
     // to map new points into old points.
     //
-    this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (vtkIdType i = 0; i < numPts; i++)
+    std::vector<vtkIdType> pointMap;
+    if (threaded)
     {
-      this->Map->SetId(i, i);
-    }
+      // Label the regions around each point, then number the duplicated
+      // points in the same order as the serial path: after the input
+      // points, in increasing order of the point they duplicate.
+      std::vector<int> regions(polys->GetNumberOfConnectivityIds());
+      std::vector<vtkIdType> firstNewId(numPts);
+      MarkRegions mark(polys, &links, cellOffsets.data(), edgeNeighbors.data(), this->PolyNormals,
+        this->CosAngle, regions.data(), firstNewId.data());
+      vtkSMPTools::For(0, numPts, mark);
+
+      numNewPts = numPts;
+      for (ptId = 0; ptId < numPts; ptId++)
+      {
+        vtkIdType numSplits = firstNewId[ptId];
+        firstNewId[ptId] = numNewPts;
+        numNewPts += numSplits;
+      }
 
-    for (ptId = 0; ptId < numPts; ptId++)
+      SplitPolys split(newPolys, &links, regions.data(), firstNewId.data());
+      vtkSMPTools::For(0, numPolys, split);
+
+      pointMap.resize(numNewPts);
+      vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+        for (; id < endId; ++id)
+        {
+          pointMap[id] = id;
+          vtkIdType endNewId = (id + 1 < numPts ? firstNewId[id + 1] : numNewPts);
+          for (vtkIdType newId = firstNewId[id]; newId < endNewId; ++newId)
+          {
+            pointMap[newId] = id;
+          }
+        }
+      });
+    }
+    else
     {
-      this->MarkAndSplit(ptId);
-    } // for all input points
+      this->Map = vtkIdList::New();
+      this->Map->SetNumberOfIds(numPts);
+      for (vtkIdType i = 0; i < numPts; i++)
+      {
+        this->Map->SetId(i, i);
+      }
 
-    numNewPts = this->Map->GetNumberOfIds();
+      for (ptId = 0; ptId < numPts; ptId++)
+      {
+        this->MarkAndSplit(ptId);
+      } // for all input points
+
+      numNewPts = this->Map->GetNumberOfIds();
+    }
 
     vtkDebugMacro(<< "Created " << numNewPts - numPts << " new points");
 
@@ -433,13 +1071,40 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId = 0; ptId < numNewPts; ptId++)
+    if (threaded)
+    {
+      // Arrays that are not data arrays cannot be copied in parallel
+      bool dataArraysOnly = true;
+      for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+      {
+        dataArraysOnly &= (outPD->GetArray(i) != nullptr);
+      }
+      ArrayList arrays;
+      if (dataArraysOnly)
+      {
+        arrays.AddArrays(numNewPts, pd, outPD);
+      }
+      CopySplitPoints copyPoints{ pointMap.data(), inPts, newPts,
+        (dataArraysOnly ? &arrays : nullptr) };
+      vtkSMPTools::For(0, numNewPts, copyPoints);
+      if (!dataArraysOnly)
+      {
+        for (ptId = 0; ptId < numNewPts; ptId++)
+        {
+          outPD->CopyData(pd, pointMap[ptId], ptId);
+        }
+      }
+    }
+    else
     {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId, inPts->GetPoint(oldId));
-      outPD->CopyData(pd, oldId, ptId);
+      for (ptId = 0; ptId < numNewPts; ptId++)
+      {
+        oldId = this->Map->GetId(ptId);
+        newPts->SetPoint(ptId, inPts->GetPoint(oldId));
+        outPD->CopyData(pd, oldId, ptId);
+      }
+      this->Map->Delete();
     }
-    this->Map->Delete();
   } // splitting
 
   else // no splitting, so no new points
@@ -449,9 +1114,10 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     outPD->PassData(pd);
   }
 
-  if (this->Consistency || this->Splitting)
+  if (this->Visited)
   {
     delete[] this->Visited;
+    this->Visited = nullptr;
     this->CellIds->Delete();
     this->CellIds = nullptr;
     this->CellPoints->Delete();
@@ -479,7 +1145,21 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
 
-  if (this->ComputePointNormals)
+  if (this->ComputePointNormals && threaded)
+  {
+    // Gather the polygon normals at the points, using the links of the
+    // split mesh if new points were created.
+    PolyLinks splitLinks;
+    PolyLinks* pointLinks = &links;
+    if (numNewPts != numPts)
+    {
+      BuildSortedLinks(splitLinks, numNewPts, newPolys);
+      pointLinks = &splitLinks;
+    }
+    AveragePointNormals average{ pointLinks, fPolyNormals, fNormals, flipDirection };
+    vtkSMPTools::For(0, numNewPts, average);
+  }
+  else if (this->ComputePointNormals)
   {
     for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
     {
@@ -787,4 +1467,5 @@ void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Cell Normals: " << (this->ComputeCellNormals ? "On\n" : "Off\n");
   os << indent << "Non-manifold Traversal: " << (this->NonManifoldTraversal ? "On\n" : "Off\n");
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
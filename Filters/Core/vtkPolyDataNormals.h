@@ -39,6 +39,15 @@
  * are split and new points generated to prevent blurry edges (due to
  * Gouraud shading).
  *
+ * The filter is threaded with vtkSMPTools (see SequentialProcessing). Edge
+ * neighbors are found with a table built in parallel from static cell
+ * links. When the polygons are found to be consistently ordered already (as
+ * is the case for the output of contouring filters), the serial traversal
+ * enforcing consistency is skipped. Polygon normals, splitting of sharp
+ * edges and point normals are computed in parallel. The output is the same
+ * as in sequential mode. Automatic orientation of the normals, and meshes
+ * with polygons using a point more than once, are processed serially.
+ *
  * @warning
  * Normals are computed only for polygons and triangle strips. Normals are
  * not computed for lines or vertices.
@@ -173,6 +182,20 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) of the normal
+   * computation. By default, sequential processing is off. Note this flag only
+   * applies if the class has been compiled with VTK_SMP_IMPLEMENTATION_TYPE
+   * set to something other than Sequential. (If set to Sequential, then the
+   * filter always runs in serial mode.) This flag is typically used for
+   * benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkPolyDataNormals();
   ~vtkPolyDataNormals() override = default;
@@ -190,6 +213,7 @@ protected:
   vtkTypeBool ComputeCellNormals;
   int NumFlips;
   int OutputPointsPrecision;
+  vtkTypeBool SequentialProcessing;
 
 private:
   vtkIdList* Wave;
@@ -14,18 +14,31 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -48,6 +61,7 @@ vtkThreshold::vtkThreshold()
 
   this->UseContinuousCellRange = 0;
   this->Invert = false;
+  this->SequentialProcessing = false;
 }
 
 vtkThreshold::~vtkThreshold() = default;
@@ -152,7 +166,6 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   outCD->CopyAllocate(cd);
 
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
 
   newPoints = vtkPoints::New();
 
@@ -178,6 +191,20 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     newPoints->SetDataType(VTK_DOUBLE);
   }
 
+  // are we using pointScalars?
+  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
+  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+
+  if (this->CanThresholdInParallel(input, outPD, outCD))
+  {
+    this->ThresholdInParallel(input, inScalars, usePointScalars, newPoints, output);
+    vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
+    output->SetPoints(newPoints);
+    newPoints->Delete();
+    return 1;
+  }
+
+  output->Allocate(input->GetNumberOfCells());
   newPoints->Allocate(numPts);
 
   pointMap = vtkIdList::New(); // maps old point ids into new
@@ -189,52 +216,13 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
 
   newCellPts = vtkIdList::New();
 
-  // are we using pointScalars?
-  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
-  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
-
   // Check that the scalars of each cell satisfy the threshold criterion
   for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
   {
     cell = input->GetCell(cellId);
     cellPts = cell->GetPointIds();
     numCellPts = cell->GetNumberOfPoints();
-
-    if (usePointScalars)
-    {
-      if (this->AllScalars)
-      {
-        keepCell = 1;
-        for (i = 0; keepCell && (i < numCellPts); i++)
-        {
-          ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents(inScalars, ptId);
-        }
-      }
-      else
-      {
-        if (!this->UseContinuousCellRange)
-        {
-          keepCell = 0;
-          for (i = 0; (!keepCell) && (i < numCellPts); i++)
-          {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents(inScalars, ptId);
-          }
-        }
-        else
-        {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
-        }
-      }
-    }
-    else // use cell scalars
-    {
-      keepCell = this->EvaluateComponents(inScalars, cellId);
-    }
-
-    // Invert the keep flag if the Invert option is enabled.
-    keepCell = this->Invert ? (1 - keepCell) : keepCell;
+    keepCell = this->EvaluateKeepCell(inScalars, usePointScalars, cellId, cellPts);
 
     if (numCellPts > 0 && keepCell)
     {
@@ -278,6 +266,313 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkThreshold::EvaluateKeepCell(
+  vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId, vtkIdList* cellPts)
+{
+  int numCellPts = static_cast<int>(cellPts->GetNumberOfIds());
+  int keepCell;
+
+  if (usePointScalars)
+  {
+    if (this->AllScalars)
+    {
+      keepCell = 1;
+      for (int i = 0; keepCell && (i < numCellPts); i++)
+      {
+        keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+      }
+    }
+    else
+    {
+      if (!this->UseContinuousCellRange)
+      {
+        keepCell = 0;
+        for (int i = 0; (!keepCell) && (i < numCellPts); i++)
+        {
+          keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+        }
+      }
+      else
+      {
+        keepCell = this->EvaluateCell(scalars, cellPts, numCellPts);
+      }
+    }
+  }
+  else // use cell scalars
+  {
+    keepCell = this->EvaluateComponents(scalars, cellId);
+  }
+
+  // Invert the keep flag if the Invert option is enabled.
+  return this->Invert ? (1 - keepCell) : keepCell;
+}
+
+namespace
+{
+
+// Cells, and the connectivity of the kept cells, are processed in blocks of
+// this size. Each block is counted, then filled at the offset given by the
+// scan of the counts, so the output does not depend on the scheduling.
+const vtkIdType ThresholdBlockSize = 4096;
+
+// Whether each output array was allocated by CopyAllocate() from the input
+// array with the same index, and can be accessed through a raw pointer.
+bool ArraysMatchByIndex(vtkDataSetAttributes* in, vtkDataSetAttributes* out)
+{
+  if (in->GetNumberOfArrays() != out->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* inArray = in->GetArray(i);
+    vtkDataArray* outArray = out->GetArray(i);
+    if (!inArray || !outArray || inArray->GetDataType() != outArray->GetDataType() ||
+      inArray->GetNumberOfComponents() != outArray->GetNumberOfComponents() ||
+      !inArray->HasStandardMemoryLayout() || !outArray->HasStandardMemoryLayout())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Pair the arrays of the input and output attribute data by index, since
+// they may not be named.
+void AddArrayPairs(
+  ArrayList& list, vtkIdType numOut, vtkDataSetAttributes* in, vtkDataSetAttributes* out)
+{
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* inArray = in->GetArray(i);
+    vtkDataArray* outArray = out->GetArray(i);
+    outArray->SetNumberOfTuples(numOut);
+    void* inData = inArray->GetVoidPointer(0);
+    void* outData = outArray->GetVoidPointer(0);
+    switch (outArray->GetDataType())
+    {
+      vtkTemplateMacro(CreateArrayPair(&list, static_cast<VTK_TT*>(inData),
+        static_cast<VTK_TT*>(outData), numOut, outArray->GetNumberOfComponents(), outArray,
+        static_cast<VTK_TT>(0)));
+    }
+  }
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The threaded path relies on GetCellType(), GetCellPoints(vtkIdList*) and
+// GetPoint() being thread safe on the input, which rules out polydata, and
+// copies attribute values directly between arrays. Polyhedra are left to the
+// serial path since their face streams have to be renumbered.
+bool vtkThreshold::CanThresholdInParallel(
+  vtkDataSet* input, vtkPointData* outPD, vtkCellData* outCD)
+{
+  if (this->SequentialProcessing)
+  {
+    return false;
+  }
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid)
+  {
+    if (grid->GetFaces())
+    {
+      return false;
+    }
+  }
+  else if (!vtkImageData::SafeDownCast(input) && !vtkRectilinearGrid::SafeDownCast(input) &&
+    !vtkStructuredGrid::SafeDownCast(input))
+  {
+    return false;
+  }
+  return ArraysMatchByIndex(input->GetPointData(), outPD) &&
+    ArraysMatchByIndex(input->GetCellData(), outCD);
+}
+
+//------------------------------------------------------------------------------
+void vtkThreshold::ThresholdInParallel(vtkDataSet* input, vtkDataArray* inScalars,
+  bool usePointScalars, vtkPoints* newPoints, vtkUnstructuredGrid* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numBlocks = (numCells + ThresholdBlockSize - 1) / ThresholdBlockSize;
+
+  // The topological queries are thread safe once first called from a single
+  // thread.
+  if (numCells > 0)
+  {
+    vtkNew<vtkIdList> pts;
+    input->GetCellType(0);
+    input->GetCellPoints(0, pts);
+  }
+  if (numPts > 0)
+  {
+    double x[3];
+    input->GetPoint(0, x);
+  }
+
+  // Test the cells, and count the kept cells and their connectivity size per
+  // block.
+  std::vector<unsigned char> keep(numCells);
+  std::vector<vtkIdType> cellOffsets(numBlocks + 1, 0);
+  std::vector<vtkIdType> connOffsets(numBlocks + 1, 0);
+  vtkSMPThreadLocalObject<vtkIdList> localPts;
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    vtkIdList* pts = localPts.Local();
+    for (; blockId < endBlockId; ++blockId)
+    {
+      vtkIdType endCellId = std::min(numCells, (blockId + 1) * ThresholdBlockSize);
+      vtkIdType numKept = 0;
+      vtkIdType connSize = 0;
+      for (vtkIdType cellId = blockId * ThresholdBlockSize; cellId < endCellId; ++cellId)
+      {
+        keep[cellId] = 0;
+        if (input->GetCellType(cellId) != VTK_EMPTY_CELL)
+        {
+          input->GetCellPoints(cellId, pts);
+          keep[cellId] = pts->GetNumberOfIds() > 0 &&
+            this->EvaluateKeepCell(inScalars, usePointScalars, cellId, pts);
+        }
+        if (keep[cellId])
+        {
+          ++numKept;
+          connSize += pts->GetNumberOfIds();
+        }
+      }
+      cellOffsets[blockId + 1] = numKept;
+      connOffsets[blockId + 1] = connSize;
+    }
+  });
+  for (vtkIdType blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    cellOffsets[blockId + 1] += cellOffsets[blockId];
+    connOffsets[blockId + 1] += connOffsets[blockId];
+  }
+  const vtkIdType numNewCells = cellOffsets[numBlocks];
+  const vtkIdType connSize = connOffsets[numBlocks];
+
+  // Gather the kept cells, still referring to the input points, and their
+  // data.
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numNewCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewCells + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(connSize);
+  unsigned char* newTypes = types->GetPointer(0);
+  vtkIdType* newOffsets = offsets->GetPointer(0);
+  vtkIdType* newConn = conn->GetPointer(0);
+
+  ArrayList cellArrays;
+  AddArrayPairs(cellArrays, numNewCells, input->GetCellData(), output->GetCellData());
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    vtkIdList* pts = localPts.Local();
+    for (; blockId < endBlockId; ++blockId)
+    {
+      vtkIdType endCellId = std::min(numCells, (blockId + 1) * ThresholdBlockSize);
+      vtkIdType newCellId = cellOffsets[blockId];
+      vtkIdType loc = connOffsets[blockId];
+      for (vtkIdType cellId = blockId * ThresholdBlockSize; cellId < endCellId; ++cellId)
+      {
+        if (!keep[cellId])
+        {
+          continue;
+        }
+        input->GetCellPoints(cellId, pts);
+        newTypes[newCellId] = static_cast<unsigned char>(input->GetCellType(cellId));
+        newOffsets[newCellId] = loc;
+        for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+        {
+          newConn[loc++] = pts->GetId(i);
+        }
+        cellArrays.Copy(cellId, newCellId++);
+      }
+    }
+  });
+  newOffsets[numNewCells] = connSize;
+
+  // Find the first use of each point by the kept cells.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(connSize, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, connSize, [&](vtkIdType i, vtkIdType endI) {
+    for (; i < endI; ++i)
+    {
+      std::atomic<vtkIdType>& first = firstUse[newConn[i]];
+      vtkIdType current = first.load(std::memory_order_relaxed);
+      while (i < current && !first.compare_exchange_weak(current, i, std::memory_order_relaxed))
+      {
+      }
+    }
+  });
+
+  // Number the used points in order of first use, as the serial path does:
+  // count the first uses per block of connectivity, scan the counts, then
+  // assign the ids and copy the points and their data.
+  auto isFirstUse = [&](vtkIdType i) {
+    return firstUse[newConn[i]].load(std::memory_order_relaxed) == i;
+  };
+  const vtkIdType numUseBlocks = (connSize + ThresholdBlockSize - 1) / ThresholdBlockSize;
+  std::vector<vtkIdType> useOffsets(numUseBlocks + 1, 0);
+  vtkSMPTools::For(0, numUseBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      vtkIdType endI = std::min(connSize, (blockId + 1) * ThresholdBlockSize);
+      vtkIdType count = 0;
+      for (vtkIdType i = blockId * ThresholdBlockSize; i < endI; ++i)
+      {
+        count += (isFirstUse(i) ? 1 : 0);
+      }
+      useOffsets[blockId + 1] = count;
+    }
+  });
+  for (vtkIdType blockId = 0; blockId < numUseBlocks; ++blockId)
+  {
+    useOffsets[blockId + 1] += useOffsets[blockId];
+  }
+  const vtkIdType numNewPts = useOffsets[numUseBlocks];
+
+  newPoints->SetNumberOfPoints(numNewPts);
+  ArrayList pointArrays;
+  AddArrayPairs(pointArrays, numNewPts, input->GetPointData(), output->GetPointData());
+  std::vector<vtkIdType> newIds(numPts);
+  vtkSMPTools::For(0, numUseBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    double x[3];
+    for (; blockId < endBlockId; ++blockId)
+    {
+      vtkIdType endI = std::min(connSize, (blockId + 1) * ThresholdBlockSize);
+      vtkIdType newId = useOffsets[blockId];
+      for (vtkIdType i = blockId * ThresholdBlockSize; i < endI; ++i)
+      {
+        if (isFirstUse(i))
+        {
+          const vtkIdType ptId = newConn[i];
+          input->GetPoint(ptId, x);
+          newPoints->SetPoint(newId, x);
+          pointArrays.Copy(ptId, newId);
+          newIds[ptId] = newId++;
+        }
+      }
+    }
+  });
+
+  vtkSMPTools::For(0, connSize, [&](vtkIdType i, vtkIdType endI) {
+    for (; i < endI; ++i)
+    {
+      newConn[i] = newIds[newConn[i]];
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, conn);
+  output->SetCells(types, cells);
+}
+
 int vtkThreshold::EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts)
 {
   int c(0);
@@ -460,4 +755,5 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Upper Threshold: " << this->UpperThreshold << "\n";
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
   os << indent << "Use Continuous Cell Range: " << this->UseContinuousCellRange << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
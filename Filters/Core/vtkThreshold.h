@@ -30,6 +30,12 @@
  * By default only the first scalar value is used in the decision. Use the ComponentMode
  * and SelectedComponent ivars to control this behavior.
  *
+ * Unstructured grids without polyhedra, image data, rectilinear grids and
+ * structured grids are thresholded in parallel: the cells are tested and
+ * counted block by block, the counts are scanned, and the kept cells and the
+ * points they use are then gathered concurrently. The output is identical to
+ * the serial one, with the points numbered in order of first use.
+ *
  * @sa
  * vtkThresholdPoints vtkThresholdTextureCoords
  */
@@ -49,8 +55,11 @@
 #define VTK_COMPONENT_MODE_USE_ALL 1
 #define VTK_COMPONENT_MODE_USE_ANY 2
 
+class vtkCellData;
 class vtkDataArray;
 class vtkIdList;
+class vtkPointData;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -189,6 +198,20 @@ public:
   int GetOutputPointsPrecision() const;
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when thresholding. By
+   * default, sequential processing is off. Note this flag only applies if
+   * the class has been compiled with VTK_SMP_IMPLEMENTATION_TYPE set to
+   * something other than Sequential. (If set to Sequential, then the filter
+   * always runs in serial mode.) This flag is typically used for benchmarking
+   * purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Methods used for thresholding. vtkThreshold::Lower returns true if s is lower than threshold,
@@ -226,6 +249,7 @@ protected:
   int OutputPointsPrecision;
   vtkTypeBool UseContinuousCellRange;
   bool Invert;
+  vtkTypeBool SequentialProcessing;
 
   int (vtkThreshold::*ThresholdFunction)(double s) const;
 
@@ -233,6 +257,15 @@ protected:
   int EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts);
   int EvaluateCell(vtkDataArray* scalars, int c, vtkIdList* cellPts, int numCellPts);
 
+  // Whether the cell with the given points satisfies the criterion, taking
+  // AllScalars, UseContinuousCellRange and Invert into account.
+  int EvaluateKeepCell(
+    vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId, vtkIdList* cellPts);
+
+  bool CanThresholdInParallel(vtkDataSet* input, vtkPointData* outPD, vtkCellData* outCD);
+  void ThresholdInParallel(vtkDataSet* input, vtkDataArray* inScalars, bool usePointScalars,
+    vtkPoints* newPoints, vtkUnstructuredGrid* output);
+
 private:
   vtkThreshold(const vtkThreshold&) = delete;
   void operator=(const vtkThreshold&) = delete;
@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the streamlines of seeds integrated in parallel by
+// vtkStreamTracer match exactly the serial ones, for both interpolator types,
+// on image data and on an unstructured grid of tetrahedra.
+
+#include "vtkStreamTracer.h"
+
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkRungeKutta4.h"
+#include "vtkRungeKutta45.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// A swirling velocity field and a scalar field at the points.
+void AddFields(vtkDataSet* input)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    input->GetPoint(i, x);
+    velocity->SetComponent(i, 0, -(x[1] - 2.5) + 0.2 * std::sin(x[2]));
+    velocity->SetComponent(i, 1, (x[0] - 2.5) + 0.1 * x[2]);
+    velocity->SetComponent(i, 2, 0.3 * std::cos(x[0] + x[1]));
+    scalars->SetValue(i, x[0] * x[1] - x[2]);
+  }
+  input->GetPointData()->SetVectors(velocity);
+  input->GetPointData()->AddArray(scalars);
+}
+
+bool CompareTracers(vtkDataSet* input, vtkDataSet* seeds, int interpolatorType, bool adaptive)
+{
+  vtkNew<vtkStreamTracer> tracers[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    tracers[i]->SetInputData(input);
+    tracers[i]->SetSourceData(seeds);
+    tracers[i]->SetInterpolatorType(interpolatorType);
+    tracers[i]->SetIntegrationDirectionToBoth();
+    if (adaptive)
+    {
+      vtkNew<vtkRungeKutta45> integrator;
+      tracers[i]->SetIntegrator(integrator);
+    }
+    else
+    {
+      vtkNew<vtkRungeKutta4> integrator;
+      tracers[i]->SetIntegrator(integrator);
+    }
+    tracers[i]->SetMaximumPropagation(20.0);
+    tracers[i]->SetInitialIntegrationStep(0.2);
+    tracers[i]->SetComputeVorticity(true);
+    tracers[i]->SetSequentialProcessing(i == 0);
+    tracers[i]->Update();
+  }
+  if (tracers[0]->GetOutput()->GetNumberOfLines() < 10)
+  {
+    std::cerr << "Too few streamlines" << std::endl;
+    return false;
+  }
+  return vtkTest::SamePolyData(tracers[0]->GetOutput(), tracers[1]->GetOutput());
+}
+}
+
+int TestStreamTracerSMP(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 6);
+  image->SetSpacing(0.5, 0.5, 0.5);
+  AddFields(image);
+
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(VTK_TETRA);
+  source->SetBlocksDimensions(5, 5, 2);
+  source->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(source->GetOutput());
+  grid->GetCellData()->Initialize();
+  AddFields(grid);
+
+  // Some of the seeds are outside the domains.
+  vtkNew<vtkPointSource> seeds;
+  seeds->SetCenter(2.5, 2.5, 1.0);
+  seeds->SetRadius(2.8);
+  seeds->SetNumberOfPoints(200);
+  seeds->Update();
+
+  vtkDataSet* inputs[] = { image, grid };
+  const int interpolatorTypes[] = { vtkStreamTracer::INTERPOLATOR_WITH_DATASET_POINT_LOCATOR,
+    vtkStreamTracer::INTERPOLATOR_WITH_CELL_LOCATOR };
+  for (vtkDataSet* input : inputs)
+  {
+    for (int interpolatorType : interpolatorTypes)
+    {
+      for (int adaptive = 0; adaptive < 2; ++adaptive)
+      {
+        if (!CompareTracers(input, seeds->GetOutput(), interpolatorType, adaptive != 0))
+        {
+          std::cerr << "Streamlines differ on " << input->GetClassName() << " for interpolator "
+                    << interpolatorType << " and adaptive " << adaptive << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeCellLocators.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the serial and threaded builds of vtkCellLocator, vtkOBBTree and
+// vtkModifiedBSPTree against the build of vtkStaticCellLocator, and check
+// that the threaded builds answer queries exactly like the serial ones.
+
+#include "vtkCellLocator.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkOBBTree.h"
+#include "vtkStaticCellLocator.h"
+
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Move the points of a dataset as a deforming mesh would.
+void Deform(vtkPointSet* input)
+{
+  vtkPoints* points = input->GetPoints();
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    x[0] += 0.05 * std::sin(3.0 * x[1] + x[2]);
+    x[1] += 0.04 * std::cos(2.0 * x[0] - x[2]);
+    x[2] += 0.03 * std::sin(x[0] * x[1]);
+    points->SetPoint(i, x);
+  }
+}
+
+double TimeBuild(vtkAbstractCellLocator* locator, vtkDataSet* input, int sequential)
+{
+  vtkNew<vtkTimerLog> timer;
+  locator->SetDataSet(input);
+  locator->SetSequentialProcessing(sequential);
+  locator->LazyEvaluationOff();
+  timer->StartTimer();
+  locator->BuildLocator();
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+bool SameRepresentations(vtkAbstractCellLocator* a, vtkAbstractCellLocator* b, int level)
+{
+  vtkNew<vtkPolyData> pa, pb;
+  a->GenerateRepresentation(level, pa);
+  b->GenerateRepresentation(level, pb);
+  if (pa->GetNumberOfPoints() != pb->GetNumberOfPoints() || pa->GetNumberOfPoints() == 0)
+  {
+    return false;
+  }
+  vtkDataArray* xa = pa->GetPoints()->GetData();
+  vtkDataArray* xb = pb->GetPoints()->GetData();
+  for (vtkIdType i = 0; i < xa->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      if (xa->GetComponent(i, c) != xb->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Query both locators with random segments and points inside the bounds of
+// the input.
+bool SameQueries(vtkAbstractCellLocator* a, vtkAbstractCellLocator* b, vtkDataSet* input,
+  bool findCell, bool findClosestPoint)
+{
+  double bounds[6];
+  input->GetBounds(bounds);
+  vtkNew<vtkGenericCell> cell;
+  vtkMath::RandomSeed(4242);
+  for (int q = 0; q < 200; ++q)
+  {
+    double p1[3], p2[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      p1[c] = vtkMath::Random(bounds[2 * c] - 0.2, bounds[2 * c + 1] + 0.2);
+      p2[c] = vtkMath::Random(bounds[2 * c] - 0.2, bounds[2 * c + 1] + 0.2);
+    }
+
+    double tA, tB, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellIdA = -1, cellIdB = -1;
+    int hitA = a->IntersectWithLine(p1, p2, 0.0, tA, x, pcoords, subId, cellIdA);
+    int hitB = b->IntersectWithLine(p1, p2, 0.0, tB, x, pcoords, subId, cellIdB);
+    if (hitA != hitB || (hitA && (cellIdA != cellIdB || tA != tB)))
+    {
+      std::cerr << "IntersectWithLine differs for query " << q << std::endl;
+      return false;
+    }
+
+    if (findCell)
+    {
+      double weights[8];
+      if (a->FindCell(p1, 0.0, cell, pcoords, weights) !=
+        b->FindCell(p1, 0.0, cell, pcoords, weights))
+      {
+        std::cerr << "FindCell differs for query " << q << std::endl;
+        return false;
+      }
+    }
+
+    if (findClosestPoint)
+    {
+      double closestA[3], closestB[3], dist2A, dist2B;
+      vtkIdType cellIdA, cellIdB;
+      int subIdA, subIdB;
+      a->FindClosestPoint(p1, closestA, cell, cellIdA, subIdA, dist2A);
+      b->FindClosestPoint(p1, closestB, cell, cellIdB, subIdB, dist2B);
+      if (cellIdA != cellIdB || dist2A != dist2B)
+      {
+        std::cerr << "FindClosestPoint differs for query " << q << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TLocator>
+bool TimeAndCompare(const char* name, vtkDataSet* input, bool findCell, bool findClosestPoint)
+{
+  vtkNew<TLocator> locators[2];
+  double serial = TimeBuild(locators[0], input, 1);
+  double threaded = TimeBuild(locators[1], input, 0);
+  cout << "  " << name << ": serial build " << serial << ", threaded build " << threaded << "\n";
+
+  for (int level = 0; level < 3; ++level)
+  {
+    if (!SameRepresentations(locators[0], locators[1], level))
+    {
+      std::cerr << name << ": trees differ at level " << level << std::endl;
+      return false;
+    }
+  }
+  if (!SameQueries(locators[0], locators[1], input, findCell, findClosestPoint))
+  {
+    std::cerr << name << ": queries differ" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TimeLocators(vtkDataSet* input)
+{
+  cout << "\nTiming for " << input->GetNumberOfCells() << " cells of a "
+       << input->GetClassName() << "\n";
+
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  cout << "  vtkStaticCellLocator: build " << TimeBuild(staticLocator, input, 0) << "\n";
+
+  // vtkOBBTree only handles surfaces, whose area gives the moments of a box.
+  bool volume = input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID;
+  return TimeAndCompare<vtkCellLocator>("vtkCellLocator", input, volume, true) &&
+    (volume || TimeAndCompare<vtkOBBTree>("vtkOBBTree", input, false, false)) &&
+    TimeAndCompare<vtkModifiedBSPTree>("vtkModifiedBSPTree", input, volume, false);
+}
+}
+
+int TimeCellLocators(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkNew<vtkPolyData> surface;
+  surface->DeepCopy(sphere->GetOutput());
+  Deform(surface);
+
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(VTK_TETRA);
+  source->SetBlocksDimensions(20, 20, 20);
+  source->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(source->GetOutput());
+  Deform(grid);
+
+  if (!TimeLocators(surface) || !TimeLocators(grid))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -259,6 +259,34 @@ void vtkCellLocatorInterpolatedVelocityField::AddDataSet(vtkDataSet* dataset)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::CopyDataSets(
+  vtkCompositeInterpolatedVelocityField* from)
+{
+  vtkCellLocatorInterpolatedVelocityField* other =
+    vtkCellLocatorInterpolatedVelocityField::SafeDownCast(from);
+  if (!other)
+  {
+    this->Superclass::CopyDataSets(from);
+    return;
+  }
+
+  for (size_t i = 0; i < other->DataSets->size(); ++i)
+  {
+    vtkDataSet* dataset = (*other->DataSets)[i];
+    this->DataSets->push_back(dataset);
+    this->CellLocators->push_back((*other->CellLocators)[i]);
+
+    int size = dataset->GetMaxCellSize();
+    if (size > this->WeightsSize)
+    {
+      this->WeightsSize = size;
+      delete[] this->Weights;
+      this->Weights = new double[size];
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkCellLocatorInterpolatedVelocityField::CopyParameters(
   vtkAbstractInterpolatedVelocityField* from)
@@ -101,6 +101,13 @@ public:
    */
   void AddDataSet(vtkDataSet* dataset) override;
 
+  /**
+   * Add the datasets of another interpolator. When it is also a
+   * vtkCellLocatorInterpolatedVelocityField, its cell locators are shared
+   * rather than instantiated again from the prototype.
+   */
+  void CopyDataSets(vtkCompositeInterpolatedVelocityField* from) override;
+
   using Superclass::FunctionValues;
   /**
    * Evaluate the velocity field f at point (x, y, z).
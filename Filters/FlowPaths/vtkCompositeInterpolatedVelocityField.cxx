@@ -35,6 +35,16 @@ vtkCompositeInterpolatedVelocityField::~vtkCompositeInterpolatedVelocityField()
   this->DataSets = nullptr;
 }
 
+//------------------------------------------------------------------------------
+void vtkCompositeInterpolatedVelocityField::CopyDataSets(
+  vtkCompositeInterpolatedVelocityField* from)
+{
+  for (vtkDataSet* dataset : *from->DataSets)
+  {
+    this->AddDataSet(dataset);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkCompositeInterpolatedVelocityField::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -59,6 +59,14 @@ public:
    */
   virtual void AddDataSet(vtkDataSet* dataset) = 0;
 
+  /**
+   * Add all the datasets of another interpolator, along with any search
+   * structure built for them, so that the two interpolators can evaluate the
+   * same velocity field concurrently (e.g., one per thread). The structures
+   * of from are shared, and must have been built beforehand.
+   */
+  virtual void CopyDataSets(vtkCompositeInterpolatedVelocityField* from);
+
   //@{
   /**
    * Get the most recently visited dataset and its id. The dataset is used
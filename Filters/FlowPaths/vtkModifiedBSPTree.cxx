@@ -18,6 +18,8 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
@@ -84,8 +86,6 @@ public:
 
 typedef cell_extents* cell_extents_List;
 
-static int global_list_count = 0;
-
 class Sorted_cell_extents_Lists
 {
 public:
@@ -99,7 +99,6 @@ public:
       Mins[i] = new cell_extents[nCells]; // max num <= nCells/2 ?
       Maxs[i] = new cell_extents[nCells];
     }
-    global_list_count += 1;
   };
   ~Sorted_cell_extents_Lists()
   {
@@ -108,38 +107,163 @@ public:
       delete[](Mins[i]);
       delete[](Maxs[i]);
     }
-    global_list_count -= 1;
+  }
+  // The list for the given dominant axis (see the enum above)
+  cell_extents_List& List(int dominantAxis)
+  {
+    return (dominantAxis % 2) ? Maxs[dominantAxis / 2] : Mins[dominantAxis / 2];
   }
 };
 
-extern "C" int _compareMin(const void* pA, const void* B)
+// The cell ids break ties so that the order of the sorted lists, hence the
+// tree, is the same whatever the sorting algorithm.
+struct _compareMin
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->min == tB->min)
+  bool operator()(const cell_extents& tA, const cell_extents& tB) const
   {
-    return 0;
+    return tA.min < tB.min || (tA.min == tB.min && tA.cell_ID < tB.cell_ID);
   }
-  else
+};
+
+struct _compareMax
+{
+  bool operator()(const cell_extents& tA, const cell_extents& tB) const
   {
-    return tA->min < tB->min ? -1 : 1;
+    return tA.max > tB.max || (tA.max == tB.max && tA.cell_ID < tB.cell_ID);
   }
-}
+};
 
-extern "C" int _compareMax(const void* pA, const void* B)
+// Counters gathered while building (part of) the tree.
+struct BSPBuildStatistics
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->max == tB->max)
+  int ParentNodes;
+  int LeafNodes;
+  int TotalDepth;
+  int MaxDepth;
+};
+
+namespace
+{
+// Fill the sorted lists of a node with the extents of all the cells along
+// one axis, before they are sorted.
+struct FillExtentsFunctor
+{
+  double (*CellBounds)[6];
+  Sorted_cell_extents_Lists* Lists;
+  int Axis;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
   {
-    return 0;
+    for (vtkIdType j = begin; j < end; j++)
+    {
+      cell_extents& ext = this->Lists->Mins[this->Axis][j];
+      ext.min = this->CellBounds[j][this->Axis * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
+      ext.max = this->CellBounds[j][this->Axis * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
+      ext.cell_ID = j;
+      this->Lists->Maxs[this->Axis][j] = ext;
+    }
   }
-  else
+};
+
+// Distribute each of the 6 sorted lists of a node among the lists of its 3
+// children, keeping the order, depending on which side of the split plane
+// the cells lie.
+struct PartitionListsFunctor
+{
+  double (*CellBounds)[6];
+  Sorted_cell_extents_Lists* Lists;
+  vtkIdType NumberOfCells;
+  int SplitAxis;
+  double Split;
+  Sorted_cell_extents_Lists** Kids;
+  vtkIdType (*KidCounts)[3];
+
+  void operator()(vtkIdType begin, vtkIdType end) const
   {
-    return tA->max > tB->max ? -1 : 1;
+    for (vtkIdType l = begin; l < end; l++)
+    {
+      int list = static_cast<int>(l);
+      const cell_extents* exts = this->Lists->List(list);
+      cell_extents* kidExts[3] = { this->Kids[0]->List(list), this->Kids[1]->List(list),
+        this->Kids[2]->List(list) };
+      vtkIdType* counts = this->KidCounts[list];
+      counts[0] = counts[1] = counts[2] = 0;
+      for (vtkIdType i = 0; i < this->NumberOfCells; i++)
+      {
+        const cell_extents& ext = exts[i];
+        const double* bounds = this->CellBounds[ext.cell_ID];
+        // max is on left of middle node, min is on right of middle node,
+        // otherwise it must be one of ours
+        int kid = bounds[2 * this->SplitAxis + 1] < this->Split
+          ? 0
+          : (bounds[2 * this->SplitAxis] > this->Split ? 2 : 1);
+        kidExts[kid][counts[kid]++] = ext;
+      }
+    }
   }
+};
 }
 
+// Build the subtrees of the nodes left once the top of the tree has been
+// built, one node at a time per thread.
+struct BSPSubtreesFunctor
+{
+  struct Subtree
+  {
+    BSPNode* Node;
+    Sorted_cell_extents_Lists* Lists;
+    vtkIdType NumberOfCells;
+    int Depth;
+  };
+
+  vtkModifiedBSPTree* Tree;
+  std::vector<Subtree>& Subtrees;
+  int MaxLevel;
+  vtkIdType MaxCells;
+  vtkSMPThreadLocal<BSPBuildStatistics> Statistics;
+  BSPBuildStatistics Total;
+
+  BSPSubtreesFunctor(
+    vtkModifiedBSPTree* tree, std::vector<Subtree>& subtrees, int maxLevel, vtkIdType maxCells)
+    : Tree(tree)
+    , Subtrees(subtrees)
+    , MaxLevel(maxLevel)
+    , MaxCells(maxCells)
+  {
+  }
+
+  void Initialize()
+  {
+    BSPBuildStatistics& stats = this->Statistics.Local();
+    stats.ParentNodes = stats.LeafNodes = stats.TotalDepth = stats.MaxDepth = 0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    BSPBuildStatistics& stats = this->Statistics.Local();
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const Subtree& subtree = this->Subtrees[i];
+      this->Tree->SubdivideSubtree(subtree.Node, subtree.Lists, subtree.NumberOfCells,
+        subtree.Depth, this->MaxLevel, this->MaxCells, stats);
+      delete subtree.Lists;
+    }
+  }
+
+  void Reduce()
+  {
+    this->Total.ParentNodes = this->Total.LeafNodes = this->Total.TotalDepth = 0;
+    this->Total.MaxDepth = 0;
+    for (const BSPBuildStatistics& stats : this->Statistics)
+    {
+      this->Total.ParentNodes += stats.ParentNodes;
+      this->Total.LeafNodes += stats.LeafNodes;
+      this->Total.TotalDepth += stats.TotalDepth;
+      this->Total.MaxDepth = std::max(this->Total.MaxDepth, stats.MaxDepth);
+    }
+  }
+};
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -202,7 +326,7 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 
   // create the root node
   this->mRoot = new BSPNode();
-  this->mRoot->mAxis = rand() % 3;
+  this->mRoot->mAxis = 0;
   this->mRoot->depth = 0;
   //
   if (numCells == 0)
@@ -216,31 +340,70 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
   for (int i = 0; i < 3; i++)
   { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
+    FillExtentsFunctor fill = { this->CellBounds, lists, i };
+    if (this->SequentialProcessing)
+    {
+      fill(0, numCells);
+      std::sort(lists->Mins[i], lists->Mins[i] + numCells, _compareMin());
+      std::sort(lists->Maxs[i], lists->Maxs[i] + numCells, _compareMax());
+    }
+    else
+    {
+      vtkSMPTools::For(0, numCells, fill);
+      vtkSMPTools::Sort(lists->Mins[i], lists->Mins[i] + numCells, _compareMin());
+      vtkSMPTools::Sort(lists->Maxs[i], lists->Maxs[i] + numCells, _compareMax());
     }
-    // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), _compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), _compareMax);
   }
   //
   // call the recursive subdivision routine
   //
   vtkDebugMacro(<< "Beginning Subdivision");
   //
-  if (numCells > 0)
+  if (this->SequentialProcessing)
   {
     Subdivide(this->mRoot, lists, this->DataSet, numCells, 0, this->MaxLevel,
       this->NumberOfCellsPerNode, this->Level);
+    delete lists;
+  }
+  else
+  {
+    // Split the top nodes one at a time, partitioning their lists in
+    // parallel, until there are enough nodes to build their subtrees in
+    // parallel. Either way the nodes are split the same way.
+    BSPBuildStatistics stats = { 0, 0, 0, this->Level };
+    std::vector<BSPSubtreesFunctor::Subtree> subtrees(1, { this->mRoot, lists, numCells, 0 });
+    size_t numThreads = static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    while (!subtrees.empty() && subtrees.size() < numThreads)
+    {
+      std::vector<BSPSubtreesFunctor::Subtree> kids;
+      for (const BSPSubtreesFunctor::Subtree& subtree : subtrees)
+      {
+        Sorted_cell_extents_Lists* kidLists[3];
+        vtkIdType kidCells[3];
+        if (this->SplitNode(subtree.Node, subtree.Lists, subtree.NumberOfCells,
+              subtree.Depth, this->MaxLevel, this->NumberOfCellsPerNode, true, kidLists,
+              kidCells, stats))
+        {
+          for (int i = 0; i < 3; i++)
+          {
+            if (kidLists[i])
+            {
+              kids.push_back(
+                { subtree.Node->mChild[i], kidLists[i], kidCells[i], subtree.Depth + 1 });
+            }
+          }
+        }
+        delete subtree.Lists;
+      }
+      subtrees.swap(kids);
+    }
+    BSPSubtreesFunctor functor(this, subtrees, this->MaxLevel, this->NumberOfCellsPerNode);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, functor);
+    this->npn += stats.ParentNodes + functor.Total.ParentNodes;
+    this->nln += stats.LeafNodes + functor.Total.LeafNodes;
+    this->tot_depth += stats.TotalDepth + functor.Total.TotalDepth;
+    this->Level = std::max(stats.MaxDepth, functor.Total.MaxDepth);
   }
-  delete lists;
   // Child nodes are responsible for freeing the temporary sorted lists
   //
   this->BuildTime.Modified();
@@ -258,16 +421,57 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 // a small part of this, the rest is just bookkeeping - it looks worse than it is.
 //
 void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists,
-  vtkDataSet* dataset, vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth)
+  vtkDataSet* vtkNotUsed(dataset), vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells,
+  int& MaxDepth)
+{
+  BSPBuildStatistics stats = { 0, 0, 0, MaxDepth };
+  this->SubdivideSubtree(node, lists, nCells, depth, maxlevel, maxCells, stats);
+  this->npn += stats.ParentNodes;
+  this->nln += stats.LeafNodes;
+  this->tot_depth += stats.TotalDepth;
+  MaxDepth = stats.MaxDepth;
+}
+
+//------------------------------------------------------------------------------
+// Subdivide a node and its children in the calling thread only, so that
+// several subtrees can be built concurrently. The lists of the node are
+// left to the caller.
+void vtkModifiedBSPTree::SubdivideSubtree(BSPNode* node, Sorted_cell_extents_Lists* lists,
+  vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, BSPBuildStatistics& stats)
+{
+  Sorted_cell_extents_Lists* kidLists[3];
+  vtkIdType kidCells[3];
+  if (this->SplitNode(
+        node, lists, nCells, depth, maxlevel, maxCells, false, kidLists, kidCells, stats))
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      if (kidLists[i])
+      {
+        this->SubdivideSubtree(
+          node->mChild[i], kidLists[i], kidCells[i], depth + 1, maxlevel, maxCells, stats);
+        delete kidLists[i];
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Look for a split plane of a node. If one is found, create its children
+// and return their sorted lists (nullptr for an empty middle child, which is
+// then deleted). Otherwise make the node a leaf holding its cells.
+bool vtkModifiedBSPTree::SplitNode(BSPNode* node, Sorted_cell_extents_Lists* lists,
+  vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, bool threaded,
+  Sorted_cell_extents_Lists* kidLists[3], vtkIdType kidCells[3], BSPBuildStatistics& stats)
 {
   //
   // We've got lists sorted on the axes, so we can easily get BBox
   node->setMin(lists->Mins[0][0].min, lists->Mins[1][0].min, lists->Mins[2][0].min);
   node->setMax(lists->Maxs[0][0].max, lists->Maxs[1][0].max, lists->Maxs[2][0].max);
   // Update depth info
-  if (node->depth > MaxDepth)
+  if (node->depth > stats.MaxDepth)
   {
-    MaxDepth = depth;
+    stats.MaxDepth = depth;
   }
   //
   // Make sure child nodes are clear to start with
@@ -319,123 +523,42 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       {
         node->mChild[i] = new BSPNode();
         node->mChild[i]->depth = node->depth + 1;
-        node->mChild[i]->mAxis = rand() % 3;
+        // cycle through the axes from the split one so that the tree does not
+        // depend on a random sequence
+        node->mChild[i]->mAxis = (node->mAxis + i + 1) % 3;
       }
-      Daxis = node->mAxis;
       Sorted_cell_extents_Lists* left = new Sorted_cell_extents_Lists(nCells);
       Sorted_cell_extents_Lists* mid = new Sorted_cell_extents_Lists(nCells);
       Sorted_cell_extents_Lists* right = new Sorted_cell_extents_Lists(nCells);
+      Sorted_cell_extents_Lists* kids[3] = { left, mid, right };
       // we ought to keep track of how many we are adding to each list
-      vtkIdType Cmin_l[3] = { 0, 0, 0 }, Cmin_m[3] = { 0, 0, 0 }, Cmin_r[3] = { 0, 0, 0 };
-      vtkIdType Cmax_l[3] = { 0, 0, 0 }, Cmax_m[3] = { 0, 0, 0 }, Cmax_r[3] = { 0, 0, 0 };
+      vtkIdType counts[6][3];
       // Partition the cells into the correct child lists
-      // here we use the lists for the axis we're dividing along
-      for (vtkIdType i = 0; i < nCells; i++)
+      // do everything in order so our sorted lists aren't munged
+      PartitionListsFunctor partition = { this->CellBounds, lists, nCells, node->mAxis, pDiv,
+        kids, counts };
+      if (threaded)
       {
-        // process the MIN-List
-        cell_extents ext = lists->Mins[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-        }
-        //
-        // process the MAX-List
-        ext = lists->Maxs[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-        }
+        vtkSMPTools::For(0, 6, 1, partition);
       }
-      // construct the sorted list of extents for the 2 remaining axes
-      // do everything in order so our sorted lists aren't munged
-      for (Daxis = (node->mAxis + 1) % 3; Daxis != node->mAxis; Daxis = (Daxis + 1) % 3)
+      else
       {
-        for (vtkIdType i = 0; i < nCells; i++)
-        {
-          // process the MIN-List
-          cell_extents ext = lists->Mins[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
-          {
-            left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-          }
-          //
-          // process the MAX-List
-          ext = lists->Maxs[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
-          {
-            left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-          }
-        }
+        partition(0, 6);
       }
       //
       // Better check we didn't make a diddly
       // this is overkill but for now I want a FULL DEBUG!
-      if ((Cmin_l[0] + Cmin_r[0] + Cmin_m[0]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmin_l[1] + Cmin_r[1] + Cmin_m[1]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmin_l[2] + Cmin_r[2] + Cmin_m[2]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmax_l[0] + Cmax_r[0] + Cmax_m[0]) != nCells)
-      {
-        vtkWarningMacro("Error count in max lists");
-      }
-      if ((Cmax_l[1] + Cmax_r[1] + Cmax_m[1]) != nCells)
-      {
-        vtkWarningMacro("Error count in max lists");
-      }
-      if ((Cmax_l[2] + Cmax_r[2] + Cmax_m[2]) != nCells)
+      for (int i = 0; i < 6; i++)
       {
-        vtkWarningMacro("Error count in max lists");
+        if ((counts[i][0] + counts[i][1] + counts[i][2]) != nCells)
+        {
+          vtkWarningMacro(<< "Error count in " << ((i % 2) ? "max" : "min") << " lists");
+        }
       }
       //
       // Bug : Can sometimes get unbalanced leaves
       //
-      if (!Cmin_l[0] || !Cmin_r[0])
+      if (!counts[POS_X][0] || !counts[POS_X][2])
       {
         // vtkDebugMacro(<<"Child 0 or 2 empty : Aborting subdivision for node " << Cmin_l[0] << " "
         // << Cmin_m[0] << " " << Cmin_r[0]); clean up all the memory we allocated. Yikes.
@@ -450,51 +573,27 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       }
       else
       {
-        //
-        // Now we can delete the lists that the parent passed on to us
-        //
         //
         // And of course, we really ought to subdivide again - Hoorah!
         // NB: it is possible for a node to be empty now, so check and delete if necessary
-        if (Cmin_l[0])
-        {
-          Subdivide(
-            node->mChild[0], left, dataset, Cmin_l[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          vtkWarningMacro(<< "Child 0 Empty ! - this shouldn't happen");
-        }
-        delete left;
-
-        if (Cmin_m[0])
+        for (int i = 0; i < 3; i++)
         {
-          Subdivide(
-            node->mChild[1], mid, dataset, Cmin_m[0], depth + 1, maxlevel, maxCells, MaxDepth);
+          kidLists[i] = kids[i];
+          kidCells[i] = counts[POS_X][i];
         }
-        else
+        if (!kidCells[1])
         {
           delete node->mChild[1];
           node->mChild[1] = nullptr;
+          delete mid;
+          kidLists[1] = nullptr;
         }
-        delete mid;
-
-        if (Cmin_r[0])
-        {
-          Subdivide(
-            node->mChild[2], right, dataset, Cmin_r[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
-        }
-        delete right;
         //
-        npn += 1; // Parent node
+        stats.ParentNodes += 1; // Parent node
         //
         // we've done all we were asked to do
         //
-        return;
+        return true;
       }
     }
   }
@@ -503,8 +602,8 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   //
   // Copy the cell IDs into the actual node structure for proper use
   node->num_cells = nCells;
-  nln += 1; // Leaf node
-  tot_depth += node->depth;
+  stats.LeafNodes += 1; // Leaf node
+  stats.TotalDepth += node->depth;
   for (int i = 0; i < 6; i++)
   {
     node->sorted_cell_lists[i] = new vtkIdType[nCells];
@@ -519,6 +618,7 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
     }
   }
   // Thank buggery that's all over.
+  return false;
 }
 
 //////////////////////////////////////////////////////////////////////////////
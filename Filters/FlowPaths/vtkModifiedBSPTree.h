@@ -95,6 +95,10 @@
  * segments the lists and passes them down to the new child nodes whilst
  * maintaining sorted order. This makes for an efficient subdivision strategy.
  *
+ * Unless SequentialProcessing is on, the lists are sorted and the top nodes
+ * segment them in parallel, then the subtrees below are built concurrently.
+ * The tree is the same whatever the number of threads.
+ *
  * NB. The following reference has been sent to me
  *   @Article{formella-1995-ray,
  *     author =     "Arno Formella and Christian Gill",
@@ -148,6 +152,7 @@
 #include "vtkSmartPointer.h"           // required because it is nice
 
 class Sorted_cell_extents_Lists;
+struct BSPBuildStatistics;
 class BSPNode;
 class vtkGenericCell;
 class vtkIdList;
@@ -247,6 +252,12 @@ protected:
   // The main subdivision routine
   void Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkDataSet* dataSet,
     vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth);
+  void SubdivideSubtree(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkIdType nCells,
+    int depth, int maxlevel, vtkIdType maxCells, BSPBuildStatistics& stats);
+  bool SplitNode(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkIdType nCells, int depth,
+    int maxlevel, vtkIdType maxCells, bool threaded, Sorted_cell_extents_Lists* kidLists[3],
+    vtkIdType kidCells[3], BSPBuildStatistics& stats);
+  friend struct BSPSubtreesFunctor;
 
   // We provide a function which does the cell/ray test so that
   // it can be overridden by subclasses to perform special treatment
@@ -22,6 +22,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkCompositeInterpolatedVelocityField.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
@@ -43,9 +44,14 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStaticCellLocator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer);
@@ -128,6 +134,7 @@ vtkStreamTracer::vtkStreamTracer()
   this->HasMatchingPointAttributes = true;
 
   this->SurfaceStreamlines = false;
+  this->SequentialProcessing = false;
 }
 
 //------------------------------------------------------------------------------
@@ -650,6 +657,369 @@ int vtkStreamTracer::CheckInputs(vtkAbstractInterpolatedVelocityField*& func, in
   return VTK_OK;
 }
 
+//------------------------------------------------------------------------------
+// The containers receiving the points of the streamlines and their point
+// attributes. The serial path fills the output ones directly, while each
+// batch of seeds integrated by a thread has its own.
+struct vtkStreamTracer::StreamlineBuffers
+{
+  vtkPoints* Points;
+  vtkDataSetAttributes* PointData;
+  vtkDoubleArray* Time;
+  vtkDoubleArray* VelocityVectors;
+  vtkDoubleArray* Vorticity;
+  vtkDoubleArray* Rotation;
+  vtkDoubleArray* AngularVel;
+};
+
+//------------------------------------------------------------------------------
+// Integrate the seeds of contiguous ranges with a clone of the velocity field
+// and of the integrator per thread. Each range is integrated into its own
+// batch of streamlines, and the batches are appended to the output in seed
+// order, so that the output does not depend on the number of threads.
+struct StreamlineIntegratingFunctor
+{
+  struct SeedBatch
+  {
+    vtkIdType Begin;
+    vtkSmartPointer<vtkPoints> Points;
+    vtkSmartPointer<vtkPointData> PointData;
+    vtkSmartPointer<vtkDoubleArray> Time;
+    vtkSmartPointer<vtkDoubleArray> VelocityVectors;
+    vtkSmartPointer<vtkDoubleArray> Vorticity;
+    vtkSmartPointer<vtkDoubleArray> Rotation;
+    vtkSmartPointer<vtkDoubleArray> AngularVel;
+    vtkStreamTracer::StreamlineBuffers Buffers;
+
+    // The streamlines with more than one point
+    std::vector<vtkIdType> LineStarts;
+    std::vector<vtkIdType> LineSizes;
+    std::vector<int> RetVals;
+    std::vector<vtkIdType> SeedIds;
+
+    // The state left by the last integrated seed, and the last values
+    // written to the corresponding members of the tracer (NaN if none)
+    bool HasIntegrated = false;
+    double Propagation = 0.0;
+    vtkIdType NumSteps = 0;
+    double IntegrationTime = 0.0;
+    double LastPoint[3];
+    double LastUsedStepSize;
+  };
+
+  struct LocalData
+  {
+    vtkSmartPointer<vtkCompositeInterpolatedVelocityField> Func;
+    vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+    vtkSmartPointer<vtkGenericCell> Cell;
+    vtkSmartPointer<vtkDoubleArray> CellVectors;
+    std::vector<double> Weights;
+    std::vector<std::shared_ptr<SeedBatch>> Batches;
+  };
+
+  vtkStreamTracer* Tracer;
+  vtkStreamTracer::StreamlineBuffers& Output;
+  vtkCellArray* OutputLines;
+  vtkIntArray* RetVals;
+  vtkIntArray* SeedIdsOut;
+  vtkPointData* InputData;
+  vtkDataArray* SeedSource;
+  vtkIdList* SeedIds;
+  vtkIntArray* IntegrationDirections;
+  vtkCompositeInterpolatedVelocityField* Func;
+  int MaxCellSize;
+  int VecType;
+  const char* VecName;
+  vtkSMPThreadLocal<LocalData> Local;
+  std::atomic<bool> Abort;
+
+  // What the last integrated seeds leave in the arguments and members of the
+  // tracer, as in the serial path.
+  bool HasIntegrated;
+  double Propagation;
+  vtkIdType NumSteps;
+  double IntegrationTime;
+  double* LastPoint;
+
+  StreamlineIntegratingFunctor(vtkStreamTracer* tracer, vtkStreamTracer::StreamlineBuffers& output,
+    vtkCellArray* outputLines, vtkIntArray* retVals, vtkIntArray* seedIdsOut,
+    vtkPointData* inputData, vtkDataArray* seedSource, vtkIdList* seedIds,
+    vtkIntArray* integrationDirections, vtkCompositeInterpolatedVelocityField* func,
+    int maxCellSize, int vecType, const char* vecName, double lastPoint[3])
+    : Tracer(tracer)
+    , Output(output)
+    , OutputLines(outputLines)
+    , RetVals(retVals)
+    , SeedIdsOut(seedIdsOut)
+    , InputData(inputData)
+    , SeedSource(seedSource)
+    , SeedIds(seedIds)
+    , IntegrationDirections(integrationDirections)
+    , Func(func)
+    , MaxCellSize(maxCellSize)
+    , VecType(vecType)
+    , VecName(vecName)
+    , Abort(false)
+    , HasIntegrated(false)
+    , Propagation(0.0)
+    , NumSteps(0)
+    , IntegrationTime(0.0)
+    , LastPoint(lastPoint)
+  {
+  }
+
+  void Initialize()
+  {
+    LocalData& local = this->Local.Local();
+    local.Func.TakeReference(this->Func->NewInstance());
+    local.Func->CopyParameters(this->Func);
+    local.Func->CopyDataSets(this->Func);
+    local.Func->SelectVectors(this->VecType, this->VecName);
+    local.Integrator.TakeReference(this->Tracer->GetIntegrator()->NewInstance());
+    local.Integrator->SetFunctionSet(local.Func);
+    local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    if (this->Tracer->ComputeVorticity)
+    {
+      local.CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      local.CellVectors->SetNumberOfComponents(3);
+      local.CellVectors->Allocate(3 * VTK_CELL_SIZE);
+    }
+    local.Weights.resize(this->MaxCellSize);
+  }
+
+  std::shared_ptr<SeedBatch> NewBatch(vtkIdType begin)
+  {
+    std::shared_ptr<SeedBatch> batch = std::make_shared<SeedBatch>();
+    batch->Begin = begin;
+    batch->Points = vtkSmartPointer<vtkPoints>::New();
+    batch->PointData = vtkSmartPointer<vtkPointData>::New();
+    batch->PointData->InterpolateAllocate(this->InputData);
+    batch->Time = vtkSmartPointer<vtkDoubleArray>::New();
+    if (this->Output.VelocityVectors)
+    {
+      batch->VelocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      batch->VelocityVectors->SetNumberOfComponents(3);
+    }
+    if (this->Output.Vorticity)
+    {
+      batch->Vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+      batch->Vorticity->SetNumberOfComponents(3);
+      batch->Rotation = vtkSmartPointer<vtkDoubleArray>::New();
+      batch->AngularVel = vtkSmartPointer<vtkDoubleArray>::New();
+    }
+    batch->Buffers = { batch->Points, batch->PointData, batch->Time, batch->VelocityVectors,
+      batch->Vorticity, batch->Rotation, batch->AngularVel };
+    const double nan = vtkMath::Nan();
+    batch->LastPoint[0] = batch->LastPoint[1] = batch->LastPoint[2] = nan;
+    batch->LastUsedStepSize = nan;
+    return batch;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData& local = this->Local.Local();
+    std::shared_ptr<SeedBatch> batch = this->NewBatch(begin);
+    local.Batches.push_back(batch);
+
+    int direction = 1;
+    for (vtkIdType line = begin; line < end && !this->Abort; ++line)
+    {
+      switch (this->IntegrationDirections->GetValue(line))
+      {
+        case vtkStreamTracer::FORWARD:
+          direction = 1;
+          break;
+        case vtkStreamTracer::BACKWARD:
+          direction = -1;
+          break;
+      }
+
+      // Each seed starts its search in the first dataset, as if it was the
+      // first one integrated by the velocity field.
+      double seed[3];
+      this->SeedSource->GetTuple(this->SeedIds->GetId(line), seed);
+      local.Func->SetLastCellId(-1, 0);
+
+      double propagation = 0.0;
+      vtkIdType numSteps = 0;
+      double integrationTime = 0.0;
+      vtkIdType numPts = 0;
+      int retVal = vtkStreamTracer::OUT_OF_LENGTH;
+      int shouldAbort = 0;
+      if (!this->Tracer->IntegrateStreamline(batch->Buffers, seed, direction, line, 0, local.Func,
+            local.Integrator, nullptr, local.Cell, local.CellVectors, local.Weights.data(),
+            this->VecType, this->VecName, propagation, numSteps, integrationTime, batch->LastPoint,
+            batch->LastUsedStepSize, numPts, retVal, shouldAbort))
+      {
+        continue;
+      }
+      if (shouldAbort)
+      {
+        this->Abort = true;
+        break;
+      }
+
+      if (numPts > 1)
+      {
+        batch->LineStarts.push_back(batch->Points->GetNumberOfPoints() - numPts);
+        batch->LineSizes.push_back(numPts);
+        batch->RetVals.push_back(retVal);
+        batch->SeedIds.push_back(this->SeedIds->GetId(line));
+      }
+      batch->HasIntegrated = true;
+      batch->Propagation = propagation;
+      batch->NumSteps = numSteps;
+      batch->IntegrationTime = integrationTime;
+    }
+  }
+
+  void Reduce()
+  {
+    if (this->Abort)
+    {
+      return;
+    }
+
+    std::vector<std::shared_ptr<SeedBatch>> batches;
+    for (LocalData& local : this->Local)
+    {
+      batches.insert(batches.end(), local.Batches.begin(), local.Batches.end());
+    }
+    std::sort(batches.begin(), batches.end(),
+      [](const std::shared_ptr<SeedBatch>& a, const std::shared_ptr<SeedBatch>& b) {
+        return a->Begin < b->Begin;
+      });
+
+    vtkStreamTracer::StreamlineBuffers& out = this->Output;
+    for (const std::shared_ptr<SeedBatch>& batch : batches)
+    {
+      vtkIdType offset = out.Points->GetNumberOfPoints();
+      vtkIdType numPts = batch->Points->GetNumberOfPoints();
+      if (numPts > 0)
+      {
+        out.Points->InsertPoints(offset, numPts, 0, batch->Points);
+        for (int i = 0; i < out.PointData->GetNumberOfArrays(); ++i)
+        {
+          out.PointData->GetAbstractArray(i)->InsertTuples(
+            offset, numPts, 0, batch->PointData->GetAbstractArray(i));
+        }
+        out.Time->InsertTuples(offset, numPts, 0, batch->Time);
+        if (out.VelocityVectors)
+        {
+          out.VelocityVectors->InsertTuples(offset, numPts, 0, batch->VelocityVectors);
+        }
+        if (out.Vorticity)
+        {
+          out.Vorticity->InsertTuples(offset, numPts, 0, batch->Vorticity);
+          out.Rotation->InsertTuples(offset, numPts, 0, batch->Rotation);
+          out.AngularVel->InsertTuples(offset, numPts, 0, batch->AngularVel);
+        }
+      }
+
+      for (size_t i = 0; i < batch->LineSizes.size(); ++i)
+      {
+        this->OutputLines->InsertNextCell(batch->LineSizes[i]);
+        for (vtkIdType j = 0; j < batch->LineSizes[i]; ++j)
+        {
+          this->OutputLines->InsertCellPoint(offset + batch->LineStarts[i] + j);
+        }
+        this->RetVals->InsertNextValue(batch->RetVals[i]);
+        this->SeedIdsOut->InsertNextValue(batch->SeedIds[i]);
+      }
+
+      if (batch->HasIntegrated)
+      {
+        this->HasIntegrated = true;
+        this->Propagation = batch->Propagation;
+        this->NumSteps = batch->NumSteps;
+        this->IntegrationTime = batch->IntegrationTime;
+      }
+      if (!vtkMath::IsNan(batch->LastPoint[0]))
+      {
+        std::copy(batch->LastPoint, batch->LastPoint + 3, this->LastPoint);
+      }
+      if (!vtkMath::IsNan(batch->LastUsedStepSize))
+      {
+        this->Tracer->LastUsedStepSize = batch->LastUsedStepSize;
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Seeds are integrated in parallel when each streamline only depends on its
+// seed: the velocity field must be one of the composite interpolators, whose
+// clones can share the datasets, and the integration must not be continued
+// from a previous one, nor use custom termination callbacks (which are given
+// all the points integrated so far), surface streamlines, or point data that
+// differs between the blocks of the input.
+bool vtkStreamTracer::CanIntegrateInParallel(vtkAbstractInterpolatedVelocityField* func,
+  vtkIdType numLines, double propagation, vtkIdType numSteps, double integrationTime)
+{
+  return !this->SequentialProcessing && numLines > 1 &&
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(func) && propagation == 0.0 &&
+    numSteps == 0 && integrationTime == 0.0 && this->CustomTerminationCallback.empty() &&
+    !this->SurfaceStreamlines && this->HasMatchingPointAttributes;
+}
+
+//------------------------------------------------------------------------------
+int vtkStreamTracer::IntegrateInParallel(StreamlineBuffers& buffers, vtkCellArray* outputLines,
+  vtkIntArray* retVals, vtkIntArray* sids, vtkPointData* input0Data, vtkDataArray* seedSource,
+  vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3],
+  vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType, const char* vecName,
+  double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime)
+{
+  vtkCompositeInterpolatedVelocityField* compositeFunc =
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(func);
+
+  // The datasets build their search structures (bounds, locators, links)
+  // lazily. Evaluate the field once in each of them beforehand, so that the
+  // threads only read these structures.
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(this->InputData->NewIterator());
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights;
+  int dataIndex = 0;
+  for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* input = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!input)
+    {
+      continue;
+    }
+    input->GetLength();
+    if (input->GetNumberOfCells() > 0)
+    {
+      double pcoords[3], x[3], velocity[3];
+      int subId;
+      input->GetCell(0, cell);
+      cell->GetParametricCenter(pcoords);
+      weights.resize(std::max<vtkIdType>(cell->GetNumberOfPoints(), maxCellSize));
+      cell->EvaluateLocation(subId, pcoords, x, weights.data());
+      compositeFunc->SetLastCellId(-1, dataIndex);
+      compositeFunc->FunctionValues(x, velocity);
+    }
+    ++dataIndex;
+  }
+
+  StreamlineIntegratingFunctor functor(this, buffers, outputLines, retVals, sids, input0Data,
+    seedSource, seedIds, integrationDirections, compositeFunc, maxCellSize, vecType, vecName,
+    lastPoint);
+  vtkSMPTools::For(0, seedIds->GetNumberOfIds(), functor);
+  if (functor.Abort)
+  {
+    return 0;
+  }
+
+  if (functor.HasIntegrated)
+  {
+    inPropagation = functor.Propagation;
+    inNumSteps = functor.NumSteps;
+    inIntegrationTime = functor.IntegrationTime;
+  }
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   vtkDataArray* seedSource, vtkIdList* seedIds, vtkIntArray* integrationDirections,
@@ -664,9 +1034,6 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   // Useful pointers
   vtkDataSetAttributes* outputPD = output->GetPointData();
   vtkDataSetAttributes* outputCD = output->GetCellData();
-  vtkPointData* inputPD;
-  vtkDataSet* input;
-  vtkDataArray* inVectors;
 
   int direction = 1;
 
@@ -772,370 +1139,74 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   //       the intermediate memory is timely released.
   outputPD->InterpolateAllocate(input0Data, this->MaximumNumberOfSteps);
 
-  vtkIdType numPtsTotal = 0;
-  double velocity[3];
+  StreamlineBuffers buffers = { outputPoints, outputPD, time, velocityVectors, vorticity, rotation,
+    angularVel };
 
   int shouldAbort = 0;
 
-  for (int currentLine = 0; currentLine < numLines; currentLine++)
+  if (this->CanIntegrateInParallel(func, numLines, propagation, numSteps, integrationTime))
   {
-    double progress = static_cast<double>(currentLine) / numLines;
-    this->UpdateProgress(progress);
-
-    switch (integrationDirections->GetValue(currentLine))
-    {
-      case FORWARD:
-        direction = 1;
-        break;
-      case BACKWARD:
-        direction = -1;
-        break;
-    }
-
-    // temporary variables used in the integration
-    double point1[3], point2[3], pcoords[3], vort[3], omega;
-    vtkIdType index, numPts = 0;
-
-    // Clear the last cell to avoid starting a search from
-    // the last point in the streamline
-    func->ClearLastCellId();
-
-    // Initial point
-    seedSource->GetTuple(seedIds->GetId(currentLine), point1);
-    memcpy(point2, point1, 3 * sizeof(double));
-    if (!func->FunctionValues(point1, velocity))
-    {
-      continue;
-    }
-
-    if (propagation >= this->MaximumPropagation || numSteps > this->MaximumNumberOfSteps)
-    {
-      continue;
-    }
-
-    numPts++;
-    numPtsTotal++;
-    vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
-    double lastInsertedPoint[3];
-    outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-    time->InsertNextValue(integrationTime);
-
-    // We will always pass an arc-length step size to the integrator.
-    // If the user specifies a step size in cell length unit, we will
-    // have to convert it to arc length.
-    IntervalInformation stepSize; // either positive or negative
-    stepSize.Unit = LENGTH_UNIT;
-    stepSize.Interval = 0;
-    IntervalInformation aStep; // always positive
-    aStep.Unit = LENGTH_UNIT;
-    double step, minStep = 0, maxStep = 0;
-    double stepTaken;
-    double speed;
-    double cellLength;
-    int retVal = OUT_OF_LENGTH, tmp;
-
-    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-    input = func->GetLastDataSet();
-    inputPD = input->GetPointData();
-    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
-    // Convert intervals to arc-length unit
-    input->GetCell(func->GetLastCellId(), cell);
-    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-    speed = vtkMath::Norm(velocity);
-    // Never call conversion methods if speed == 0
-    if (speed != 0.0)
-    {
-      this->ConvertIntervals(stepSize.Interval, minStep, maxStep, direction, cellLength);
-    }
-
-    // Interpolate all point attributes on first point
-    func->GetLastWeights(weights);
-    InterpolatePoint(
-      outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-    // handle both point and cell velocity attributes.
-    vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
-    if (vecType != vtkDataObject::POINT)
-    {
-      velocityVectors->InsertNextTuple(velocity);
-      outputVelocityVectors = velocityVectors;
-    }
-
-    // Compute vorticity if required
-    // This can be used later for streamribbon generation.
-    if (this->ComputeVorticity)
-    {
-      if (vecType == vtkDataObject::POINT)
-      {
-        inVectors->GetTuples(cell->PointIds, cellVectors);
-        func->GetLastLocalCoordinates(pcoords);
-        vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
-      }
-      else
-      {
-        vort[0] = 0;
-        vort[1] = 0;
-        vort[2] = 0;
-      }
-      vorticity->InsertNextTuple(vort);
-      // rotation
-      // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
-      if (speed != 0.0)
-      {
-        omega = vtkMath::Dot(vort, velocity);
-        omega /= speed;
-        omega *= this->RotationScale;
-      }
-      else
-      {
-        omega = 0.0;
-      }
-      angularVel->InsertNextValue(omega);
-      rotation->InsertNextValue(0.0);
-    }
-
-    double error = 0;
-
-    // Integrate until the maximum propagation length is reached,
-    // maximum number of steps is reached or until a boundary is encountered.
-    // Begin Integration
-    while (propagation < this->MaximumPropagation)
+    shouldAbort = !this->IntegrateInParallel(buffers, outputLines, retVals, sids, input0Data,
+      seedSource, seedIds, integrationDirections, lastPoint, func, maxCellSize, vecType, vecName,
+      inPropagation, inNumSteps, inIntegrationTime);
+  }
+  else
+  {
+    for (int currentLine = 0; currentLine < numLines; currentLine++)
     {
+      double progress = static_cast<double>(currentLine) / numLines;
+      this->UpdateProgress(progress);
 
-      if (numSteps > this->MaximumNumberOfSteps)
-      {
-        retVal = OUT_OF_STEPS;
-        break;
-      }
-
-      bool endIntegration = false;
-      for (std::size_t i = 0; i < this->CustomTerminationCallback.size(); ++i)
+      switch (integrationDirections->GetValue(currentLine))
       {
-        if (this->CustomTerminationCallback[i](
-              this->CustomTerminationClientData[i], outputPoints, outputVelocityVectors, direction))
-        {
-          retVal = this->CustomReasonForTermination[i];
-          endIntegration = true;
+        case FORWARD:
+          direction = 1;
           break;
-        }
-      }
-      if (endIntegration)
-      {
-        break;
-      }
-
-      if (numSteps++ % 1000 == 1)
-      {
-        progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
-        this->UpdateProgress(progress);
-
-        if (this->GetAbortExecute())
-        {
-          shouldAbort = 1;
+        case BACKWARD:
+          direction = -1;
           break;
-        }
       }
 
-      // Never call conversion methods if speed == 0
-      if ((speed == 0) || (speed <= this->TerminalSpeed))
+      double seed[3];
+      seedSource->GetTuple(seedIds->GetId(currentLine), seed);
+      vtkIdType numPts = 0;
+      int retVal = OUT_OF_LENGTH;
+      if (!this->IntegrateStreamline(buffers, seed, direction, currentLine, numLines, func,
+            integrator, surfaceFunc, cell, cellVectors, weights, vecType, vecName, propagation,
+            numSteps, integrationTime, lastPoint, this->LastUsedStepSize, numPts, retVal,
+            shouldAbort))
       {
-        retVal = STAGNATION;
-        break;
+        continue;
       }
 
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      aStep.Interval = fabs(stepSize.Interval);
-
-      if ((propagation + aStep.Interval) > this->MaximumPropagation)
+      if (shouldAbort)
       {
-        aStep.Interval = this->MaximumPropagation - propagation;
-        if (stepSize.Interval >= 0)
-        {
-          stepSize.Interval = this->ConvertToLength(aStep, cellLength);
-        }
-        else
-        {
-          stepSize.Interval = this->ConvertToLength(aStep, cellLength) * (-1.0);
-        }
-        maxStep = stepSize.Interval;
-      }
-      this->LastUsedStepSize = stepSize.Interval;
-
-      // Calculate the next step using the integrator provided
-      // Break if the next point is out of bounds.
-      func->SetNormalizeVector(true);
-      tmp = integrator->ComputeNextStep(point1, point2, 0, stepSize.Interval, stepTaken, minStep,
-        maxStep, this->MaximumError, error);
-      func->SetNormalizeVector(false);
-      if (tmp != 0)
-      {
-        retVal = tmp;
-        memcpy(lastPoint, point2, 3 * sizeof(double));
         break;
       }
 
-      // This is the next starting point
-      if (this->SurfaceStreamlines && surfaceFunc != nullptr)
+      if (numPts > 1)
       {
-        if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
+        vtkIdType numPtsTotal = outputPoints->GetNumberOfPoints();
+        outputLines->InsertNextCell(numPts);
+        for (vtkIdType i = numPtsTotal - numPts; i < numPtsTotal; i++)
         {
-          retVal = OUT_OF_DOMAIN;
-          memcpy(lastPoint, point2, 3 * sizeof(double));
-          break;
+          outputLines->InsertCellPoint(i);
         }
-      }
-      else
-      {
-        for (int i = 0; i < 3; i++)
-        {
-          point1[i] = point2[i];
-        }
-      }
-
-      // Interpolate the velocity at the next point
-      if (!func->FunctionValues(point2, velocity))
-      {
-        retVal = OUT_OF_DOMAIN;
-        memcpy(lastPoint, point2, 3 * sizeof(double));
-        break;
-      }
-
-      // It is not enough to use the starting point for stagnation calculation
-      // Use average speed to check if it is below stagnation threshold
-      double speed2 = vtkMath::Norm(velocity);
-      if ((speed + speed2) / 2 <= this->TerminalSpeed)
-      {
-        retVal = STAGNATION;
-        break;
+        retVals->InsertNextValue(retVal);
+        sids->InsertNextValue(seedIds->GetId(currentLine));
       }
 
-      integrationTime += stepTaken / speed;
-      // Calculate propagation (using the same units as MaximumPropagation
-      propagation += fabs(stepSize.Interval);
+      // Initialize these to 0 before starting the next line.
+      // The values passed in the function call are only used
+      // for the first line.
+      inPropagation = propagation;
+      inNumSteps = numSteps;
+      inIntegrationTime = integrationTime;
 
-      // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-      input = func->GetLastDataSet();
-      inputPD = input->GetPointData();
-      inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
-
-      // Calculate cell length and speed to be used in unit conversions
-      input->GetCell(func->GetLastCellId(), cell);
-      cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-      speed = speed2;
-
-      // Check if conversion to float will produce a point in same place
-      float convertedPoint[3];
-      for (int i = 0; i < 3; i++)
-      {
-        convertedPoint[i] = point1[i];
-      }
-      if (lastInsertedPoint[0] != convertedPoint[0] || lastInsertedPoint[1] != convertedPoint[1] ||
-        lastInsertedPoint[2] != convertedPoint[2])
-      {
-        // Point is valid. Insert it.
-        numPts++;
-        numPtsTotal++;
-        nextPoint = outputPoints->InsertNextPoint(point1);
-        outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-        time->InsertNextValue(integrationTime);
-
-        // Interpolate all point attributes on current point
-        func->GetLastWeights(weights);
-        InterpolatePoint(
-          outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-
-        if (vecType != vtkDataObject::POINT)
-        {
-          velocityVectors->InsertNextTuple(velocity);
-        }
-        // Compute vorticity if required
-        // This can be used later for streamribbon generation.
-        if (this->ComputeVorticity)
-        {
-          if (vecType == vtkDataObject::POINT)
-          {
-            inVectors->GetTuples(cell->PointIds, cellVectors);
-            func->GetLastLocalCoordinates(pcoords);
-            vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
-          }
-          else
-          {
-            vort[0] = 0;
-            vort[1] = 0;
-            vort[2] = 0;
-          }
-          vorticity->InsertNextTuple(vort);
-          // rotation
-          // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
-          // rotation = sum ( angular velocity * stepSize )
-          omega = vtkMath::Dot(vort, velocity);
-          omega /= speed;
-          omega *= this->RotationScale;
-          index = angularVel->InsertNextValue(omega);
-          rotation->InsertNextValue(rotation->GetValue(index - 1) +
-            (angularVel->GetValue(index - 1) + omega) / 2 *
-              (integrationTime - time->GetValue(index - 1)));
-        }
-      }
-
-      // Never call conversion methods if speed == 0
-      if ((speed == 0) || (speed <= this->TerminalSpeed))
-      {
-        retVal = STAGNATION;
-        break;
-      }
-
-      // Convert all intervals to arc length
-      this->ConvertIntervals(step, minStep, maxStep, direction, cellLength);
-
-      // If the solver is adaptive and the next step size (stepSize.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the cell
-      // size (unless it is specified in arc-length unit)
-      if (integrator->IsAdaptive())
-      {
-        if (fabs(stepSize.Interval) < fabs(minStep))
-        {
-          stepSize.Interval = fabs(minStep) * stepSize.Interval / fabs(stepSize.Interval);
-        }
-        else if (fabs(stepSize.Interval) > fabs(maxStep))
-        {
-          stepSize.Interval = fabs(maxStep) * stepSize.Interval / fabs(stepSize.Interval);
-        }
-      }
-      else
-      {
-        stepSize.Interval = step;
-      }
+      propagation = 0;
+      numSteps = 0;
+      integrationTime = 0;
     }
-
-    if (shouldAbort)
-    {
-      break;
-    }
-
-    if (numPts > 1)
-    {
-      outputLines->InsertNextCell(numPts);
-      for (int i = numPtsTotal - numPts; i < numPtsTotal; i++)
-      {
-        outputLines->InsertCellPoint(i);
-      }
-      retVals->InsertNextValue(retVal);
-      sids->InsertNextValue(seedIds->GetId(currentLine));
-    }
-
-    // Initialize these to 0 before starting the next line.
-    // The values passed in the function call are only used
-    // for the first line.
-    inPropagation = propagation;
-    inNumSteps = numSteps;
-    inIntegrationTime = integrationTime;
-
-    propagation = 0;
-    numSteps = 0;
-    integrationTime = 0;
   }
 
   if (!shouldAbort)
@@ -1196,6 +1267,355 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   output->Squeeze();
 }
 
+//------------------------------------------------------------------------------
+// Integrate the streamline of a single seed, appending its points to the
+// buffers. Returns false when the seed is not integrated at all (outside the
+// domain or past the limits), in which case nothing is appended. Progress is
+// only reported when numLines is positive.
+bool vtkStreamTracer::IntegrateStreamline(StreamlineBuffers& buffers, double seed[3],
+  int direction, vtkIdType currentLine, vtkIdType numLines,
+  vtkAbstractInterpolatedVelocityField* func, vtkInitialValueProblemSolver* integrator,
+  vtkInterpolatedVelocityField* surfaceFunc, vtkGenericCell* cell, vtkDoubleArray* cellVectors,
+  double* weights, int vecType, const char* vecName, double& propagation, vtkIdType& numSteps,
+  double& integrationTime, double lastPoint[3], double& lastUsedStepSize, vtkIdType& numPts,
+  int& retVal, int& shouldAbort)
+{
+  vtkPoints* outputPoints = buffers.Points;
+  vtkDataSetAttributes* outputPD = buffers.PointData;
+  vtkDoubleArray* time = buffers.Time;
+  vtkDoubleArray* velocityVectors = buffers.VelocityVectors;
+  vtkDoubleArray* vorticity = buffers.Vorticity;
+  vtkDoubleArray* rotation = buffers.Rotation;
+  vtkDoubleArray* angularVel = buffers.AngularVel;
+  vtkPointData* inputPD;
+  vtkDataSet* input;
+  vtkDataArray* inVectors;
+  double velocity[3];
+
+  // temporary variables used in the integration
+  double point1[3], point2[3], pcoords[3], vort[3], omega;
+  vtkIdType index;
+  numPts = 0;
+
+  // Clear the last cell to avoid starting a search from
+  // the last point in the streamline
+  func->ClearLastCellId();
+
+  // Initial point
+  memcpy(point1, seed, 3 * sizeof(double));
+  memcpy(point2, point1, 3 * sizeof(double));
+  if (!func->FunctionValues(point1, velocity))
+  {
+    return false;
+  }
+
+  if (propagation >= this->MaximumPropagation || numSteps > this->MaximumNumberOfSteps)
+  {
+    return false;
+  }
+
+  numPts++;
+  vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
+  double lastInsertedPoint[3];
+  outputPoints->GetPoint(nextPoint, lastInsertedPoint);
+  time->InsertNextValue(integrationTime);
+
+  // We will always pass an arc-length step size to the integrator.
+  // If the user specifies a step size in cell length unit, we will
+  // have to convert it to arc length.
+  IntervalInformation stepSize; // either positive or negative
+  stepSize.Unit = LENGTH_UNIT;
+  stepSize.Interval = 0;
+  IntervalInformation aStep; // always positive
+  aStep.Unit = LENGTH_UNIT;
+  double step, minStep = 0, maxStep = 0;
+  double stepTaken;
+  double speed;
+  double cellLength;
+  int tmp;
+  retVal = OUT_OF_LENGTH;
+
+  // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+  input = func->GetLastDataSet();
+  inputPD = input->GetPointData();
+  inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+  // Convert intervals to arc-length unit
+  input->GetCell(func->GetLastCellId(), cell);
+  cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+  speed = vtkMath::Norm(velocity);
+  // Never call conversion methods if speed == 0
+  if (speed != 0.0)
+  {
+    this->ConvertIntervals(stepSize.Interval, minStep, maxStep, direction, cellLength);
+  }
+
+  // Interpolate all point attributes on first point
+  func->GetLastWeights(weights);
+  InterpolatePoint(
+    outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
+  // handle both point and cell velocity attributes.
+  vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
+  if (vecType != vtkDataObject::POINT)
+  {
+    velocityVectors->InsertNextTuple(velocity);
+    outputVelocityVectors = velocityVectors;
+  }
+
+  // Compute vorticity if required
+  // This can be used later for streamribbon generation.
+  if (this->ComputeVorticity)
+  {
+    if (vecType == vtkDataObject::POINT)
+    {
+      inVectors->GetTuples(cell->PointIds, cellVectors);
+      func->GetLastLocalCoordinates(pcoords);
+      vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
+    }
+    else
+    {
+      vort[0] = 0;
+      vort[1] = 0;
+      vort[2] = 0;
+    }
+    vorticity->InsertNextTuple(vort);
+    // rotation
+    // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
+    if (speed != 0.0)
+    {
+      omega = vtkMath::Dot(vort, velocity);
+      omega /= speed;
+      omega *= this->RotationScale;
+    }
+    else
+    {
+      omega = 0.0;
+    }
+    angularVel->InsertNextValue(omega);
+    rotation->InsertNextValue(0.0);
+  }
+
+  double error = 0;
+
+  // Integrate until the maximum propagation length is reached,
+  // maximum number of steps is reached or until a boundary is encountered.
+  // Begin Integration
+  while (propagation < this->MaximumPropagation)
+  {
+
+    if (numSteps > this->MaximumNumberOfSteps)
+    {
+      retVal = OUT_OF_STEPS;
+      break;
+    }
+
+    bool endIntegration = false;
+    for (std::size_t i = 0; i < this->CustomTerminationCallback.size(); ++i)
+    {
+      if (this->CustomTerminationCallback[i](
+            this->CustomTerminationClientData[i], outputPoints, outputVelocityVectors, direction))
+      {
+        retVal = this->CustomReasonForTermination[i];
+        endIntegration = true;
+        break;
+      }
+    }
+    if (endIntegration)
+    {
+      break;
+    }
+
+    if (numSteps++ % 1000 == 1)
+    {
+      if (numLines > 0)
+      {
+        double progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
+        this->UpdateProgress(progress);
+      }
+
+      if (this->GetAbortExecute())
+      {
+        shouldAbort = 1;
+        break;
+      }
+    }
+
+    // Never call conversion methods if speed == 0
+    if ((speed == 0) || (speed <= this->TerminalSpeed))
+    {
+      retVal = STAGNATION;
+      break;
+    }
+
+    // If, with the next step, propagation will be larger than
+    // max, reduce it so that it is (approximately) equal to max.
+    aStep.Interval = fabs(stepSize.Interval);
+
+    if ((propagation + aStep.Interval) > this->MaximumPropagation)
+    {
+      aStep.Interval = this->MaximumPropagation - propagation;
+      if (stepSize.Interval >= 0)
+      {
+        stepSize.Interval = this->ConvertToLength(aStep, cellLength);
+      }
+      else
+      {
+        stepSize.Interval = this->ConvertToLength(aStep, cellLength) * (-1.0);
+      }
+      maxStep = stepSize.Interval;
+    }
+    lastUsedStepSize = stepSize.Interval;
+
+    // Calculate the next step using the integrator provided
+    // Break if the next point is out of bounds.
+    func->SetNormalizeVector(true);
+    tmp = integrator->ComputeNextStep(point1, point2, 0, stepSize.Interval, stepTaken, minStep,
+      maxStep, this->MaximumError, error);
+    func->SetNormalizeVector(false);
+    if (tmp != 0)
+    {
+      retVal = tmp;
+      memcpy(lastPoint, point2, 3 * sizeof(double));
+      break;
+    }
+
+    // This is the next starting point
+    if (this->SurfaceStreamlines && surfaceFunc != nullptr)
+    {
+      if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
+      {
+        retVal = OUT_OF_DOMAIN;
+        memcpy(lastPoint, point2, 3 * sizeof(double));
+        break;
+      }
+    }
+    else
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        point1[i] = point2[i];
+      }
+    }
+
+    // Interpolate the velocity at the next point
+    if (!func->FunctionValues(point2, velocity))
+    {
+      retVal = OUT_OF_DOMAIN;
+      memcpy(lastPoint, point2, 3 * sizeof(double));
+      break;
+    }
+
+    // It is not enough to use the starting point for stagnation calculation
+    // Use average speed to check if it is below stagnation threshold
+    double speed2 = vtkMath::Norm(velocity);
+    if ((speed + speed2) / 2 <= this->TerminalSpeed)
+    {
+      retVal = STAGNATION;
+      break;
+    }
+
+    integrationTime += stepTaken / speed;
+    // Calculate propagation (using the same units as MaximumPropagation
+    propagation += fabs(stepSize.Interval);
+
+    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+    input = func->GetLastDataSet();
+    inputPD = input->GetPointData();
+    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+
+    // Calculate cell length and speed to be used in unit conversions
+    input->GetCell(func->GetLastCellId(), cell);
+    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+    speed = speed2;
+
+    // Check if conversion to float will produce a point in same place
+    float convertedPoint[3];
+    for (int i = 0; i < 3; i++)
+    {
+      convertedPoint[i] = point1[i];
+    }
+    if (lastInsertedPoint[0] != convertedPoint[0] || lastInsertedPoint[1] != convertedPoint[1] ||
+      lastInsertedPoint[2] != convertedPoint[2])
+    {
+      // Point is valid. Insert it.
+      numPts++;
+      nextPoint = outputPoints->InsertNextPoint(point1);
+      outputPoints->GetPoint(nextPoint, lastInsertedPoint);
+      time->InsertNextValue(integrationTime);
+
+      // Interpolate all point attributes on current point
+      func->GetLastWeights(weights);
+      InterpolatePoint(
+        outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
+
+      if (vecType != vtkDataObject::POINT)
+      {
+        velocityVectors->InsertNextTuple(velocity);
+      }
+      // Compute vorticity if required
+      // This can be used later for streamribbon generation.
+      if (this->ComputeVorticity)
+      {
+        if (vecType == vtkDataObject::POINT)
+        {
+          inVectors->GetTuples(cell->PointIds, cellVectors);
+          func->GetLastLocalCoordinates(pcoords);
+          vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
+        }
+        else
+        {
+          vort[0] = 0;
+          vort[1] = 0;
+          vort[2] = 0;
+        }
+        vorticity->InsertNextTuple(vort);
+        // rotation
+        // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
+        // rotation = sum ( angular velocity * stepSize )
+        omega = vtkMath::Dot(vort, velocity);
+        omega /= speed;
+        omega *= this->RotationScale;
+        index = angularVel->InsertNextValue(omega);
+        rotation->InsertNextValue(rotation->GetValue(index - 1) +
+          (angularVel->GetValue(index - 1) + omega) / 2 *
+            (integrationTime - time->GetValue(index - 1)));
+      }
+    }
+
+    // Never call conversion methods if speed == 0
+    if ((speed == 0) || (speed <= this->TerminalSpeed))
+    {
+      retVal = STAGNATION;
+      break;
+    }
+
+    // Convert all intervals to arc length
+    this->ConvertIntervals(step, minStep, maxStep, direction, cellLength);
+
+    // If the solver is adaptive and the next step size (stepSize.Interval)
+    // that the solver wants to use is smaller than minStep or larger
+    // than maxStep, re-adjust it. This has to be done every step
+    // because minStep and maxStep can change depending on the cell
+    // size (unless it is specified in arc-length unit)
+    if (integrator->IsAdaptive())
+    {
+      if (fabs(stepSize.Interval) < fabs(minStep))
+      {
+        stepSize.Interval = fabs(minStep) * stepSize.Interval / fabs(stepSize.Interval);
+      }
+      else if (fabs(stepSize.Interval) > fabs(maxStep))
+      {
+        stepSize.Interval = fabs(maxStep) * stepSize.Interval / fabs(stepSize.Interval);
+      }
+    }
+    else
+    {
+      stepSize.Interval = step;
+    }
+  }
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkStreamTracer::GenerateNormals(vtkPolyData* output, double* firstNormal, const char* vecName)
 {
@@ -1407,6 +1827,7 @@ void vtkStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Maximum number of steps: " << this->MaximumNumberOfSteps << endl;
   os << indent << "Vorticity computation: " << (this->ComputeVorticity ? " On" : " Off") << endl;
   os << indent << "Rotation scale: " << this->RotationScale << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -69,6 +69,14 @@
  * a source object, traces will be generated from each point in the source
  * that is inside the dataset.
  *
+ * When the velocity field is interpolated by one of the default
+ * interpolators (or any vtkCompositeInterpolatedVelocityField), the seeds
+ * are integrated in parallel with vtkSMPTools: each thread integrates its
+ * seeds with its own copy of the interpolator, which shares the cell
+ * locators of the input. The streamlines are assembled in seed order, so
+ * the output does not depend on the number of threads. Custom termination
+ * callbacks and surface streamlines are always processed serially.
+ *
  * @note Field data is shallow copied to the output. When the input is a
  * composite data set, field data associated with the root block is shallow-
  * copied to the output vtkPolyData.
@@ -92,6 +100,7 @@
 #include "vtkInitialValueProblemSolver.h" // Needed for constants
 
 class vtkAbstractInterpolatedVelocityField;
+class vtkCellArray;
 class vtkCompositeDataSet;
 class vtkDataArray;
 class vtkDataSetAttributes;
@@ -100,6 +109,8 @@ class vtkExecutive;
 class vtkGenericCell;
 class vtkIdList;
 class vtkIntArray;
+class vtkInterpolatedVelocityField;
+class vtkPointData;
 class vtkPoints;
 
 #include <vector>
@@ -380,6 +391,20 @@ public:
   void AddCustomTerminationCallback(
     CustomTerminationCallbackType callback, void* clientdata, int reasonForTermination);
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when integrating the
+   * seeds. By default, sequential processing is off. Note this flag only
+   * applies if the class has been compiled with VTK_SMP_IMPLEMENTATION_TYPE
+   * set to something other than Sequential. (If set to Sequential, then the
+   * filter always runs in serial mode.) This flag is typically used for
+   * benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkStreamTracer();
   ~vtkStreamTracer() override;
@@ -402,6 +427,23 @@ protected:
     vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3],
     vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType,
     const char* vecFieldName, double& propagation, vtkIdType& numSteps, double& integrationTime);
+
+  struct StreamlineBuffers;
+  bool IntegrateStreamline(StreamlineBuffers& buffers, double seed[3], int direction,
+    vtkIdType currentLine, vtkIdType numLines, vtkAbstractInterpolatedVelocityField* func,
+    vtkInitialValueProblemSolver* integrator, vtkInterpolatedVelocityField* surfaceFunc,
+    vtkGenericCell* cell, vtkDoubleArray* cellVectors, double* weights, int vecType,
+    const char* vecName, double& propagation, vtkIdType& numSteps, double& integrationTime,
+    double lastPoint[3], double& lastUsedStepSize, vtkIdType& numPts, int& retVal,
+    int& shouldAbort);
+  bool CanIntegrateInParallel(vtkAbstractInterpolatedVelocityField* func, vtkIdType numLines,
+    double propagation, vtkIdType numSteps, double integrationTime);
+  int IntegrateInParallel(StreamlineBuffers& buffers, vtkCellArray* outputLines,
+    vtkIntArray* retVals, vtkIntArray* sids, vtkPointData* input0Data, vtkDataArray* seedSource,
+    vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3],
+    vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType, const char* vecName,
+    double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime);
+
   double SimpleIntegrate(double seed[3], double lastPoint[3], double stepSize,
     vtkAbstractInterpolatedVelocityField* func);
   int CheckInputs(vtkAbstractInterpolatedVelocityField*& func, int* maxCellSize);
@@ -461,7 +503,10 @@ protected:
   std::vector<void*> CustomTerminationClientData;
   std::vector<int> CustomReasonForTermination;
 
+  vtkTypeBool SequentialProcessing;
+
   friend class PStreamTracerUtils;
+  friend struct StreamlineIntegratingFunctor;
 
 private:
   vtkStreamTracer(const vtkStreamTracer&) = delete;
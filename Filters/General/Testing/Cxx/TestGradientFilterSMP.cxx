@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGradientFilterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded gradients of unstructured grids match the serial
+// ones exactly, and that the fast path of linear tetrahedra and hexahedra
+// recovers the gradient of a linear field.
+
+#include "vtkGradientFilter.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// The coefficients of the linear field used to check the fast path.
+const double FieldGradient[3][3] = { { 1.0, -2.0, 0.5 }, { 0.25, 3.0, -1.0 },
+  { -0.75, 0.5, 2.0 } };
+
+// Cells of the given types on a grid with slightly moved points, so that
+// the cells are not parallelepipeds, with a linear and a nonlinear vector
+// field at the points and a vector field on the cells.
+void MakeInput(const int* cellTypes, int numCellTypes, vtkUnstructuredGrid* input)
+{
+  vtkNew<vtkAppendFilter> append;
+  append->MergePointsOn();
+  for (int i = 0; i < numCellTypes; ++i)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellTypes[i]);
+    source->SetBlocksDimensions(7, 6, 5);
+    source->Update();
+    append->AddInputData(source->GetOutput());
+  }
+  append->Update();
+  input->DeepCopy(append->GetOutput());
+
+  vtkPoints* points = input->GetPoints();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  linear->SetNumberOfComponents(3);
+  linear->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> waves;
+  waves->SetName("Waves");
+  waves->SetNumberOfComponents(3);
+  waves->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    x[0] += 0.15 * std::sin(1.7 * x[1] + x[2]);
+    x[1] += 0.1 * std::cos(x[0] + 2.3 * x[2]);
+    x[2] += 0.12 * std::sin(x[0] * x[1]);
+    points->SetPoint(i, x);
+    points->GetPoint(i, x);
+    for (int c = 0; c < 3; ++c)
+    {
+      linear->SetComponent(i, c,
+        FieldGradient[c][0] * x[0] + FieldGradient[c][1] * x[1] + FieldGradient[c][2] * x[2] + c);
+    }
+    waves->SetComponent(i, 0, std::sin(0.5 * x[0]) * x[1]);
+    waves->SetComponent(i, 1, std::cos(0.4 * x[1] + x[2]));
+    waves->SetComponent(i, 2, x[0] * x[2] * 0.1);
+  }
+  input->GetPointData()->AddArray(linear);
+  input->GetPointData()->AddArray(waves);
+
+  vtkNew<vtkDoubleArray> cellWaves;
+  cellWaves->SetName("CellWaves");
+  cellWaves->SetNumberOfComponents(3);
+  cellWaves->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellWaves->SetComponent(i, 0, std::sin(0.01 * i));
+    cellWaves->SetComponent(i, 1, std::cos(0.02 * i));
+    cellWaves->SetComponent(i, 2, 0.001 * (i % 97));
+  }
+  input->GetCellData()->AddArray(cellWaves);
+}
+
+void SetupFilter(vtkGradientFilter* filter, vtkDataSet* input, int association, const char* name)
+{
+  filter->SetInputData(input);
+  filter->SetInputScalars(association, name);
+  filter->ComputeDivergenceOn();
+  filter->ComputeVorticityOn();
+  filter->ComputeQCriterionOn();
+}
+
+bool CompareSerialAndThreaded(vtkDataSet* input, int association, const char* name,
+  int contributingCellOption, bool fasterApproximation)
+{
+  vtkNew<vtkGradientFilter> filters[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    SetupFilter(filters[i], input, association, name);
+    filters[i]->SetContributingCellOption(contributingCellOption);
+    filters[i]->SetFasterApproximation(fasterApproximation);
+    filters[i]->SetSequentialProcessing(i == 0);
+    filters[i]->Update();
+  }
+
+  vtkDataSet* serial = filters[0]->GetOutput();
+  vtkDataSet* threaded = filters[1]->GetOutput();
+  vtkDataSetAttributes* outputData = association == vtkDataObject::FIELD_ASSOCIATION_POINTS
+    ? static_cast<vtkDataSetAttributes*>(serial->GetPointData())
+    : static_cast<vtkDataSetAttributes*>(serial->GetCellData());
+  const char* names[] = { "Gradients", "Divergence", "Vorticity", "Q-criterion" };
+  for (const char* arrayName : names)
+  {
+    if (!outputData->GetArray(arrayName))
+    {
+      std::cerr << "Missing " << arrayName << " array" << std::endl;
+      return false;
+    }
+  }
+  return vtkTest::SameAttributes(serial->GetPointData(), threaded->GetPointData()) &&
+    vtkTest::SameAttributes(serial->GetCellData(), threaded->GetCellData());
+}
+
+// The gradient of the linear field must be recovered at every point and,
+// with the faster approximation, at every cell.
+bool CheckLinearField(vtkUnstructuredGrid* input)
+{
+  for (int faster = 0; faster < 2; ++faster)
+  {
+    vtkNew<vtkGradientFilter> filter;
+    SetupFilter(filter, input, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Linear");
+    filter->SetFasterApproximation(faster);
+    filter->Update();
+    vtkDataArray* gradients = filter->GetOutput()->GetPointData()->GetArray("Gradients");
+    for (vtkIdType i = 0; i < gradients->GetNumberOfTuples(); ++i)
+    {
+      for (int c = 0; c < 9; ++c)
+      {
+        if (!vtkMathUtilities::FuzzyCompare(
+              gradients->GetComponent(i, c), FieldGradient[c / 3][c % 3], 1e-8))
+        {
+          std::cerr << "Wrong gradient " << gradients->GetComponent(i, c) << " at point " << i
+                    << " instead of " << FieldGradient[c / 3][c % 3] << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestGradientFilterSMP(int, char*[])
+{
+  // Linear tetrahedra and hexahedra only go through the fast path.
+  const int linearTypes[] = { VTK_TETRA, VTK_HEXAHEDRON };
+  for (int cellType : linearTypes)
+  {
+    vtkNew<vtkUnstructuredGrid> input;
+    MakeInput(&cellType, 1, input);
+    if (!CheckLinearField(input))
+    {
+      std::cerr << "Linear field not recovered for cell type " << cellType << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Mix cells of all dimensions and orders, with and without fast path.
+  const int cellTypes[] = { VTK_TETRA, VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID,
+    VTK_QUADRATIC_TETRA, VTK_TRIANGLE, VTK_QUAD, VTK_LINE };
+  vtkNew<vtkUnstructuredGrid> input;
+  MakeInput(cellTypes, static_cast<int>(sizeof(cellTypes) / sizeof(cellTypes[0])), input);
+
+  const int options[] = { vtkGradientFilter::All, vtkGradientFilter::Patch,
+    vtkGradientFilter::DataSetMax };
+  for (int option : options)
+  {
+    for (int faster = 0; faster < 2; ++faster)
+    {
+      if (!CompareSerialAndThreaded(
+            input, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Waves", option, faster != 0))
+      {
+        std::cerr << "Threaded point gradients differ for option " << option
+                  << " and faster approximation " << faster << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (!CompareSerialAndThreaded(
+          input, vtkDataObject::FIELD_ASSOCIATION_CELLS, "CellWaves", option, false))
+    {
+      std::cerr << "Threaded cell gradients differ for option " << option << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
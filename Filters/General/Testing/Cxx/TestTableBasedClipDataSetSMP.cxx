@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded clipping of unstructured grids produces exactly
+// the same output as the serial path.
+
+#include "vtkTableBasedClipDataSet.h"
+
+#include "vtkBitArray.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkElevationFilter.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSphere.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+int TestTableBasedClipDataSetSMP(int, char*[])
+{
+  const int cellTypes[] = { VTK_TETRA, VTK_PYRAMID, VTK_WEDGE, VTK_HEXAHEDRON, VTK_TRIANGLE,
+    VTK_QUAD, VTK_LINE };
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(2.1, 1.3, 0.9);
+  sphere->SetRadius(2.2);
+
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(13, 11, 9);
+
+    vtkNew<vtkElevationFilter> elevation;
+    elevation->SetInputConnection(source->GetOutputPort());
+    elevation->SetLowPoint(0, 0, 0);
+    elevation->SetHighPoint(13, 11, 9);
+    elevation->Update();
+
+    vtkNew<vtkUnstructuredGrid> input;
+    input->ShallowCopy(elevation->GetOutput());
+
+    // An integral point array exercises the rounding of interpolated values
+    vtkNew<vtkIntArray> ids;
+    ids->SetName("Ids");
+    ids->SetNumberOfTuples(input->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      ids->SetValue(i, static_cast<int>(i * 7 % 31));
+    }
+    input->GetPointData()->AddArray(ids);
+
+    // Bit arrays are copied serially, since neighbor tuples share bytes.
+    vtkNew<vtkUnstructuredGrid> bitInput;
+    bitInput->ShallowCopy(input);
+    vtkNew<vtkBitArray> pointBits;
+    pointBits->SetName("PointBits");
+    pointBits->SetNumberOfTuples(input->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      pointBits->SetValue(i, static_cast<int>(i % 3 == 0));
+    }
+    bitInput->GetPointData()->AddArray(pointBits);
+    vtkNew<vtkBitArray> cellBits;
+    cellBits->SetName("CellBits");
+    cellBits->SetNumberOfTuples(input->GetNumberOfCells());
+    for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+    {
+      cellBits->SetValue(i, static_cast<int>(i % 5 < 2));
+    }
+    bitInput->GetCellData()->AddArray(cellBits);
+
+    for (int test = 0; test < 4; ++test)
+    {
+      vtkUnstructuredGrid* data = test < 2 ? input.GetPointer() : bitInput.GetPointer();
+      const int insideOut = test % 2;
+      vtkNew<vtkTableBasedClipDataSet> serial;
+      serial->SetInputData(data);
+      serial->SetClipFunction(sphere);
+      serial->SetInsideOut(insideOut);
+      serial->GenerateClippedOutputOn();
+      serial->SequentialProcessingOn();
+      serial->Update();
+
+      vtkNew<vtkTableBasedClipDataSet> threaded;
+      threaded->SetInputData(data);
+      threaded->SetClipFunction(sphere);
+      threaded->SetInsideOut(insideOut);
+      threaded->GenerateClippedOutputOn();
+      threaded->SequentialProcessingOff();
+      threaded->Update();
+
+      if (serial->GetOutput()->GetNumberOfCells() == 0)
+      {
+        std::cerr << "Empty output for cell type " << cellType << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!vtkTest::SameUnstructuredGrids(serial->GetOutput(), threaded->GetOutput()) ||
+        !vtkTest::SameUnstructuredGrids(serial->GetClippedOutput(), threaded->GetClippedOutput()))
+      {
+        std::cerr << "Threaded output differs for cell type " << cellType << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -25,6 +25,8 @@
 #include "vtkCellDataToPointData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkHexahedron.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,9 +37,12 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
+#include "vtkTetra.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <limits>
@@ -87,14 +92,18 @@ void ComputeQCriterionFromGradient(data_type* gradients, data_type* qCriterion)
 template <class data_type>
 void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
   int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
-  int highestCellDimension, int contributingCellOption);
+  int highestCellDimension, int contributingCellOption, bool parallel);
 
 int GetCellParametricData(
   vtkIdType pointId, double pointCoord[3], vtkCell* cell, int& subId, double parametricCoord[3]);
 
+bool ComputeLinearCellDerivatives(vtkCell* cell, const double parametricCoord[3],
+  vtkDataArray* array, int numberOfInputComponents, double* derivatives);
+
 template <class data_type>
 void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence);
+  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
+  bool parallel);
 
 // Functions for image data and structured grids
 template <class Grid, class data_type>
@@ -178,6 +187,7 @@ vtkGradientFilter::vtkGradientFilter()
   this->ComputeQCriterion = 0;
   this->ContributingCellOption = vtkGradientFilter::All;
   this->ReplacementValueOption = vtkGradientFilter::Zero;
+  this->SequentialProcessing = false;
   this->SetInputScalars(
     vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS, vtkDataSetAttributes::SCALARS);
 }
@@ -212,6 +222,7 @@ void vtkGradientFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ComputeQCriterion:" << this->ComputeQCriterion << endl;
   os << indent << "ContributingCellOption:" << this->ContributingCellOption << endl;
   os << indent << "ReplacementValueOption:" << this->ReplacementValueOption << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -363,6 +374,17 @@ int vtkGradientFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Cells and point links are fetched concurrently through the vtkIdList and
+// vtkGenericCell forms of the vtkDataSet API, which vtkUnstructuredGrid
+// implements without touching shared scratch storage. vtkPolyData goes
+// through vtkCellArray::GetCellAtId() with a shared temporary cell when the
+// connectivity is not stored as vtkIdType, so it is processed serially.
+bool vtkGradientFilter::CanComputeGradientInParallel(vtkDataSet* input)
+{
+  return !this->SequentialProcessing && vtkUnstructuredGrid::SafeDownCast(input) != nullptr;
+}
+
 //------------------------------------------------------------------------------
 int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int fieldAssociation,
   vtkDataSet* input, bool computeVorticity, bool computeQCriterion, bool computeDivergence,
@@ -467,6 +489,7 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
     }
   }
 
+  const bool parallel = this->CanComputeGradientInParallel(input);
   if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
   {
     if (!this->FasterApproximation)
@@ -479,7 +502,7 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
           (vorticity == nullptr ? nullptr : static_cast<VTK_TT*>(vorticity->GetVoidPointer(0))),
           (qCriterion == nullptr ? nullptr : static_cast<VTK_TT*>(qCriterion->GetVoidPointer(0))),
           (divergence == nullptr ? nullptr : static_cast<VTK_TT*>(divergence->GetVoidPointer(0))),
-          highestCellDimension, this->ContributingCellOption));
+          highestCellDimension, this->ContributingCellOption, parallel));
       }
       if (gradients)
       {
@@ -544,7 +567,8 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
           (qCriterion == nullptr ? nullptr
                                  : static_cast<VTK_TT*>(cellQCriterion->GetVoidPointer(0))),
           (divergence == nullptr ? nullptr
-                                 : static_cast<VTK_TT*>(cellDivergence->GetVoidPointer(0)))));
+                                 : static_cast<VTK_TT*>(cellDivergence->GetVoidPointer(0))),
+          parallel));
       }
 
       // We need to convert cell Array to points Array.
@@ -620,7 +644,8 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
         numberOfInputComponents,
         (vorticity == nullptr ? nullptr : static_cast<VTK_TT*>(vorticity->GetVoidPointer(0))),
         (qCriterion == nullptr ? nullptr : static_cast<VTK_TT*>(qCriterion->GetVoidPointer(0))),
-        (divergence == nullptr ? nullptr : static_cast<VTK_TT*>(divergence->GetVoidPointer(0)))));
+        (divergence == nullptr ? nullptr : static_cast<VTK_TT*>(divergence->GetVoidPointer(0))),
+        parallel));
     }
 
     if (gradients)
@@ -806,118 +831,180 @@ int vtkGradientFilter::GetOutputArrayType(vtkDataArray* array)
 namespace
 {
 //------------------------------------------------------------------------------
+// Compute the gradients at a range of points, averaging the derivatives at
+// the point of the cells using it. Each thread gets its own cell and list of
+// cells, so ranges of points can be processed concurrently.
 template <class data_type>
-void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
-  int highestCellDimension, int contributingCellOption)
+struct PointGradientsUG
 {
-  vtkNew<vtkIdList> currentPoint;
-  currentPoint->SetNumberOfIds(1);
-  vtkNew<vtkIdList> cellsOnPoint;
-
-  vtkIdType numpts = structure->GetNumberOfPoints();
-
-  int numberOfOutputComponents = 3 * numberOfInputComponents;
-  std::vector<data_type> g(numberOfOutputComponents);
-
-  // if we are doing patches for contributing cell dimensions we want to keep track of
-  // the maximum expected dimension so we can exit out of the check loop quicker
-  const int maxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+  vtkDataSet* Structure;
+  vtkDataArray* Array;
+  data_type* Gradients;
+  int NumberOfInputComponents;
+  data_type* Vorticity;
+  data_type* QCriterion;
+  data_type* Divergence;
+  int HighestCellDimension;
+  int ContributingCellOption;
+  int MaxCellDimension;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> CellsOnPoint;
+
+  PointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+    data_type* divergence, int highestCellDimension, int contributingCellOption)
+    : Structure(structure)
+    , Array(array)
+    , Gradients(gradients)
+    , NumberOfInputComponents(numberOfInputComponents)
+    , Vorticity(vorticity)
+    , QCriterion(qCriterion)
+    , Divergence(divergence)
+    , HighestCellDimension(highestCellDimension)
+    , ContributingCellOption(contributingCellOption)
+  {
+    // if we are doing patches for contributing cell dimensions we want to keep track of
+    // the maximum expected dimension so we can exit out of the check loop quicker
+    this->MaxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+  }
 
-  for (vtkIdType point = 0; point < numpts; point++)
+  void operator()(vtkIdType point, vtkIdType endPoint)
   {
-    currentPoint->SetId(0, point);
-    double pointcoords[3];
-    structure->GetPoint(point, pointcoords);
-    // Get all cells touching this point.
-    structure->GetCellNeighbors(-1, currentPoint, cellsOnPoint);
-    vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-
-    for (int i = 0; i < numberOfOutputComponents; i++)
+    vtkDataSet* structure = this->Structure;
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* cellsOnPoint = this->CellsOnPoint.Local();
+    int numberOfInputComponents = this->NumberOfInputComponents;
+    int numberOfOutputComponents = 3 * numberOfInputComponents;
+    std::vector<data_type> g(numberOfOutputComponents);
+    std::vector<double> derivatives(numberOfOutputComponents);
+    std::vector<double> values(8);
+
+    for (; point < endPoint; point++)
     {
-      g[i] = 0;
-    }
+      double pointcoords[3];
+      structure->GetPoint(point, pointcoords);
+      // Get all cells touching this point.
+      structure->GetPointCells(point, cellsOnPoint);
+      vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
 
-    if (contributingCellOption == vtkGradientFilter::Patch)
-    {
-      highestCellDimension = 0;
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+      for (int i = 0; i < numberOfOutputComponents; i++)
       {
-        int cellDimension = structure->GetCell(cellsOnPoint->GetId(neighbor))->GetCellDimension();
-        if (cellDimension > highestCellDimension)
+        g[i] = 0;
+      }
+
+      int highestCellDimension = this->HighestCellDimension;
+      if (this->ContributingCellOption == vtkGradientFilter::Patch)
+      {
+        highestCellDimension = 0;
+        for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
         {
-          highestCellDimension = cellDimension;
-          if (highestCellDimension == maxCellDimension)
+          cell->SetCellType(structure->GetCellType(cellsOnPoint->GetId(neighbor)));
+          int cellDimension = cell->GetCellDimension();
+          if (cellDimension > highestCellDimension)
           {
-            break;
+            highestCellDimension = cellDimension;
+            if (highestCellDimension == this->MaxCellDimension)
+            {
+              break;
+            }
           }
         }
       }
-    }
-    vtkIdType numValidCellNeighbors = 0;
+      vtkIdType numValidCellNeighbors = 0;
 
-    // Iterate on all cells and find all points connected to current point
-    // by an edge.
-    for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
-    {
-      vtkCell* cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-      if (cell->GetCellDimension() >= highestCellDimension)
+      // Iterate on all cells and find all points connected to current point
+      // by an edge.
+      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
       {
-        int subId;
-        double parametricCoord[3];
-        if (GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
+        structure->GetCell(cellsOnPoint->GetId(neighbor), cell);
+        if (cell->GetCellDimension() >= highestCellDimension)
         {
-          numValidCellNeighbors++;
-          for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+          int subId;
+          double parametricCoord[3];
+          if (GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
           {
-            int numberOfCellPoints = cell->GetNumberOfPoints();
-            std::vector<double> values(numberOfCellPoints);
-            // Get values of Array at cell points.
-            for (int i = 0; i < numberOfCellPoints; i++)
+            numValidCellNeighbors++;
+            if (!ComputeLinearCellDerivatives(
+                  cell, parametricCoord, this->Array, numberOfInputComponents, &derivatives[0]))
             {
-              values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+              int numberOfCellPoints = cell->GetNumberOfPoints();
+              if (static_cast<size_t>(numberOfCellPoints) > values.size())
+              {
+                values.resize(numberOfCellPoints);
+              }
+              for (int inputComponent = 0; inputComponent < numberOfInputComponents;
+                   inputComponent++)
+              {
+                // Get values of Array at cell points.
+                for (int i = 0; i < numberOfCellPoints; i++)
+                {
+                  values[i] = this->Array->GetComponent(cell->GetPointId(i), inputComponent);
+                }
+
+                // Get derivative of cell at point.
+                cell->Derivatives(
+                  subId, parametricCoord, &values[0], 1, &derivatives[3 * inputComponent]);
+              }
             }
+            for (int i = 0; i < numberOfOutputComponents; i++)
+            {
+              g[i] += static_cast<data_type>(derivatives[i]);
+            }
+          } // if(GetCellParametricData())
+        }   // if(cell->GetCellDimension () >= highestCellDimension
+      }     // iterating over neighbors
 
-            double derivative[3];
-            // Get derivative of cell at point.
-            cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
-
-            g[inputComponent * 3] += static_cast<data_type>(derivative[0]);
-            g[inputComponent * 3 + 1] += static_cast<data_type>(derivative[1]);
-            g[inputComponent * 3 + 2] += static_cast<data_type>(derivative[2]);
-          } // iterating over Components
-        }   // if(GetCellParametricData())
-      }     // if(cell->GetCellDimension () >= highestCellDimension
-    }       // iterating over neighbors
-
-    if (numValidCellNeighbors > 0)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
+      if (numValidCellNeighbors > 0)
       {
-        g[i] /= numValidCellNeighbors;
-      }
+        for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        {
+          g[i] /= numValidCellNeighbors;
+        }
 
-      if (vorticity)
-      {
-        ComputeVorticityFromGradient(&g[0], vorticity + 3 * point);
-      }
-      if (qCriterion)
-      {
-        ComputeQCriterionFromGradient(&g[0], qCriterion + point);
-      }
-      if (divergence)
-      {
-        ComputeDivergenceFromGradient(&g[0], divergence + point);
-      }
-      if (gradients)
-      {
-        for (int i = 0; i < numberOfOutputComponents; i++)
+        if (this->Vorticity)
         {
-          gradients[point * numberOfOutputComponents + i] = g[i];
+          ComputeVorticityFromGradient(&g[0], this->Vorticity + 3 * point);
+        }
+        if (this->QCriterion)
+        {
+          ComputeQCriterionFromGradient(&g[0], this->QCriterion + point);
+        }
+        if (this->Divergence)
+        {
+          ComputeDivergenceFromGradient(&g[0], this->Divergence + point);
+        }
+        if (this->Gradients)
+        {
+          for (int i = 0; i < numberOfOutputComponents; i++)
+          {
+            this->Gradients[point * numberOfOutputComponents + i] = g[i];
+          }
         }
       }
-    }
-  } // iterating over points in grid
+    } // iterating over points in grid
+  }
+};
+
+//------------------------------------------------------------------------------
+template <class data_type>
+void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
+  int highestCellDimension, int contributingCellOption, bool parallel)
+{
+  PointGradientsUG<data_type> worker(structure, array, gradients, numberOfInputComponents,
+    vorticity, qCriterion, divergence, highestCellDimension, contributingCellOption);
+  vtkIdType numpts = structure->GetNumberOfPoints();
+  if (parallel)
+  {
+    // Build the links from a single thread before querying them concurrently.
+    vtkNew<vtkIdList> cellIds;
+    structure->GetPointCells(0, cellIds);
+    vtkSMPTools::For(0, numpts, worker);
+  }
+  else
+  {
+    worker(0, numpts);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -928,11 +1015,13 @@ int GetCellParametricData(
   // fail.
   vtkIdList* pointIds = cell->GetPointIds();
   int timesPointRegistered = 0;
+  int cellPointId = 0;
   for (int i = 0; i < pointIds->GetNumberOfIds(); i++)
   {
     if (pointId == pointIds->GetId(i))
     {
       timesPointRegistered++;
+      cellPointId = i;
     }
   }
   if (timesPointRegistered != 1)
@@ -941,6 +1030,19 @@ int GetCellParametricData(
     return 0;
   }
 
+  // The parametric coordinates of the vertices of linear tetrahedra and
+  // hexahedra are known, there is no need to search for them.
+  int cellType = cell->GetCellType();
+  if (cellType == VTK_TETRA || cellType == VTK_HEXAHEDRON)
+  {
+    const double* vertexCoord = cell->GetParametricCoords() + 3 * cellPointId;
+    parametricCoord[0] = vertexCoord[0];
+    parametricCoord[1] = vertexCoord[1];
+    parametricCoord[2] = vertexCoord[2];
+    subId = 0;
+    return 1;
+  }
+
   double dummy;
   int numpoints = cell->GetNumberOfPoints();
   std::vector<double> values(numpoints);
@@ -952,58 +1054,175 @@ int GetCellParametricData(
 }
 
 //------------------------------------------------------------------------------
-template <class data_type>
-void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence)
+// Fast path for linear tetrahedra and hexahedra. The interpolation function
+// derivatives and the inverse Jacobian are computed once for all the
+// components of the array, instead of once per component through
+// vtkCell::Derivatives(). Returns false for other cell types and for cells
+// with a singular Jacobian, which are left to vtkCell::Derivatives().
+bool ComputeLinearCellDerivatives(vtkCell* cell, const double parametricCoord[3],
+  vtkDataArray* array, int numberOfInputComponents, double* derivatives)
 {
-  vtkIdType numcells = structure->GetNumberOfCells();
-  std::vector<double> values(8);
-  std::vector<data_type> cellGradients(3 * numberOfInputComponents);
-  for (vtkIdType cellid = 0; cellid < numcells; cellid++)
+  double functionDerivs[24];
+  int numberOfCellPoints;
+  switch (cell->GetCellType())
   {
-    vtkCell* cell = structure->GetCell(cellid);
-    int subId;
-    double cellCenter[3];
-    subId = cell->GetParametricCenter(cellCenter);
+    case VTK_TETRA:
+      vtkTetra::InterpolationDerivs(parametricCoord, functionDerivs);
+      numberOfCellPoints = 4;
+      break;
+    case VTK_HEXAHEDRON:
+      vtkHexahedron::InterpolationDerivs(parametricCoord, functionDerivs);
+      numberOfCellPoints = 8;
+      break;
+    default:
+      return false;
+  }
 
-    int numpoints = cell->GetNumberOfPoints();
-    if (static_cast<size_t>(numpoints) > values.size())
+  // create Jacobian matrix and find its inverse
+  double m0[3] = { 0.0, 0.0, 0.0 };
+  double m1[3] = { 0.0, 0.0, 0.0 };
+  double m2[3] = { 0.0, 0.0, 0.0 };
+  for (int j = 0; j < numberOfCellPoints; j++)
+  {
+    double x[3];
+    cell->Points->GetPoint(j, x);
+    for (int i = 0; i < 3; i++)
     {
-      values.resize(numpoints);
+      m0[i] += x[i] * functionDerivs[j];
+      m1[i] += x[i] * functionDerivs[numberOfCellPoints + j];
+      m2[i] += x[i] * functionDerivs[2 * numberOfCellPoints + j];
     }
-    double derivative[3];
-    for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
-    {
-      for (int i = 0; i < numpoints; i++)
-      {
-        values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
-      }
+  }
+  double j0[3], j1[3], j2[3];
+  double* m[3] = { m0, m1, m2 };
+  double* jI[3] = { j0, j1, j2 };
+  if (vtkMath::InvertMatrix(m, jI, 3) == 0)
+  {
+    return false;
+  }
 
-      cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
-      cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
-      cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
-      cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
-    }
-    if (gradients)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
-      {
-        gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
-      }
-    }
-    if (vorticity)
+  for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+  {
+    double sum[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < numberOfCellPoints; i++)
     {
-      ComputeVorticityFromGradient(&cellGradients[0], vorticity + 3 * cellid);
+      double value = array->GetComponent(cell->GetPointId(i), inputComponent);
+      sum[0] += functionDerivs[i] * value;
+      sum[1] += functionDerivs[numberOfCellPoints + i] * value;
+      sum[2] += functionDerivs[2 * numberOfCellPoints + i] * value;
     }
-    if (qCriterion)
+    for (int j = 0; j < 3; j++)
     {
-      ComputeQCriterionFromGradient(&cellGradients[0], qCriterion + cellid);
+      derivatives[3 * inputComponent + j] =
+        sum[0] * jI[j][0] + sum[1] * jI[j][1] + sum[2] * jI[j][2];
     }
-    if (divergence)
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Compute the gradients at the center of a range of cells.
+template <class data_type>
+struct CellGradientsUG
+{
+  vtkDataSet* Structure;
+  vtkDataArray* Array;
+  data_type* Gradients;
+  int NumberOfInputComponents;
+  data_type* Vorticity;
+  data_type* QCriterion;
+  data_type* Divergence;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  CellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+    data_type* divergence)
+    : Structure(structure)
+    , Array(array)
+    , Gradients(gradients)
+    , NumberOfInputComponents(numberOfInputComponents)
+    , Vorticity(vorticity)
+    , QCriterion(qCriterion)
+    , Divergence(divergence)
+  {
+  }
+
+  void operator()(vtkIdType cellid, vtkIdType endCellId)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    int numberOfInputComponents = this->NumberOfInputComponents;
+    std::vector<double> values(8);
+    std::vector<double> derivatives(3 * numberOfInputComponents);
+    std::vector<data_type> cellGradients(3 * numberOfInputComponents);
+    for (; cellid < endCellId; cellid++)
     {
-      ComputeDivergenceFromGradient(&cellGradients[0], divergence + cellid);
+      this->Structure->GetCell(cellid, cell);
+      int subId;
+      double cellCenter[3];
+      subId = cell->GetParametricCenter(cellCenter);
+
+      if (!ComputeLinearCellDerivatives(
+            cell, cellCenter, this->Array, numberOfInputComponents, &derivatives[0]))
+      {
+        int numpoints = cell->GetNumberOfPoints();
+        if (static_cast<size_t>(numpoints) > values.size())
+        {
+          values.resize(numpoints);
+        }
+        for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+        {
+          for (int i = 0; i < numpoints; i++)
+          {
+            values[i] = this->Array->GetComponent(cell->GetPointId(i), inputComponent);
+          }
+
+          cell->Derivatives(subId, cellCenter, &values[0], 1, &derivatives[3 * inputComponent]);
+        }
+      }
+      for (int i = 0; i < 3 * numberOfInputComponents; i++)
+      {
+        cellGradients[i] = static_cast<data_type>(derivatives[i]);
+      }
+      if (this->Gradients)
+      {
+        for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        {
+          this->Gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
+        }
+      }
+      if (this->Vorticity)
+      {
+        ComputeVorticityFromGradient(&cellGradients[0], this->Vorticity + 3 * cellid);
+      }
+      if (this->QCriterion)
+      {
+        ComputeQCriterionFromGradient(&cellGradients[0], this->QCriterion + cellid);
+      }
+      if (this->Divergence)
+      {
+        ComputeDivergenceFromGradient(&cellGradients[0], this->Divergence + cellid);
+      }
     }
   }
+};
+
+//------------------------------------------------------------------------------
+template <class data_type>
+void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
+  bool parallel)
+{
+  CellGradientsUG<data_type> worker(
+    structure, array, gradients, numberOfInputComponents, vorticity, qCriterion, divergence);
+  vtkIdType numcells = structure->GetNumberOfCells();
+  if (parallel)
+  {
+    vtkSMPTools::For(0, numcells, worker);
+  }
+  else
+  {
+    worker(0, numcells);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +39,11 @@
  * the entire data set. For Patch or DataSetMax it is possible that some values
  * will not be computed. The ReplacementValueOption specifies what to use
  * for these values.
+ *
+ * The gradients of unstructured grids are computed in parallel with
+ * vtkSMPTools, one range of points or cells per thread. Linear tetrahedra
+ * and hexahedra take a fast path that evaluates their derivatives directly
+ * rather than through vtkCell::Derivatives().
  */
 
 #ifndef vtkGradientFilter_h
@@ -206,6 +211,20 @@ public:
   vtkGetMacro(ReplacementValueOption, int);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when computing the
+   * gradients of unstructured grids. By default, sequential processing is
+   * off. Note this flag only applies if the class has been compiled with
+   * VTK_SMP_IMPLEMENTATION_TYPE set to something other than Sequential. (If
+   * set to Sequential, then the filter always runs in serial mode.) This flag
+   * is typically used for benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkGradientFilter();
   ~vtkGradientFilter() override;
@@ -238,6 +257,12 @@ protected:
    **/
   int GetOutputArrayType(vtkDataArray* inputArray);
 
+  /**
+   * Whether the gradients of the given unstructured input can be computed
+   * by several threads.
+   */
+  bool CanComputeGradientInParallel(vtkDataSet* input);
+
   /**
    * If non-null then it contains the name of the outputted gradient array.
    * By derault it is "Gradients".
@@ -313,6 +338,8 @@ protected:
    */
   int ReplacementValueOption;
 
+  vtkTypeBool SequentialProcessing;
+
 private:
   vtkGradientFilter(const vtkGradientFilter&) = delete;
   void operator=(const vtkGradientFilter&) = delete;
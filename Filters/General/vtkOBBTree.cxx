@@ -23,9 +23,13 @@
 #include "vtkPlane.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkOBBTree);
@@ -79,6 +83,7 @@ vtkOBBTree::vtkOBBTree()
   this->Tree = nullptr;
   this->PointsList = nullptr;
   this->InsertedPoints = nullptr;
+  this->CellMoments = nullptr;
   this->OBBCount = this->Level = 0;
 }
 
@@ -1039,11 +1044,288 @@ void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int*
   }
 }
 
+namespace
+{
+// The number of values stored per cell: the area of its triangles, their
+// first moments and their second moments.
+const int NumberOfCellMoments = 10;
+
+// Sum the mass and moments of the triangles of each cell, in the order in
+// which the moments of a list of cells used to be accumulated.
+struct ComputeCellMomentsFunctor
+{
+  vtkDataSet* DataSet;
+  double* CellMoments;
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+
+  ComputeCellMomentsFunctor(vtkDataSet* dataSet, double* cellMoments)
+    : DataSet(dataSet)
+    , CellMoments(cellMoments)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellPts = this->CellPts.Local();
+    vtkIdType pId, qId, rId;
+    double p[3], q[3], r[3], dp0[3], dp1[3], c[3], xp[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      double* m = this->CellMoments + NumberOfCellMoments * cellId;
+      std::fill(m, m + NumberOfCellMoments, 0.0);
+      int type = this->DataSet->GetCellType(cellId);
+      this->DataSet->GetCellPoints(cellId, cellPts);
+      vtkIdType numPts = cellPts->GetNumberOfIds();
+      const vtkIdType* ptIds = cellPts->GetPointer(0);
+      for (vtkIdType j = 0; j < numPts - 2; j++)
+      {
+        vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
+        if (pId < 0)
+        {
+          continue;
+        }
+        this->DataSet->GetPoint(pId, p);
+        this->DataSet->GetPoint(qId, q);
+        this->DataSet->GetPoint(rId, r);
+        for (int k = 0; k < 3; k++)
+        {
+          dp0[k] = q[k] - p[k];
+          dp1[k] = r[k] - p[k];
+          c[k] = (p[k] + q[k] + r[k]) / 3;
+        }
+        vtkMath::Cross(dp0, dp1, xp);
+        double tri_mass = 0.5 * vtkMath::Norm(xp);
+        m[0] += tri_mass;
+        for (int k = 0; k < 3; k++)
+        {
+          m[1 + k] += tri_mass * c[k];
+        }
+        m[4] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
+        m[5] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
+        m[6] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
+        m[7] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
+        m[8] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
+        m[9] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Project the points of a list of cells on the axes of an OBB, keeping the
+// extreme parametric coordinates along each axis.
+struct ProjectCellPointsFunctor
+{
+  vtkDataSet* DataSet;
+  vtkIdList* Cells;
+  const double* Mean;
+  double (*AxisEnds)[3];
+  double TMin[3];
+  double TMax[3];
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+  vtkSMPThreadLocal<std::vector<double>> LocalRange;
+
+  ProjectCellPointsFunctor(
+    vtkDataSet* dataSet, vtkIdList* cells, const double* mean, double (*axisEnds)[3])
+    : DataSet(dataSet)
+    , Cells(cells)
+    , Mean(mean)
+    , AxisEnds(axisEnds)
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<double>& range = this->LocalRange.Local();
+    range.assign(6, VTK_DOUBLE_MAX);
+    range[3] = range[4] = range[5] = -VTK_DOUBLE_MAX;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellPts = this->CellPts.Local();
+    double* range = this->LocalRange.Local().data();
+    double x[3], t, closest[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->DataSet->GetCellPoints(this->Cells->GetId(i), cellPts);
+      for (vtkIdType j = 0; j < cellPts->GetNumberOfIds(); ++j)
+      {
+        this->DataSet->GetPoint(cellPts->GetId(j), x);
+        for (int k = 0; k < 3; k++)
+        {
+          vtkLine::DistanceToLine(x, this->Mean, this->AxisEnds[k], t, closest);
+          range[k] = std::min(range[k], t);
+          range[3 + k] = std::max(range[3 + k], t);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      this->TMin[k] = VTK_DOUBLE_MAX;
+      this->TMax[k] = -VTK_DOUBLE_MAX;
+    }
+    for (const std::vector<double>& range : this->LocalRange)
+    {
+      for (int k = 0; k < 3; k++)
+      {
+        this->TMin[k] = std::min(this->TMin[k], range[k]);
+        this->TMax[k] = std::max(this->TMax[k], range[3 + k]);
+      }
+    }
+  }
+};
+
+// Decide on which side of a split plane each cell of a list lies (0 for
+// the negative side, 1 for the positive side). Cells straddling the plane
+// are assigned by their centroid.
+struct ClassifyCellsFunctor
+{
+  vtkDataSet* DataSet;
+  vtkIdList* Cells;
+  const double* Normal;
+  const double* Origin;
+  std::vector<char>& Sides;
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+
+  ClassifyCellsFunctor(vtkDataSet* dataSet, vtkIdList* cells, const double* normal,
+    const double* origin, std::vector<char>& sides)
+    : DataSet(dataSet)
+    , Cells(cells)
+    , Normal(normal)
+    , Origin(origin)
+    , Sides(sides)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellPts = this->CellPts.Local();
+    const double* n = this->Normal;
+    const double* p = this->Origin;
+    double c[3], x[3], val;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->DataSet->GetCellPoints(this->Cells->GetId(i), cellPts);
+      c[0] = c[1] = c[2] = 0.0;
+      int numPts = cellPts->GetNumberOfIds();
+      int negative = 0, positive = 0;
+      for (int j = 0; j < numPts; j++)
+      {
+        this->DataSet->GetPoint(cellPts->GetId(j), x);
+        val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+        c[0] += x[0];
+        c[1] += x[1];
+        c[2] += x[2];
+        if (val < 0.0)
+        {
+          negative = 1;
+        }
+        else
+        {
+          positive = 1;
+        }
+      }
+
+      if (negative && positive)
+      { // Use centroid to decide straddle cases
+        c[0] /= numPts;
+        c[1] /= numPts;
+        c[2] /= numPts;
+        this->Sides[i] =
+          (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0) ? 0 : 1;
+      }
+      else
+      {
+        this->Sides[i] = negative ? 0 : 1;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Run a functor over [0, n) in the calling thread only.
+template <typename Functor>
+void ExecuteSerially(Functor& functor, vtkIdType n)
+{
+  functor.Initialize();
+  functor(0, n);
+  functor.Reduce();
+}
+}
+
+// Build the subtrees of the nodes left once the top of the tree has been
+// built, one node at a time per thread.
+struct OBBSubtreesFunctor
+{
+  struct Subtree
+  {
+    vtkIdList* Cells;
+    vtkOBBNode* Node;
+    int Level;
+  };
+
+  vtkOBBTree* Tree;
+  std::vector<Subtree>& Subtrees;
+  vtkSMPThreadLocal<int> MaxLevel;
+  vtkSMPThreadLocal<int> NumberOfNodes;
+
+  OBBSubtreesFunctor(vtkOBBTree* tree, std::vector<Subtree>& subtrees)
+    : Tree(tree)
+    , Subtrees(subtrees)
+  {
+  }
+
+  void Initialize()
+  {
+    this->MaxLevel.Local() = 0;
+    this->NumberOfNodes.Local() = 0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int& maxLevel = this->MaxLevel.Local();
+    int& numNodes = this->NumberOfNodes.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const Subtree& subtree = this->Subtrees[i];
+      this->Tree->BuildSubtree(subtree.Cells, subtree.Node, subtree.Level, maxLevel, numNodes);
+    }
+  }
+
+  void Reduce()
+  {
+    for (int maxLevel : this->MaxLevel)
+    {
+      this->Tree->Level = std::max(this->Tree->Level, maxLevel);
+    }
+    for (int numNodes : this->NumberOfNodes)
+    {
+      this->Tree->OBBCount += numNodes;
+    }
+  }
+};
+
 //
 //  Method to form subdivision of space based on the cells provided and
 //  subject to the constraints of levels and NumberOfCellsInOctant.
 //  The result is directly addressable and of uniform subdivision.
 //
+//  The top of the tree is built one node at a time, each node computing its
+//  OBB and split in parallel, until there are enough nodes to build their
+//  subtrees in parallel. Every node is computed the same way in both
+//  phases, so the tree does not depend on the number of threads.
+//
 void vtkOBBTree::BuildLocator()
 {
   vtkIdType numPts, numCells, i;
@@ -1065,22 +1347,28 @@ void vtkOBBTree::BuildLocator()
   }
 
   this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
+  this->CellMoments = new double[NumberOfCellMoments * numCells];
+  ComputeCellMomentsFunctor cellMoments(this->DataSet, this->CellMoments);
+  if (this->SequentialProcessing)
   {
-    this->InsertedPoints[i] = 0;
+    ExecuteSerially(cellMoments, numCells);
+  }
+  else
+  {
+    // The first call may build internal structures of the dataset (e.g., the
+    // cells of polydata), which is not thread safe.
+    cellMoments(0, 1);
+    vtkSMPTools::For(1, numCells, cellMoments);
   }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
 
   //
   // Begin recursively creating OBB's
   //
   cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
+  cellList->SetNumberOfIds(numCells);
   for (i = 0; i < numCells; i++)
   {
-    cellList->InsertId(i, i);
+    cellList->SetId(i, i);
   }
 
   if (this->Tree)
@@ -1090,7 +1378,33 @@ void vtkOBBTree::BuildLocator()
   }
   this->Tree = new vtkOBBNode;
   this->Level = 0;
-  this->BuildTree(cellList, this->Tree, 0);
+  if (this->SequentialProcessing)
+  {
+    this->BuildTree(cellList, this->Tree, 0);
+  }
+  else
+  {
+    std::vector<OBBSubtreesFunctor::Subtree> subtrees(1, { cellList, this->Tree, 0 });
+    size_t numThreads = static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    while (!subtrees.empty() && subtrees.size() < numThreads)
+    {
+      std::vector<OBBSubtreesFunctor::Subtree> kids;
+      for (const OBBSubtreesFunctor::Subtree& subtree : subtrees)
+      {
+        this->Level = std::max(this->Level, subtree.Level);
+        this->OBBCount++;
+        vtkIdList *lhList, *rhList;
+        if (this->BuildNode(subtree.Cells, subtree.Node, subtree.Level, true, lhList, rhList))
+        {
+          kids.push_back({ lhList, subtree.Node->Kids[0], subtree.Level + 1 });
+          kids.push_back({ rhList, subtree.Node->Kids[1], subtree.Level + 1 });
+        }
+      }
+      subtrees.swap(kids);
+    }
+    OBBSubtreesFunctor functor(this, subtrees);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, functor);
+  }
 
   vtkDebugMacro(<< "# Cells: " << numCells << ", Deepest tree level: " << this->Level
                 << ", Created: " << this->OBBCount << " OBB nodes");
@@ -1107,8 +1421,8 @@ void vtkOBBTree::BuildLocator()
   //
   // Clean up
   //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
+  delete[] this->CellMoments;
+  this->CellMoments = nullptr;
 
   this->BuildTime.Modified();
 }
@@ -1117,20 +1431,137 @@ void vtkOBBTree::BuildLocator()
 // frees its first argument
 void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 {
-  vtkIdType i, j, numCells = cells->GetNumberOfIds();
-  vtkIdType cellId;
-  vtkIdType ptId;
-  vtkIdList* cellPts = vtkIdList::New();
-  double size[3];
+  int maxLevel = this->Level;
+  int numNodes = 0;
+  this->BuildSubtree(cells, OBBptr, level, maxLevel, numNodes);
+  this->Level = maxLevel;
+  this->OBBCount += numNodes;
+}
 
-  if (level > this->Level)
+// Build the subtree of a node in the calling thread only, so that several
+// subtrees can be built concurrently. The deepest level reached and the
+// number of nodes created are accumulated in the last arguments.
+void vtkOBBTree::BuildSubtree(
+  vtkIdList* cells, vtkOBBNode* OBBptr, int level, int& maxLevel, int& numNodes)
+{
+  maxLevel = std::max(maxLevel, level);
+  numNodes++;
+  vtkIdList *lhList, *rhList;
+  if (this->BuildNode(cells, OBBptr, level, false, lhList, rhList))
   {
-    this->Level = level;
+    this->BuildSubtree(lhList, OBBptr->Kids[0], level + 1, maxLevel, numNodes);
+    this->BuildSubtree(rhList, OBBptr->Kids[1], level + 1, maxLevel, numNodes);
   }
+}
+
+// Compute the OBB of a node from its cells (using the moments of the cells
+// computed by BuildLocator) and try to split it. If it is split, its two
+// children are created, their lists of cells are returned, and the list of
+// the node is freed. Otherwise the node is a leaf and keeps its list if
+// RetainCellLists is on.
+bool vtkOBBTree::BuildNode(vtkIdList* cells, vtkOBBNode* OBBptr, int level, bool threaded,
+  vtkIdList*& lhList, vtkIdList*& rhList)
+{
+  vtkIdType i, numCells = cells->GetNumberOfIds();
+  lhList = rhList = nullptr;
+
   //
   // Now compute the OBB
   //
-  this->ComputeOBB(cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
+  double mean[3], *v[3], v0[3], v1[3], v2[3];
+  double *a[3], a0[3], a1[3], a2[3], tot_mass = 0.0;
+  double* max = OBBptr->Axes[0];
+  double* mid = OBBptr->Axes[1];
+  double* min = OBBptr->Axes[2];
+  double size[3];
+  mean[0] = mean[1] = mean[2] = 0.0;
+  a[0] = a0;
+  a[1] = a1;
+  a[2] = a2;
+  for (i = 0; i < 3; i++)
+  {
+    a0[i] = a1[i] = a2[i] = 0.0;
+  }
+  for (i = 0; i < numCells; i++)
+  {
+    const double* m = this->CellMoments + NumberOfCellMoments * cells->GetId(i);
+    tot_mass += m[0];
+    mean[0] += m[1];
+    mean[1] += m[2];
+    mean[2] += m[3];
+    a0[0] += m[4];
+    a1[1] += m[5];
+    a2[2] += m[6];
+    a0[1] += m[7];
+    a0[2] += m[8];
+    a1[2] += m[9];
+  }
+
+  // normalize data
+  for (i = 0; i < 3; i++)
+  {
+    mean[i] = mean[i] / tot_mass;
+  }
+
+  // matrix is symmetric
+  a1[0] = a0[1];
+  a2[0] = a0[2];
+  a2[1] = a1[2];
+
+  // get covariance from moments
+  for (i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      a[i][j] = a[i][j] / tot_mass - mean[i] * mean[j];
+    }
+  }
+
+  //
+  // Extract axes (i.e., eigenvectors) from covariance matrix.
+  //
+  v[0] = v0;
+  v[1] = v1;
+  v[2] = v2;
+  vtkMath::Jacobi(a, size, v);
+  for (i = 0; i < 3; i++)
+  {
+    max[i] = v[i][0];
+    mid[i] = v[i][1];
+    min[i] = v[i][2];
+  }
+
+  double axisEnds[3][3];
+  for (i = 0; i < 3; i++)
+  {
+    axisEnds[0][i] = mean[i] + max[i];
+    axisEnds[1][i] = mean[i] + mid[i];
+    axisEnds[2][i] = mean[i] + min[i];
+  }
+
+  //
+  // Create oriented bounding box by projecting points onto eigenvectors.
+  //
+  ProjectCellPointsFunctor projector(this->DataSet, cells, mean, axisEnds);
+  if (threaded)
+  {
+    vtkSMPTools::For(0, numCells, projector);
+  }
+  else
+  {
+    ExecuteSerially(projector, numCells);
+  }
+  const double* tMin = projector.TMin;
+  const double* tMax = projector.TMax;
+
+  for (i = 0; i < 3; i++)
+  {
+    OBBptr->Corner[i] = mean[i] + tMin[0] * max[i] + tMin[1] * mid[i] + tMin[2] * min[i];
+
+    max[i] = (tMax[0] - tMin[0]) * max[i];
+    mid[i] = (tMax[1] - tMin[1]) * mid[i];
+    min[i] = (tMax[2] - tMin[2]) * min[i];
+  }
 
   //
   // Check whether to continue recursing; if so, create two children and
@@ -1138,14 +1569,11 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
   //
   if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
   {
-    vtkIdList* LHlist = vtkIdList::New();
-    LHlist->Allocate(cells->GetNumberOfIds() / 2);
-    vtkIdList* RHlist = vtkIdList::New();
-    RHlist->Allocate(cells->GetNumberOfIds() / 2);
-    double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
-    int negative, positive, splitAcceptable, splitPlane;
-    int foundBestSplit, bestPlane = 0, numPts;
-    int numInLHnode, numInRHnode;
+    double n[3], p[3], ratio, bestRatio;
+    int splitAcceptable, splitPlane;
+    int foundBestSplit, bestPlane = 0;
+    vtkIdType numInLHnode, numInRHnode;
+    std::vector<char> sides(numCells);
 
     // loop over three split planes to find acceptable one
     for (i = 0; i < 3; i++) // compute split point
@@ -1166,60 +1594,19 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
       vtkMath::Normalize(n);
 
       // traverse cells, assigning to appropriate child list as necessary
-      for (i = 0; i < numCells; i++)
+      ClassifyCellsFunctor classifier(this->DataSet, cells, n, p, sides);
+      if (threaded)
       {
-        cellId = cells->GetId(i);
-        this->DataSet->GetCellPoints(cellId, cellPts);
-        c[0] = c[1] = c[2] = 0.0;
-        numPts = cellPts->GetNumberOfIds();
-        for (negative = positive = j = 0; j < numPts; j++)
-        {
-          ptId = cellPts->GetId(j);
-          this->DataSet->GetPoint(ptId, x);
-          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
-          c[0] += x[0];
-          c[1] += x[1];
-          c[2] += x[2];
-          if (val < 0.0)
-          {
-            negative = 1;
-          }
-          else
-          {
-            positive = 1;
-          }
-        }
-
-        if (negative && positive)
-        { // Use centroid to decide straddle cases
-          c[0] /= numPts;
-          c[1] /= numPts;
-          c[2] /= numPts;
-          if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-        else
-        {
-          if (negative)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-      } // for all cells
+        vtkSMPTools::For(0, numCells, classifier);
+      }
+      else
+      {
+        ExecuteSerially(classifier, numCells);
+      }
+      numInRHnode = std::count(sides.begin(), sides.end(), 1);
+      numInLHnode = numCells - numInRHnode;
 
       // evaluate this split
-      numInLHnode = LHlist->GetNumberOfIds();
-      numInRHnode = RHlist->GetNumberOfIds();
       ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
 
       // see whether we've found acceptable split plane
@@ -1229,8 +1616,6 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
       }
       else
       { // not a great split try another
-        LHlist->Reset();
-        RHlist->Reset();
         if (ratio < bestRatio)
         {
           bestRatio = ratio;
@@ -1247,6 +1632,15 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 
     if (splitAcceptable) // otherwise recursion terminates
     {
+      lhList = vtkIdList::New();
+      lhList->Allocate(numInLHnode);
+      rhList = vtkIdList::New();
+      rhList->Allocate(numInRHnode);
+      for (i = 0; i < numCells; i++)
+      {
+        (sides[i] ? rhList : lhList)->InsertNextId(cells->GetId(i));
+      }
+
       vtkOBBNode* LHnode = new vtkOBBNode;
       vtkOBBNode* RHnode = new vtkOBBNode;
       OBBptr->Kids = new vtkOBBNode*[2];
@@ -1255,29 +1649,21 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
       LHnode->Parent = OBBptr;
       RHnode->Parent = OBBptr;
 
-      cells->Delete();
-      cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
-    }
-    else
-    {
-      // free up local objects
-      LHlist->Delete();
-      RHlist->Delete();
+      cells->Delete(); // don't need to keep anymore
+      return true;
     }
   } // if should build tree
 
-  if (cells && this->RetainCellLists)
+  if (this->RetainCellLists)
   {
     cells->Squeeze();
     OBBptr->Cells = cells;
   }
-  else if (cells)
+  else
   {
     cells->Delete();
   }
-  cellPts->Delete();
+  return false;
 }
 
 // Create polygonal representation for OBB tree at specified level. If
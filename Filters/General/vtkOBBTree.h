@@ -30,6 +30,11 @@
  * then assigned to the children OBB's. This process then continues until
  * the MaxLevel ivar limits the recursion, or no split plane can be found.
  *
+ * The tree is built with vtkSMPTools unless SequentialProcessing is on:
+ * the OBBs and split planes of the top nodes are computed in parallel, then
+ * the subtrees below them are built concurrently. The resulting tree does
+ * not depend on the number of threads.
+ *
  * A good reference for OBB-trees is Gottschalk & Manocha in Proceedings of
  * Siggraph `96.
  *
@@ -200,10 +205,18 @@ protected:
 
   vtkOBBNode* Tree;
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
+  void BuildSubtree(vtkIdList* cells, vtkOBBNode* parent, int level, int& maxLevel, int& numNodes);
+  bool BuildNode(vtkIdList* cells, vtkOBBNode* parent, int level, bool threaded,
+    vtkIdList*& lhList, vtkIdList*& rhList);
   vtkPoints* PointsList;
   int* InsertedPoints;
   int OBBCount;
 
+  // Mass and moments of the triangles of each cell, while the tree is built.
+  double* CellMoments;
+
+  friend struct OBBSubtreesFunctor;
+
   void DeleteTree(vtkOBBNode* OBBptr);
   void GeneratePolygons(
     vtkOBBNode* OBBptr, int level, int repLevel, vtkPoints* pts, vtkCellArray* polys);
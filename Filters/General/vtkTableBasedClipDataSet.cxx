@@ -46,17 +46,29 @@
 
 #include "vtkAppendFilter.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include "vtkTableBasedClipCases.cxx"
 
 vtkStandardNewMacro(vtkTableBasedClipDataSet);
@@ -1542,6 +1554,980 @@ inline void GetPoint(
 // =============== vtkTableBasedClipperVolumeFromVolume ( end ) ===============
 // ============================================================================
 
+// ============================================================================
+// ================ vtkTableBasedClipperThreadedClip (begin) =================
+// ============================================================================
+
+// Threaded clipping of a vtkUnstructuredGrid. The cells are processed in
+// fixed-size batches so that the result does not depend on the number of
+// threads: a first pass counts what each batch generates, prefix sums turn
+// the counts into offsets, and later passes write connectivity, points and
+// attributes straight into preallocated output arrays. Points and cells are
+// emitted in the same order as vtkTableBasedClipperVolumeFromVolume does, so
+// the threaded and the serial paths produce identical output.
+namespace
+{
+
+constexpr vtkIdType TBCBatchSize = 1024;
+constexpr int TBCNumberOfShapeTypes = 8;
+
+// Shape slots, in the order of vtkTableBasedClipperVolumeFromVolume::shapes.
+const int TBCShapeSize[TBCNumberOfShapeTypes] = { 4, 5, 6, 8, 4, 3, 2, 1 };
+const unsigned char TBCShapeVTKType[TBCNumberOfShapeTypes] = { VTK_TETRA, VTK_PYRAMID, VTK_WEDGE,
+  VTK_HEXAHEDRON, VTK_QUAD, VTK_TRIANGLE, VTK_LINE, VTK_VERTEX };
+
+typedef const int TBCEdgeIndices[2];
+
+//------------------------------------------------------------------------------
+bool TBCIsClippableCellType(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Retrieve the clip case of a cell from the VisIt tables.
+bool TBCGetClipCase(int cellType, int caseIndx, const unsigned char*& thisCase, int& nOutputs,
+  TBCEdgeIndices*& edgeVtxs)
+{
+  int startIdx = 0;
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      return true;
+
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      return true;
+
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      return true;
+
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      return true;
+
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      return true;
+
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      return true;
+
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      return true;
+
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      return true;
+
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
+      edgeVtxs = (TBCEdgeIndices*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      return true;
+
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
+      edgeVtxs = nullptr;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Walk the clip case of a single cell and report the generated edge points,
+// centroid points and output shapes to a visitor. This follows the cell loop
+// of vtkTableBasedClipDataSet::ClipUnstructuredGridData() step by step.
+template <typename Visitor>
+void TBCClipCell(vtkIdType cellId, int cellType, vtkIdType npts, const vtkIdType* pntIndxs,
+  vtkDataArray* clipArray, double isoValue, bool insideOut, Visitor& visitor)
+{
+  int caseIndx = 0;
+  double grdDiffs[8];
+  for (vtkIdType j = npts - 1; j >= 0; j--)
+  {
+    grdDiffs[j] = clipArray->GetComponent(pntIndxs[j], 0) - isoValue;
+    caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
+    caseIndx <<= (1 - (!j));
+  }
+
+  const unsigned char* thisCase = nullptr;
+  int nOutputs = 0;
+  TBCEdgeIndices* edgeVtxs = nullptr;
+  if (!TBCGetClipCase(cellType, caseIndx, thisCase, nOutputs, edgeVtxs))
+  {
+    return;
+  }
+
+  vtkIdType intrpIds[4] = { 0, 0, 0, 0 };
+  for (int j = 0; j < nOutputs; j++)
+  {
+    int nCellPts = 0;
+    int theColor = -1;
+    int intrpIdx = -1;
+    int slot = -1;
+    unsigned char theShape = *thisCase++;
+
+    switch (theShape)
+    {
+      case ST_TET:
+        nCellPts = 4;
+        slot = 0;
+        break;
+      case ST_PYR:
+        nCellPts = 5;
+        slot = 1;
+        break;
+      case ST_WDG:
+        nCellPts = 6;
+        slot = 2;
+        break;
+      case ST_HEX:
+        nCellPts = 8;
+        slot = 3;
+        break;
+      case ST_QUA:
+        nCellPts = 4;
+        slot = 4;
+        break;
+      case ST_TRI:
+        nCellPts = 3;
+        slot = 5;
+        break;
+      case ST_LIN:
+        nCellPts = 2;
+        slot = 6;
+        break;
+      case ST_VTX:
+        nCellPts = 1;
+        slot = 7;
+        break;
+      case ST_PNT:
+        intrpIdx = *thisCase++;
+        break;
+      default:
+        // The tables only contain the shapes above.
+        return;
+    }
+    theColor = *thisCase++;
+    if (theShape == ST_PNT)
+    {
+      nCellPts = *thisCase++;
+    }
+
+    if ((!insideOut && theColor == COLOR0) || (insideOut && theColor == COLOR1))
+    {
+      // We don't want this one; it's the wrong side.
+      thisCase += nCellPts;
+      continue;
+    }
+
+    vtkIdType shapeIds[8];
+    for (int p = 0; p < nCellPts; p++)
+    {
+      unsigned char pntIndex = *thisCase++;
+
+      if (pntIndex <= P7)
+      {
+        shapeIds[p] = pntIndxs[pntIndex];
+      }
+      else if (pntIndex >= EA && pntIndex <= EL)
+      {
+        int pt1Index = edgeVtxs[pntIndex - EA][0];
+        int pt2Index = edgeVtxs[pntIndex - EA][1];
+        if (pt2Index < pt1Index)
+        {
+          std::swap(pt1Index, pt2Index);
+        }
+        double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
+        double pt1ToIso = 0.0 - grdDiffs[pt1Index];
+        double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
+
+        shapeIds[p] = visitor.AddEdgePoint(pntIndxs[pt1Index], pntIndxs[pt2Index], p1Weight);
+      }
+      else if (pntIndex >= N0 && pntIndex <= N3)
+      {
+        shapeIds[p] = intrpIds[pntIndex - N0];
+      }
+    }
+
+    if (theShape == ST_PNT)
+    {
+      intrpIds[intrpIdx] = visitor.AddCentroidPoint(nCellPts, shapeIds);
+    }
+    else
+    {
+      visitor.AddShape(slot, cellId, shapeIds);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Number the flagged entries of the range [0,n) consecutively, in increasing
+// order: the flags are set in parallel, an exclusive scan turns them into
+// ranks, and the ranks of the flagged entries are then assigned in parallel.
+template <typename FlagFunctor, typename AssignFunctor>
+vtkIdType TBCEnumerate(vtkIdType n, FlagFunctor isFlagged, AssignFunctor assign)
+{
+  // One extra entry receives the number of flagged entries.
+  std::vector<vtkIdType> ranks(n + 1, 0);
+  vtkSMPTools::For(0, n, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      ranks[i] = isFlagged(i) ? 1 : 0;
+    }
+  });
+  vtkSMPTools::ExclusiveScan(ranks.begin(), ranks.end(), ranks.begin(), vtkIdType(0));
+
+  vtkSMPTools::For(0, n, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      if (ranks[i + 1] != ranks[i])
+      {
+        assign(i, ranks[i]);
+      }
+    }
+  });
+
+  return ranks[n];
+}
+
+//------------------------------------------------------------------------------
+// What a batch of cells generates, and where it goes in the output.
+struct TBCBatchInfo
+{
+  vtkIdType NumberOfShapes[TBCNumberOfShapeTypes];
+  vtkIdType NumberOfEdgeRefs;
+  vtkIdType NumberOfCentroids;
+
+  vtkIdType ShapeOffset[TBCNumberOfShapeTypes];
+  vtkIdType EdgeRefOffset;
+  vtkIdType CentroidOffset;
+};
+
+// An edge point requested by a cell. Seq is the position of the request in
+// serial traversal order, so sorting by (V0,V1,Seq) puts the first request
+// of each edge at the head of its group.
+struct TBCEdgeRef
+{
+  vtkIdType V0;
+  vtkIdType V1;
+  vtkIdType Seq;
+
+  bool operator<(const TBCEdgeRef& other) const
+  {
+    return this->V0 < other.V0 ||
+      (this->V0 == other.V0 &&
+        (this->V1 < other.V1 || (this->V1 == other.V1 && this->Seq < other.Seq)));
+  }
+  bool SameEdge(const TBCEdgeRef& other) const
+  {
+    return this->V0 == other.V0 && this->V1 == other.V1;
+  }
+};
+
+struct TBCCentroid
+{
+  int NumberOfPoints;
+  vtkIdType PointIds[8];
+};
+
+// A pair of matching input / output attribute arrays.
+struct TBCArrayPair
+{
+  vtkDataArray* Input;
+  vtkDataArray* Output;
+  bool NearestNeighbor;
+};
+
+//------------------------------------------------------------------------------
+// Pair the arrays of the input attributes with the arrays created by
+// CopyAllocate() so that the threads can copy and interpolate tuples without
+// going through the (non thread-safe) vtkDataSetAttributes iteration.
+// Returns false if the layout is not a plain one-to-one mapping of data
+// arrays, or if an array packs several tuples in a byte (vtkBitArray), in
+// which case the serial path is used.
+bool TBCPairArrays(
+  vtkDataSetAttributes* inDSA, vtkDataSetAttributes* outDSA, std::vector<TBCArrayPair>& pairs)
+{
+  int numArrays = inDSA->GetNumberOfArrays();
+  if (outDSA->GetNumberOfArrays() != numArrays)
+  {
+    return false;
+  }
+
+  pairs.clear();
+  for (int i = 0; i < numArrays; ++i)
+  {
+    vtkDataArray* inArray = vtkArrayDownCast<vtkDataArray>(inDSA->GetAbstractArray(i));
+    vtkDataArray* outArray = vtkArrayDownCast<vtkDataArray>(outDSA->GetAbstractArray(i));
+    if (!inArray || !outArray ||
+      inArray->GetNumberOfComponents() != outArray->GetNumberOfComponents() ||
+      outArray->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+    const char* inName = inArray->GetName();
+    const char* outName = outArray->GetName();
+    if ((inName == nullptr) != (outName == nullptr) || (inName && strcmp(inName, outName) != 0))
+    {
+      return false;
+    }
+
+    int attributeIndex = outDSA->IsArrayAnAttribute(i);
+    bool nearest = attributeIndex != -1 &&
+      outDSA->GetCopyAttribute(attributeIndex, vtkDataSetAttributes::INTERPOLATE) == 2;
+    pairs.push_back(TBCArrayPair{ inArray, outArray, nearest });
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Common state of the functors traversing batches of input cells.
+struct TBCBatchWorker
+{
+  vtkUnstructuredGrid* Input;
+  const unsigned char* CellTypes;
+  vtkDataArray* ClipArray;
+  double IsoValue;
+  bool InsideOut;
+  std::vector<TBCBatchInfo>& Batches;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+
+  TBCBatchWorker(vtkUnstructuredGrid* input, vtkDataArray* clipArray, double isoValue,
+    bool insideOut, std::vector<TBCBatchInfo>& batches)
+    : Input(input)
+    , CellTypes(input->GetCellTypesArray()->GetPointer(0))
+    , ClipArray(clipArray)
+    , IsoValue(isoValue)
+    , InsideOut(insideOut)
+    , Batches(batches)
+  {
+  }
+
+  void InitializeIterator()
+  {
+    this->CellIterator.Local().TakeReference(this->Input->GetCells()->NewIterator());
+  }
+
+  template <typename Visitor>
+  void ProcessBatch(vtkIdType batchId, Visitor& visitor)
+  {
+    vtkCellArrayIterator* iter = this->CellIterator.Local();
+    vtkIdType cellId = batchId * TBCBatchSize;
+    vtkIdType endCellId = std::min(cellId + TBCBatchSize, this->Input->GetNumberOfCells());
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      TBCClipCell(cellId, this->CellTypes[cellId], npts, pts, this->ClipArray, this->IsoValue,
+        this->InsideOut, visitor);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Pass 1: count the shapes, edge point requests and centroids of each batch.
+struct TBCCountVisitor
+{
+  TBCBatchInfo* Info;
+
+  vtkIdType AddEdgePoint(vtkIdType, vtkIdType, double)
+  {
+    this->Info->NumberOfEdgeRefs++;
+    return 0;
+  }
+  vtkIdType AddCentroidPoint(int, const vtkIdType*)
+  {
+    return -1 - this->Info->NumberOfCentroids++;
+  }
+  void AddShape(int slot, vtkIdType, const vtkIdType*) { this->Info->NumberOfShapes[slot]++; }
+};
+
+struct TBCCountWorker : public TBCBatchWorker
+{
+  using TBCBatchWorker::TBCBatchWorker;
+
+  void Initialize() { this->InitializeIterator(); }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      TBCBatchInfo& info = this->Batches[batchId];
+      std::fill_n(info.NumberOfShapes, TBCNumberOfShapeTypes, 0);
+      info.NumberOfEdgeRefs = 0;
+      info.NumberOfCentroids = 0;
+      TBCCountVisitor visitor{ &info };
+      this->ProcessBatch(batchId, visitor);
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Pass 2: record the edge point requests in serial traversal order.
+struct TBCEdgeVisitor
+{
+  TBCEdgeRef* Refs;
+  double* Percents;
+  vtkIdType Cursor;
+
+  vtkIdType AddEdgePoint(vtkIdType ap1, vtkIdType ap2, double apercent)
+  {
+    // Same normalization as vtkTableBasedClipperEdgeHashTable::AddPoint()
+    TBCEdgeRef& ref = this->Refs[this->Cursor];
+    if (ap2 < ap1)
+    {
+      ref.V0 = ap2;
+      ref.V1 = ap1;
+      this->Percents[this->Cursor] = 1.0 - apercent;
+    }
+    else
+    {
+      ref.V0 = ap1;
+      ref.V1 = ap2;
+      this->Percents[this->Cursor] = apercent;
+    }
+    ref.Seq = this->Cursor++;
+    return 0;
+  }
+  vtkIdType AddCentroidPoint(int, const vtkIdType*) { return -1; }
+  void AddShape(int, vtkIdType, const vtkIdType*) {}
+};
+
+struct TBCEdgeWorker : public TBCBatchWorker
+{
+  TBCEdgeRef* Refs;
+  double* Percents;
+
+  TBCEdgeWorker(vtkUnstructuredGrid* input, vtkDataArray* clipArray, double isoValue,
+    bool insideOut, std::vector<TBCBatchInfo>& batches, TBCEdgeRef* refs, double* percents)
+    : TBCBatchWorker(input, clipArray, isoValue, insideOut, batches)
+    , Refs(refs)
+    , Percents(percents)
+  {
+  }
+
+  void Initialize() { this->InitializeIterator(); }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      TBCEdgeVisitor visitor{ this->Refs, this->Percents, this->Batches[batchId].EdgeRefOffset };
+      this->ProcessBatch(batchId, visitor);
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Pass 3: write the output shapes and centroids. Point ids are encoded as
+// in the serial path: input points keep their id, edge points are offset by
+// the number of input points and centroids are negative.
+struct TBCFillVisitor
+{
+  vtkIdType NumberOfInputPoints;
+  const vtkIdType* EdgeIds;
+  vtkIdType EdgeCursor;
+  TBCCentroid* Centroids;
+  vtkIdType CentroidCursor;
+  vtkIdType* Connectivity;
+  vtkIdType* CellMap;
+  const vtkIdType* SlotCellOffset;
+  const vtkIdType* SlotConnOffset;
+  vtkIdType ShapeCursor[TBCNumberOfShapeTypes];
+
+  vtkIdType AddEdgePoint(vtkIdType, vtkIdType, double)
+  {
+    return this->NumberOfInputPoints + this->EdgeIds[this->EdgeCursor++];
+  }
+  vtkIdType AddCentroidPoint(int npts, const vtkIdType* ids)
+  {
+    TBCCentroid& centroid = this->Centroids[this->CentroidCursor];
+    centroid.NumberOfPoints = npts;
+    std::copy(ids, ids + npts, centroid.PointIds);
+    return -1 - this->CentroidCursor++;
+  }
+  void AddShape(int slot, vtkIdType cellId, const vtkIdType* ids)
+  {
+    vtkIdType outCellId = this->ShapeCursor[slot]++;
+    vtkIdType* conn = this->Connectivity + this->SlotConnOffset[slot] +
+      (outCellId - this->SlotCellOffset[slot]) * TBCShapeSize[slot];
+    std::copy(ids, ids + TBCShapeSize[slot], conn);
+    this->CellMap[outCellId] = cellId;
+  }
+};
+
+struct TBCFillWorker : public TBCBatchWorker
+{
+  TBCFillVisitor Prototype;
+
+  TBCFillWorker(vtkUnstructuredGrid* input, vtkDataArray* clipArray, double isoValue,
+    bool insideOut, std::vector<TBCBatchInfo>& batches, const TBCFillVisitor& prototype)
+    : TBCBatchWorker(input, clipArray, isoValue, insideOut, batches)
+    , Prototype(prototype)
+  {
+  }
+
+  void Initialize() { this->InitializeIterator(); }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    for (; batchId < endBatchId; ++batchId)
+    {
+      const TBCBatchInfo& info = this->Batches[batchId];
+      TBCFillVisitor visitor = this->Prototype;
+      visitor.EdgeCursor = info.EdgeRefOffset;
+      visitor.CentroidCursor = info.CentroidOffset;
+      for (int slot = 0; slot < TBCNumberOfShapeTypes; ++slot)
+      {
+        visitor.ShapeCursor[slot] = this->Prototype.SlotCellOffset[slot] + info.ShapeOffset[slot];
+      }
+      this->ProcessBatch(batchId, visitor);
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Clip an unstructured grid made only of cells the tables handle. Returns
+// false without touching the output if the input cannot be processed here.
+bool TBCClipUnstructuredGrid(vtkUnstructuredGrid* input, vtkDataArray* clipArray,
+  double isoValue, bool insideOut, int precision, vtkUnstructuredGrid* output)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  if (numCells < 1 || !input->GetCellTypesArray() ||
+    inPD->GetAbstractArray("avtOriginalNodeNumbers") != nullptr)
+  {
+    return false;
+  }
+
+  const unsigned char* cellTypes = input->GetCellTypesArray()->GetPointer(0);
+  std::atomic<bool> allClippable(true);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId && allClippable; ++cellId)
+    {
+      if (!TBCIsClippableCellType(cellTypes[cellId]))
+      {
+        allClippable = false;
+      }
+    }
+  });
+  if (!allClippable)
+  {
+    return false;
+  }
+
+  // Make sure the attributes can be processed by the threads before doing
+  // any work.
+  vtkNew<vtkUnstructuredGrid> probe;
+  std::vector<TBCArrayPair> pointPairs;
+  std::vector<TBCArrayPair> cellPairs;
+  probe->GetPointData()->CopyAllocate(inPD, 0);
+  probe->GetCellData()->CopyAllocate(inCD, 0);
+  if (!TBCPairArrays(inPD, probe->GetPointData(), pointPairs) ||
+    !TBCPairArrays(inCD, probe->GetCellData(), cellPairs))
+  {
+    return false;
+  }
+
+  // Pass 1: count, then prefix sum the counts over the batches.
+  vtkIdType numBatches = (numCells + TBCBatchSize - 1) / TBCBatchSize;
+  std::vector<TBCBatchInfo> batches(numBatches);
+  TBCCountWorker counter(input, clipArray, isoValue, insideOut, batches);
+  vtkSMPTools::For(0, numBatches, counter);
+
+  vtkIdType numShapes[TBCNumberOfShapeTypes] = { 0 };
+  vtkIdType numEdgeRefs = 0;
+  vtkIdType numCentroids = 0;
+  for (TBCBatchInfo& info : batches)
+  {
+    for (int slot = 0; slot < TBCNumberOfShapeTypes; ++slot)
+    {
+      info.ShapeOffset[slot] = numShapes[slot];
+      numShapes[slot] += info.NumberOfShapes[slot];
+    }
+    info.EdgeRefOffset = numEdgeRefs;
+    numEdgeRefs += info.NumberOfEdgeRefs;
+    info.CentroidOffset = numCentroids;
+    numCentroids += info.NumberOfCentroids;
+  }
+
+  vtkIdType slotCellOffset[TBCNumberOfShapeTypes + 1];
+  vtkIdType slotConnOffset[TBCNumberOfShapeTypes + 1];
+  slotCellOffset[0] = 0;
+  slotConnOffset[0] = 0;
+  for (int slot = 0; slot < TBCNumberOfShapeTypes; ++slot)
+  {
+    slotCellOffset[slot + 1] = slotCellOffset[slot] + numShapes[slot];
+    slotConnOffset[slot + 1] = slotConnOffset[slot] + numShapes[slot] * TBCShapeSize[slot];
+  }
+  vtkIdType numOutCells = slotCellOffset[TBCNumberOfShapeTypes];
+  vtkIdType connSize = slotConnOffset[TBCNumberOfShapeTypes];
+
+  // Pass 2: gather the edge requests and merge them. The first request of an
+  // edge (in serial order) defines the edge point, and the edge points are
+  // numbered in the order of their first request, as the serial hash does.
+  std::vector<TBCEdgeRef> refs(numEdgeRefs);
+  std::vector<double> percents(numEdgeRefs);
+  TBCEdgeWorker edgeGatherer(
+    input, clipArray, isoValue, insideOut, batches, refs.data(), percents.data());
+  vtkSMPTools::For(0, numBatches, edgeGatherer);
+  vtkSMPTools::Sort(refs.begin(), refs.end());
+
+  std::vector<vtkIdType> edgeIds(numEdgeRefs);
+  std::vector<unsigned char> isFirstRef(numEdgeRefs);
+  vtkSMPTools::For(0, numEdgeRefs, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      isFirstRef[refs[i].Seq] = (i == 0 || !refs[i].SameEdge(refs[i - 1])) ? 1 : 0;
+    }
+  });
+  vtkIdType numEdgePts = TBCEnumerate(
+    numEdgeRefs, [&](vtkIdType seq) { return isFirstRef[seq] != 0; },
+    [&](vtkIdType seq, vtkIdType rank) { edgeIds[seq] = rank; });
+
+  std::vector<TBCEdgeRef> edgePts(numEdgePts);
+  std::vector<double> edgePercents(numEdgePts);
+  vtkSMPTools::For(0, numEdgeRefs, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      if (i > 0 && refs[i].SameEdge(refs[i - 1]))
+      {
+        continue;
+      }
+      vtkIdType first = refs[i].Seq;
+      vtkIdType edgeId = edgeIds[first];
+      edgePts[edgeId] = refs[i];
+      edgePercents[edgeId] = percents[first];
+      for (vtkIdType j = i + 1; j < numEdgeRefs && refs[j].SameEdge(refs[i]); ++j)
+      {
+        edgeIds[refs[j].Seq] = edgeId;
+      }
+    }
+  });
+  refs.clear();
+  refs.shrink_to_fit();
+  percents.clear();
+  percents.shrink_to_fit();
+  isFirstRef.clear();
+  isFirstRef.shrink_to_fit();
+
+  // Pass 3: write the shapes (with encoded point ids) and centroids.
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connSize);
+  std::vector<vtkIdType> cellMap(numOutCells);
+  std::vector<TBCCentroid> centroids(numCentroids);
+
+  TBCFillVisitor prototype;
+  prototype.NumberOfInputPoints = numPts;
+  prototype.EdgeIds = edgeIds.data();
+  prototype.EdgeCursor = 0;
+  prototype.Centroids = centroids.data();
+  prototype.CentroidCursor = 0;
+  prototype.Connectivity = connectivity->GetPointer(0);
+  prototype.CellMap = cellMap.data();
+  prototype.SlotCellOffset = slotCellOffset;
+  prototype.SlotConnOffset = slotConnOffset;
+  TBCFillWorker filler(input, clipArray, isoValue, insideOut, batches, prototype);
+  vtkSMPTools::For(0, numBatches, filler);
+  edgeIds.clear();
+  edgeIds.shrink_to_fit();
+
+  // Only the input points used by the output are kept. They are numbered in
+  // the order in which the output connectivity first references them.
+  vtkIdType* conn = connectivity->GetPointer(0);
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numPts]);
+  std::vector<vtkIdType> ptLookup(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(connSize, std::memory_order_relaxed);
+      ptLookup[ptId] = -1;
+    }
+  });
+  vtkSMPTools::For(0, connSize, [&](vtkIdType pos, vtkIdType endPos) {
+    for (; pos < endPos; ++pos)
+    {
+      vtkIdType ptId = conn[pos];
+      if (ptId < 0 || ptId >= numPts)
+      {
+        continue;
+      }
+      vtkIdType current = firstUse[ptId].load(std::memory_order_relaxed);
+      while (pos < current &&
+        !firstUse[ptId].compare_exchange_weak(current, pos, std::memory_order_relaxed))
+      {
+      }
+    }
+  });
+  vtkIdType numUsed = TBCEnumerate(
+    connSize,
+    [&](vtkIdType pos) {
+      vtkIdType ptId = conn[pos];
+      return ptId >= 0 && ptId < numPts && firstUse[ptId].load(std::memory_order_relaxed) == pos;
+    },
+    [&](vtkIdType pos, vtkIdType rank) { ptLookup[conn[pos]] = rank; });
+  firstUse.reset();
+
+  vtkIdType centroidStart = numUsed + numEdgePts;
+  vtkIdType numOutPts = centroidStart + numCentroids;
+  auto decode = [&](vtkIdType id) -> vtkIdType {
+    if (id < 0)
+    {
+      return centroidStart - 1 - id;
+    }
+    else if (id >= numPts)
+    {
+      return numUsed + (id - numPts);
+    }
+    return ptLookup[id];
+  };
+
+  // Output points and point data.
+  vtkNew<vtkPoints> outPts;
+  if (precision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    outPts->SetDataType(input->GetPoints()->GetDataType());
+  }
+  else if (precision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_FLOAT);
+  }
+  else if (precision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_DOUBLE);
+  }
+  outPts->SetNumberOfPoints(numOutPts);
+
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numOutPts);
+  outPD->SetNumberOfTuples(numOutPts);
+  TBCPairArrays(inPD, outPD, pointPairs);
+
+  vtkPoints* inPts = input->GetPoints();
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType outId = ptLookup[ptId];
+      if (outId < 0)
+      {
+        continue;
+      }
+      inPts->GetPoint(ptId, x);
+      outPts->SetPoint(outId, x);
+      for (const TBCArrayPair& pair : pointPairs)
+      {
+        pair.Output->InsertTuple(outId, ptId, pair.Input);
+      }
+    }
+  });
+
+  vtkSMPTools::For(0, numEdgePts, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    double pt1[3], pt2[3], pt[3];
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      const TBCEdgeRef& edge = edgePts[edgeId];
+      inPts->GetPoint(edge.V0, pt1);
+      inPts->GetPoint(edge.V1, pt2);
+      double p = edgePercents[edgeId];
+      double bp = 1.0 - p;
+      pt[0] = pt1[0] * p + pt2[0] * bp;
+      pt[1] = pt1[1] * p + pt2[1] * bp;
+      pt[2] = pt1[2] * p + pt2[2] * bp;
+      vtkIdType outId = numUsed + edgeId;
+      outPts->SetPoint(outId, pt);
+      for (const TBCArrayPair& pair : pointPairs)
+      {
+        if (pair.NearestNeighbor)
+        {
+          pair.Output->InsertTuple(outId, bp < .5 ? edge.V0 : edge.V1, pair.Input);
+        }
+        else
+        {
+          pair.Output->InterpolateTuple(outId, edge.V0, pair.Input, edge.V1, pair.Input, bp);
+        }
+      }
+    }
+  });
+
+  // Centroids may depend on earlier centroids of the same cell, so each batch
+  // processes its own centroids in order.
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> localIdList;
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType batchId, vtkIdType endBatchId) {
+    vtkSmartPointer<vtkIdList>& idList = localIdList.Local();
+    if (!idList)
+    {
+      idList = vtkSmartPointer<vtkIdList>::New();
+    }
+    for (; batchId < endBatchId; ++batchId)
+    {
+      const TBCBatchInfo& info = batches[batchId];
+      for (vtkIdType c = info.CentroidOffset; c < info.CentroidOffset + info.NumberOfCentroids;
+           ++c)
+      {
+        const TBCCentroid& centroid = centroids[c];
+        idList->SetNumberOfIds(centroid.NumberOfPoints);
+        double pts[8][3];
+        double weights[8];
+        double pt[3] = { 0.0, 0.0, 0.0 };
+        double weightFactor = 1.0 / centroid.NumberOfPoints;
+        for (int k = 0; k < centroid.NumberOfPoints; k++)
+        {
+          weights[k] = 1.0 * weightFactor;
+          vtkIdType id = decode(centroid.PointIds[k]);
+          idList->SetId(k, id);
+          outPts->GetPoint(id, pts[k]);
+          pt[0] += pts[k][0];
+          pt[1] += pts[k][1];
+          pt[2] += pts[k][2];
+        }
+        pt[0] *= weightFactor;
+        pt[1] *= weightFactor;
+        pt[2] *= weightFactor;
+
+        vtkIdType outId = centroidStart + c;
+        outPts->SetPoint(outId, pt);
+        for (const TBCArrayPair& pair : pointPairs)
+        {
+          if (pair.NearestNeighbor)
+          {
+            // Same selection as vtkDataSetAttributes::InterpolatePoint()
+            vtkIdType maxId = idList->GetId(0);
+            vtkIdType maxWeight = 0;
+            for (int k = 0; k < centroid.NumberOfPoints; k++)
+            {
+              if (weights[k] > maxWeight)
+              {
+                maxWeight = static_cast<vtkIdType>(weights[k]);
+                maxId = idList->GetId(k);
+              }
+            }
+            pair.Output->InsertTuple(outId, maxId, pair.Output);
+          }
+          else
+          {
+            pair.Output->InterpolateTuple(outId, idList, pair.Output, weights);
+          }
+        }
+      }
+    }
+  });
+  output->SetPoints(outPts);
+
+  // Cells and cell data. The encoded ids are turned into output point ids.
+  vtkSMPTools::For(0, connSize, [&](vtkIdType pos, vtkIdType endPos) {
+    for (; pos < endPos; ++pos)
+    {
+      conn[pos] = decode(conn[pos]);
+    }
+  });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numOutCells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkNew<vtkUnsignedCharArray> outCellTypes;
+  outCellTypes->SetNumberOfValues(numOutCells);
+  unsigned char* outCellTypesPtr = outCellTypes->GetPointer(0);
+  for (int slot = 0; slot < TBCNumberOfShapeTypes; ++slot)
+  {
+    vtkSMPTools::For(
+      slotCellOffset[slot], slotCellOffset[slot + 1], [&](vtkIdType cellId, vtkIdType endCellId) {
+        for (; cellId < endCellId; ++cellId)
+        {
+          offsetsPtr[cellId] =
+            slotConnOffset[slot] + (cellId - slotCellOffset[slot]) * TBCShapeSize[slot];
+          outCellTypesPtr[cellId] = TBCShapeVTKType[slot];
+        }
+      });
+  }
+  offsetsPtr[numOutCells] = connSize;
+
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numOutCells);
+  outCD->SetNumberOfTuples(numOutCells);
+  TBCPairArrays(inCD, outCD, cellPairs);
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      for (const TBCArrayPair& pair : cellPairs)
+      {
+        pair.Output->InsertTuple(cellId, cellMap[cellId], pair.Input);
+      }
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(outCellTypes, cells);
+
+  return true;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ================ vtkTableBasedClipperThreadedClip ( end ) =================
+// ============================================================================
+
 //------------------------------------------------------------------------------
 // Construct with user-specified implicit function; InsideOut turned off; value
 // set to 0.0; and generate clip scalars turned off.
@@ -1564,6 +2550,7 @@ vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
   this->GenerateClippedOutput = 0;
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 
   this->SetNumberOfOutputPorts(2);
   vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
@@ -2902,6 +3889,15 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
 {
   vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
 
+  // Grids made only of cells covered by the clip tables are processed by
+  // multiple threads; the output is identical to the serial path below.
+  if (!this->SequentialProcessing &&
+    TBCClipUnstructuredGrid(unstruct, clipAray, isoValue, this->InsideOut != 0,
+      this->OutputPointsPrecision, outputUG))
+  {
+    return;
+  }
+
   vtkIdType i, j;
   vtkIdType numbPnts = 0;
   int numCants = 0; // number of cells not clipped by this filter
@@ -3312,4 +4308,6 @@ void vtkTableBasedClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseValueAsOffset: " << (this->UseValueAsOffset ? "On\n" : "Off\n");
 
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
+
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
@@ -68,6 +68,13 @@
  *  advantages are gained by adopting the unique clipping and triangulation tables
  *  proposed by VisIt.
  *
+ *  Unstructured grids whose cells are all handled by the clipping tables
+ *  (linear 3D cells, triangles, quads, pixels, lines and vertices) are clipped
+ *  using vtkSMPTools: cells are classified and counted in parallel, prefix sums
+ *  over the counts give the output layout, and connectivity and interpolated
+ *  point data are written directly into preallocated arrays. The result does
+ *  not depend on the number of threads and is identical to the serial output.
+ *
  * @warning
  *  vtkTableBasedClipDataSet makes use of a hash table (that is provided by class
  *  maintained by internal class vtkTableBasedClipperDataSetFromVolume) to achieve
@@ -226,6 +233,20 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when clipping
+   * unstructured grids. By default, sequential processing is off. Note this
+   * flag only applies if the class has been compiled with
+   * VTK_SMP_IMPLEMENTATION_TYPE set to something other than Sequential. (If
+   * set to Sequential, then the filter always runs in serial mode.) This flag
+   * is typically used for benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkTableBasedClipDataSet(vtkImplicitFunction* cf = nullptr);
   ~vtkTableBasedClipDataSet() override;
@@ -304,6 +325,7 @@ protected:
   vtkIncrementalPointLocator* Locator;
 
   int OutputPointsPrecision;
+  vtkTypeBool SequentialProcessing;
 
 private:
   vtkTableBasedClipDataSet(const vtkTableBasedClipDataSet&) = delete;
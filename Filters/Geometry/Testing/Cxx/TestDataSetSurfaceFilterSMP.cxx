@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded extraction of the external faces of unstructured
+// grids by vtkDataSetSurfaceFilter and vtkGeometryFilter produces exactly the
+// same output as their serial paths, with and without ghosts.
+
+#include "vtkDataSetSurfaceFilter.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkGeometryFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestDataSetComparison.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+// Blocks of each linear 3D cell type, plus voxels. When separated, each
+// block is moved away from the others so that the mesh is conforming;
+// otherwise the blocks overlap and share their merged points. The faces of
+// adjacent pentagonal prisms only partly overlap, so they are left out of the
+// conforming mesh.
+void MakeInput(bool separated, vtkUnstructuredGrid* input)
+{
+  const int cellTypes[] = { VTK_HEXAHEDRON, VTK_TETRA, VTK_WEDGE, VTK_PYRAMID,
+    VTK_PENTAGONAL_PRISM, VTK_HEXAGONAL_PRISM };
+  vtkNew<vtkAppendFilter> append;
+  append->MergePointsOn();
+  double shift = 0.0;
+  for (int cellType : cellTypes)
+  {
+    if (separated && cellType == VTK_PENTAGONAL_PRISM)
+    {
+      continue;
+    }
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(6, 5, 4);
+    source->Update();
+    vtkNew<vtkUnstructuredGrid> block;
+    block->DeepCopy(source->GetOutput());
+    vtkPoints* points = block->GetPoints();
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      double x[3];
+      points->GetPoint(i, x);
+      x[0] += shift;
+      points->SetPoint(i, x);
+    }
+    shift += (separated ? 10.0 : 0.0);
+    append->AddInputData(block);
+  }
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(5, 4, 6);
+  image->SetOrigin(shift, 0.0, 0.0);
+  append->AddInputData(image);
+  append->Update();
+  input->DeepCopy(append->GetOutput());
+  input->GetPointData()->Initialize();
+  input->GetCellData()->Initialize();
+
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    pointScalars->SetValue(i, 0.5 * i + 1.0 / 3.0);
+  }
+  input->GetPointData()->SetScalars(pointScalars);
+
+  vtkNew<vtkIntArray> cellInts;
+  cellInts->SetName("CellInts");
+  cellInts->SetNumberOfComponents(2);
+  cellInts->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellInts->SetTypedComponent(i, 0, static_cast<int>(i));
+    cellInts->SetTypedComponent(i, 1, static_cast<int>(i * 7 % 13));
+  }
+  input->GetCellData()->AddArray(cellInts);
+}
+
+// Hide a few points and mark a few cells as duplicate ghosts.
+void AddGhosts(vtkUnstructuredGrid* input)
+{
+  vtkNew<vtkUnsignedCharArray> pointGhosts;
+  pointGhosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  pointGhosts->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    pointGhosts->SetValue(i, i % 17 == 0 ? vtkDataSetAttributes::HIDDENPOINT : 0);
+  }
+  input->GetPointData()->AddArray(pointGhosts);
+
+  vtkNew<vtkUnsignedCharArray> cellGhosts;
+  cellGhosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  cellGhosts->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    cellGhosts->SetValue(i, i % 11 == 0 ? vtkDataSetAttributes::DUPLICATECELL : 0);
+  }
+  input->GetCellData()->AddArray(cellGhosts);
+}
+
+// Both outputs must be the same, with polygons.
+bool SameOutputs(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPolys() == 0)
+  {
+    std::cerr << "No polygons extracted" << std::endl;
+    return false;
+  }
+  return vtkTest::SamePolyData(a, b);
+}
+
+bool CompareSurfaceFilters(vtkUnstructuredGrid* input, bool passThroughIds)
+{
+  vtkNew<vtkDataSetSurfaceFilter> filters[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    filters[i]->SetInputData(input);
+    filters[i]->SetPassThroughCellIds(passThroughIds);
+    filters[i]->SetPassThroughPointIds(passThroughIds);
+    filters[i]->SetSequentialProcessing(i == 0);
+    filters[i]->Update();
+  }
+  return SameOutputs(filters[0]->GetOutput(), filters[1]->GetOutput());
+}
+
+bool CompareGeometryFilters(vtkUnstructuredGrid* input)
+{
+  vtkNew<vtkGeometryFilter> filters[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    filters[i]->SetInputData(input);
+    filters[i]->SetSequentialProcessing(i == 0);
+    filters[i]->Update();
+  }
+  return SameOutputs(filters[0]->GetOutput(), filters[1]->GetOutput());
+}
+}
+
+int TestDataSetSurfaceFilterSMP(int, char*[])
+{
+  for (int ghosts = 0; ghosts < 2; ++ghosts)
+  {
+    for (int separated = 0; separated < 2; ++separated)
+    {
+      vtkNew<vtkUnstructuredGrid> input;
+      MakeInput(separated != 0, input);
+      if (ghosts)
+      {
+        AddGhosts(input);
+      }
+
+      for (int passThroughIds = 0; passThroughIds < 2; ++passThroughIds)
+      {
+        if (!CompareSurfaceFilters(input, passThroughIds != 0))
+        {
+          std::cerr << "vtkDataSetSurfaceFilter differs for ghosts " << ghosts << ", separated "
+                    << separated << " and pass through ids " << passThroughIds << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      // Only conforming meshes give the same faces as the cell neighbors.
+      if (separated && !CompareGeometryFilters(input))
+      {
+        std::cerr << "vtkGeometryFilter differs for ghosts " << ghosts << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
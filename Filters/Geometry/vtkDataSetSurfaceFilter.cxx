@@ -26,6 +26,7 @@
 #include "vtkCellIterator.h"
 #include "vtkCellTypes.h"
 #include "vtkDoubleArray.h"
+#include "vtkExternalFacesInternal.h"
 #include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
 #include "vtkIdTypeArray.h"
@@ -41,6 +42,7 @@
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -57,8 +59,11 @@
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 static inline int sizeofFastQuad(int numPts)
 {
@@ -142,6 +147,7 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->OriginalPointIdsName = nullptr;
 
   this->NonlinearSubdivisionLevel = 1;
+  this->SequentialProcessing = false;
 }
 
 //------------------------------------------------------------------------------
@@ -1453,6 +1459,7 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OriginalPointIdsName: " << this->GetOriginalPointIdsName() << endl;
 
   os << indent << "NonlinearSubdivisionLevel: " << this->GetNonlinearSubdivisionLevel() << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 
 //========================================================================
@@ -1463,6 +1470,10 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPolyData* output)
 {
   vtkUnstructuredGridBase* input = vtkUnstructuredGridBase::SafeDownCast(dataSetInput);
+  if (this->CanExtractFacesInParallel(input))
+  {
+    return this->ExtractFacesInParallel(static_cast<vtkUnstructuredGrid*>(input), output);
+  }
 
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
@@ -2280,6 +2291,251 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, v
   return 1;
 }
 
+namespace
+{
+
+// The faces of the linear 3D cells, in the order and orientation in which
+// UnstructuredGridExecute() inserts them in the hash. Empty cells have none.
+const CellFaceTable EmptyCellFaces = { 0, {}, {} };
+const CellFaceTable TetraFaces = { 4, { 3, 3, 3, 3 },
+  { { 0, 1, 3 }, { 0, 2, 1 }, { 0, 3, 2 }, { 1, 2, 3 } } };
+const CellFaceTable VoxelFaces = { 6, { 4, 4, 4, 4, 4, 4 },
+  { { 0, 1, 5, 4 }, { 0, 2, 3, 1 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 2, 6, 7, 3 },
+    { 4, 5, 7, 6 } } };
+const CellFaceTable HexahedronFaces = { 6, { 4, 4, 4, 4, 4, 4 },
+  { { 0, 1, 5, 4 }, { 0, 3, 2, 1 }, { 0, 4, 7, 3 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 },
+    { 4, 5, 6, 7 } } };
+const CellFaceTable WedgeFaces = { 5, { 4, 4, 4, 3, 3 },
+  { { 0, 2, 5, 3 }, { 1, 0, 3, 4 }, { 2, 1, 4, 5 }, { 0, 1, 2 }, { 3, 5, 4 } } };
+const CellFaceTable PyramidFaces = { 5, { 4, 3, 3, 3, 3 },
+  { { 3, 2, 1, 0 }, { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 } } };
+const CellFaceTable PentagonalPrismFaces = { 7, { 4, 4, 4, 4, 4, 5, 5 },
+  { { 0, 1, 6, 5 }, { 1, 2, 7, 6 }, { 2, 3, 8, 7 }, { 3, 4, 9, 8 }, { 4, 0, 5, 9 },
+    { 0, 1, 2, 3, 4 }, { 5, 6, 7, 8, 9 } } };
+const CellFaceTable HexagonalPrismFaces = { 8, { 4, 4, 4, 4, 4, 4, 6, 6 },
+  { { 0, 1, 7, 6 }, { 1, 2, 8, 7 }, { 2, 3, 9, 8 }, { 3, 4, 10, 9 }, { 4, 5, 11, 10 },
+    { 5, 0, 6, 11 }, { 0, 1, 2, 3, 4, 5 }, { 6, 7, 8, 9, 10, 11 } } };
+
+CellFaceTables MakeSurfaceFaceTables()
+{
+  CellFaceTables tables;
+  tables.fill(nullptr);
+  tables[VTK_EMPTY_CELL] = &EmptyCellFaces;
+  tables[VTK_TETRA] = &TetraFaces;
+  tables[VTK_VOXEL] = &VoxelFaces;
+  tables[VTK_HEXAHEDRON] = &HexahedronFaces;
+  tables[VTK_WEDGE] = &WedgeFaces;
+  tables[VTK_PYRAMID] = &PyramidFaces;
+  tables[VTK_PENTAGONAL_PRISM] = &PentagonalPrismFaces;
+  tables[VTK_HEXAGONAL_PRISM] = &HexagonalPrismFaces;
+  return tables;
+}
+
+const CellFaceTables SurfaceFaceTables = MakeSurfaceFaceTables();
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// The threaded path handles the linear 3D cells whose faces are inserted in
+// the hash from a fixed table, which covers large volume meshes. The serial
+// path outputs the vertices, lines and 2D cells before the faces, and
+// triangulates the faces of nonlinear cells as it goes, so grids with any
+// other cell type are left to it.
+bool vtkDataSetSurfaceFilter::CanExtractFacesInParallel(vtkUnstructuredGridBase* input)
+{
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  return !this->SequentialProcessing && grid && HasFaceTables(grid, SurfaceFaceTables);
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::ExtractFacesInParallel(
+  vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  // Shallow copy field data not associated with points or cells
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  // Gather the external faces in the order of the hash traversal.
+  ExternalFaces faces(input, SurfaceFaceTables);
+  faces.Execute();
+  std::vector<vtkIdType> faceCells;
+  vtkNew<vtkIdTypeArray> faceOffsets;
+  vtkNew<vtkIdTypeArray> faceConn;
+  faces.GatherInBinOrder(faceCells, faceOffsets, faceConn);
+  const vtkIdType numFaces = static_cast<vtkIdType>(faceCells.size());
+  const vtkIdType connSize = faceConn->GetNumberOfValues();
+  const vtkIdType* offsets = faceOffsets->GetPointer(0);
+  const vtkIdType* conn = faceConn->GetPointer(0);
+
+  // Number the points in order of first use by the external faces, like
+  // GetOutputPointId() does. The points of faces dropped below because of a
+  // hidden point are numbered as well.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUse[ptId].store(connSize, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, connSize, [&](vtkIdType i, vtkIdType endI) {
+    for (; i < endI; ++i)
+    {
+      std::atomic<vtkIdType>& first = firstUse[conn[i]];
+      vtkIdType current = first.load(std::memory_order_relaxed);
+      while (i < current && !first.compare_exchange_weak(current, i, std::memory_order_relaxed))
+      {
+      }
+    }
+  });
+  auto isFirstUse = [&](vtkIdType i) {
+    return firstUse[conn[i]].load(std::memory_order_relaxed) == i;
+  };
+  std::vector<vtkIdType> useOffsets;
+  const vtkIdType numNewPts = ScanBlocks(connSize, useOffsets, [&](vtkIdType i, vtkIdType endI) {
+    vtkIdType count = 0;
+    for (; i < endI; ++i)
+    {
+      count += (isFirstUse(i) ? 1 : 0);
+    }
+    return count;
+  });
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(input->GetPoints()->GetData()->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  std::vector<vtkIdType> originalPointIds(numNewPts);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(useOffsets.size()) - 1,
+    [&](vtkIdType blockId, vtkIdType endBlockId) {
+      double x[3];
+      for (; blockId < endBlockId; ++blockId)
+      {
+        vtkIdType newId = useOffsets[blockId];
+        vtkIdType endI = std::min(connSize, (blockId + 1) * ExternalFacesBlockSize);
+        for (vtkIdType i = blockId * ExternalFacesBlockSize; i < endI; ++i)
+        {
+          if (isFirstUse(i))
+          {
+            input->GetPoint(conn[i], x);
+            newPts->SetPoint(newId, x);
+            originalPointIds[newId] = conn[i];
+            pointMap[conn[i]] = newId++;
+          }
+        }
+      }
+    });
+  firstUse.reset();
+
+  // Output the faces without hidden points, renumbering their points.
+  vtkUnsignedCharArray* ghosts = input->GetPointGhostArray();
+  const unsigned char* ghostValues = ghosts ? ghosts->GetPointer(0) : nullptr;
+  auto isVisible = [&](vtkIdType faceId) {
+    for (vtkIdType i = offsets[faceId]; ghostValues && i < offsets[faceId + 1]; ++i)
+    {
+      if (ghostValues[conn[i]] & vtkDataSetAttributes::HIDDENPOINT)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  std::vector<vtkIdType> polyOffsets;
+  std::vector<vtkIdType> polyConnOffsets;
+  const vtkIdType numNewCells =
+    ScanBlocks(numFaces, polyOffsets, [&](vtkIdType faceId, vtkIdType endFaceId) {
+      vtkIdType count = 0;
+      for (; faceId < endFaceId; ++faceId)
+      {
+        count += (isVisible(faceId) ? 1 : 0);
+      }
+      return count;
+    });
+  const vtkIdType newConnSize =
+    ScanBlocks(numFaces, polyConnOffsets, [&](vtkIdType faceId, vtkIdType endFaceId) {
+      vtkIdType size = 0;
+      for (; faceId < endFaceId; ++faceId)
+      {
+        size += (isVisible(faceId) ? offsets[faceId + 1] - offsets[faceId] : 0);
+      }
+      return size;
+    });
+
+  vtkNew<vtkIdTypeArray> newOffsets;
+  newOffsets->SetNumberOfValues(numNewCells + 1);
+  vtkNew<vtkIdTypeArray> newConn;
+  newConn->SetNumberOfValues(newConnSize);
+  vtkIdType* newOffsetsPtr = newOffsets->GetPointer(0);
+  vtkIdType* newConnPtr = newConn->GetPointer(0);
+  std::vector<vtkIdType> originalCellIds(numNewCells);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(polyOffsets.size()) - 1,
+    [&](vtkIdType blockId, vtkIdType endBlockId) {
+      for (; blockId < endBlockId; ++blockId)
+      {
+        vtkIdType newCellId = polyOffsets[blockId];
+        vtkIdType loc = polyConnOffsets[blockId];
+        vtkIdType endFaceId = std::min(numFaces, (blockId + 1) * ExternalFacesBlockSize);
+        for (vtkIdType faceId = blockId * ExternalFacesBlockSize; faceId < endFaceId; ++faceId)
+        {
+          if (isVisible(faceId))
+          {
+            originalCellIds[newCellId] = faceCells[faceId];
+            newOffsetsPtr[newCellId++] = loc;
+            for (vtkIdType i = offsets[faceId]; i < offsets[faceId + 1]; ++i)
+            {
+              newConnPtr[loc++] = pointMap[conn[i]];
+            }
+          }
+        }
+      }
+    });
+  newOffsetsPtr[numNewCells] = newConnSize;
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->SetData(newOffsets, newConn);
+
+  // Copy the data of the points and of the cells owning the faces.
+  if (this->NonlinearSubdivisionLevel < 2)
+  {
+    outputPD->CopyGlobalIdsOn();
+    outputPD->CopyAllocate(inputPD, numNewPts);
+  }
+  else
+  {
+    outputPD->InterpolateAllocate(inputPD, numNewPts);
+  }
+  CopyAttributes(inputPD, outputPD, originalPointIds.data(), numNewPts);
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numNewCells);
+  CopyAttributes(inputCD, outputCD, originalCellIds.data(), numNewCells);
+
+  if (this->PassThroughCellIds)
+  {
+    vtkNew<vtkIdTypeArray> cellIds;
+    cellIds->SetName(this->GetOriginalCellIdsName());
+    cellIds->SetNumberOfValues(numNewCells);
+    std::copy(originalCellIds.begin(), originalCellIds.end(), cellIds->GetPointer(0));
+    outputCD->AddArray(cellIds);
+  }
+  if (this->PassThroughPointIds)
+  {
+    vtkNew<vtkIdTypeArray> pointIds;
+    pointIds->SetName(this->GetOriginalPointIdsName());
+    pointIds->SetNumberOfValues(numNewPts);
+    std::copy(originalPointIds.begin(), originalPointIds.end(), pointIds->GetPointer(0));
+    outputPD->AddArray(pointIds);
+  }
+
+  output->SetPoints(newPts);
+  output->SetPolys(newPolys);
+  output->Squeeze();
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
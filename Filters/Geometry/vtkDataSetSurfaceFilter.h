@@ -21,6 +21,14 @@
  * vtkGeometryFilter.  It only has one option: whether to use triangle strips
  * when the input type is structured.
  *
+ * The surface of unstructured grids made of linear 3D cells (tetrahedra,
+ * hexahedra, voxels, wedges, pyramids and prisms) is extracted in parallel
+ * using vtkSMPTools: the faces are enumerated and binned by point
+ * concurrently, interior faces are culled bin by bin, and the output is
+ * gathered in the order of the serial face hash, so that the result does not
+ * depend on the number of threads. Other unstructured grids are processed
+ * serially.
+ *
  * @sa
  * vtkGeometryFilter vtkStructuredGridGeometryFilter.
  */
@@ -35,6 +43,8 @@ class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
+class vtkUnstructuredGridBase;
 
 // Helper structure for hashing faces.
 struct vtkFastGeomQuadStruct
@@ -126,6 +136,20 @@ public:
   vtkGetMacro(NonlinearSubdivisionLevel, int);
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when extracting the
+   * surface of unstructured grids. By default, sequential processing is off.
+   * Note this flag only applies if the class has been compiled with
+   * VTK_SMP_IMPLEMENTATION_TYPE set to something other than Sequential. (If
+   * set to Sequential, then the filter always runs in serial mode.) This flag
+   * is typically used for benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Direct access methods that can be used to use the this class as an
@@ -253,6 +277,10 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  vtkTypeBool SequentialProcessing;
+  bool CanExtractFacesInParallel(vtkUnstructuredGridBase* input);
+  int ExtractFacesInParallel(vtkUnstructuredGrid* input, vtkPolyData* output);
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&) = delete;
   void operator=(const vtkDataSetSurfaceFilter&) = delete;
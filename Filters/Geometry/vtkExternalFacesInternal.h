@@ -0,0 +1,568 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExternalFacesInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkExternalFacesInternal
+ * @brief   threaded extraction of the external faces of linear 3D cells
+ *
+ * vtkExternalFacesInternal finds the faces of the cells of an unstructured
+ * grid that are not shared with any other cell. The faces of each cell type
+ * are described by a table. All faces are enumerated in parallel and
+ * partitioned into bins by their first point once rotated to start at their
+ * smallest point id, which is the bin of the face hash of
+ * vtkDataSetSurfaceFilter. Each bin is then sorted by cell and face id, the
+ * order in which the serial hash receives its faces, and its faces are
+ * compared pairwise with the same rules as the hash. A face is external when
+ * no other face of its bin matches it.
+ *
+ * The external faces can then be gathered either in the traversal order of
+ * the serial hash (vtkDataSetSurfaceFilter) or in cell order
+ * (vtkGeometryFilter), so that the threaded filters produce exactly the same
+ * output as their serial counterparts.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkDataSetSurfaceFilter vtkGeometryFilter
+ */
+
+#ifndef vtkExternalFacesInternal_h
+#define vtkExternalFacesInternal_h
+
+#include "vtkArrayListTemplate.h"
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+const int MaximumCellFaces = 8;
+const int MaximumCellFaceSize = 6;
+
+// Points, bins and cells are processed in blocks of this size when a
+// deterministic numbering (count, prefix sum, fill) is required.
+const vtkIdType ExternalFacesBlockSize = 4096;
+
+// The faces of a cell type, as lists of cell point indices.
+struct CellFaceTable
+{
+  int NumberOfFaces;
+  int FaceSizes[MaximumCellFaces];
+  int Faces[MaximumCellFaces][MaximumCellFaceSize];
+};
+
+// The face table of each cell type, or nullptr if the type is not supported.
+using CellFaceTables = std::array<const CellFaceTable*, VTK_NUMBER_OF_CELL_TYPES>;
+
+// Rotate a face so that it starts at its smallest point id, like the
+// InsertTriInHash(), InsertQuadInHash() and InsertPolygonInHash() methods of
+// vtkDataSetSurfaceFilter. Triangles and quads are only rotated when one point
+// id is strictly smaller than the others, polygons start at the first
+// smallest point id.
+void OrderFacePoints(vtkIdType* face, int numPts)
+{
+  int first = 0;
+  if (numPts == 3 || numPts == 4)
+  {
+    for (int i = 1; i < numPts && first == 0; ++i)
+    {
+      bool smallest = true;
+      for (int j = 0; j < numPts; ++j)
+      {
+        smallest = smallest && (j == i || face[i] < face[j]);
+      }
+      first = smallest ? i : 0;
+    }
+  }
+  else
+  {
+    for (int i = 1; i < numPts; ++i)
+    {
+      first = face[i] < face[first] ? i : first;
+    }
+  }
+  std::rotate(face, face + first, face + numPts);
+}
+
+// Whether a face matches a face of the same size and first point received
+// earlier by the hash of vtkDataSetSurfaceFilter, both ordered by
+// OrderFacePoints(). The matches do not depend on the orientation.
+bool SameFace(const vtkIdType* face, const vtkIdType* earlier, int numPts)
+{
+  if (numPts == 3)
+  {
+    return (face[1] == earlier[1] && face[2] == earlier[2]) ||
+      (face[1] == earlier[2] && face[2] == earlier[1]);
+  }
+  if (numPts == 4)
+  {
+    return face[2] == earlier[2] &&
+      ((face[1] == earlier[1] && face[3] == earlier[3]) ||
+        (face[1] == earlier[3] && face[3] == earlier[1]));
+  }
+  if (face[1] == earlier[1])
+  {
+    return std::equal(face + 2, face + numPts, earlier + 2);
+  }
+  for (int i = 1; i < numPts; ++i)
+  {
+    if (face[numPts - i] != earlier[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether every cell type of the input has a face table.
+bool HasFaceTables(vtkUnstructuredGrid* input, const CellFaceTables& tables)
+{
+  vtkUnsignedCharArray* types = input->GetCellTypesArray();
+  if (!input->GetCells() || !types)
+  {
+    return false;
+  }
+  const unsigned char* cellTypes = types->GetPointer(0);
+  std::atomic<bool> supported(true);
+  vtkSMPTools::For(0, input->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId && supported.load(std::memory_order_relaxed); ++cellId)
+    {
+      if (!tables[cellTypes[cellId]])
+      {
+        supported.store(false, std::memory_order_relaxed);
+      }
+    }
+  });
+  return supported;
+}
+
+// Number the blocks of [0, num) with the count of each block, scanned in
+// place. Returns the total.
+template <typename CountFunctor>
+vtkIdType ScanBlocks(vtkIdType num, std::vector<vtkIdType>& blockOffsets, CountFunctor&& count)
+{
+  const vtkIdType numBlocks = (num + ExternalFacesBlockSize - 1) / ExternalFacesBlockSize;
+  blockOffsets.assign(numBlocks + 1, 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      blockOffsets[blockId + 1] = count(blockId * ExternalFacesBlockSize,
+        std::min(num, (blockId + 1) * ExternalFacesBlockSize));
+    }
+  });
+  for (vtkIdType blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    blockOffsets[blockId + 1] += blockOffsets[blockId];
+  }
+  return blockOffsets[numBlocks];
+}
+
+class ExternalFaces
+{
+public:
+  ExternalFaces(vtkUnstructuredGrid* input, const CellFaceTables& tables)
+    : Input(input)
+    , Tables(tables)
+    , Types(input->GetCellTypesArray()->GetPointer(0))
+  {
+  }
+
+  // Bin the faces of all cells and flag the external ones.
+  void Execute()
+  {
+    const vtkIdType numPts = this->Input->GetNumberOfPoints();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    vtkCellArray* cells = this->Input->GetCells();
+
+    std::unique_ptr<std::atomic<vtkIdType>[]> cursors(new std::atomic<vtkIdType>[numPts] {});
+    cells->Visit(CountFaces{}, this, cursors.get());
+
+    // The bin sizes become the offsets of the bins, and the cursors used to
+    // fill them.
+    this->BinOffsets.resize(numPts + 1);
+    std::vector<vtkIdType> blockOffsets;
+    const vtkIdType numFaces = ScanBlocks(numPts, blockOffsets, [&](vtkIdType ptId, vtkIdType end) {
+      vtkIdType count = 0;
+      for (; ptId < end; ++ptId)
+      {
+        count += cursors[ptId].load(std::memory_order_relaxed);
+      }
+      return count;
+    });
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blockOffsets.size()) - 1,
+      [&](vtkIdType blockId, vtkIdType endBlockId) {
+        for (; blockId < endBlockId; ++blockId)
+        {
+          vtkIdType offset = blockOffsets[blockId];
+          vtkIdType endPtId = std::min(numPts, (blockId + 1) * ExternalFacesBlockSize);
+          for (vtkIdType ptId = blockId * ExternalFacesBlockSize; ptId < endPtId; ++ptId)
+          {
+            vtkIdType size = cursors[ptId].load(std::memory_order_relaxed);
+            this->BinOffsets[ptId] = offset;
+            cursors[ptId].store(offset, std::memory_order_relaxed);
+            offset += size;
+          }
+        }
+      });
+    this->BinOffsets[numPts] = numFaces;
+
+    this->BinFaces.resize(numFaces);
+    cells->Visit(FillBins{}, this, cursors.get());
+    cursors.reset();
+
+    this->External.reset(new std::atomic<unsigned char>[numCells] {});
+    cells->Visit(CullBins{}, this);
+  }
+
+  bool IsExternal(vtkIdType cellId, int faceId) const
+  {
+    return (this->External[cellId].load(std::memory_order_relaxed) >> faceId) & 1;
+  }
+
+  // Gather the external faces in the order of the hash traversal of
+  // vtkDataSetSurfaceFilter: by bin, then by cell and face id. Their points
+  // are ordered by OrderFacePoints().
+  void GatherInBinOrder(
+    std::vector<vtkIdType>& faceCells, vtkIdTypeArray* offsets, vtkIdTypeArray* conn)
+  {
+    this->Gather(this->Input->GetNumberOfPoints(), BinFaceOrder{ this }, true, faceCells,
+      offsets, conn);
+  }
+
+  // Gather the external faces by cell and face id, with their points in the
+  // order of the face tables. The faces of the cells flagged as duplicate
+  // ghost cells, if any, are skipped.
+  void GatherInCellOrder(const unsigned char* cellGhosts, std::vector<vtkIdType>& faceCells,
+    vtkIdTypeArray* offsets, vtkIdTypeArray* conn)
+  {
+    this->Gather(this->Input->GetNumberOfCells(), CellFaceOrder{ this, cellGhosts }, false,
+      faceCells, offsets, conn);
+  }
+
+private:
+  const CellFaceTable& GetTable(vtkIdType cellId) const
+  {
+    return *this->Tables[this->Types[cellId]];
+  }
+
+  // Copy the points of a face of a cell, ordered by OrderFacePoints() if
+  // requested. Returns the number of points of the face.
+  template <typename CellStateT>
+  int GetFace(CellStateT& state, vtkIdType cellId, int faceId, bool ordered, vtkIdType* face) const
+  {
+    const auto cellPts = state.GetCellRange(cellId);
+    const CellFaceTable& table = this->GetTable(cellId);
+    const int numFacePts = table.FaceSizes[faceId];
+    for (int i = 0; i < numFacePts; ++i)
+    {
+      face[i] = static_cast<vtkIdType>(cellPts[table.Faces[faceId][i]]);
+    }
+    if (ordered)
+    {
+      OrderFacePoints(face, numFacePts);
+    }
+    return numFacePts;
+  }
+
+  struct CountFaces
+  {
+    template <typename CellStateT>
+    void operator()(CellStateT& state, ExternalFaces* self, std::atomic<vtkIdType>* binSizes)
+    {
+      vtkSMPTools::For(0, state.GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+        vtkIdType face[MaximumCellFaceSize];
+        for (; cellId < endCellId; ++cellId)
+        {
+          for (int faceId = 0; faceId < self->GetTable(cellId).NumberOfFaces; ++faceId)
+          {
+            self->GetFace(state, cellId, faceId, true, face);
+            binSizes[face[0]].fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+  };
+
+  struct FillBins
+  {
+    template <typename CellStateT>
+    void operator()(CellStateT& state, ExternalFaces* self, std::atomic<vtkIdType>* cursors)
+    {
+      vtkSMPTools::For(0, state.GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+        vtkIdType face[MaximumCellFaceSize];
+        for (; cellId < endCellId; ++cellId)
+        {
+          for (int faceId = 0; faceId < self->GetTable(cellId).NumberOfFaces; ++faceId)
+          {
+            self->GetFace(state, cellId, faceId, true, face);
+            vtkIdType slot = cursors[face[0]].fetch_add(1, std::memory_order_relaxed);
+            self->BinFaces[slot] = cellId * MaximumCellFaces + faceId;
+          }
+        }
+      });
+    }
+  };
+
+  // Sort each bin in the order in which the serial hash receives the faces,
+  // and flag the faces that no other face of the bin matches.
+  struct CullBins
+  {
+    template <typename CellStateT>
+    void operator()(CellStateT& state, ExternalFaces* self)
+    {
+      const vtkIdType numBins = static_cast<vtkIdType>(self->BinOffsets.size()) - 1;
+      vtkSMPTools::For(0, numBins, [&](vtkIdType ptId, vtkIdType endPtId) {
+        std::vector<vtkIdType> points;
+        std::vector<int> sizes;
+        std::vector<char> matched;
+        for (; ptId < endPtId; ++ptId)
+        {
+          vtkIdType* begin = self->BinFaces.data() + self->BinOffsets[ptId];
+          vtkIdType* end = self->BinFaces.data() + self->BinOffsets[ptId + 1];
+          const vtkIdType numFaces = end - begin;
+          std::sort(begin, end);
+
+          points.resize(numFaces * MaximumCellFaceSize);
+          sizes.resize(numFaces);
+          matched.assign(numFaces, 0);
+          for (vtkIdType i = 0; i < numFaces; ++i)
+          {
+            sizes[i] = self->GetFace(state, begin[i] / MaximumCellFaces,
+              static_cast<int>(begin[i] % MaximumCellFaces), true,
+              points.data() + i * MaximumCellFaceSize);
+          }
+          for (vtkIdType i = 0; i < numFaces; ++i)
+          {
+            for (vtkIdType j = i + 1; j < numFaces; ++j)
+            {
+              if (sizes[i] == sizes[j] &&
+                SameFace(points.data() + j * MaximumCellFaceSize,
+                  points.data() + i * MaximumCellFaceSize, sizes[i]))
+              {
+                matched[i] = matched[j] = 1;
+              }
+            }
+            if (!matched[i])
+            {
+              self->External[begin[i] / MaximumCellFaces].fetch_or(
+                static_cast<unsigned char>(1 << (begin[i] % MaximumCellFaces)),
+                std::memory_order_relaxed);
+            }
+          }
+        }
+      });
+    }
+  };
+
+  // Call add(cellId, faceId) for the faces of a bin, by cell and face id.
+  struct BinFaceOrder
+  {
+    const ExternalFaces* Self;
+
+    template <typename FaceFunctor>
+    void operator()(vtkIdType ptId, FaceFunctor&& add) const
+    {
+      for (vtkIdType i = this->Self->BinOffsets[ptId]; i < this->Self->BinOffsets[ptId + 1]; ++i)
+      {
+        add(this->Self->BinFaces[i] / MaximumCellFaces,
+          static_cast<int>(this->Self->BinFaces[i] % MaximumCellFaces));
+      }
+    }
+  };
+
+  // Call add(cellId, faceId) for the faces of a cell, unless it is a
+  // duplicate ghost cell.
+  struct CellFaceOrder
+  {
+    const ExternalFaces* Self;
+    const unsigned char* CellGhosts;
+
+    template <typename FaceFunctor>
+    void operator()(vtkIdType cellId, FaceFunctor&& add) const
+    {
+      if (this->CellGhosts && (this->CellGhosts[cellId] & vtkDataSetAttributes::DUPLICATECELL))
+      {
+        return;
+      }
+      for (int faceId = 0; faceId < this->Self->GetTable(cellId).NumberOfFaces; ++faceId)
+      {
+        add(cellId, faceId);
+      }
+    }
+  };
+
+  template <typename FaceOrder>
+  struct GatherFaces
+  {
+    template <typename CellStateT>
+    void operator()(CellStateT& state, const ExternalFaces* self, const FaceOrder& order,
+      vtkIdType numItems, const std::vector<vtkIdType>& faceOffsets,
+      const std::vector<vtkIdType>& connOffsets, bool ordered, vtkIdType* faceCells,
+      vtkIdType* offsets, vtkIdType* conn)
+    {
+      const vtkIdType numBlocks = static_cast<vtkIdType>(faceOffsets.size()) - 1;
+      vtkSMPTools::For(0, numBlocks, [&](vtkIdType blockId, vtkIdType endBlockId) {
+        for (; blockId < endBlockId; ++blockId)
+        {
+          vtkIdType newFaceId = faceOffsets[blockId];
+          vtkIdType loc = connOffsets[blockId];
+          vtkIdType endItem = std::min(numItems, (blockId + 1) * ExternalFacesBlockSize);
+          for (vtkIdType item = blockId * ExternalFacesBlockSize; item < endItem; ++item)
+          {
+            order(item, [&](vtkIdType cellId, int faceId) {
+              if (self->IsExternal(cellId, faceId))
+              {
+                faceCells[newFaceId] = cellId;
+                offsets[newFaceId++] = loc;
+                loc += self->GetFace(state, cellId, faceId, ordered, conn + loc);
+              }
+            });
+          }
+        }
+      });
+    }
+  };
+
+  // Count the external faces, and their number of points, of each block of
+  // items (bins or cells) visited in the given order, then gather them.
+  template <typename FaceOrder>
+  void Gather(vtkIdType numItems, const FaceOrder& order, bool ordered,
+    std::vector<vtkIdType>& faceCells, vtkIdTypeArray* offsets, vtkIdTypeArray* conn)
+  {
+    std::vector<vtkIdType> faceOffsets;
+    std::vector<vtkIdType> connOffsets;
+    const vtkIdType numFaces =
+      ScanBlocks(numItems, faceOffsets, [&](vtkIdType item, vtkIdType endItem) {
+        vtkIdType count = 0;
+        for (; item < endItem; ++item)
+        {
+          order(item, [&](vtkIdType cellId, int faceId) {
+            count += this->IsExternal(cellId, faceId) ? 1 : 0;
+          });
+        }
+        return count;
+      });
+    const vtkIdType connSize =
+      ScanBlocks(numItems, connOffsets, [&](vtkIdType item, vtkIdType endItem) {
+        vtkIdType size = 0;
+        for (; item < endItem; ++item)
+        {
+          order(item, [&](vtkIdType cellId, int faceId) {
+            size += this->IsExternal(cellId, faceId) ? this->GetTable(cellId).FaceSizes[faceId] : 0;
+          });
+        }
+        return size;
+      });
+
+    faceCells.resize(numFaces);
+    offsets->SetNumberOfValues(numFaces + 1);
+    conn->SetNumberOfValues(connSize);
+    this->Input->GetCells()->Visit(GatherFaces<FaceOrder>{}, this, order, numItems, faceOffsets,
+      connOffsets, ordered, faceCells.data(), offsets->GetPointer(0), conn->GetPointer(0));
+    offsets->SetValue(numFaces, connSize);
+  }
+
+  vtkUnstructuredGrid* Input;
+  const CellFaceTables& Tables;
+  const unsigned char* Types;
+
+  // The faces of bin i, encoded as cellId * MaximumCellFaces + faceId, are
+  // BinFaces[BinOffsets[i]] to BinFaces[BinOffsets[i + 1] - 1].
+  std::vector<vtkIdType> BinOffsets;
+  std::vector<vtkIdType> BinFaces;
+
+  // One bit per face of each cell, set if the face is external.
+  std::unique_ptr<std::atomic<unsigned char>[]> External;
+};
+
+// Whether each output array was allocated by CopyAllocate() from the input
+// array with the same index, and can be accessed through a raw pointer.
+bool ArraysMatchByIndex(vtkDataSetAttributes* in, vtkDataSetAttributes* out)
+{
+  if (in->GetNumberOfArrays() != out->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* inArray = in->GetArray(i);
+    vtkDataArray* outArray = out->GetArray(i);
+    if (!inArray || !outArray || inArray->GetDataType() != outArray->GetDataType() ||
+      inArray->GetNumberOfComponents() != outArray->GetNumberOfComponents() ||
+      !inArray->HasStandardMemoryLayout() || !outArray->HasStandardMemoryLayout())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy the attributes of inIds[i] to output tuple i for all i < numOut. The
+// copy is threaded when the output arrays were allocated one to one from the
+// input arrays, and done through CopyData() otherwise.
+void CopyAttributes(
+  vtkDataSetAttributes* in, vtkDataSetAttributes* out, const vtkIdType* inIds, vtkIdType numOut)
+{
+  if (!ArraysMatchByIndex(in, out))
+  {
+    for (vtkIdType i = 0; i < numOut; ++i)
+    {
+      out->CopyData(in, inIds[i], i);
+    }
+    return;
+  }
+
+  // Pair the arrays by index, since they may not be named.
+  ArrayList arrays;
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* inArray = in->GetArray(i);
+    vtkDataArray* outArray = out->GetArray(i);
+    outArray->SetNumberOfTuples(numOut);
+    void* inData = inArray->GetVoidPointer(0);
+    void* outData = outArray->GetVoidPointer(0);
+    switch (outArray->GetDataType())
+    {
+      vtkTemplateMacro(CreateArrayPair(&arrays, static_cast<VTK_TT*>(inData),
+        static_cast<VTK_TT*>(outData), numOut, outArray->GetNumberOfComponents(), outArray,
+        static_cast<VTK_TT>(0)));
+    }
+  }
+  vtkSMPTools::For(0, numOut, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      arrays.Copy(inIds[i], i);
+    }
+  });
+}
+
+} // anonymous namespace
+
+#endif // vtkExternalFacesInternal_h
+// VTK-HeaderTest-Exclude: vtkExternalFacesInternal.h
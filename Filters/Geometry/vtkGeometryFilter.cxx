@@ -21,6 +21,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkExternalFacesInternal.h"
 #include "vtkGenericCell.h"
 #include "vtkHexagonalPrism.h"
 #include "vtkHexahedron.h"
@@ -69,6 +70,7 @@ vtkGeometryFilter::vtkGeometryFilter()
   this->Merging = 1;
   this->Locator = nullptr;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->SequentialProcessing = false;
 }
 
 //------------------------------------------------------------------------------
@@ -445,6 +447,7 @@ void vtkGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Locator: (none)\n";
   }
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -584,6 +587,135 @@ void vtkGeometryFilter::PolyDataExecute(vtkDataSet* dataSetInput, vtkPolyData* o
                 << output->GetNumberOfCells() << " cells.");
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+
+// Fill the face table of a linear 3D cell from its face array, in the order
+// in which UnstructuredGridExecute() outputs the face points.
+template <typename TCell>
+void FillFaceTable(CellFaceTable& table, const int* order)
+{
+  table.NumberOfFaces = static_cast<int>(TCell::NumberOfFaces);
+  for (int faceId = 0; faceId < table.NumberOfFaces; ++faceId)
+  {
+    const vtkIdType* faceVerts = TCell::GetFaceArray(faceId);
+    int numFacePts = 0;
+    while (numFacePts < TCell::MaximumFaceSize && faceVerts[numFacePts] >= 0)
+    {
+      ++numFacePts;
+    }
+    table.FaceSizes[faceId] = numFacePts;
+    for (int i = 0; i < numFacePts; ++i)
+    {
+      table.Faces[faceId][i] = static_cast<int>(faceVerts[order ? order[i] : i]);
+    }
+  }
+}
+
+struct GeometryFaceTables
+{
+  CellFaceTable Empty;
+  CellFaceTable Tetra;
+  CellFaceTable Voxel;
+  CellFaceTable Hexahedron;
+  CellFaceTable Wedge;
+  CellFaceTable Pyramid;
+  CellFaceTable PentagonalPrism;
+  CellFaceTable HexagonalPrism;
+  CellFaceTables Tables;
+
+  GeometryFaceTables()
+  {
+    const int pixelConvert[4] = { 0, 1, 3, 2 };
+    this->Empty = CellFaceTable();
+    FillFaceTable<vtkTetra>(this->Tetra, nullptr);
+    FillFaceTable<vtkVoxel>(this->Voxel, pixelConvert);
+    FillFaceTable<vtkHexahedron>(this->Hexahedron, nullptr);
+    FillFaceTable<vtkWedge>(this->Wedge, nullptr);
+    FillFaceTable<vtkPyramid>(this->Pyramid, nullptr);
+    FillFaceTable<vtkPentagonalPrism>(this->PentagonalPrism, nullptr);
+    FillFaceTable<vtkHexagonalPrism>(this->HexagonalPrism, nullptr);
+
+    this->Tables.fill(nullptr);
+    this->Tables[VTK_EMPTY_CELL] = &this->Empty;
+    this->Tables[VTK_TETRA] = &this->Tetra;
+    this->Tables[VTK_VOXEL] = &this->Voxel;
+    this->Tables[VTK_HEXAHEDRON] = &this->Hexahedron;
+    this->Tables[VTK_WEDGE] = &this->Wedge;
+    this->Tables[VTK_PYRAMID] = &this->Pyramid;
+    this->Tables[VTK_PENTAGONAL_PRISM] = &this->PentagonalPrism;
+    this->Tables[VTK_HEXAGONAL_PRISM] = &this->HexagonalPrism;
+  }
+};
+
+const CellFaceTables& GetGeometryFaceTables()
+{
+  static const GeometryFaceTables tables;
+  return tables.Tables;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Only grids of linear 3D cells without any clipping are extracted in
+// parallel. Faces are then culled when another face has the same points,
+// which matches the cell neighbors used by the serial path on conforming
+// meshes.
+bool vtkGeometryFilter::CanExtractFacesInParallel(vtkUnstructuredGrid* input)
+{
+  return !this->SequentialProcessing && !this->CellClipping && !this->PointClipping &&
+    !this->ExtentClipping && HasFaceTables(input, GetGeometryFaceTables());
+}
+
+//------------------------------------------------------------------------------
+void vtkGeometryFilter::ExtractFacesInParallel(vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkCellData* cd = input->GetCellData();
+  vtkCellData* outputCD = output->GetCellData();
+  unsigned char* cellGhosts = nullptr;
+
+  vtkDebugMacro(<< "Executing threaded geometry filter for unstructured grid input");
+
+  vtkDataArray* temp = cd->GetArray(vtkDataSetAttributes::GhostArrayName());
+  if (temp && temp->GetDataType() == VTK_UNSIGNED_CHAR && temp->GetNumberOfComponents() == 1)
+  {
+    cellGhosts = static_cast<vtkUnsignedCharArray*>(temp)->GetPointer(0);
+  }
+
+  // Just pass points through, never merge
+  output->SetPoints(input->GetPoints());
+  output->GetPointData()->PassData(input->GetPointData());
+
+  ExternalFaces faces(input, GetGeometryFaceTables());
+  faces.Execute();
+  std::vector<vtkIdType> polyCellIds;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> conn;
+  faces.GatherInCellOrder(cellGhosts, polyCellIds, offsets, conn);
+  vtkIdType numPolys = static_cast<vtkIdType>(polyCellIds.size());
+
+  vtkNew<vtkCellArray> polys;
+  polys->SetData(offsets, conn);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> strips;
+  output->SetVerts(verts);
+  output->SetLines(lines);
+  output->SetPolys(polys);
+  output->SetStrips(strips);
+
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(cd, numCells, numCells / 2);
+  CopyAttributes(cd, outputCD, polyCellIds.data(), numPolys);
+
+  output->Squeeze();
+
+  vtkDebugMacro(<< "Extracted " << input->GetNumberOfPoints() << " points,"
+                << output->GetNumberOfCells() << " cells.");
+}
+
 //------------------------------------------------------------------------------
 void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPolyData* output)
 {
@@ -593,6 +725,11 @@ void vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPol
   {
     return;
   }
+  if (this->CanExtractFacesInParallel(input))
+  {
+    this->ExtractFacesInParallel(input, output);
+    return;
+  }
   auto cellIter = vtk::TakeSmartPointer(connectivity->NewIterator());
   vtkIdType cellId;
   int allVisible;
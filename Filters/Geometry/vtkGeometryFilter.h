@@ -31,6 +31,12 @@
  * vtkExtractUnstructuredGrid, vtkRectilinearGridGeometryFilter, or
  * vtkExtractVOI.)
  *
+ * When no clipping is requested, the boundary faces of unstructured grids
+ * made of linear 3D cells are extracted in parallel with vtkSMPTools, by
+ * matching the faces that have the same points instead of looking up the
+ * neighbors of each face. Both approaches agree on conforming meshes, and
+ * the output is the same as the serial one.
+ *
  * @warning
  * When vtkGeometryFilter extracts cells (or boundaries of cells) it
  * will (by default) merge duplicate vertices. This may cause problems
@@ -57,6 +63,7 @@
 #include "vtkPolyDataAlgorithm.h"
 
 class vtkIncrementalPointLocator;
+class vtkUnstructuredGrid;
 
 class VTKFILTERSGEOMETRY_EXPORT vtkGeometryFilter : public vtkPolyDataAlgorithm
 {
@@ -178,6 +185,20 @@ public:
   int GetOutputPointsPrecision() const;
   //@}
 
+  //@{
+  /**
+   * Force sequential processing (i.e. single thread) when extracting the
+   * boundary faces of unstructured grids. By default, sequential processing
+   * is off. Note this flag only applies if the class has been compiled with
+   * VTK_SMP_IMPLEMENTATION_TYPE set to something other than Sequential. (If
+   * set to Sequential, then the filter always runs in serial mode.) This flag
+   * is typically used for benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, vtkTypeBool);
+  vtkGetMacro(SequentialProcessing, vtkTypeBool);
+  vtkBooleanMacro(SequentialProcessing, vtkTypeBool);
+  //@}
+
 protected:
   vtkGeometryFilter();
   ~vtkGeometryFilter() override;
@@ -204,6 +225,10 @@ protected:
   vtkTypeBool Merging;
   vtkIncrementalPointLocator* Locator;
 
+  vtkTypeBool SequentialProcessing;
+  bool CanExtractFacesInParallel(vtkUnstructuredGrid* input);
+  void ExtractFacesInParallel(vtkUnstructuredGrid* input, vtkPolyData* output);
+
 private:
   vtkGeometryFilter(const vtkGeometryFilter&) = delete;
   void operator=(const vtkGeometryFilter&) = delete;
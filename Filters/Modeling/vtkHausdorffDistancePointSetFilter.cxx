@@ -46,11 +46,70 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
-#include "vtkCellLocator.h"
-#include "vtkGenericCell.h"
-#include "vtkKdTreePointLocator.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
 #include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+namespace
+{
+// Store in distances the distance from each point of input to the closest
+// point of target, and return the largest distance. The closest points of
+// all the points of input are looked up in one batch. Points without a
+// closest point (e.g., when target has no cells) get a NaN distance and are
+// ignored by the largest distance.
+double ComputeDistances(vtkPointSet* input, vtkPointSet* target,
+  vtkAbstractPointLocator* pointLocator, vtkAbstractCellLocator* cellLocator,
+  vtkDoubleArray* distances)
+{
+  vtkDataArray* points = input->GetPoints()->GetData();
+  vtkSmartPointer<vtkDoubleArray> closestPoints = vtkSmartPointer<vtkDoubleArray>::New();
+  vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+  if (pointLocator)
+  {
+    pointLocator->FindClosestPoints(points, ids);
+    closestPoints->SetNumberOfComponents(3);
+    closestPoints->SetNumberOfTuples(ids->GetNumberOfTuples());
+    for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); i++)
+    {
+      if (ids->GetValue(i) != -1)
+      {
+        target->GetPoint(ids->GetValue(i), closestPoints->GetPointer(3 * i));
+      }
+    }
+  }
+  else
+  {
+    cellLocator->FindClosestPoints(points, closestPoints, ids);
+  }
+
+  double maxDist = 0.0;
+  double currentPoint[3];
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); i++)
+  {
+    if (ids->GetValue(i) == -1)
+    {
+      distances->SetValue(i, vtkMath::Nan());
+      continue;
+    }
+    input->GetPoint(i, currentPoint);
+    const double* closestPoint = closestPoints->GetPointer(3 * i);
+    double dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
+      std::pow(currentPoint[1] - closestPoint[1], 2) +
+      std::pow(currentPoint[2] - closestPoint[2], 2));
+    distances->SetValue(i, dist);
+
+    if (dist > maxDist)
+    {
+      maxDist = dist;
+    }
+  }
+  return maxDist;
+}
+}
 
 vtkStandardNewMacro(vtkHausdorffDistancePointSetFilter);
 
@@ -101,36 +160,30 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
   this->RelativeDistance[1] = 0.0;
   this->HausdorffDistance = 0.0;
 
-  vtkSmartPointer<vtkKdTreePointLocator> pointLocatorA =
-    vtkSmartPointer<vtkKdTreePointLocator>::New();
-  vtkSmartPointer<vtkKdTreePointLocator> pointLocatorB =
-    vtkSmartPointer<vtkKdTreePointLocator>::New();
-
-  vtkSmartPointer<vtkCellLocator> cellLocatorA = vtkSmartPointer<vtkCellLocator>::New();
-  vtkSmartPointer<vtkCellLocator> cellLocatorB = vtkSmartPointer<vtkCellLocator>::New();
+  vtkSmartPointer<vtkStaticPointLocator> pointLocatorA = nullptr;
+  vtkSmartPointer<vtkStaticPointLocator> pointLocatorB = nullptr;
+  vtkSmartPointer<vtkStaticCellLocator> cellLocatorA = nullptr;
+  vtkSmartPointer<vtkStaticCellLocator> cellLocatorB = nullptr;
 
   if (this->TargetDistanceMethod == POINT_TO_POINT)
   {
+    pointLocatorA = vtkSmartPointer<vtkStaticPointLocator>::New();
     pointLocatorA->SetDataSet(inputA);
     pointLocatorA->BuildLocator();
+    pointLocatorB = vtkSmartPointer<vtkStaticPointLocator>::New();
     pointLocatorB->SetDataSet(inputB);
     pointLocatorB->BuildLocator();
   }
   else
   {
+    cellLocatorA = vtkSmartPointer<vtkStaticCellLocator>::New();
     cellLocatorA->SetDataSet(inputA);
     cellLocatorA->BuildLocator();
+    cellLocatorB = vtkSmartPointer<vtkStaticCellLocator>::New();
     cellLocatorB->SetDataSet(inputB);
     cellLocatorB->BuildLocator();
   }
 
-  double dist;
-  double currentPoint[3];
-  double closestPoint[3];
-  vtkIdType cellId;
-  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
-  int subId;
-
   vtkSmartPointer<vtkDoubleArray> distanceAToB = vtkSmartPointer<vtkDoubleArray>::New();
   distanceAToB->SetNumberOfComponents(1);
   distanceAToB->SetNumberOfTuples(inputA->GetNumberOfPoints());
@@ -141,55 +194,11 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
   distanceBToA->SetNumberOfTuples(inputB->GetNumberOfPoints());
   distanceBToA->SetName("Distance");
 
-  // Find the nearest neighbors to each point and add edges between them,
-  // if they do not already exist and they are not self loops
-  for (int i = 0; i < inputA->GetNumberOfPoints(); i++)
-  {
-    inputA->GetPoint(i, currentPoint);
-    if (this->TargetDistanceMethod == POINT_TO_POINT)
-    {
-      vtkIdType closestPointId = pointLocatorB->FindClosestPoint(currentPoint);
-      inputB->GetPoint(closestPointId, closestPoint);
-    }
-    else
-    {
-      cellLocatorB->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist);
-    }
-
-    dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
-      std::pow(currentPoint[1] - closestPoint[1], 2) +
-      std::pow(currentPoint[2] - closestPoint[2], 2));
-    distanceAToB->SetValue(i, dist);
-
-    if (dist > this->RelativeDistance[0])
-    {
-      this->RelativeDistance[0] = dist;
-    }
-  }
-
-  for (int i = 0; i < inputB->GetNumberOfPoints(); i++)
-  {
-    inputB->GetPoint(i, currentPoint);
-    if (this->TargetDistanceMethod == POINT_TO_POINT)
-    {
-      vtkIdType closestPointId = pointLocatorA->FindClosestPoint(currentPoint);
-      inputA->GetPoint(closestPointId, closestPoint);
-    }
-    else
-    {
-      cellLocatorA->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist);
-    }
-
-    dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
-      std::pow(currentPoint[1] - closestPoint[1], 2) +
-      std::pow(currentPoint[2] - closestPoint[2], 2));
-    distanceBToA->SetValue(i, dist);
-
-    if (dist > this->RelativeDistance[1])
-    {
-      this->RelativeDistance[1] = dist;
-    }
-  }
+  // Find the distance from each point to the closest point of the other set
+  this->RelativeDistance[0] =
+    ComputeDistances(inputA, inputB, pointLocatorB, cellLocatorB, distanceAToB);
+  this->RelativeDistance[1] =
+    ComputeDistances(inputB, inputA, pointLocatorA, cellLocatorA, distanceBToA);
 
   if (this->RelativeDistance[0] >= RelativeDistance[1])
   {
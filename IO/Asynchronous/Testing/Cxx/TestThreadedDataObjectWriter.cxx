@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedDataObjectWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkThreadedDataObjectWriter writes snapshots of the data,
+// bounds its queue, and reports failed writes.
+
+#include "vtkDoubleArray.h"
+#include "vtkErrorCode.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkThreadedDataObjectWriter.h"
+#include "vtkWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// A writer that waits until it is allowed to write, and may fail.
+class vtkGateWriter : public vtkWriter
+{
+public:
+  static vtkGateWriter* New();
+  vtkTypeMacro(vtkGateWriter, vtkWriter);
+
+  static std::atomic<bool> Open;
+  static std::atomic<int> NumberOfWrites;
+  bool Fail = false;
+
+protected:
+  vtkGateWriter() = default;
+
+  void WriteData() override
+  {
+    while (!Open)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ++NumberOfWrites;
+    if (this->Fail)
+    {
+      this->SetErrorCode(vtkErrorCode::UserError);
+    }
+  }
+
+  int FillInputPortInformation(int, vtkInformation* info) override
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+    return 1;
+  }
+
+private:
+  vtkGateWriter(const vtkGateWriter&) = delete;
+  void operator=(const vtkGateWriter&) = delete;
+};
+
+vtkStandardNewMacro(vtkGateWriter);
+std::atomic<bool> vtkGateWriter::Open(false);
+std::atomic<int> vtkGateWriter::NumberOfWrites(0);
+
+namespace
+{
+const vtkIdType NumberOfPoints = 1000;
+
+// Check that the file holds the points with values offset + index.
+bool CheckFile(const std::string& fileName, double offset)
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkDataArray* values = reader->GetOutput()->GetPointData()->GetArray("values");
+  if (!values || values->GetNumberOfTuples() != NumberOfPoints)
+  {
+    std::cerr << "Missing values in " << fileName << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    if (values->GetTuple1(i) != offset + i)
+    {
+      std::cerr << "Wrong values in " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void SetValues(vtkDoubleArray* values, double offset)
+{
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    values->SetValue(i, offset + i);
+  }
+}
+}
+
+int TestThreadedDataObjectWriter(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestThreadedDataObjectWriter";
+  delete[] tempDir;
+
+  vtkNew<vtkPolyData> data;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i, 0, 0);
+  }
+  SetValues(values, 0);
+  data->SetPoints(points);
+  data->GetPointData()->AddArray(values);
+
+  vtkNew<vtkThreadedDataObjectWriter> asyncWriter;
+
+  // Writes wait while the queue is full.
+  asyncWriter->SetMaxQueueSize(1);
+  vtkNew<vtkGateWriter> first;
+  vtkNew<vtkGateWriter> second;
+  vtkNew<vtkGateWriter> third;
+  second->Fail = true;
+  asyncWriter->Write(data, first);
+  asyncWriter->Write(data, second);
+  if (asyncWriter->TryWrite(data, third) || asyncWriter->GetNumberOfPendingWrites() != 2 ||
+    vtkGateWriter::NumberOfWrites != 0)
+  {
+    std::cerr << "The queue is not bounded" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkGateWriter::Open = true;
+  asyncWriter->Flush();
+  if (asyncWriter->GetNumberOfPendingWrites() != 0 || vtkGateWriter::NumberOfWrites != 2 ||
+    asyncWriter->GetNumberOfFailedWrites() != 1)
+  {
+    std::cerr << "Flushing failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // With deep copies, the values may be changed in place once queued.
+  asyncWriter->SetMaxQueueSize(4);
+  asyncWriter->SetNumberOfThreads(2);
+  asyncWriter->DeepCopyDataOn();
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetFileName((prefix + std::to_string(i) + ".vtp").c_str());
+    asyncWriter->Write(data, writer);
+    SetValues(values, 100 * (i + 1));
+  }
+
+  // With shallow copies, the arrays may be replaced.
+  asyncWriter->DeepCopyDataOff();
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetFileName((prefix + "4.vtp").c_str());
+  asyncWriter->Write(data, writer);
+  vtkNew<vtkDoubleArray> newValues;
+  newValues->SetName("values");
+  newValues->SetNumberOfTuples(NumberOfPoints);
+  SetValues(newValues, -1);
+  data->GetPointData()->AddArray(newValues);
+
+  asyncWriter->Finalize();
+  for (int i = 0; i < 5; ++i)
+  {
+    if (!CheckFile(prefix + std::to_string(i) + ".vtp", 100 * i))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (asyncWriter->GetNumberOfFailedWrites() != 1)
+  {
+    std::cerr << "Unexpected failed writes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTimeStepPrefetcher.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkTimeStepPrefetcher reads the next time step in the time
+// direction, within its cache size and memory limit, and that cancelled
+// prefetches do not corrupt the output.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStepPrefetcher.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// A source of 10 time steps, each one a point at (time, 0, 0), which takes
+// some time to read and can be aborted. Like many readers, it reuses the
+// points of its previous output.
+class vtkSlowTimeStepSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSlowTimeStepSource* New();
+  vtkTypeMacro(vtkSlowTimeStepSource, vtkPolyDataAlgorithm);
+
+  std::vector<double> ReadTimes;
+
+protected:
+  vtkSlowTimeStepSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->Points->InsertNextPoint(0, 0, 0);
+  }
+
+  vtkNew<vtkPoints> Points;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+    {
+      steps[i] = i;
+    }
+    double range[2] = { 0, 9 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    this->ReadTimes.push_back(time);
+    for (int i = 0; i < 20 && !this->GetAbortExecute(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    if (this->GetAbortExecute())
+    {
+      return 1;
+    }
+    this->Points->SetPoint(0, time, 0, 0);
+    this->Points->Modified();
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(this->Points);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+private:
+  vtkSlowTimeStepSource(const vtkSlowTimeStepSource&) = delete;
+  void operator=(const vtkSlowTimeStepSource&) = delete;
+};
+
+vtkStandardNewMacro(vtkSlowTimeStepSource);
+
+namespace
+{
+// Request a time, and check that the output is the time step expected.
+bool CheckOutput(vtkTimeStepPrefetcher* prefetcher, double time, double step)
+{
+  prefetcher->UpdateTimeStep(time);
+  vtkPolyData* output = vtkPolyData::SafeDownCast(prefetcher->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfPoints() != 1 || output->GetPoint(0)[0] != step)
+  {
+    std::cerr << "Wrong output for time " << time << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckOutput(vtkTimeStepPrefetcher* prefetcher, double time)
+{
+  return CheckOutput(prefetcher, time, time);
+}
+
+bool CheckReads(vtkSlowTimeStepSource* source, const std::vector<double>& expected)
+{
+  if (source->ReadTimes != expected)
+  {
+    std::cerr << "Read time steps:";
+    for (double time : source->ReadTimes)
+    {
+      std::cerr << " " << time;
+    }
+    std::cerr << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestTimeStepPrefetcher(int, char*[])
+{
+  vtkNew<vtkSlowTimeStepSource> source;
+  vtkNew<vtkTimeStepPrefetcher> prefetcher;
+  prefetcher->SetReader(source);
+
+  // Going forward, the next time step is read in the background, without
+  // changing the current output.
+  if (!CheckOutput(prefetcher, 0))
+  {
+    return EXIT_FAILURE;
+  }
+  prefetcher->WaitForPrefetch();
+  if (vtkPolyData::SafeDownCast(prefetcher->GetOutputDataObject(0))->GetPoint(0)[0] != 0)
+  {
+    std::cerr << "The prefetch changed the output" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!prefetcher->IsCached(1) || !CheckOutput(prefetcher, 1) || !CheckOutput(prefetcher, 2.5, 2))
+  {
+    std::cerr << "Time steps were not prefetched" << std::endl;
+    return EXIT_FAILURE;
+  }
+  prefetcher->WaitForPrefetch();
+  if (!CheckReads(source, { 0, 1, 2, 3 }) || prefetcher->IsCached(1))
+  {
+    std::cerr << "Wrong time steps cached going forward" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Going backward, the previous one is, and the cache keeps the current
+  // and previous time steps.
+  if (!CheckOutput(prefetcher, 1) || !CheckOutput(prefetcher, 0))
+  {
+    return EXIT_FAILURE;
+  }
+  prefetcher->WaitForPrefetch();
+  if (!CheckReads(source, { 0, 1, 2, 3, 1, 0 }) || !prefetcher->IsCached(0) ||
+    !prefetcher->IsCached(1) || prefetcher->IsCached(2))
+  {
+    std::cerr << "Wrong time steps cached going backward" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A cancelled prefetch leaves no partial time step behind, and does not
+  // modify the pipeline.
+  if (!CheckOutput(prefetcher, 5))
+  {
+    return EXIT_FAILURE;
+  }
+  const vtkMTimeType mTime = prefetcher->GetMTime();
+  prefetcher->CancelPrefetch();
+  if (prefetcher->GetMTime() != mTime || prefetcher->IsCached(6) || !CheckOutput(prefetcher, 6))
+  {
+    std::cerr << "Cancelling the prefetch failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is prefetched when two time steps do not fit the memory limit.
+  prefetcher->WaitForPrefetch();
+  prefetcher->SetMemoryLimit(1);
+  if (!CheckOutput(prefetcher, 7) || !CheckOutput(prefetcher, 8))
+  {
+    return EXIT_FAILURE;
+  }
+  prefetcher->WaitForPrefetch();
+  if (prefetcher->IsCached(9) || prefetcher->IsCached(7))
+  {
+    std::cerr << "The memory limit was ignored" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the reader clears the cache.
+  prefetcher->SetMemoryLimit(0);
+  prefetcher->SetPrefetch(false);
+  source->Modified();
+  source->ReadTimes.clear();
+  if (!CheckOutput(prefetcher, 8) || !CheckReads(source, { 8 }))
+  {
+    std::cerr << "The cache was not cleared" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
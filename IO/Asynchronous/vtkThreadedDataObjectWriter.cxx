@@ -0,0 +1,247 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataObjectWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedDataObjectWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//****************************************************************************
+class vtkThreadedDataObjectWriter::vtkInternals
+{
+public:
+  struct Task
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    vtkSmartPointer<vtkAlgorithm> Writer;
+  };
+
+  std::mutex Mutex;
+  std::condition_variable TaskQueued;   // for workers
+  std::condition_variable TaskStarted;  // for callers waiting for room
+  std::condition_variable TaskFinished; // for Flush()
+  std::deque<Task> Tasks;
+  int NumberOfRunningTasks = 0;
+  vtkTypeUInt64 NumberOfFailedTasks = 0;
+  bool Done = false;
+  std::vector<std::thread> Threads;
+
+  ~vtkInternals() { this->TerminateAllWorkers(); }
+
+  void SpawnWorkers(int numberOfThreads)
+  {
+    for (int cc = 0; cc < numberOfThreads; ++cc)
+    {
+      this->Threads.emplace_back(&vtkInternals::Work, this, cc);
+    }
+  }
+
+  void TerminateAllWorkers()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Done = true;
+    lock.unlock();
+    this->TaskQueued.notify_all();
+    for (std::thread& thread : this->Threads)
+    {
+      thread.join();
+    }
+    this->Threads.clear();
+    lock.lock();
+    this->Done = false;
+  }
+
+  void Work(int threadId)
+  {
+    vtkLogger::SetThreadName("tdow::worker" + std::to_string(threadId));
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->TaskQueued.wait(lock, [this] { return this->Done || !this->Tasks.empty(); });
+      // Queued tasks are written before the workers stop.
+      if (this->Tasks.empty())
+      {
+        return;
+      }
+      Task task = std::move(this->Tasks.front());
+      this->Tasks.pop_front();
+      ++this->NumberOfRunningTasks;
+      lock.unlock();
+      this->TaskStarted.notify_one();
+
+      vtkLogF(TRACE, "writing with %s", task.Writer->GetClassName());
+      task.Writer->SetInputDataObject(0, task.Data);
+      task.Writer->Modified();
+      task.Writer->Update();
+      const bool failed = task.Writer->GetErrorCode() != vtkErrorCode::NoError;
+      task.Writer->SetInputDataObject(0, nullptr);
+      task = Task();
+
+      lock.lock();
+      --this->NumberOfRunningTasks;
+      if (failed)
+      {
+        ++this->NumberOfFailedTasks;
+      }
+      this->TaskFinished.notify_all();
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkThreadedDataObjectWriter);
+
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::vtkThreadedDataObjectWriter()
+  : Internals(new vtkInternals())
+{
+  this->NumberOfThreads = 1;
+  this->MaxQueueSize = 2;
+  this->DeepCopyData = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::~vtkThreadedDataObjectWriter()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::SetNumberOfThreads(int numberOfThreads)
+{
+  numberOfThreads = std::max(numberOfThreads, 1);
+  if (this->NumberOfThreads != numberOfThreads)
+  {
+    this->Finalize();
+    this->NumberOfThreads = numberOfThreads;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataObjectWriter::Write(vtkDataObject* data, vtkAlgorithm* writer)
+{
+  return this->Queue(data, writer, true);
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataObjectWriter::TryWrite(vtkDataObject* data, vtkAlgorithm* writer)
+{
+  return this->Queue(data, writer, false);
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataObjectWriter::Queue(vtkDataObject* data, vtkAlgorithm* writer, bool wait)
+{
+  if (!data || !writer)
+  {
+    vtkErrorMacro("Write: please specify data and a writer.");
+    return false;
+  }
+
+  vtkInternals& internals = *this->Internals;
+  std::unique_lock<std::mutex> lock(internals.Mutex);
+  auto hasRoom = [&] { return static_cast<int>(internals.Tasks.size()) < this->MaxQueueSize; };
+  if (!wait && !hasRoom())
+  {
+    return false;
+  }
+  internals.TaskStarted.wait(lock, hasRoom);
+  lock.unlock();
+
+  // Take the snapshot without blocking the workers.
+  vtkInternals::Task task;
+  task.Data.TakeReference(data->NewInstance());
+  if (this->DeepCopyData)
+  {
+    task.Data->DeepCopy(data);
+  }
+  else
+  {
+    task.Data->ShallowCopy(data);
+  }
+  task.Writer = writer;
+
+  // Other threads may have filled the queue meanwhile.
+  lock.lock();
+  if (!hasRoom())
+  {
+    if (!wait)
+    {
+      return false;
+    }
+    internals.TaskStarted.wait(lock, hasRoom);
+  }
+  if (internals.Threads.empty())
+  {
+    internals.SpawnWorkers(this->NumberOfThreads);
+  }
+  internals.Tasks.push_back(std::move(task));
+  lock.unlock();
+  internals.TaskQueued.notify_one();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::Flush()
+{
+  vtkInternals& internals = *this->Internals;
+  std::unique_lock<std::mutex> lock(internals.Mutex);
+  internals.TaskFinished.wait(
+    lock, [&] { return internals.Tasks.empty() && internals.NumberOfRunningTasks == 0; });
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::Finalize()
+{
+  this->Internals->TerminateAllWorkers();
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedDataObjectWriter::GetNumberOfPendingWrites()
+{
+  vtkInternals& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return static_cast<int>(internals.Tasks.size()) + internals.NumberOfRunningTasks;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkThreadedDataObjectWriter::GetNumberOfFailedWrites()
+{
+  vtkInternals& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.NumberOfFailedTasks;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "MaxQueueSize: " << this->MaxQueueSize << endl;
+  os << indent << "DeepCopyData: " << (this->DeepCopyData ? "On" : "Off") << endl;
+}
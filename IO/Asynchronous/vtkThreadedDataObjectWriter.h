@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataObjectWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkThreadedDataObjectWriter
+ * @brief   write data objects with any writer on worker threads
+ *
+ * vtkThreadedDataObjectWriter runs writers on a pool of worker threads, so
+ * that the caller, typically a simulation, does not wait while its data is
+ * serialized to disk. Write() takes a snapshot of any vtkDataObject and a
+ * configured writer, such as an XML or legacy writer, and queues them. The
+ * writer is updated with the snapshot as input on a worker thread.
+ *
+ * At most MaxQueueSize writes wait for a worker. When the queue is full,
+ * Write() blocks until a worker takes a write, which bounds the memory held
+ * by the snapshots, and TryWrite() returns false instead. Flush() waits for
+ * all the queued writes.
+ *
+ * The snapshot is a shallow copy by default: the arrays are shared with the
+ * data and must not be modified in place until they are written, while
+ * the data may be freely modified otherwise. Turn DeepCopyData on when the
+ * arrays are reused.
+ *
+ * The writer must not be used by the caller once queued. Writers that
+ * communicate between processes, like the parallel XML writers, must be
+ * queued in the same order on all processes, with one worker thread.
+ *
+ * @sa
+ * vtkThreadedImageWriter
+ */
+
+#ifndef vtkThreadedDataObjectWriter_h
+#define vtkThreadedDataObjectWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedDataObjectWriter : public vtkObject
+{
+public:
+  static vtkThreadedDataObjectWriter* New();
+  vtkTypeMacro(vtkThreadedDataObjectWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Queue the writing of a snapshot of data with writer, which writes its
+   * input when updated. Wait while MaxQueueSize writes are queued. Return
+   * false if data or writer is null.
+   */
+  bool Write(vtkDataObject* data, vtkAlgorithm* writer);
+
+  /**
+   * Like Write(), but return false instead of waiting when the queue is
+   * full.
+   */
+  bool TryWrite(vtkDataObject* data, vtkAlgorithm* writer);
+
+  /**
+   * Wait for all the queued writes to be written.
+   */
+  void Flush();
+
+  /**
+   * Wait for all the queued writes, and stop the worker threads. They are
+   * started again by the next write.
+   */
+  void Finalize();
+
+  //@{
+  /**
+   * The number of worker threads. Setting it finalizes the writer. Default
+   * is 1, which writes the data in the order it was queued.
+   */
+  void SetNumberOfThreads(int numberOfThreads);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
+  //@{
+  /**
+   * The maximum number of writes waiting for a worker thread. Default is 2.
+   */
+  vtkSetClampMacro(MaxQueueSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxQueueSize, int);
+  //@}
+
+  //@{
+  /**
+   * Whether the snapshot is a deep copy of the data. Default is off.
+   */
+  vtkSetMacro(DeepCopyData, vtkTypeBool);
+  vtkGetMacro(DeepCopyData, vtkTypeBool);
+  vtkBooleanMacro(DeepCopyData, vtkTypeBool);
+  //@}
+
+  /**
+   * Return the number of writes queued or being written.
+   */
+  int GetNumberOfPendingWrites();
+
+  /**
+   * Return the number of writes whose writer reported an error.
+   */
+  vtkTypeUInt64 GetNumberOfFailedWrites();
+
+protected:
+  vtkThreadedDataObjectWriter();
+  ~vtkThreadedDataObjectWriter() override;
+
+  bool Queue(vtkDataObject* data, vtkAlgorithm* writer, bool wait);
+
+  int NumberOfThreads;
+  int MaxQueueSize;
+  vtkTypeBool DeepCopyData;
+
+private:
+  vtkThreadedDataObjectWriter(const vtkThreadedDataObjectWriter&) = delete;
+  void operator=(const vtkThreadedDataObjectWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
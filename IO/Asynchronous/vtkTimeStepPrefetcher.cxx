@@ -0,0 +1,531 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTimeStepPrefetcher.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTimeStepPrefetcher.h"
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+
+//****************************************************************************
+namespace
+{
+// The piece and extent requested downstream, which the cached time steps
+// depend on.
+struct PieceRequest
+{
+  int Piece = -1;
+  int NumberOfPieces = 1;
+  int GhostLevels = 0;
+  bool HasExtent = false;
+  int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+
+  PieceRequest() = default;
+
+  PieceRequest(vtkInformation* outInfo)
+  {
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()))
+    {
+      this->Piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+      this->NumberOfPieces =
+        outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+      this->GhostLevels =
+        outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    }
+    this->HasExtent = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) != 0;
+    if (this->HasExtent)
+    {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), this->Extent);
+    }
+  }
+
+  bool operator==(const PieceRequest& other) const
+  {
+    return this->Piece == other.Piece && this->NumberOfPieces == other.NumberOfPieces &&
+      this->GhostLevels == other.GhostLevels && this->HasExtent == other.HasExtent &&
+      std::equal(this->Extent, this->Extent + 6, other.Extent);
+  }
+};
+
+// Update the reader for a time step and return a copy of its output, or
+// nullptr if the reader failed or was aborted.
+vtkSmartPointer<vtkDataObject> ReadTimeStep(
+  vtkAlgorithm* reader, double time, const PieceRequest& request, bool deepCopy)
+{
+  const int status = reader->UpdateTimeStep(time, request.Piece, request.NumberOfPieces,
+    request.GhostLevels, request.HasExtent ? request.Extent : nullptr);
+  vtkDataObject* output = reader->GetOutputDataObject(0);
+  if (!output)
+  {
+    return nullptr;
+  }
+  if (!status || reader->GetAbortExecute())
+  {
+    // Drop the partial output, so that the time step is read again when it
+    // is requested.
+    output->Initialize();
+    return nullptr;
+  }
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(output->NewInstance());
+  if (deepCopy)
+  {
+    copy->DeepCopy(output);
+  }
+  else
+  {
+    copy->ShallowCopy(output);
+  }
+  return copy;
+}
+
+void CopyKey(vtkInformation* from, vtkInformation* to, vtkInformationKey* key)
+{
+  if (from->Has(key))
+  {
+    to->CopyEntry(from, key);
+  }
+  else
+  {
+    to->Remove(key);
+  }
+}
+}
+
+//****************************************************************************
+class vtkTimeStepPrefetcher::vtkInternals
+{
+public:
+  struct CacheItem
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    unsigned long Size; // in kibibytes
+  };
+  std::map<double, CacheItem> Cache;
+
+  std::vector<double> TimeSteps;
+  PieceRequest Request;
+  int Index = -1;
+  int Direction = 1;
+
+  std::future<vtkSmartPointer<vtkDataObject>> Pending;
+  double PendingTime = 0.0;
+
+  // Aborting the reader modifies it. These changes are hidden from the
+  // modification time: ReaderMTime is the last change of the reader before
+  // an abort, and AbortMTime the modification time after it.
+  vtkMTimeType ReaderMTime = 0;
+  vtkMTimeType AbortMTime = 0;
+  vtkMTimeType CacheMTime = 0;
+
+  // The background thread updates the reader while Prefetching is true, and
+  // the modification time of the reader is then PrefetchReaderMTime, taken
+  // before the prefetch started.
+  std::mutex Mutex;
+  bool Prefetching = false;
+  vtkMTimeType PrefetchReaderMTime = 0;
+
+  vtkMTimeType GetReaderMTime(vtkAlgorithm* reader) const
+  {
+    const vtkMTimeType mTime = reader->GetMTime();
+    return mTime > this->AbortMTime ? mTime : this->ReaderMTime;
+  }
+
+  void Add(double time, vtkDataObject* data)
+  {
+    CacheItem& item = this->Cache[time];
+    item.Data = data;
+    item.Size = data->GetActualMemorySize();
+  }
+
+  unsigned long GetMemorySize() const
+  {
+    unsigned long size = 0;
+    for (const auto& item : this->Cache)
+    {
+      size += item.second.Size;
+    }
+    return size;
+  }
+
+  // Remove time steps other than current until there are at most maxCount
+  // of them using at most maxSize kibibytes. The time steps behind the
+  // current one in the time direction go first, the farthest first.
+  void Trim(double current, size_t maxCount, unsigned long maxSize)
+  {
+    while (this->Cache.size() > 1 &&
+      (this->Cache.size() > maxCount || this->GetMemorySize() > maxSize))
+    {
+      auto worst = this->Cache.end();
+      double worstDistance = 0.0;
+      for (auto it = this->Cache.begin(); it != this->Cache.end(); ++it)
+      {
+        if (it->first == current)
+        {
+          continue;
+        }
+        const double ahead = (it->first - current) * this->Direction;
+        // Behind comes before ahead, whatever the distances.
+        const double distance = ahead < 0 ? VTK_DOUBLE_MAX / 2 - ahead : ahead;
+        if (worst == this->Cache.end() || distance > worstDistance)
+        {
+          worst = it;
+          worstDistance = distance;
+        }
+      }
+      if (worst == this->Cache.end())
+      {
+        break;
+      }
+      this->Cache.erase(worst);
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkTimeStepPrefetcher);
+
+//------------------------------------------------------------------------------
+vtkTimeStepPrefetcher::vtkTimeStepPrefetcher()
+  : Internals(new vtkInternals())
+{
+  this->Reader = nullptr;
+  this->Prefetch = 1;
+  this->CacheSize = 2;
+  this->MemoryLimit = 0;
+  this->DeepCopyData = 1;
+  this->SetNumberOfInputPorts(0);
+  this->SetNumberOfOutputPorts(1);
+}
+
+//------------------------------------------------------------------------------
+vtkTimeStepPrefetcher::~vtkTimeStepPrefetcher()
+{
+  this->SetReader(nullptr);
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::SetReader(vtkAlgorithm* reader)
+{
+  if (this->Reader == reader)
+  {
+    return;
+  }
+  this->ClearCache();
+  this->Internals->ReaderMTime = 0;
+  this->Internals->AbortMTime = 0;
+  vtkSetObjectBodyMacro(Reader, vtkAlgorithm, reader);
+}
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkTimeStepPrefetcher::GetMTime()
+{
+  vtkMTimeType mTime = this->Superclass::GetMTime();
+  if (this->Reader)
+  {
+    // Do not read the modification time of the reader while it is updated.
+    vtkInternals& internals = *this->Internals;
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    mTime = std::max(mTime,
+      internals.Prefetching ? internals.PrefetchReaderMTime
+                            : internals.GetReaderMTime(this->Reader));
+  }
+  return mTime;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::CancelPrefetch()
+{
+  vtkInternals& internals = *this->Internals;
+  if (!internals.Pending.valid())
+  {
+    return;
+  }
+  internals.ReaderMTime = internals.PrefetchReaderMTime;
+  this->Reader->SetAbortExecute(1);
+  internals.Pending.get();
+  this->Reader->SetAbortExecute(0);
+  internals.AbortMTime = this->Reader->GetMTime();
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::WaitForPrefetch()
+{
+  vtkInternals& internals = *this->Internals;
+  if (!internals.Pending.valid())
+  {
+    return;
+  }
+  vtkSmartPointer<vtkDataObject> data = internals.Pending.get();
+  if (data)
+  {
+    internals.Add(internals.PendingTime, data);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::ClearCache()
+{
+  this->CancelPrefetch();
+  this->Internals->Cache.clear();
+  this->Internals->Index = -1;
+}
+
+//------------------------------------------------------------------------------
+bool vtkTimeStepPrefetcher::IsCached(double time)
+{
+  vtkInternals& internals = *this->Internals;
+  if (internals.Pending.valid() &&
+    internals.Pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+  {
+    this->WaitForPrefetch();
+  }
+  return internals.Cache.find(time) != internals.Cache.end();
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkTimeStepPrefetcher::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+  {
+    return this->RequestDataObject(request, inputVector, outputVector);
+  }
+
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    return this->RequestInformation(request, inputVector, outputVector);
+  }
+
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    return this->RequestData(request, inputVector, outputVector);
+  }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//------------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::FillOutputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::RequestDataObject(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  if (!this->Reader)
+  {
+    vtkErrorMacro("No reader is set.");
+    return 0;
+  }
+
+  this->CancelPrefetch();
+  this->Reader->UpdateDataObject();
+  vtkDataObject* input = this->Reader->GetOutputDataObject(0);
+  if (!input)
+  {
+    return 0;
+  }
+
+  vtkInformation* info = outputVector->GetInformationObject(0);
+  vtkDataObject* output = info->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || !output->IsA(input->GetClassName()))
+  {
+    vtkDataObject* newOutput = input->NewInstance();
+    info->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+    newOutput->Delete();
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkInternals& internals = *this->Internals;
+  if (!this->Reader)
+  {
+    return 0;
+  }
+
+  this->CancelPrefetch();
+  this->Reader->UpdateInformation();
+
+  // The cached time steps are obsolete once the reader is modified.
+  const vtkMTimeType readerMTime = internals.GetReaderMTime(this->Reader);
+  if (readerMTime != internals.CacheMTime)
+  {
+    this->ClearCache();
+    internals.CacheMTime = readerMTime;
+  }
+
+  vtkInformation* readerInfo = this->Reader->GetOutputInformation(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkInformationKey* keys[] = { vtkStreamingDemandDrivenPipeline::TIME_STEPS(),
+    vtkStreamingDemandDrivenPipeline::TIME_RANGE(),
+    vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT(),
+    vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), vtkDataObject::ORIGIN(), vtkDataObject::SPACING(),
+    vtkDataObject::DIRECTION() };
+  for (vtkInformationKey* key : keys)
+  {
+    CopyKey(readerInfo, outInfo, key);
+  }
+
+  internals.TimeSteps.clear();
+  if (readerInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    const double* steps = readerInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    internals.TimeSteps.assign(
+      steps, steps + readerInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()));
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkInternals& internals = *this->Internals;
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!this->Reader || !output)
+  {
+    return 0;
+  }
+
+  const PieceRequest request(outInfo);
+  if (!(request == internals.Request))
+  {
+    this->ClearCache();
+    internals.Request = request;
+  }
+
+  // Snap the requested time to a time step, like readers do, to find the
+  // current time step and the time direction.
+  double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+    ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+    : 0.0;
+  const std::vector<double>& steps = internals.TimeSteps;
+  int index = -1;
+  if (!steps.empty())
+  {
+    index = static_cast<int>(std::upper_bound(steps.begin(), steps.end(), time) - steps.begin());
+    index = std::max(index - 1, 0);
+    time = steps[index];
+    if (internals.Index >= 0 && index != internals.Index)
+    {
+      internals.Direction = index > internals.Index ? 1 : -1;
+    }
+  }
+  internals.Index = index;
+
+  // A prefetch ahead of the current time step keeps running. Others are
+  // cancelled, unless the current time step is being prefetched, and the
+  // reader is then needed.
+  const bool cached = this->IsCached(time);
+  if (internals.Pending.valid())
+  {
+    if (internals.PendingTime == time)
+    {
+      this->WaitForPrefetch();
+    }
+    else if (!cached || (internals.PendingTime - time) * internals.Direction < 0)
+    {
+      this->CancelPrefetch();
+    }
+  }
+
+  auto current = internals.Cache.find(time);
+  if (current == internals.Cache.end())
+  {
+    vtkSmartPointer<vtkDataObject> data =
+      ReadTimeStep(this->Reader, time, request, this->DeepCopyData != 0);
+    if (!data)
+    {
+      vtkErrorMacro("Could not read time step " << time << ".");
+      return 0;
+    }
+    internals.Add(time, data);
+    current = internals.Cache.find(time);
+  }
+  output->ShallowCopy(current->second.Data);
+  const unsigned long currentSize = current->second.Size;
+
+  const unsigned long maxSize = this->MemoryLimit ? this->MemoryLimit : VTK_UNSIGNED_LONG_MAX;
+  internals.Trim(time, static_cast<size_t>(this->CacheSize), maxSize);
+
+  // Read the next time step in the time direction, if the cache can hold it
+  // as well, assuming it is as large as the current one.
+  const int next = index + internals.Direction;
+  if (!this->Prefetch || index < 0 || next < 0 || next >= static_cast<int>(steps.size()) ||
+    internals.Pending.valid() || internals.Cache.find(steps[next]) != internals.Cache.end())
+  {
+    return 1;
+  }
+  internals.Trim(time, static_cast<size_t>(this->CacheSize - 1),
+    maxSize - std::min(maxSize, currentSize));
+  if (internals.Cache.size() >= static_cast<size_t>(this->CacheSize) ||
+    (this->MemoryLimit && internals.GetMemorySize() + currentSize > this->MemoryLimit))
+  {
+    return 1;
+  }
+
+  vtkAlgorithm* reader = this->Reader;
+  const double nextTime = steps[next];
+  const bool deepCopy = this->DeepCopyData != 0;
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    internals.PrefetchReaderMTime = internals.GetReaderMTime(reader);
+    internals.Prefetching = true;
+  }
+  internals.PendingTime = nextTime;
+  vtkInternals* prefetcher = &internals;
+  internals.Pending =
+    std::async(std::launch::async, [prefetcher, reader, nextTime, request, deepCopy]() {
+      vtkSmartPointer<vtkDataObject> data = ReadTimeStep(reader, nextTime, request, deepCopy);
+      std::lock_guard<std::mutex> lock(prefetcher->Mutex);
+      prefetcher->Prefetching = false;
+      return data;
+    });
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Reader: " << this->Reader << endl;
+  os << indent << "Prefetch: " << (this->Prefetch ? "On" : "Off") << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "DeepCopyData: " << (this->DeepCopyData ? "On" : "Off") << endl;
+}
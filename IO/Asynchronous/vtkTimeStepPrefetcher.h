@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTimeStepPrefetcher.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkTimeStepPrefetcher
+ * @brief   read the next time step of a reader on a background thread
+ *
+ * vtkTimeStepPrefetcher wraps a time aware reader and produces its output.
+ * When a time step has been produced, the next one in the direction of the
+ * last time change is read on a background thread, with the reader's
+ * UPDATE_TIME_STEP request, while the current one is processed and
+ * rendered downstream. The time steps read are kept in a cache, so going
+ * forward or backward through time does not wait for the reader as long as
+ * reading a time step is faster than processing one.
+ *
+ * The cache holds at most CacheSize time steps, and no more than
+ * MemoryLimit kibibytes when it is set. The time steps farthest behind the
+ * current one are dropped first, and no time step is prefetched when it
+ * would not fit. When the time direction changes, or when another time step
+ * is requested, the running prefetch is cancelled with the reader's
+ * AbortExecute flag.
+ *
+ * The cache holds deep copies of the reader output by default, since
+ * readers may reuse their arrays from one time step to the next. Turn
+ * DeepCopyData off to save the copies with readers that create new arrays
+ * for each time step.
+ *
+ * The reader is only updated by the prefetcher, either on the main thread
+ * or on the background thread. The reader must not be modified, or updated
+ * directly, while a prefetch may be running: call CancelPrefetch() or
+ * WaitForPrefetch() before changing its properties. Its progress events may
+ * be invoked on the background thread.
+ *
+ * @sa
+ * vtkTemporalDataSetCache vtkThreadedImageWriter
+ */
+
+#ifndef vtkTimeStepPrefetcher_h
+#define vtkTimeStepPrefetcher_h
+
+#include "vtkAlgorithm.h"
+#include "vtkIOAsynchronousModule.h" // For export macro
+
+class VTKIOASYNCHRONOUS_EXPORT vtkTimeStepPrefetcher : public vtkAlgorithm
+{
+public:
+  static vtkTimeStepPrefetcher* New();
+  vtkTypeMacro(vtkTimeStepPrefetcher, vtkAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * The reader whose time steps are produced. It must provide TIME_STEPS
+   * for time steps to be prefetched, and should have no input.
+   */
+  void SetReader(vtkAlgorithm* reader);
+  vtkGetObjectMacro(Reader, vtkAlgorithm);
+  //@}
+
+  //@{
+  /**
+   * Whether the next time step is read on a background thread. When off,
+   * the time steps are read on demand, and the cache is still used. Default
+   * is on.
+   */
+  vtkSetMacro(Prefetch, vtkTypeBool);
+  vtkGetMacro(Prefetch, vtkTypeBool);
+  vtkBooleanMacro(Prefetch, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * The maximum number of time steps kept, including the current one and
+   * the one being prefetched. Default is 2, which double buffers the reader
+   * output.
+   */
+  vtkSetClampMacro(CacheSize, int, 2, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  //@}
+
+  //@{
+  /**
+   * The maximum memory used by the cached time steps, in kibibytes, as
+   * reported by vtkDataObject::GetActualMemorySize(). The current time step
+   * is always kept. The time step to prefetch is assumed to be as large as
+   * the current one. 0, the default, means no limit.
+   */
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Whether the cached time steps are deep copies of the reader output.
+   * Shallow copies are only valid when the reader creates new arrays for
+   * each time step, instead of changing the values of its previous output.
+   * Default is on.
+   */
+  vtkSetMacro(DeepCopyData, vtkTypeBool);
+  vtkGetMacro(DeepCopyData, vtkTypeBool);
+  vtkBooleanMacro(DeepCopyData, vtkTypeBool);
+  //@}
+
+  /**
+   * Stop the running prefetch, if any, and wait for the reader to return.
+   * Its output is dropped.
+   */
+  void CancelPrefetch();
+
+  /**
+   * Wait for the running prefetch, if any, and keep its output in the cache.
+   */
+  void WaitForPrefetch();
+
+  /**
+   * Remove all the time steps from the cache, after cancelling the running
+   * prefetch.
+   */
+  void ClearCache();
+
+  /**
+   * Return true if the given time step is in the cache. A prefetched time
+   * step is only added to the cache when the next time step is requested,
+   * or by WaitForPrefetch().
+   */
+  bool IsCached(double time);
+
+  /**
+   * Include the reader in the modification time.
+   */
+  vtkMTimeType GetMTime() override;
+
+  /**
+   * see vtkAlgorithm for details
+   */
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+protected:
+  vtkTimeStepPrefetcher();
+  ~vtkTimeStepPrefetcher() override;
+
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+
+  virtual int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  virtual int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+
+  vtkAlgorithm* Reader;
+  vtkTypeBool Prefetch;
+  int CacheSize;
+  unsigned long MemoryLimit;
+  vtkTypeBool DeepCopyData;
+
+private:
+  vtkTimeStepPrefetcher(const vtkTimeStepPrefetcher&) = delete;
+  void operator=(const vtkTimeStepPrefetcher&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressedDataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkCompressedDataArray keeps its values through the cache,
+// copies and changes of settings, and that vtkArrayCompressor replaces the
+// arrays of a dataset.
+
+#include "vtkArrayCompressor.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCompressedDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+// A smooth, well compressible function of the value index.
+double Expected(vtkIdType valueIdx)
+{
+  return static_cast<double>((valueIdx / 7) % 1000);
+}
+
+int CheckValues(vtkDataArray* array, const char* what)
+{
+  vtkIdType valueIdx = 0;
+  for (auto value : vtk::DataArrayValueRange(array))
+  {
+    if (value != Expected(valueIdx))
+    {
+      std::cerr << what << ": wrong value " << value << " at " << valueIdx << std::endl;
+      return EXIT_FAILURE;
+    }
+    ++valueIdx;
+  }
+  if (valueIdx != array->GetNumberOfValues())
+  {
+    std::cerr << what << ": wrong number of values " << valueIdx << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestValues()
+{
+  const vtkIdType numTuples = 100003;
+  vtkNew<vtkCompressedDataArray<float>> array;
+  array->SetBlockSize(1000);
+  array->SetCacheSize(2);
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(numTuples);
+
+  // Values set one by one go through the cache, and many blocks are evicted.
+  for (vtkIdType i = 0; i < 3 * numTuples; ++i)
+  {
+    array->SetValue(i, static_cast<float>(Expected(i)));
+  }
+  if (CheckValues(array, "SetValue") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Random accesses across blocks.
+  array->SetTypedComponent(5, 1, -1.0f);
+  array->SetTypedComponent(99999, 2, -2.0f);
+  array->SetTypedComponent(6, 1, -3.0f);
+  if (array->GetTypedComponent(5, 1) != -1.0f || array->GetTypedComponent(99999, 2) != -2.0f ||
+    array->GetTypedComponent(6, 1) != -3.0f ||
+    array->GetTypedComponent(50000, 0) != Expected(150000))
+  {
+    std::cerr << "Wrong values after random accesses" << std::endl;
+    return EXIT_FAILURE;
+  }
+  array->SetTypedComponent(5, 1, static_cast<float>(Expected(16)));
+  array->SetTypedComponent(99999, 2, static_cast<float>(Expected(299999)));
+  array->SetTypedComponent(6, 1, static_cast<float>(Expected(19)));
+
+  // Changing the settings compresses the values again.
+  array->SetBlockSize(777);
+  vtkNew<vtkZLibDataCompressor> zlib;
+  array->SetCompressor(zlib);
+  array->Squeeze();
+  if (CheckValues(array, "Recompress") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Threads share the cache, and load the blocks they read concurrently.
+  std::atomic<int> errors(0);
+  vtkSMPTools::For(0, 3 * numTuples, 1000, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (array->GetValue(i) != static_cast<float>(Expected(i)))
+      {
+        ++errors;
+      }
+    }
+  });
+  if (errors != 0)
+  {
+    std::cerr << "Wrong values read by concurrent threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkFloatArray> plain;
+  plain->DeepCopy(array);
+  if (CheckValues(plain, "Export") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  if (array->GetActualMemorySize() * 4 > plain->GetActualMemorySize())
+  {
+    std::cerr << "Compressed array uses " << array->GetActualMemorySize() << " KiB, "
+              << plain->GetActualMemorySize() << " KiB uncompressed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  double range[2];
+  plain->GetRange(range, 0);
+  double compressedRange[2];
+  array->GetRange(compressedRange, 0);
+  if (compressedRange[0] != range[0] || compressedRange[1] != range[1])
+  {
+    std::cerr << "Wrong range" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Growing the array keeps the values and the new tuples are writable.
+  array->InsertNextTypedTuple(plain->GetPointer(0));
+  if (array->GetNumberOfTuples() != numTuples + 1 || array->GetTypedComponent(numTuples, 2) != 0.0f)
+  {
+    std::cerr << "Wrong inserted tuple" << std::endl;
+    return EXIT_FAILURE;
+  }
+  array->SetNumberOfTuples(numTuples);
+  return CheckValues(array, "Resize");
+}
+
+int TestCopies()
+{
+  vtkNew<vtkIntArray> ints;
+  ints->SetNumberOfComponents(2);
+  ints->SetNumberOfTuples(50000);
+  for (vtkIdType i = 0; i < ints->GetNumberOfValues(); ++i)
+  {
+    ints->SetValue(i, static_cast<int>(Expected(i)));
+  }
+
+  vtkNew<vtkCompressedDataArray<int>> compressed;
+  compressed->SetBlockSize(4096);
+  compressed->DeepCopy(ints);
+  vtkNew<vtkCompressedDataArray<int>> copy;
+  copy->DeepCopy(compressed);
+  vtkNew<vtkCompressedDataArray<double>> converted;
+  converted->DeepCopy(compressed);
+  if (CheckValues(compressed, "AOS copy") != EXIT_SUCCESS ||
+    CheckValues(copy, "Compressed copy") != EXIT_SUCCESS ||
+    CheckValues(converted, "Converted copy") != EXIT_SUCCESS ||
+    copy->GetCompressedSize() != compressed->GetCompressedSize())
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkDataArray> instance = vtk::TakeSmartPointer(compressed->NewInstance());
+  if (!vtkArrayDownCast<vtkAOSDataArrayTemplate<int>>(instance) ||
+    vtkArrayDownCast<vtkCompressedDataArray<int>>(converted.GetPointer()) ||
+    vtkArrayDownCast<vtkCompressedDataArray<double>>(converted.GetPointer()) != converted)
+  {
+    std::cerr << "Wrong new instance or down cast" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestArrayCompressor()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(100, 100, 10);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkNew<vtkDoubleArray> small;
+  small->SetName("small");
+  small->SetNumberOfTuples(10);
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    scalars->SetValue(i, Expected(i));
+  }
+  image->GetPointData()->SetScalars(scalars);
+  image->GetFieldData()->AddArray(small);
+
+  vtkNew<vtkArrayCompressor> compressor;
+  if (compressor->CompressArrays(image) != 1)
+  {
+    std::cerr << "Wrong number of compressed arrays" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* compressedScalars = image->GetPointData()->GetScalars();
+  if (!compressedScalars ||
+    compressedScalars->GetArrayType() != vtkAbstractArray::CompressedDataArray ||
+    CheckValues(compressedScalars, "Compressed scalars") != EXIT_SUCCESS ||
+    image->GetFieldData()->GetArray("small") != small)
+  {
+    std::cerr << "Wrong compressed scalars" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (compressor->DecompressArrays(image) != 1)
+  {
+    std::cerr << "Wrong number of decompressed arrays" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* decompressedScalars = image->GetPointData()->GetScalars();
+  if (!vtkArrayDownCast<vtkDoubleArray>(decompressedScalars) ||
+    strcmp(decompressedScalars->GetName(), "scalars") != 0 ||
+    CheckValues(decompressedScalars, "Decompressed scalars") != EXIT_SUCCESS)
+  {
+    std::cerr << "Wrong decompressed scalars" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestCompressedDataArray(int, char*[])
+{
+  if (TestValues() != EXIT_SUCCESS || TestCopies() != EXIT_SUCCESS ||
+    TestArrayCompressor() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStringToNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkStringToNumber parses numbers like operator>> does, and
+// floating point numbers like strtod() does with ParseLikeStrtod().
+
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkStringToNumber.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Parse text with vtkStringToNumber and with a stream, and check that both
+// succeed or fail together, with the same value.
+template <typename T>
+bool SameAsStream(const char* text)
+{
+  T value = T();
+  const bool parsed = vtkStringToNumber::Parse(text, text + strlen(text), value) != nullptr;
+
+  std::istringstream stream(text);
+  stream.imbue(std::locale::classic());
+  T expected = T();
+  stream >> expected;
+  const bool streamed = !stream.fail();
+
+  if (parsed != streamed || (parsed && value != expected))
+  {
+    std::cerr << "Parsing \"" << text << "\" gave " << (parsed ? "" : "no ") << "value " << value
+              << " instead of " << (streamed ? "" : "no ") << "value " << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+
+inline float StrToReal(const char* text, char** end, float)
+{
+  return std::strtof(text, end);
+}
+
+inline double StrToReal(const char* text, char** end, double)
+{
+  return std::strtod(text, end);
+}
+
+// Parse text with vtkStringToNumber::ParseLikeStrtod() and with strtod(),
+// and check that both succeed or fail together, with the same value and the
+// same end.
+template <typename T>
+bool SameAsStrtod(const char* text)
+{
+  T value = T();
+  const char* end = vtkStringToNumber::ParseLikeStrtod(text, text + strlen(text), value);
+
+  char* expectedEnd = nullptr;
+  const T expected = StrToReal(text, &expectedEnd, T());
+  if (expectedEnd == text)
+  {
+    expectedEnd = nullptr;
+  }
+
+  const bool same = std::isnan(value) ? std::isnan(expected) : value == expected;
+  if (end != expectedEnd || (end && !same))
+  {
+    std::cerr << "Parsing \"" << text << "\" gave " << (end ? "" : "no ") << "value " << value
+              << " instead of " << (expectedEnd ? "" : "no ") << "value " << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Write numValues random values, then read them back with ReadValues, and
+// check that they are those read with operator>>, and that the stream is
+// left after them.
+template <typename T>
+bool ReadLikeStream(int numValues, double scale)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  std::ostringstream text;
+  text.precision(std::numeric_limits<T>::max_digits10);
+  for (int i = 0; i < numValues; ++i)
+  {
+    random->Next();
+    text << static_cast<T>(scale * (random->GetValue() - 0.5)) << (i % 9 ? " " : "\n  ");
+  }
+  text << "END";
+
+  std::vector<T> expected(numValues);
+  std::istringstream stream(text.str());
+  for (T& value : expected)
+  {
+    stream >> value;
+  }
+
+  std::vector<T> values(numValues);
+  std::istringstream input(text.str());
+  if (!vtkStringToNumber::ReadValues(input, values.data(), numValues))
+  {
+    std::cerr << "Could not read " << numValues << " values" << std::endl;
+    return false;
+  }
+  if (values != expected)
+  {
+    std::cerr << "Wrong values among " << numValues << " values" << std::endl;
+    return false;
+  }
+  std::string keyword;
+  input >> keyword;
+  if (keyword != "END")
+  {
+    std::cerr << "Stream left at \"" << keyword << "\" after " << numValues << " values"
+              << std::endl;
+    return false;
+  }
+
+  // Reading past the end fails.
+  std::istringstream shortInput(text.str());
+  if (vtkStringToNumber::ReadValues(shortInput, values.data(), numValues + 1))
+  {
+    std::cerr << "Reading a word as a number succeeded" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestStringToNumber(int, char*[])
+{
+  bool ok = true;
+
+  const char* integers[] = { "0", "  42", "-17", "+8", "2147483647", "-2147483648", "2147483648",
+    "99999999999999999999", "-", "x1", "12abc", "" };
+  for (const char* text : integers)
+  {
+    ok = SameAsStream<int>(text) && ok;
+    ok = SameAsStream<long long>(text) && ok;
+    ok = SameAsStream<short>(text) && ok;
+  }
+  const char* unsignedIntegers[] = { "0", "4294967295", "4294967296", "-1", "65535", "65536" };
+  for (const char* text : unsignedIntegers)
+  {
+    ok = SameAsStream<unsigned int>(text) && ok;
+    ok = SameAsStream<unsigned short>(text) && ok;
+  }
+  const char* reals[] = { "0", "-0.0", "1", "0.1", "-2.5e-3", "1E10", ".5", "5.", "3.4028235e38",
+    "1e39", "1.7976931348623157e308", "4.9e-324", "1e-50", "0.30000000000000004",
+    "123456789012345678901234567890", "e5", ".", "1e400", "-1e400", "nan", "-nan", "NaN", "inf",
+    "-inf", "Infinity", "INFINITE", "0x10", "-0X1f", "0x1.8p1" };
+  for (const char* text : reals)
+  {
+    ok = SameAsStream<double>(text) && ok;
+    ok = SameAsStream<float>(text) && ok;
+    ok = SameAsStrtod<double>(text) && ok;
+    ok = SameAsStrtod<float>(text) && ok;
+  }
+
+  // The values that operator>> rejects make ReadValues() fail.
+  const char* rejected[] = { "1 inf 2", "1 nan 2", "1 1e400 2", "1 0x10 2" };
+  for (const char* text : rejected)
+  {
+    double values[3];
+    std::istringstream input(text);
+    if (vtkStringToNumber::ReadValues(input, values, 3))
+    {
+      std::cerr << "Reading \"" << text << "\" succeeded" << std::endl;
+      ok = false;
+    }
+  }
+
+  // Small counts are parsed serially, large ones by chunks.
+  const int counts[] = { 1, 10, 1000, 200000 };
+  for (int count : counts)
+  {
+    ok = ReadLikeStream<int>(count, 1e9) && ok;
+    ok = ReadLikeStream<long long>(count, 1e18) && ok;
+    ok = ReadLikeStream<float>(count, 1e6) && ok;
+    ok = ReadLikeStream<double>(count, 1e-3) && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayCompressor.h"
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkCompressedDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkFieldData.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+vtkStandardNewMacro(vtkArrayCompressor);
+vtkCxxSetObjectMacro(vtkArrayCompressor, Compressor, vtkDataCompressor);
+
+//------------------------------------------------------------------------------
+vtkArrayCompressor::vtkArrayCompressor()
+{
+  this->Compressor = vtkLZ4DataCompressor::New();
+  this->BlockSize = 16384;
+  this->CacheSize = 8;
+  this->MinimumNumberOfValues = 65536;
+}
+
+//------------------------------------------------------------------------------
+vtkArrayCompressor::~vtkArrayCompressor()
+{
+  this->SetCompressor(nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkArrayCompressor::NewCompressedArray(vtkDataArray* array)
+{
+  if (!array)
+  {
+    return nullptr;
+  }
+
+  vtkDataArray* compressed = nullptr;
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro({
+      vtkCompressedDataArray<VTK_TT>* typed = vtkCompressedDataArray<VTK_TT>::New();
+      if (this->Compressor)
+      {
+        typed->SetCompressor(this->Compressor);
+      }
+      typed->SetBlockSize(this->BlockSize);
+      typed->SetCacheSize(this->CacheSize);
+      typed->DeepCopy(array);
+      compressed = typed;
+    });
+    default:
+      break;
+  }
+  return compressed;
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkArrayCompressor::NewDecompressedArray(vtkDataArray* array)
+{
+  if (!array || array->GetArrayType() != vtkAbstractArray::CompressedDataArray)
+  {
+    return nullptr;
+  }
+
+  // New instances of compressed arrays are regular arrays.
+  vtkDataArray* decompressed = array->NewInstance();
+  decompressed->SetName(array->GetName());
+  decompressed->SetNumberOfComponents(array->GetNumberOfComponents());
+  decompressed->CopyComponentNames(array);
+  if (array->HasInformation())
+  {
+    decompressed->CopyInformation(array->GetInformation());
+  }
+  decompressed->SetNumberOfTuples(array->GetNumberOfTuples());
+  array->ExportToVoidPointer(decompressed->GetVoidPointer(0));
+  return decompressed;
+}
+
+//------------------------------------------------------------------------------
+int vtkArrayCompressor::CompressArrays(vtkDataObject* dataObject)
+{
+  return this->ReplaceArrays(dataObject, true);
+}
+
+//------------------------------------------------------------------------------
+int vtkArrayCompressor::DecompressArrays(vtkDataObject* dataObject)
+{
+  return this->ReplaceArrays(dataObject, false);
+}
+
+//------------------------------------------------------------------------------
+int vtkArrayCompressor::ReplaceArrays(vtkDataObject* dataObject, bool compress)
+{
+  if (!dataObject)
+  {
+    return 0;
+  }
+
+  int numReplaced = 0;
+  if (vtkCompositeDataSet* composite = vtkCompositeDataSet::SafeDownCast(dataObject))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter =
+      vtkSmartPointer<vtkCompositeDataIterator>::Take(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      numReplaced += this->ReplaceArrays(iter->GetCurrentDataObject(), compress);
+    }
+    return numReplaced;
+  }
+
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+  {
+    vtkFieldData* fieldData = dataObject->GetAttributesAsFieldData(type);
+    for (int i = 0; fieldData && i < fieldData->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = fieldData->GetArray(i);
+      if (!array || !array->GetName())
+      {
+        continue;
+      }
+
+      vtkDataArray* newArray = nullptr;
+      if (!compress)
+      {
+        newArray = this->NewDecompressedArray(array);
+      }
+      else if (array->GetArrayType() != vtkAbstractArray::CompressedDataArray &&
+        array->GetNumberOfValues() >= this->MinimumNumberOfValues)
+      {
+        newArray = this->NewCompressedArray(array);
+      }
+
+      if (newArray)
+      {
+        // Arrays of the same name are replaced in place.
+        fieldData->AddArray(newArray);
+        newArray->Delete();
+        ++numReplaced;
+      }
+    }
+  }
+  return numReplaced;
+}
+
+//------------------------------------------------------------------------------
+void vtkArrayCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Compressor: ";
+  if (this->Compressor)
+  {
+    os << endl;
+    this->Compressor->PrintSelf(os, indent.GetNextIndent());
+  }
+  else
+  {
+    os << "(none)" << endl;
+  }
+  os << indent << "BlockSize: " << this->BlockSize << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "MinimumNumberOfValues: " << this->MinimumNumberOfValues << endl;
+}
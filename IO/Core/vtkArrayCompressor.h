@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkArrayCompressor
+ * @brief   Compress and decompress the data arrays of datasets in memory.
+ *
+ * vtkArrayCompressor replaces the numeric arrays of the point, cell and field
+ * data of a data object, or of every block of a composite dataset, by
+ * vtkCompressedDataArray copies, and the other way around. Arrays are
+ * replaced in place, so that they keep their names and attribute roles.
+ * The points and cells of the datasets are not compressed.
+ *
+ * This is meant for keeping datasets, e.g. the time steps of a time series,
+ * in memory at a fraction of their size: filters can read the compressed
+ * arrays, but are faster on decompressed ones.
+ *
+ * @sa
+ * vtkCompressedDataArray vtkDataCompressor
+ */
+
+#ifndef vtkArrayCompressor_h
+#define vtkArrayCompressor_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataArray;
+class vtkDataCompressor;
+class vtkDataObject;
+
+class VTKIOCORE_EXPORT vtkArrayCompressor : public vtkObject
+{
+public:
+  static vtkArrayCompressor* New();
+  vtkTypeMacro(vtkArrayCompressor, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the compressor of the arrays. Default is a vtkLZ4DataCompressor.
+   */
+  virtual void SetCompressor(vtkDataCompressor*);
+  vtkGetObjectMacro(Compressor, vtkDataCompressor);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of tuples of the compressed blocks. Default is 16384.
+   */
+  vtkSetClampMacro(BlockSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(BlockSize, vtkIdType);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of decompressed blocks cached by each compressed
+   * array. Default is 8.
+   */
+  vtkSetClampMacro(CacheSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(CacheSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of values under which arrays are not worth
+   * compressing and are left as they are. Default is 65536.
+   */
+  vtkSetClampMacro(MinimumNumberOfValues, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(MinimumNumberOfValues, vtkIdType);
+  //@}
+
+  /**
+   * Return a vtkCompressedDataArray holding the values of the given array,
+   * or nullptr if the array is not numeric.
+   */
+  VTK_NEWINSTANCE vtkDataArray* NewCompressedArray(vtkDataArray* array);
+
+  /**
+   * Return a regular array holding the values of the given compressed array,
+   * or nullptr if the array is not compressed.
+   */
+  VTK_NEWINSTANCE vtkDataArray* NewDecompressedArray(vtkDataArray* array);
+
+  //@{
+  /**
+   * Replace the arrays of the data object by compressed or decompressed
+   * copies. Return the number of replaced arrays.
+   */
+  int CompressArrays(vtkDataObject* dataObject);
+  int DecompressArrays(vtkDataObject* dataObject);
+  //@}
+
+protected:
+  vtkArrayCompressor();
+  ~vtkArrayCompressor() override;
+
+  // Replace the named arrays of the attributes of a data object, or of the
+  // blocks of a composite dataset, by compressed or decompressed copies.
+  int ReplaceArrays(vtkDataObject* dataObject, bool compress);
+
+  vtkDataCompressor* Compressor;
+  vtkIdType BlockSize;
+  int CacheSize;
+  vtkIdType MinimumNumberOfValues;
+
+private:
+  vtkArrayCompressor(const vtkArrayCompressor&) = delete;
+  void operator=(const vtkArrayCompressor&) = delete;
+};
+
+#endif
@@ -0,0 +1,278 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompressedDataArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompressedDataArray
+ * @brief   vtkGenericDataArray storing its values in compressed blocks.
+ *
+ *
+ * vtkCompressedDataArray splits its tuples into blocks of BlockSize tuples
+ * and keeps each block compressed in memory by a vtkDataCompressor (LZ4 by
+ * default). Accessing a value decompresses its block into a small cache of
+ * the CacheSize most recently used blocks; modified blocks are compressed
+ * again when they leave the cache or when Squeeze() is called. Blocks never
+ * written to are zero and use no memory.
+ *
+ * The array supports the whole vtkGenericDataArray API, so that it works
+ * with vtkArrayDispatch and the vtkDataArrayRange API. Access is fast when
+ * consecutive accesses fall in the same few blocks, e.g. when iterating over
+ * the array, and much slower for random accesses. The cache is shared by
+ * all the threads reading the array. Each cached block has its own lock, so
+ * that threads accessing different blocks decompress them concurrently.
+ *
+ * ImportValues() and ExportToVoidPointer() compress and decompress whole
+ * arrays block by block in parallel through vtkSMPTools: the compressor must
+ * support concurrent calls, which is the case of the compressors of VTK.
+ * NewInstance() returns a regular vtkAOSDataArrayTemplate of the same value
+ * type. vtkArrayCompressor compresses the arrays of whole datasets.
+ *
+ * @sa
+ * vtkGenericDataArray vtkDataCompressor vtkArrayCompressor
+ */
+
+#ifndef vtkCompressedDataArray_h
+#define vtkCompressedDataArray_h
+
+#include "vtkBuffer.h" // For GetVoidPointer
+#include "vtkDataCompressor.h"
+#include "vtkGenericDataArray.h"
+#include "vtkSmartPointer.h" // For vtkSmartPointer
+
+#include <memory> // For std::unique_ptr
+#include <mutex>  // For std::mutex
+#include <vector> // For std::vector
+
+template <class ValueTypeT>
+class vtkCompressedDataArray
+  : public vtkGenericDataArray<vtkCompressedDataArray<ValueTypeT>, ValueTypeT>
+{
+  typedef vtkGenericDataArray<vtkCompressedDataArray<ValueTypeT>, ValueTypeT>
+    GenericDataArrayType;
+
+public:
+  typedef vtkCompressedDataArray<ValueTypeT> SelfType;
+  vtkAbstractTypeMacroWithNewInstanceType(
+    SelfType, GenericDataArrayType, vtkDataArray, typeid(SelfType).name());
+  vtkAOSArrayNewInstanceMacro(SelfType);
+  typedef typename Superclass::ValueType ValueType;
+
+  static vtkCompressedDataArray* New();
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const
+  {
+    return this->GetTypedComponent(
+      valueIdx / this->NumberOfComponents, valueIdx % this->NumberOfComponents);
+  }
+
+  /**
+   * Set the value at @a valueIdx to @a value. @a valueIdx assumes AOS ordering.
+   */
+  inline void SetValue(vtkIdType valueIdx, ValueType value)
+  {
+    this->SetTypedComponent(
+      valueIdx / this->NumberOfComponents, valueIdx % this->NumberOfComponents, value);
+  }
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+
+  /**
+   * Set this array's tuple at @a tupleIdx to the values in @a tuple.
+   */
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple);
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   */
+  ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const;
+
+  /**
+   * Set component @a comp of the tuple at @a tupleIdx to @a value.
+   */
+  void SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType value);
+
+  /**
+   * Replace the values of the array by the first GetNumberOfValues() values
+   * of @a values, in AoS ordering. This compresses the blocks in parallel and
+   * is much faster than setting the values one by one.
+   */
+  void ImportValues(const ValueType* values);
+
+  /**
+   * Decompress all the values in AoS ordering to the preallocated memory
+   * buffer.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  /**
+   * Use of this method is discouraged, it creates a deep copy of the data into
+   * a contiguous AoS-ordered buffer and prints a warning.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Compress the modified blocks of the cache and release the cache.
+   */
+  void Squeeze() override;
+
+  /**
+   * Return the memory used by the compressed blocks and by the cache, in
+   * kibibytes (1024 bytes).
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  /**
+   * Return the size of the compressed blocks in bytes.
+   */
+  size_t GetCompressedSize() const;
+
+  //@{
+  /**
+   * Set/Get the number of tuples of a block. Smaller blocks make random
+   * accesses faster and compress less. Changing the size of the blocks of a
+   * non-empty array compresses it again. Default is 16384.
+   */
+  void SetBlockSize(vtkIdType numTuples);
+  vtkIdType GetBlockSize() const { return this->BlockSize; }
+  //@}
+
+  //@{
+  /**
+   * Set/Get the maximum number of decompressed blocks kept in the cache.
+   * Default is 8.
+   */
+  void SetCacheSize(int numBlocks);
+  int GetCacheSize() const { return this->CacheSize; }
+  //@}
+
+  //@{
+  /**
+   * Set/Get the compressor of the blocks. Changing the compressor of a
+   * non-empty array compresses it again. Default is a vtkLZ4DataCompressor.
+   */
+  void SetCompressor(vtkDataCompressor* compressor);
+  vtkDataCompressor* GetCompressor() const { return this->Compressor; }
+  //@}
+
+  void SetNumberOfComponents(int numComps) override;
+
+  /**
+   * Reimplemented to compress whole blocks when copying arrays of the same
+   * value type, and to copy the compressed blocks of compressed arrays.
+   */
+  void DeepCopy(vtkDataArray* other) override;
+  // MSVC doesn't like 'using' here (error C2487). Just forward instead:
+  // using Superclass::DeepCopy;
+  void DeepCopy(vtkAbstractArray* other) override { this->Superclass::DeepCopy(other); }
+
+#ifndef __VTK_WRAP__
+  //@{
+  /**
+   * Perform a fast, safe cast from a vtkAbstractArray to a
+   * vtkCompressedDataArray. This method checks if source->GetArrayType()
+   * returns CompressedDataArray with the same value type, and performs a
+   * static_cast to return source as a vtkCompressedDataArray pointer.
+   * Otherwise, nullptr is returned.
+   */
+  static vtkCompressedDataArray<ValueType>* FastDownCast(vtkAbstractArray* source)
+  {
+    if (source && source->GetArrayType() == vtkAbstractArray::CompressedDataArray &&
+      vtkDataTypesCompare(source->GetDataType(), vtkTypeTraits<ValueType>::VTK_TYPE_ID))
+    {
+      return static_cast<vtkCompressedDataArray<ValueType>*>(source);
+    }
+    return nullptr;
+  }
+  //@}
+#endif
+
+  int GetArrayType() const override { return vtkAbstractArray::CompressedDataArray; }
+
+protected:
+  vtkCompressedDataArray();
+  ~vtkCompressedDataArray() override;
+
+  /**
+   * Allocate space for numTuples. Old data is not preserved.
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+
+  /**
+   * Allocate space for numTuples. Old data is preserved.
+   */
+  bool ReallocateTuples(vtkIdType numTuples);
+
+  // A decompressed block. Its mutex is locked while the block is accessed
+  // or loaded.
+  struct CachedBlock
+  {
+    vtkIdType Index;
+    std::vector<ValueType> Values;
+    bool Modified;
+    unsigned long long LastUse;
+    std::mutex Mutex;
+  };
+
+  // Return the decompressed block of index blockIdx, decompressing it if
+  // needed, with lock holding its mutex. CacheMutex must not be locked.
+  CachedBlock& LockCachedBlock(vtkIdType blockIdx, std::unique_lock<std::mutex>& lock) const;
+
+  // Compress values, BlockSize tuples, as the block of index blockIdx.
+  void CompressBlock(vtkIdType blockIdx, const ValueType* values) const;
+
+  // Decompress the block of index blockIdx into values, BlockSize tuples.
+  void DecompressBlock(vtkIdType blockIdx, ValueType* values) const;
+
+  // Compress the modified blocks of the cache, and empty it if release is
+  // true. CacheMutex must be locked.
+  void FlushCache(bool release) const;
+
+  // Decompress the values, apply the new settings and compress them again.
+  template <typename Functor>
+  void Recompress(Functor changeSettings);
+
+  vtkIdType BlockSize;
+  int CacheSize;
+  vtkSmartPointer<vtkDataCompressor> Compressor;
+
+  // The compressed blocks, empty for blocks that are zero.
+  mutable std::vector<std::vector<unsigned char>> Blocks;
+  mutable std::vector<std::unique_ptr<CachedBlock>> Cache;
+  mutable unsigned long long CacheClock;
+  // Protects the list of the cached blocks and CacheClock. It is locked
+  // before the mutex of any cached block.
+  mutable std::mutex CacheMutex;
+
+  vtkBuffer<ValueType>* AoSCopy;
+
+private:
+  vtkCompressedDataArray(const vtkCompressedDataArray&) = delete;
+  void operator=(const vtkCompressedDataArray&) = delete;
+
+  friend class vtkGenericDataArray<vtkCompressedDataArray<ValueTypeT>, ValueTypeT>;
+};
+
+// Declare vtkArrayDownCast implementations for compressed containers:
+vtkArrayDownCast_TemplateFastCastMacro(vtkCompressedDataArray);
+
+#include "vtkCompressedDataArray.txx"
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkCompressedDataArray.h
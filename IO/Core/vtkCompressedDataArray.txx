@@ -0,0 +1,559 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompressedDataArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkCompressedDataArray_txx
+#define vtkCompressedDataArray_txx
+
+#include "vtkCompressedDataArray.h"
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkLookupTable.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkCompressedDataArray<ValueTypeT>* vtkCompressedDataArray<ValueTypeT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkCompressedDataArray<ValueTypeT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkCompressedDataArray<ValueTypeT>::vtkCompressedDataArray()
+  : BlockSize(16384)
+  , CacheSize(8)
+  , Compressor(vtkSmartPointer<vtkLZ4DataCompressor>::New())
+  , CacheClock(0)
+  , AoSCopy(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkCompressedDataArray<ValueTypeT>::~vtkCompressedDataArray()
+{
+  if (this->AoSCopy)
+  {
+    this->AoSCopy->Delete();
+    this->AoSCopy = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::GetTypedTuple(
+  vtkIdType tupleIdx, ValueType* tuple) const
+{
+  std::unique_lock<std::mutex> lock;
+  const CachedBlock& block = this->LockCachedBlock(tupleIdx / this->BlockSize, lock);
+  std::copy_n(block.Values.data() + (tupleIdx % this->BlockSize) * this->NumberOfComponents,
+    this->NumberOfComponents, tuple);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::SetTypedTuple(
+  vtkIdType tupleIdx, const ValueType* tuple)
+{
+  std::unique_lock<std::mutex> lock;
+  CachedBlock& block = this->LockCachedBlock(tupleIdx / this->BlockSize, lock);
+  std::copy_n(tuple, this->NumberOfComponents,
+    block.Values.data() + (tupleIdx % this->BlockSize) * this->NumberOfComponents);
+  block.Modified = true;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+typename vtkCompressedDataArray<ValueTypeT>::ValueType
+vtkCompressedDataArray<ValueTypeT>::GetTypedComponent(vtkIdType tupleIdx, int comp) const
+{
+  std::unique_lock<std::mutex> lock;
+  const CachedBlock& block = this->LockCachedBlock(tupleIdx / this->BlockSize, lock);
+  return block.Values[(tupleIdx % this->BlockSize) * this->NumberOfComponents + comp];
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::SetTypedComponent(
+  vtkIdType tupleIdx, int comp, ValueType value)
+{
+  std::unique_lock<std::mutex> lock;
+  CachedBlock& block = this->LockCachedBlock(tupleIdx / this->BlockSize, lock);
+  block.Values[(tupleIdx % this->BlockSize) * this->NumberOfComponents + comp] = value;
+  block.Modified = true;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::ImportValues(const ValueType* values)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->CacheMutex);
+    this->Cache.clear();
+  }
+
+  const vtkIdType numValues = this->GetNumberOfValues();
+  const vtkIdType blockValues = this->BlockSize * this->NumberOfComponents;
+  const vtkIdType numBlocks = static_cast<vtkIdType>(this->Blocks.size());
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<ValueType> lastBlock;
+    for (vtkIdType blockIdx = begin; blockIdx < end; ++blockIdx)
+    {
+      const vtkIdType first = blockIdx * blockValues;
+      if (first + blockValues <= numValues)
+      {
+        this->CompressBlock(blockIdx, values + first);
+      }
+      else if (first < numValues)
+      {
+        // Partial last block, padded with zeros.
+        lastBlock.assign(blockValues, ValueType());
+        std::copy(values + first, values + numValues, lastBlock.begin());
+        this->CompressBlock(blockIdx, lastBlock.data());
+      }
+      else
+      {
+        std::vector<unsigned char>().swap(this->Blocks[blockIdx]);
+      }
+    }
+  });
+  this->DataChanged();
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::ExportToVoidPointer(void* voidPtr)
+{
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (numValues == 0)
+  {
+    // Nothing to do.
+    return;
+  }
+
+  if (!voidPtr)
+  {
+    vtkErrorMacro(<< "Buffer is nullptr.");
+    return;
+  }
+
+  // Compress the modified blocks first, so that the compressed blocks hold
+  // all the values.
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  this->FlushCache(false);
+
+  ValueType* values = static_cast<ValueType*>(voidPtr);
+  const vtkIdType blockValues = this->BlockSize * this->NumberOfComponents;
+  const vtkIdType numBlocks = (numValues + blockValues - 1) / blockValues;
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<ValueType> lastBlock;
+    for (vtkIdType blockIdx = begin; blockIdx < end; ++blockIdx)
+    {
+      const vtkIdType first = blockIdx * blockValues;
+      if (first + blockValues <= numValues)
+      {
+        this->DecompressBlock(blockIdx, values + first);
+      }
+      else
+      {
+        lastBlock.resize(blockValues);
+        this->DecompressBlock(blockIdx, lastBlock.data());
+        std::copy(lastBlock.begin(), lastBlock.begin() + (numValues - first), values + first);
+      }
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void* vtkCompressedDataArray<ValueTypeT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  // Allow warnings to be silenced:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "compressed arrays, as all the values must be "
+                       "decompressed. Using the vtkGenericDataArray API with "
+                       "vtkArrayDispatch are preferred. Define the environment "
+                       "variable VTK_SILENCE_GET_VOID_POINTER_WARNINGS to "
+                       "silence this warning.");
+  }
+
+  size_t numValues = this->GetNumberOfValues();
+
+  if (!this->AoSCopy)
+  {
+    this->AoSCopy = vtkBuffer<ValueType>::New();
+  }
+
+  if (!this->AoSCopy->Allocate(static_cast<vtkIdType>(numValues)))
+  {
+    vtkErrorMacro(<< "Error allocating a buffer of " << numValues << " '"
+                  << this->GetDataTypeAsString() << "' elements.");
+    return nullptr;
+  }
+
+  this->ExportToVoidPointer(static_cast<void*>(this->AoSCopy->GetBuffer()));
+
+  return static_cast<void*>(this->AoSCopy->GetBuffer() + valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::Squeeze()
+{
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  this->FlushCache(true);
+  this->Cache.shrink_to_fit();
+  if (this->AoSCopy)
+  {
+    this->AoSCopy->Delete();
+    this->AoSCopy = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+unsigned long vtkCompressedDataArray<ValueTypeT>::GetActualMemorySize() const
+{
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  size_t size = this->Blocks.capacity() * sizeof(std::vector<unsigned char>);
+  for (const auto& block : this->Blocks)
+  {
+    size += block.capacity();
+  }
+  for (const auto& block : this->Cache)
+  {
+    std::lock_guard<std::mutex> blockLock(block->Mutex);
+    size += block->Values.capacity() * sizeof(ValueType);
+  }
+  if (this->AoSCopy)
+  {
+    size += this->AoSCopy->GetSize() * sizeof(ValueType);
+  }
+  return static_cast<unsigned long>(size / 1024 + 1);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+size_t vtkCompressedDataArray<ValueTypeT>::GetCompressedSize() const
+{
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  size_t size = 0;
+  for (const auto& block : this->Blocks)
+  {
+    size += block.size();
+  }
+  return size;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::SetBlockSize(vtkIdType numTuples)
+{
+  numTuples = std::max(numTuples, static_cast<vtkIdType>(1));
+  if (numTuples != this->BlockSize)
+  {
+    this->Recompress([this, numTuples]() { this->BlockSize = numTuples; });
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::SetCacheSize(int numBlocks)
+{
+  numBlocks = std::max(numBlocks, 1);
+  if (numBlocks != this->CacheSize)
+  {
+    std::lock_guard<std::mutex> lock(this->CacheMutex);
+    this->FlushCache(true);
+    this->CacheSize = numBlocks;
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::SetCompressor(vtkDataCompressor* compressor)
+{
+  if (compressor && compressor != this->Compressor)
+  {
+    this->Recompress([this, compressor]() { this->Compressor = compressor; });
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::SetNumberOfComponents(int numComps)
+{
+  if (numComps != this->NumberOfComponents)
+  {
+    // Keep the values in AoS ordering, as vtkAOSDataArrayTemplate does.
+    this->Recompress(
+      [this, numComps]() { this->GenericDataArrayType::SetNumberOfComponents(numComps); });
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::DeepCopy(vtkDataArray* other)
+{
+  if (other == nullptr || other == this)
+  {
+    return;
+  }
+
+  if (!vtkDataTypesCompare(other->GetDataType(), vtkTypeTraits<ValueType>::VTK_TYPE_ID))
+  {
+    this->Superclass::DeepCopy(other);
+    return;
+  }
+  SelfType* compressed = SelfType::FastDownCast(other);
+  vtkAOSDataArrayTemplate<ValueType>* aos =
+    vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType>>(other);
+
+  this->Initialize();
+  this->vtkAbstractArray::DeepCopy(other); // copy Information object
+  this->SetNumberOfComponents(other->GetNumberOfComponents());
+  if (compressed)
+  {
+    // Copy the compressed blocks.
+    std::lock(this->CacheMutex, compressed->CacheMutex);
+    std::lock_guard<std::mutex> lock(this->CacheMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(compressed->CacheMutex, std::adopt_lock);
+    compressed->FlushCache(false);
+    this->Cache.clear();
+    this->BlockSize = compressed->BlockSize;
+    this->Compressor = compressed->Compressor;
+    this->Blocks = compressed->Blocks;
+    this->Size = compressed->Size;
+    this->MaxId = compressed->MaxId;
+  }
+  else if (aos)
+  {
+    this->SetNumberOfTuples(aos->GetNumberOfTuples());
+    this->ImportValues(aos->GetPointer(0));
+  }
+  else
+  {
+    // Other layouts are exported to AoS ordering first.
+    std::vector<ValueType> values(static_cast<size_t>(other->GetNumberOfValues()));
+    other->ExportToVoidPointer(values.data());
+    this->SetNumberOfTuples(other->GetNumberOfTuples());
+    this->ImportValues(values.data());
+  }
+
+  this->SetLookupTable(nullptr);
+  if (vtkLookupTable* lut = other->GetLookupTable())
+  {
+    vtkLookupTable* copy = lut->NewInstance();
+    copy->DeepCopy(lut);
+    this->SetLookupTable(copy);
+    copy->Delete();
+  }
+  this->DataChanged();
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkCompressedDataArray<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
+{
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  this->Cache.clear();
+  this->Blocks.clear();
+  this->Blocks.resize((numTuples + this->BlockSize - 1) / this->BlockSize);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkCompressedDataArray<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
+{
+  std::lock_guard<std::mutex> lock(this->CacheMutex);
+  const vtkIdType numBlocks = (numTuples + this->BlockSize - 1) / this->BlockSize;
+  this->Cache.erase(
+    std::remove_if(this->Cache.begin(), this->Cache.end(),
+      [numBlocks](const std::unique_ptr<CachedBlock>& block) { return block->Index >= numBlocks; }),
+    this->Cache.end());
+  this->Blocks.resize(numBlocks);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+typename vtkCompressedDataArray<ValueTypeT>::CachedBlock&
+vtkCompressedDataArray<ValueTypeT>::LockCachedBlock(
+  vtkIdType blockIdx, std::unique_lock<std::mutex>& lock) const
+{
+  while (true)
+  {
+    std::unique_lock<std::mutex> cacheLock(this->CacheMutex);
+    ++this->CacheClock;
+    auto cached = std::find_if(this->Cache.begin(), this->Cache.end(),
+      [blockIdx](const std::unique_ptr<CachedBlock>& block) { return block->Index == blockIdx; });
+    if (cached != this->Cache.end())
+    {
+      CachedBlock* block = cached->get();
+      block->LastUse = this->CacheClock;
+      cacheLock.unlock();
+      // Wait for the block to be loaded, and check that it was not replaced
+      // meanwhile.
+      lock = std::unique_lock<std::mutex>(block->Mutex);
+      if (block->Index == blockIdx)
+      {
+        return *block;
+      }
+      lock.unlock();
+      continue;
+    }
+
+    CachedBlock* block = nullptr;
+    if (static_cast<int>(this->Cache.size()) < this->CacheSize)
+    {
+      this->Cache.emplace_back(new CachedBlock());
+      block = this->Cache.back().get();
+      lock = std::unique_lock<std::mutex>(block->Mutex);
+    }
+    else
+    {
+      // Replace the least recently used block that is not in use, or wait
+      // for the least recently used block if they all are.
+      for (const auto& candidate : this->Cache)
+      {
+        if (!block || candidate->LastUse < block->LastUse)
+        {
+          std::unique_lock<std::mutex> candidateLock(candidate->Mutex, std::try_to_lock);
+          if (candidateLock.owns_lock())
+          {
+            block = candidate.get();
+            lock = std::move(candidateLock);
+          }
+        }
+      }
+      if (!block)
+      {
+        block = std::min_element(this->Cache.begin(), this->Cache.end(),
+          [](const std::unique_ptr<CachedBlock>& a, const std::unique_ptr<CachedBlock>& b) {
+            return a->LastUse < b->LastUse;
+          })->get();
+        lock = std::unique_lock<std::mutex>(block->Mutex);
+      }
+      // The replaced block is compressed before it can be loaded again.
+      if (block->Modified)
+      {
+        this->CompressBlock(block->Index, block->Values.data());
+      }
+    }
+    block->Index = blockIdx;
+    block->Modified = false;
+    block->LastUse = this->CacheClock;
+    cacheLock.unlock();
+
+    // Only this block is locked while it is decompressed.
+    block->Values.resize(this->BlockSize * this->NumberOfComponents);
+    this->DecompressBlock(blockIdx, block->Values.data());
+    return *block;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::CompressBlock(
+  vtkIdType blockIdx, const ValueType* values) const
+{
+  const vtkIdType numValues = this->BlockSize * this->NumberOfComponents;
+  std::vector<unsigned char>& block = this->Blocks[blockIdx];
+  const size_t numBytes = static_cast<size_t>(numValues) * sizeof(ValueType);
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+  if (std::all_of(bytes, bytes + numBytes, [](unsigned char byte) { return byte == 0; }))
+  {
+    std::vector<unsigned char>().swap(block);
+    return;
+  }
+
+  block.resize(this->Compressor->GetMaximumCompressionSpace(numBytes));
+  const size_t size = this->Compressor->Compress(bytes, numBytes, block.data(), block.size());
+  block.resize(size);
+  block.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::DecompressBlock(
+  vtkIdType blockIdx, ValueType* values) const
+{
+  const vtkIdType numValues = this->BlockSize * this->NumberOfComponents;
+  const std::vector<unsigned char>& block = this->Blocks[blockIdx];
+  if (block.empty())
+  {
+    std::fill(values, values + numValues, ValueType());
+    return;
+  }
+
+  const size_t numBytes = static_cast<size_t>(numValues) * sizeof(ValueType);
+  if (this->Compressor->Uncompress(block.data(), block.size(),
+        reinterpret_cast<unsigned char*>(values), numBytes) != numBytes)
+  {
+    vtkErrorMacro("Failed to decompress block " << blockIdx << ".");
+    std::fill(values, values + numValues, ValueType());
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkCompressedDataArray<ValueTypeT>::FlushCache(bool release) const
+{
+  for (const auto& block : this->Cache)
+  {
+    std::lock_guard<std::mutex> blockLock(block->Mutex);
+    if (block->Modified)
+    {
+      this->CompressBlock(block->Index, block->Values.data());
+      block->Modified = false;
+    }
+  }
+  if (release)
+  {
+    this->Cache.clear();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+template <typename Functor>
+void vtkCompressedDataArray<ValueTypeT>::Recompress(Functor changeSettings)
+{
+  std::vector<ValueType> values(static_cast<size_t>(this->GetNumberOfValues()));
+  this->ExportToVoidPointer(values.data());
+  {
+    std::lock_guard<std::mutex> lock(this->CacheMutex);
+    this->Cache.clear();
+    this->Blocks.clear();
+    changeSettings();
+    const int numComps = std::max(this->NumberOfComponents, 1);
+    const vtkIdType numTuples = (this->Size + numComps - 1) / numComps;
+    this->Blocks.resize((numTuples + this->BlockSize - 1) / this->BlockSize);
+  }
+  this->ImportValues(values.data());
+  this->Modified();
+}
+
+#endif // header guard
@@ -99,6 +99,16 @@ public:
   virtual void SetCompressionLevel(int compressionLevel) = 0;
   virtual int GetCompressionLevel() = 0;
 
+  /**
+   * Return true if Compress() and Uncompress() may be called concurrently
+   * on this instance from several threads. vtkXMLWriter and
+   * vtkXMLDataParser only process the blocks of a data array in parallel
+   * when the compressor is thread-safe, and one at a time otherwise. The
+   * default is false; subclasses whose CompressBuffer() and
+   * UncompressBuffer() do not modify the compressor should return true.
+   */
+  virtual bool IsThreadSafe() { return false; }
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor() override;
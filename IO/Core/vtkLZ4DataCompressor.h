@@ -49,6 +49,11 @@ public:
   // Compression level setter required by vtkDataCompresor.
   void SetCompressionLevel(int compressionLevel) override;
 
+  /**
+   * The compression and decompression do not modify the compressor.
+   */
+  bool IsThreadSafe() override { return true; }
+
   // Direct setting of AccelerationLevel allows more direct
   // control over LZ4 compressor
   vtkSetClampMacro(AccelerationLevel, int, 1, VTK_INT_MAX);
@@ -56,6 +56,11 @@ public:
   // Compression level getter required by vtkDataCompressor.
   int GetCompressionLevel() override;
 
+  /**
+   * The compression and decompression do not modify the compressor.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkLZMADataCompressor();
   ~vtkLZMADataCompressor() override;
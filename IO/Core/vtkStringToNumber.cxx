@@ -0,0 +1,592 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStringToNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStringToNumber.h"
+
+#include "vtkSMPTools.h"
+
+// clang-format off
+#include "vtk_doubleconversion.h"
+#include VTK_DOUBLECONVERSION_HEADER(double-conversion.h)
+// clang-format on
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The size of the blocks read from a stream, and the smallest part of a
+// block parsed by a thread.
+const std::streamsize BlockSize = 1 << 24;
+const std::streamsize ChunkSize = 1 << 16;
+
+// The white space of the "C" locale, which separates the numbers.
+inline bool IsSpace(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline const char* SkipSpace(const char* p, const char* end)
+{
+  while (p != end && IsSpace(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+const char* ParseInteger(const char* p, const char* end, T& value)
+{
+  p = SkipSpace(p, end);
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  if (p == end || *p < '0' || *p > '9')
+  {
+    return nullptr;
+  }
+
+  const unsigned long long maxMagnitude = std::numeric_limits<unsigned long long>::max();
+  unsigned long long magnitude = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; ++p)
+  {
+    const unsigned int digit = static_cast<unsigned int>(*p - '0');
+    if (magnitude > (maxMagnitude - digit) / 10)
+    {
+      return nullptr;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+
+  const unsigned long long maxValue =
+    static_cast<unsigned long long>(std::numeric_limits<T>::max());
+  if (std::numeric_limits<T>::is_signed)
+  {
+    if (magnitude > maxValue + (negative ? 1 : 0))
+    {
+      return nullptr;
+    }
+    value = !negative || magnitude == 0
+      ? static_cast<T>(magnitude)
+      : static_cast<T>(-static_cast<long long>(magnitude - 1) - 1);
+  }
+  else
+  {
+    if (magnitude > maxValue)
+    {
+      return nullptr;
+    }
+    // Negative values wrap around, as with operator>>.
+    value = static_cast<T>(negative ? 0 - magnitude : magnitude);
+  }
+  return p;
+}
+
+//------------------------------------------------------------------------------
+// The char types hold small integers.
+template <typename T>
+const char* ParseChar(const char* p, const char* end, T& value)
+{
+  int intValue;
+  p = ParseInteger(p, end, intValue);
+  if (p)
+  {
+    value = static_cast<T>(intValue);
+  }
+  return p;
+}
+
+//------------------------------------------------------------------------------
+// Accept decimal numbers only, as operator>> does.
+const double_conversion::StringToDoubleConverter& GetStreamConverter()
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::ALLOW_TRAILING_JUNK, 0.0, 0.0, nullptr, nullptr);
+  return converter;
+}
+
+// Accept what strtod() accepts in the "C" locale: hexadecimal numbers,
+// "inf", "infinity" and "nan" in any case, and values out of range, which
+// are converted to infinity.
+const double_conversion::StringToDoubleConverter& GetStrtodConverter()
+{
+  using Converter = double_conversion::StringToDoubleConverter;
+  static const Converter converter(Converter::ALLOW_TRAILING_JUNK | Converter::ALLOW_HEX |
+      Converter::ALLOW_HEX_FLOATS | Converter::ALLOW_CASE_INSENSIBILITY,
+    0.0, 0.0, "inf", "nan");
+  return converter;
+}
+
+// Return the end of the "inity" of "infinity" if [p, end) starts with it,
+// p otherwise.
+inline const char* SkipInfinitySuffix(const char* p, const char* end)
+{
+  const char* suffix = "inity";
+  const char* q = p;
+  for (; *suffix && q != end && (*q | 0x20) == *suffix; ++q, ++suffix)
+  {
+  }
+  return *suffix ? p : q;
+}
+
+inline void Convert(const double_conversion::StringToDoubleConverter& converter, const char* p,
+  int length, int* processed, float& value)
+{
+  value = converter.StringToFloat(p, length, processed);
+}
+
+inline void Convert(const double_conversion::StringToDoubleConverter& converter, const char* p,
+  int length, int* processed, double& value)
+{
+  value = converter.StringToDouble(p, length, processed);
+}
+
+template <typename T>
+const char* ParseFloat(const char* p, const char* end, T& value, bool likeStrtod)
+{
+  p = SkipSpace(p, end);
+  const char* tokenEnd = p;
+  while (tokenEnd != end && !IsSpace(*tokenEnd))
+  {
+    ++tokenEnd;
+  }
+  const int length =
+    static_cast<int>(std::min<std::ptrdiff_t>(tokenEnd - p, std::numeric_limits<int>::max()));
+  int processed = 0;
+  T result;
+  Convert(likeStrtod ? GetStrtodConverter() : GetStreamConverter(), p, length, &processed, result);
+  // Values out of range are rejected by operator>>.
+  if (processed == 0 || (!likeStrtod && std::isinf(result)))
+  {
+    return nullptr;
+  }
+  value = result;
+  return std::isinf(result) ? SkipInfinitySuffix(p + processed, tokenEnd) : p + processed;
+}
+
+//------------------------------------------------------------------------------
+// Parse at most numValues numbers of [begin, end). Return the number of
+// values parsed, or -1 if a number cannot be parsed, and set last past the
+// last number parsed.
+template <typename T>
+vtkIdType ParseSerial(
+  const char* begin, const char* end, T* values, vtkIdType numValues, const char*& last)
+{
+  vtkIdType count = 0;
+  const char* p = begin;
+  while (count < numValues)
+  {
+    const char* next = vtkStringToNumber::Parse(p, end, values[count]);
+    if (!next)
+    {
+      if (SkipSpace(p, end) != end)
+      {
+        return -1;
+      }
+      break;
+    }
+    p = next;
+    ++count;
+  }
+  last = p;
+  return count;
+}
+
+//------------------------------------------------------------------------------
+// Count the numbers of each chunk of a block.
+struct CountFunctor
+{
+  const char* const* Bounds;
+  vtkIdType* Counts;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      vtkIdType count = 0;
+      bool inNumber = false;
+      for (const char* p = this->Bounds[chunk]; p != this->Bounds[chunk + 1]; ++p)
+      {
+        const bool space = IsSpace(*p);
+        count += (!space && !inNumber) ? 1 : 0;
+        inNumber = !space;
+      }
+      this->Counts[chunk] = count;
+    }
+  }
+};
+
+// Parse the numbers of each chunk of a block, knowing the index of the
+// first number of each chunk.
+template <typename T>
+struct ParseFunctor
+{
+  const char* const* Bounds;
+  const vtkIdType* Offsets;
+  T* Values;
+  vtkIdType NumberOfValues;
+  const char* Last;
+  std::atomic<bool> Failed;
+
+  ParseFunctor()
+    : Last(nullptr)
+    , Failed(false)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end && !this->Failed; ++chunk)
+    {
+      const char* p = this->Bounds[chunk];
+      const char* chunkEnd = this->Bounds[chunk + 1];
+      const vtkIdType last = std::min(this->Offsets[chunk + 1], this->NumberOfValues);
+      for (vtkIdType i = this->Offsets[chunk]; i < last; ++i)
+      {
+        p = vtkStringToNumber::Parse(p, chunkEnd, this->Values[i]);
+        if (p && i + 1 == this->NumberOfValues)
+        {
+          // As with operator>>, the last number may be followed by other
+          // characters.
+          this->Last = p;
+        }
+        else if (!p || (p != chunkEnd && !IsSpace(*p)))
+        {
+          this->Failed = true;
+          return;
+        }
+      }
+    }
+  }
+};
+
+// Parse at most numValues numbers of [begin, end), in parallel when the
+// block is large enough, see ParseSerial().
+template <typename T>
+vtkIdType ParseBlock(
+  const char* begin, const char* end, T* values, vtkIdType numValues, const char*& last)
+{
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  const vtkIdType numChunks = std::min<vtkIdType>(4 * numThreads, (end - begin) / ChunkSize);
+  if (numThreads < 2 || numChunks < 2)
+  {
+    return ParseSerial(begin, end, values, numValues, last);
+  }
+
+  // Split the block on white space.
+  std::vector<const char*> bounds(numChunks + 1);
+  bounds[0] = begin;
+  bounds[numChunks] = end;
+  for (vtkIdType chunk = 1; chunk < numChunks; ++chunk)
+  {
+    const char* p = std::max(begin + (end - begin) * chunk / numChunks, bounds[chunk - 1]);
+    while (p != end && !IsSpace(*p))
+    {
+      ++p;
+    }
+    bounds[chunk] = p;
+  }
+
+  std::vector<vtkIdType> offsets(numChunks + 1, 0);
+  CountFunctor count;
+  count.Bounds = bounds.data();
+  count.Counts = offsets.data() + 1;
+  vtkSMPTools::For(0, numChunks, 1, count);
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  ParseFunctor<T> parse;
+  parse.Bounds = bounds.data();
+  parse.Offsets = offsets.data();
+  parse.Values = values;
+  parse.NumberOfValues = numValues;
+  vtkSMPTools::For(0, numChunks, 1, parse);
+  if (parse.Failed)
+  {
+    return -1;
+  }
+  if (offsets[numChunks] < numValues)
+  {
+    last = end;
+    return offsets[numChunks];
+  }
+  last = parse.Last;
+  return numValues;
+}
+
+//------------------------------------------------------------------------------
+// Read the numbers one at a time, for the streams that cannot seek.
+template <typename T>
+bool ReadTokens(std::istream& stream, T* values, vtkIdType numValues)
+{
+  std::string token;
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    if (!(stream >> token))
+    {
+      return false;
+    }
+    const char* end = token.data() + token.size();
+    if (vtkStringToNumber::Parse(token.data(), end, values[i]) != end)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool ReadStream(std::istream& stream, T* values, vtkIdType numValues)
+{
+  std::vector<char> buffer;
+  vtkIdType done = 0;
+  while (done < numValues)
+  {
+    const std::streampos start = stream.tellg();
+    if (start == std::streampos(-1))
+    {
+      return ReadTokens(stream, values + done, numValues - done);
+    }
+
+    // Read a block sized for the numbers left, without splitting the last
+    // number unless the stream ends there.
+    const std::streamsize size = std::min(
+      BlockSize, std::max(ChunkSize, static_cast<std::streamsize>(32 * (numValues - done))));
+    buffer.resize(static_cast<size_t>(size));
+    stream.read(buffer.data(), size);
+    const std::streamsize count = stream.gcount();
+    const bool atEnd = count < size;
+    std::streamsize length = count;
+    if (!atEnd)
+    {
+      while (length > 0 && !IsSpace(buffer[length - 1]))
+      {
+        --length;
+      }
+    }
+    stream.clear();
+    if (length == 0)
+    {
+      stream.seekg(start);
+      stream.setstate(std::ios::failbit);
+      return false;
+    }
+
+    const char* last = nullptr;
+    const vtkIdType parsed =
+      ParseBlock(buffer.data(), buffer.data() + length, values + done, numValues - done, last);
+    if (parsed < 0)
+    {
+      stream.seekg(start);
+      stream.setstate(std::ios::failbit);
+      return false;
+    }
+    done += parsed;
+
+    // Go back to the end of the last number if the block holds more.
+    const std::streamoff consumed = done == numValues ? last - buffer.data() : length;
+    stream.seekg(start + consumed);
+    if (done < numValues && atEnd)
+    {
+      stream.setstate(std::ios::failbit);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, char& value)
+{
+  return ParseChar(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, signed char& value)
+{
+  return ParseChar(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, unsigned char& value)
+{
+  return ParseChar(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, short& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, unsigned short& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, int& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, unsigned int& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, long& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, unsigned long& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, long long& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(
+  const char* begin, const char* end, unsigned long long& value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, float& value)
+{
+  return ParseFloat(begin, end, value, false);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::Parse(const char* begin, const char* end, double& value)
+{
+  return ParseFloat(begin, end, value, false);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::ParseLikeStrtod(const char* begin, const char* end, float& value)
+{
+  return ParseFloat(begin, end, value, true);
+}
+
+//------------------------------------------------------------------------------
+const char* vtkStringToNumber::ParseLikeStrtod(const char* begin, const char* end, double& value)
+{
+  return ParseFloat(begin, end, value, true);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, char* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, signed char* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(
+  std::istream& stream, unsigned char* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, short* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(
+  std::istream& stream, unsigned short* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, int* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, unsigned int* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, long* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(
+  std::istream& stream, unsigned long* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, long long* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(
+  std::istream& stream, unsigned long long* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, float* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+bool vtkStringToNumber::ReadValues(std::istream& stream, double* values, vtkIdType numValues)
+{
+  return ReadStream(stream, values, numValues);
+}
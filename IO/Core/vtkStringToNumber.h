@@ -0,0 +1,120 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStringToNumber.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkStringToNumber
+ * @brief Convert strings to integral and floating point numbers
+ *
+ * This class parses the numbers of ASCII files faster than operator>> on a
+ * stream or the C library functions, and independently of the locale.
+ * Parse() and ReadValues() accept the same numbers as operator>>.
+ * Floating point numbers are parsed with the double-conversion library, so
+ * they are correctly rounded like with operator>>. Integral numbers are
+ * decimal, with an optional sign. Numbers out of the range of their type,
+ * hexadecimal numbers, "nan" and "inf" are not accepted.
+ *
+ * ParseLikeStrtod() accepts the floating point numbers that strtod()
+ * accepts in the "C" locale instead: they may also be hexadecimal, "inf",
+ * "infinity" or "nan" in any case, and values out of range are converted to
+ * infinity.
+ *
+ * The char types hold small integers in VTK files, so they are parsed as
+ * int values and converted, not as characters.
+ *
+ * ReadValues() reads many numbers from a stream, as successive calls to
+ * operator>> would. The stream is read by large blocks, which are parsed in
+ * parallel with vtkSMPTools.
+ *
+ * Typical use:
+ *
+ * @code{cpp}
+ *  #include "vtkStringToNumber.h"
+ *  const char* line = "1.5 -2 3e4";
+ *  const char* end = line + strlen(line);
+ *  double xyz[3];
+ *  for (int i = 0; i < 3 && line; ++i)
+ *  {
+ *    line = vtkStringToNumber::Parse(line, end, xyz[i]);
+ *  }
+ * @endcode
+ *
+ * @sa
+ * vtkNumberToString
+ */
+#ifndef vtkStringToNumber_h
+#define vtkStringToNumber_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkType.h"         // For vtkIdType
+
+#include <istream> // For istream
+
+class VTKIOCORE_EXPORT vtkStringToNumber
+{
+public:
+  //@{
+  /**
+   * Parse the number starting at @a begin, after any white space, and
+   * ending at @a end at the latest. Return a pointer past the last
+   * character of the number, or nullptr if there is no number to parse.
+   * @a value is only set on success.
+   */
+  static const char* Parse(const char* begin, const char* end, char& value);
+  static const char* Parse(const char* begin, const char* end, signed char& value);
+  static const char* Parse(const char* begin, const char* end, unsigned char& value);
+  static const char* Parse(const char* begin, const char* end, short& value);
+  static const char* Parse(const char* begin, const char* end, unsigned short& value);
+  static const char* Parse(const char* begin, const char* end, int& value);
+  static const char* Parse(const char* begin, const char* end, unsigned int& value);
+  static const char* Parse(const char* begin, const char* end, long& value);
+  static const char* Parse(const char* begin, const char* end, unsigned long& value);
+  static const char* Parse(const char* begin, const char* end, long long& value);
+  static const char* Parse(const char* begin, const char* end, unsigned long long& value);
+  static const char* Parse(const char* begin, const char* end, float& value);
+  static const char* Parse(const char* begin, const char* end, double& value);
+  //@}
+
+  //@{
+  /**
+   * Like Parse(), but accept the numbers that strtod() accepts, for the
+   * readers of formats that used it.
+   */
+  static const char* ParseLikeStrtod(const char* begin, const char* end, float& value);
+  static const char* ParseLikeStrtod(const char* begin, const char* end, double& value);
+  //@}
+
+  //@{
+  /**
+   * Read @a numValues white space separated numbers from @a stream into
+   * @a values. The stream is left after the last number read. Return false
+   * if fewer numbers could be read, or if a number cannot be parsed.
+   */
+  static bool ReadValues(std::istream& stream, char* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, signed char* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, unsigned char* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, short* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, unsigned short* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, int* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, unsigned int* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, long* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, unsigned long* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, long long* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, unsigned long long* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, float* values, vtkIdType numValues);
+  static bool ReadValues(std::istream& stream, double* values, vtkIdType numValues);
+  //@}
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkStringToNumber.h
@@ -52,6 +52,11 @@ public:
   void SetCompressionLevel(int compressionLevel) override;
   //@}
 
+  /**
+   * The compression and decompression do not modify the compressor.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkZLibDataCompressor();
   ~vtkZLibDataCompressor() override;
@@ -21,8 +21,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkStringToNumber.h"
 #include <cctype>
-#include <sstream>
 #include <unordered_map>
 #include <vtksys/SystemTools.hxx>
 
@@ -31,6 +31,64 @@
 
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace
+{
+// Parse the values of a 'v', 'vn' or 'vt' line like operator>> on a stream
+// would: the first value that cannot be parsed is set to 0, and the
+// following ones are left unchanged.
+void ParseValues(const char* begin, const char* end, float* values, int numValues)
+{
+  for (int i = 0; i < numValues; ++i)
+  {
+    begin = vtkStringToNumber::Parse(begin, end, values[i]);
+    if (!begin)
+    {
+      values[i] = 0;
+      return;
+    }
+  }
+}
+
+// The forms of a vertex of a 'p', 'l' or 'f' line.
+enum VertexForm
+{
+  NoVertex,
+  VertexOnly,         // v
+  VertexTCoord,       // v/vt
+  VertexNormal,       // v//vn
+  VertexTCoordNormal, // v/vt/vn
+};
+
+// Parse a vertex like sscanf() would with the formats "%d/%d/%d", "%d//%d",
+// "%d/%d" and "%d", tried in this order, and return the form found.
+VertexForm ParseVertex(const char* begin, const char* end, int& vertex, int& tcoord, int& normal)
+{
+  begin = vtkStringToNumber::Parse(begin, end, vertex);
+  if (!begin)
+  {
+    return NoVertex;
+  }
+  if (begin == end || *begin != '/')
+  {
+    return VertexOnly;
+  }
+  if (++begin != end && *begin == '/')
+  {
+    return vtkStringToNumber::Parse(begin + 1, end, normal) ? VertexNormal : VertexOnly;
+  }
+  begin = vtkStringToNumber::Parse(begin, end, tcoord);
+  if (!begin)
+  {
+    return VertexOnly;
+  }
+  if (begin == end || *begin != '/')
+  {
+    return VertexTCoord;
+  }
+  return vtkStringToNumber::Parse(begin + 1, end, normal) ? VertexTCoordNormal : VertexTCoord;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkOBJReader::vtkOBJReader()
 {
@@ -263,19 +321,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       else if (strcmp(cmd, "vt") == 0)
       {
         // this is a tcoord, expect two floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1];
-          verticesTextureList.emplace_back(xyz[0], xyz[1]);
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'vt' at line " << lineNr);
-        }
+        ParseValues(pLine, pEnd, xyz, 2);
+        verticesTextureList.emplace_back(xyz[0], xyz[1]);
       }
     } // (end of first while loop)
 
@@ -354,21 +401,9 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       else if (strcmp(cmd, "v") == 0)
       {
         // vertex definition, expect three floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1] >> xyz[2];
-          points->InsertNextPoint(xyz);
-          numPoints++;
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'v' at line " << lineNr);
-          everything_ok = false;
-        }
+        ParseValues(pLine, pEnd, xyz, 3);
+        points->InsertNextPoint(xyz);
+        numPoints++;
       }
       else if (strcmp(cmd, "usemtl") == 0)
       {
@@ -395,22 +430,10 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       else if (strcmp(cmd, "vn") == 0)
       {
         // vertex normal, expect three floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1] >> xyz[2];
-          normals->InsertNextTuple(xyz);
-          hasNormals = true;
-          numNormals++;
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'vn' at line " << lineNr);
-          everything_ok = false;
-        }
+        ParseValues(pLine, pEnd, xyz, 3);
+        normals->InsertNextTuple(xyz);
+        hasNormals = true;
+        numNormals++;
       }
       else if (strcmp(cmd, "p") == 0)
       {
@@ -429,8 +452,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
           if (pLine < pEnd) // there is still data left on this line
           {
-            int iVert;
-            if (sscanf(pLine, "%d", &iVert) == 1)
+            int iVert, dummyInt;
+            if (ParseVertex(pLine, pEnd, iVert, dummyInt, dummyInt) != NoVertex)
             {
               if (iVert < 0)
               {
@@ -463,7 +486,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
               vtkErrorMacro(<< "Error reading 'p' at line " << lineNr);
               everything_ok = false;
             }
-            // skip over what we just sscanf'd
+            // skip over what we just parsed
             // (find the first whitespace character)
             while (!isspace(*pLine) && pLine < pEnd)
             {
@@ -500,7 +523,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
           if (pLine < pEnd) // there is still data left on this line
           {
             int iVert, dummyInt;
-            if (sscanf(pLine, "%d/%d", &iVert, &dummyInt) == 2)
+            const VertexForm form = ParseVertex(pLine, pEnd, iVert, dummyInt, dummyInt);
+            if (form == VertexTCoord || form == VertexTCoordNormal)
             {
               // we simply ignore texture information
               if (iVert < 0)
@@ -513,7 +537,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
               }
               nVerts++;
             }
-            else if (sscanf(pLine, "%d", &iVert) == 1)
+            else if (form != NoVertex)
             {
               if (iVert < 0)
               {
@@ -546,7 +570,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
               vtkErrorMacro(<< "Error reading 'l' at line " << lineNr);
               everything_ok = false;
             }
-            // skip over what we just sscanf'd
+            // skip over what we just parsed
             // (find the first whitespace character)
             while (!isspace(*pLine) && pLine < pEnd)
             {
@@ -586,7 +610,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
           if (pLine < pEnd) // there is still data left on this line
           {
             int iVert, iTCoord, iNormal;
-            if (sscanf(pLine, "%d/%d/%d", &iVert, &iTCoord, &iNormal) == 3)
+            const VertexForm form = ParseVertex(pLine, pEnd, iVert, iTCoord, iNormal);
+            if (form == VertexTCoordNormal)
             {
               if (iVert < 0)
               {
@@ -630,7 +655,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
                 normals_same_as_verts = false;
               }
             }
-            else if (sscanf(pLine, "%d//%d", &iVert, &iNormal) == 2)
+            else if (form == VertexNormal)
             {
               if (iVert < 0)
               {
@@ -655,7 +680,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
               if (iNormal != iVert)
                 normals_same_as_verts = false;
             }
-            else if (sscanf(pLine, "%d/%d", &iVert, &iTCoord) == 2)
+            else if (form == VertexTCoord)
             {
               if (iVert < 0)
               {
@@ -683,7 +708,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
                 tcoords_same_as_verts = false;
               }
             }
-            else if (sscanf(pLine, "%d", &iVert) == 1)
+            else if (form == VertexOnly)
             {
               if (iVert < 0)
               {
@@ -28,6 +28,7 @@
 #include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringToNumber.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
@@ -369,21 +370,20 @@ inline std::string stlParseExpected(const std::string& expected, const std::stri
 // Get three space-delimited floats from string.
 bool stlReadVertex(char* buf, float vertCoord[3])
 {
-  char* begptr = buf;
-  char* endptr = nullptr;
+  const char* begptr = buf;
+  const char* endptr = buf + strlen(buf);
 
   for (int i = 0; i < 3; ++i)
   {
-    // We really should use: vertCoord[i] = std::strtof(begptr, &endptr);
-    // instead of strtod below but Apple Clang 9.0.0.9000039 doesn't
-    // recognize strtof as part of the C++11 standard
-    vertCoord[i] = static_cast<float>(std::strtod(begptr, &endptr));
-    if (begptr == endptr)
+    // Parse as double then convert, so the coordinates are rounded like
+    // with std::strtod, but independently of the locale.
+    double coord;
+    begptr = vtkStringToNumber::ParseLikeStrtod(begptr, endptr, coord);
+    if (!begptr)
     {
       return false;
     }
-
-    begptr = endptr;
+    vertCoord[i] = static_cast<float>(coord);
   }
 
   return true;
@@ -48,6 +48,7 @@
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
+#include "vtkStringToNumber.h"
 #include "vtkTable.h"
 #include "vtkTypeInt64Array.h"
 #include "vtkTypeUInt64Array.h"
@@ -1494,19 +1495,11 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
-  vtkIdType i, j;
-
-  for (i = 0; i < numTuples; i++)
+  if (!vtkStringToNumber::ReadValues(*self->GetIStream(), data, numTuples * numComp))
   {
-    for (j = 0; j < numComp; j++)
-    {
-      if (!self->Read(data++))
-      {
-        vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
-                                  "datasize with declaration.");
-        return 0;
-      }
-    }
+    vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
+                              "datasize with declaration.");
+    return 0;
   }
   return 1;
 }
@@ -3205,7 +3198,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3223,15 +3215,12 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    if (!vtkStringToNumber::ReadValues(*this->IS, data, size))
     {
-      if (!this->Read(data + i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<< "Error reading ascii cell data!"
-                      << " for file: " << (fname ? fname : "(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
     }
   }
 
@@ -3297,6 +3286,17 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data, int skip1, int rea
       --read2;
     }
   }
+  else if (skip1 == 0 && skip3 == 0)
+  {
+    // The piece holds all the cells, which are read at once.
+    if (!vtkStringToNumber::ReadValues(*this->IS, data, size))
+    {
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
+    }
+  }
   else // ascii
   {
     // skip cells before the piece
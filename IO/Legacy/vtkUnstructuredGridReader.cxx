@@ -21,6 +21,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringToNumber.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkUpdateCellsV8toV9.h"
 
@@ -249,14 +250,11 @@ int vtkUnstructuredGridReader::ReadMeshSimple(const std::string& fname, vtkDataO
             }
           }
           // read types for piece
-          for (i = 0; i < read2; i++)
+          if (!vtkStringToNumber::ReadValues(*this->GetIStream(), types, read2))
           {
-            if (!this->Read(types + i))
-            {
-              vtkErrorMacro(<< "Error reading cell types!");
-              this->CloseVTKFile();
-              return 1;
-            }
+            vtkErrorMacro(<< "Error reading cell types!");
+            this->CloseVTKFile();
+            return 1;
           }
           // skip types after piece
           for (i = 0; i < skip3; i++)
@@ -50,6 +50,7 @@ WARRANTY OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.
 #include "vtkByteSwap.h"
 #include "vtkHeap.h"
 #include "vtkMath.h"
+#include "vtkStringToNumber.h"
 #include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
@@ -2507,6 +2508,9 @@ Exit:
 void vtkPLY::get_ascii_item(
   const char* word, int type, int* int_val, unsigned int* uint_val, double* double_val)
 {
+  // The words are parsed without the locale, and 0 is stored when a word is
+  // not a number, like atoi() and atof() would.
+  const char* end = word + strlen(word);
   switch (type)
   {
     case PLY_CHAR:
@@ -2519,14 +2523,20 @@ void vtkPLY::get_ascii_item(
     case PLY_UINT16:
     case PLY_INT:
     case PLY_INT32:
-      *int_val = atoi(word);
+      if (!vtkStringToNumber::Parse(word, end, *int_val))
+      {
+        *int_val = 0;
+      }
       *uint_val = *int_val;
       *double_val = *int_val;
       break;
 
     case PLY_UINT:
     case PLY_UINT32:
-      *uint_val = strtoul(word, nullptr, 10);
+      if (!vtkStringToNumber::Parse(word, end, *uint_val))
+      {
+        *uint_val = 0;
+      }
       *int_val = *uint_val;
       *double_val = *uint_val;
       break;
@@ -2535,7 +2545,10 @@ void vtkPLY::get_ascii_item(
     case PLY_FLOAT32:
     case PLY_DOUBLE:
     case PLY_FLOAT64:
-      *double_val = atof(word);
+      if (!vtkStringToNumber::ParseLikeStrtod(word, end, *double_val))
+      {
+        *double_val = 0;
+      }
       *int_val = (int)*double_val;
       *uint_val = (unsigned int)*double_val;
       break;
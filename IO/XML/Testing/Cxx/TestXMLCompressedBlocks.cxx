@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressedBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that compressed XML data are read back whole and in part, for one
+// or many blocks, with or without a short last block.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+// The writer uses blocks of 8 doubles.
+const size_t BlockSize = 64;
+
+double Expected(vtkIdType i)
+{
+  return 0.25 * static_cast<double>((i * 37) % 101);
+}
+
+// Read the point values of the extent [first, last] along x, and check them.
+bool CheckRead(const std::string& fileName, int first, int last)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  int extent[6] = { first, last, 0, 0, 0, 0 };
+  // vtkXMLReader hides vtkAlgorithm::UpdateExtent() with a member.
+  reader->vtkAlgorithm::UpdateExtent(extent);
+  vtkDataArray* values = reader->GetOutput()->GetPointData()->GetArray("values");
+  if (!values || values->GetNumberOfTuples() != last - first + 1)
+  {
+    std::cerr << "Missing values reading [" << first << ", " << last << "] of " << fileName
+              << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    if (values->GetTuple1(i) != Expected(first + i))
+    {
+      std::cerr << "Wrong value " << values->GetTuple1(i) << " at " << first + i
+                << " reading [" << first << ", " << last << "] of " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLCompressedBlocks(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestXMLCompressedBlocks";
+  delete[] tempDir;
+
+  // One full block, a short last block, several full blocks, and enough
+  // blocks to be decompressed by several threads with a short last block.
+  const int numbersOfPoints[] = { 8, 13, 56, 1001 };
+  for (int numPoints : numbersOfPoints)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(numPoints, 1, 1);
+    vtkNew<vtkDoubleArray> values;
+    values->SetName("values");
+    values->SetNumberOfTuples(numPoints);
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      values->SetValue(i, Expected(i));
+    }
+    image->GetPointData()->AddArray(values);
+
+    for (int compressor = 0; compressor < 2; ++compressor)
+    {
+      for (int encode = 0; encode < 2; ++encode)
+      {
+        const std::string fileName = prefix + std::to_string(numPoints) + "_" +
+          std::to_string(compressor) + std::to_string(encode) + ".vti";
+        vtkNew<vtkXMLImageDataWriter> writer;
+        writer->SetInputData(image);
+        writer->SetFileName(fileName.c_str());
+        writer->SetBlockSize(BlockSize);
+        if (compressor)
+        {
+          writer->SetCompressorTypeToLZ4();
+        }
+        else
+        {
+          writer->SetCompressorTypeToZLib();
+        }
+        writer->SetEncodeAppendedData(encode);
+        if (!writer->Write())
+        {
+          std::cerr << "Writing " << fileName << " failed" << std::endl;
+          return EXIT_FAILURE;
+        }
+
+        // The whole data, then parts starting and ending inside blocks.
+        if (!CheckRead(fileName, 0, numPoints - 1) || !CheckRead(fileName, 3, numPoints - 4) ||
+          !CheckRead(fileName, 1, 2) || !CheckRead(fileName, numPoints - 2, numPoints - 1))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMappedArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkXMLReader::MemoryMapAppendedData maps the arrays of raw
+// appended data, and that the arrays read with and without it are equal.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 1000;
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / a->GetNumberOfComponents(), i % a->GetNumberOfComponents()) !=
+      b->GetComponent(i / b->GetNumberOfComponents(), i % b->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameData(vtkPolyData* a, vtkPolyData* b)
+{
+  const char* names[] = { "uchar", "int", "double" };
+  for (const char* name : names)
+  {
+    if (!SameArrays(a->GetPointData()->GetArray(name), b->GetPointData()->GetArray(name)))
+    {
+      std::cerr << "Wrong values in array " << name << std::endl;
+      return false;
+    }
+  }
+  if (!SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()))
+  {
+    std::cerr << "Wrong points" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool IsMapped(vtkDataArray* array)
+{
+  if (auto uchars = vtkArrayDownCast<vtkUnsignedCharArray>(array))
+  {
+    return uchars->GetMemoryMap() != nullptr;
+  }
+  if (auto ints = vtkArrayDownCast<vtkIntArray>(array))
+  {
+    return ints->GetMemoryMap() != nullptr;
+  }
+  if (auto floats = vtkArrayDownCast<vtkFloatArray>(array))
+  {
+    return floats->GetMemoryMap() != nullptr;
+  }
+  if (auto doubles = vtkArrayDownCast<vtkDoubleArray>(array))
+  {
+    return doubles->GetMemoryMap() != nullptr;
+  }
+  return false;
+}
+
+// Return the number of arrays of data, including the points, that are
+// memory mapped.
+int GetNumberOfMappedArrays(vtkPolyData* data)
+{
+  int count = IsMapped(data->GetPoints()->GetData()) ? 1 : 0;
+  for (int i = 0; i < data->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    count += IsMapped(data->GetPointData()->GetArray(i)) ? 1 : 0;
+  }
+  return count;
+}
+}
+
+int TestXMLMemoryMappedArrays(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string rawFileName = std::string(tempDir) + "/TestXMLMemoryMappedArrays.vtp";
+  const std::string compressedFileName =
+    std::string(tempDir) + "/TestXMLMemoryMappedArraysCompressed.vtp";
+  const std::string unalignedFileName =
+    std::string(tempDir) + "/TestXMLMemoryMappedArraysUnaligned.vtp";
+  delete[] tempDir;
+
+  vtkNew<vtkPolyData> input;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkUnsignedCharArray> uchars;
+  uchars->SetName("uchar");
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("int");
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("double");
+  doubles->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i, 0.5 * i, -0.25 * i);
+    uchars->InsertNextValue(static_cast<unsigned char>(i % 251));
+    ints->InsertNextValue(static_cast<int>(i * 7919 - 40000));
+    doubles->InsertNextTuple2(i / 3.0, -i / 7.0);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(uchars);
+  input->GetPointData()->AddArray(ints);
+  input->GetPointData()->AddArray(doubles);
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetInputData(input);
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  writer->SetFileName(unalignedFileName.c_str());
+  writer->Write();
+  writer->AlignAppendedDataOn();
+  writer->SetFileName(rawFileName.c_str());
+  writer->Write();
+  writer->SetCompressorTypeToZLib();
+  writer->SetFileName(compressedFileName.c_str());
+  writer->Write();
+
+  // The arrays are read unless mapping is requested.
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(rawFileName.c_str());
+  reader->Update();
+  if (!SameData(input, reader->GetOutput()) || GetNumberOfMappedArrays(reader->GetOutput()) != 0)
+  {
+    std::cerr << "Reading without memory maps failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The writer aligned the raw values, so all the arrays are mapped,
+  // including the float points and the double values.
+  vtkNew<vtkXMLPolyDataReader> mappedReader;
+  mappedReader->MemoryMapAppendedDataOn();
+  mappedReader->SetFileName(rawFileName.c_str());
+  mappedReader->Update();
+  vtkPolyData* mapped = mappedReader->GetOutput();
+  if (!SameData(input, mapped) || GetNumberOfMappedArrays(mapped) != 4)
+  {
+    std::cerr << "Reading with memory maps failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Changes to mapped values are private to the output.
+  vtkUnsignedCharArray::SafeDownCast(mapped->GetPointData()->GetArray("uchar"))->SetValue(0, 255);
+  reader->Modified();
+  reader->Update();
+  if (!SameData(input, reader->GetOutput()))
+  {
+    std::cerr << "Changes to mapped values were written to the file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Unaligned arrays are read instead.
+  mappedReader->SetFileName(unalignedFileName.c_str());
+  mappedReader->Update();
+  if (!SameData(input, mappedReader->GetOutput()))
+  {
+    std::cerr << "Reading unaligned data with memory maps failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Compressed arrays cannot be mapped.
+  mappedReader->SetFileName(compressedFileName.c_str());
+  mappedReader->Update();
+  if (!SameData(input, mappedReader->GetOutput()) ||
+    GetNumberOfMappedArrays(mappedReader->GetOutput()) != 0)
+  {
+    std::cerr << "Reading compressed data with memory maps failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -482,6 +482,7 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
     return nullptr;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapAppendedData(this->MemoryMapAppendedData);
   reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
   reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
   reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
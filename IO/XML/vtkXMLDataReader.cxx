@@ -278,7 +278,7 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
         {
-          array->SetNumberOfTuples(pointTuples);
+          this->SetNumberOfOutputTuples(array, pointTuples);
           pointData->AddArray(array);
           array->Delete();
         }
@@ -306,7 +306,7 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
         {
-          array->SetNumberOfTuples(cellTuples);
+          this->SetNumberOfOutputTuples(array, cellTuples);
           cellData->AddArray(array);
           array->Delete();
         }
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkXMLReader.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkCallbackCommand.h"
 #include "vtkDataArray.h"
@@ -138,6 +139,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapAppendedData = 0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -233,6 +235,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "MemoryMapAppendedData: " << this->MemoryMapAppendedData << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -694,6 +697,7 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
 
     // Let the subclasses read the data they want.
     this->ReadXMLData();
+    this->AllocateDeferredArrays();
 
     // If we aborted or there was an error, provide empty output.
     if (this->DataError || this->AbortExecute)
@@ -856,6 +860,20 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
   return result;
 }
 
+//------------------------------------------------------------------------------
+template <class ValueType>
+int vtkXMLReaderMapArrayValues(
+  vtkAbstractArray* array, const char* fileName, vtkTypeInt64 position, vtkIdType numTuples)
+{
+  vtkAOSDataArrayTemplate<ValueType>* aos = vtkAOSDataArrayTemplate<ValueType>::FastDownCast(array);
+  // Values that are not aligned in the file would not be aligned in memory.
+  if (!aos || position % alignof(ValueType) != 0)
+  {
+    return 0;
+  }
+  return aos->MapFile(fileName, numTuples, position) ? 1 : 0;
+}
+
 }
 
 //------------------------------------------------------------------------------
@@ -868,24 +886,45 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
     return 0;
   }
   this->InReadData = 1;
-  int result;
-  vtkArrayIterator* iter = array->NewIterator();
-  if (arrayIndex + numValues > array->GetNumberOfValues())
-  {
-    vtkErrorMacro("Array has " << array->GetNumberOfValues() << " allocated elements, but "
-                               << arrayIndex + numValues << " were requested to be read");
-    return 0;
+  int result = 0;
+  auto deferred = this->DeferredArrays.find(array);
+  if (deferred != this->DeferredArrays.end())
+  {
+    // Allocate the array only if its values cannot be mapped.
+    const vtkIdType numTuples = deferred->second;
+    this->DeferredArrays.erase(deferred);
+    result = arrayIndex == 0 && this->MapArrayValues(da, array, startIndex, numValues, numTuples);
+    if (!result)
+    {
+      array->SetNumberOfTuples(numTuples);
+    }
   }
-  switch (array->GetDataType())
+  else if (this->MemoryMapAppendedData && arrayIndex == 0)
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = this->MapArrayValues(da, array, startIndex, numValues, array->GetNumberOfTuples());
   }
-  if (iter)
+  if (!result)
   {
-    iter->Delete();
+    if (arrayIndex + numValues > array->GetNumberOfValues())
+    {
+      vtkErrorMacro("Array has " << array->GetNumberOfValues() << " allocated elements, but "
+                                 << arrayIndex + numValues << " were requested to be read");
+      this->InReadData = 0;
+      return 0;
+    }
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+                                      arrayIndex, static_cast<VTK_TT*>(iter), startIndex,
+                                      numValues));
+      default:
+        result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
@@ -901,6 +940,59 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array,
+  vtkIdType startIndex, vtkIdType numValues, vtkIdType numTuples)
+{
+  // Only files opened by this reader can be mapped, and only whole arrays.
+  if (!this->FileName || this->ReadFromInputString || this->Stream != this->FileStream ||
+    array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate || numValues <= 0 ||
+    numValues != numTuples * array->GetNumberOfComponents() || !da->GetAttribute("offset"))
+  {
+    return 0;
+  }
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkTypeInt64 position = this->XMLParser->GetAppendedDataFilePosition(
+    offset, startIndex, numValues, array->GetDataType());
+  if (position < 0)
+  {
+    return 0;
+  }
+
+  int result = 0;
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro(
+      result = vtkXMLReaderMapArrayValues<VTK_TT>(array, this->FileName, position, numTuples));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLReader::SetNumberOfOutputTuples(vtkAbstractArray* array, vtkIdType numTuples)
+{
+  if (this->MemoryMapAppendedData && this->FileName && !this->ReadFromInputString &&
+    array->GetArrayType() == vtkAbstractArray::AoSDataArrayTemplate && numTuples > 0)
+  {
+    this->DeferredArrays[array] = numTuples;
+  }
+  else
+  {
+    array->SetNumberOfTuples(numTuples);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLReader::AllocateDeferredArrays()
+{
+  for (const auto& deferred : this->DeferredArrays)
+  {
+    deferred.first->SetNumberOfTuples(deferred.second);
+  }
+  this->DeferredArrays.clear();
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLReader::ReadXMLData()
 {
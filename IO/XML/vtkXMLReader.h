@@ -27,6 +27,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkIOXMLModule.h" // For export macro
 
+#include <map>    // for std::map
 #include <string> // for std::string
 #include <vector>
 
@@ -182,6 +183,24 @@ public:
   vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  //@{
+  /**
+   * If true, the arrays stored uncompressed in a raw appended data section,
+   * in the byte order of this machine, are memory mapped from the file
+   * rather than read, see vtkAOSDataArrayTemplate::MapFile(). Their values
+   * are then only loaded from the file when they are accessed, and changes
+   * to them are private to the output. This only applies to the arrays read
+   * whole from a file given by FileName, and whose values are aligned in the
+   * file, see vtkXMLWriter::SetAlignAppendedData(); the other arrays are
+   * read as usual.
+   * Mapped arrays are not allocated beforehand. The file must not be
+   * modified while the output is in use. Default is false.
+   */
+  vtkSetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkGetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkBooleanMacro(MemoryMapAppendedData, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Set/get the ErrorObserver for the internal reader
@@ -292,11 +311,27 @@ protected:
 
   // Read an Array values starting at the given index and up to numValues.
   // This method assumes that the array is of correct size to
-  // accommodate all numValues values. arrayIndex is the value index at which the read
+  // accommodate all numValues values, or that its allocation was deferred
+  // by SetNumberOfOutputTuples(). arrayIndex is the value index at which the read
   // values will be put in the array.
   virtual int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  // Memory map the numValues values of the array starting at the given
+  // index in the appended data, if they are all the numTuples tuples of
+  // the array and can be used without decoding them. Returns 0 if they
+  // must be read.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array, vtkIdType startIndex,
+    vtkIdType numValues, vtkIdType numTuples);
+
+  // Set the number of tuples of an array created for the output. When its
+  // values may be memory mapped, the allocation is deferred until they are
+  // read, and only done if mapping them fails.
+  void SetNumberOfOutputTuples(vtkAbstractArray* array, vtkIdType numTuples);
+
+  // Allocate the arrays whose allocation is deferred, and that were not read.
+  void AllocateDeferredArrays();
+
   // Setup the data array selections for the input's set of arrays.
   void SetDataArraySelections(vtkXMLDataElement* eDSA, vtkDataArraySelection* sel);
 
@@ -334,6 +369,13 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether the raw appended arrays are memory mapped rather than read.
+  vtkTypeBool MemoryMapAppendedData;
+
+  // The output arrays whose allocation is deferred, with their number of
+  // tuples.
+  std::map<vtkAbstractArray*, vtkIdType> DeferredArrays;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
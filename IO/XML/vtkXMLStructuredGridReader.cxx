@@ -138,7 +138,7 @@ void vtkXMLStructuredGridReader::SetupOutputData()
     if (a)
     {
       // Allocate the points array.
-      a->SetNumberOfTuples(this->GetNumberOfPoints());
+      this->SetNumberOfOutputTuples(a, this->GetNumberOfPoints());
       points->SetData(a);
       a->Delete();
     }
@@ -341,7 +341,7 @@ void vtkXMLUnstructuredDataReader::SetupOutputData()
     if (a)
     {
       // Allocate the points array.
-      a->SetNumberOfTuples(this->GetNumberOfPoints());
+      this->SetNumberOfOutputTuples(a, this->GetNumberOfPoints());
       points->SetData(a);
       a->Delete();
     }
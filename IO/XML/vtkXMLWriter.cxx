@@ -45,6 +45,8 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -65,9 +67,11 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -103,9 +107,39 @@ public:
   }
 };
 
+//*****************************************************************************
+// Uncompressed blocks of the array being written, kept back to back until
+// they are compressed together.
+class vtkXMLWriterCompressionBatch
+{
+public:
+  std::vector<unsigned char> Data;
+  std::vector<size_t> Sizes;
+  size_t MaximumNumberOfBlocks = 1;
+};
+
 namespace
 {
 
+// Compress the blocks [begin, end) of a batch, each one independently.
+struct CompressBlocksFunctor
+{
+  vtkDataCompressor* Compressor;
+  const unsigned char* Data;
+  const size_t* Offsets;
+  const size_t* Sizes;
+  vtkSmartPointer<vtkUnsignedCharArray>* Outputs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Outputs[i].TakeReference(
+        this->Compressor->Compress(this->Data + this->Offsets[i], this->Sizes[i]));
+    }
+  }
+};
+
 struct WriteBinaryDataBlockWorker
 {
   vtkXMLWriter* Writer;
@@ -473,10 +507,12 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; // 2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = nullptr;
+  this->CompressionBatch = new vtkXMLWriterCompressionBatch;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
   this->EncodeAppendedData = 1;
+  this->AlignAppendedData = 0;
   this->AppendedDataPosition = 0;
   this->DataMode = vtkXMLWriter::Appended;
   this->ProgressRange[0] = 0;
@@ -509,6 +545,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBatch;
 }
 
 //------------------------------------------------------------------------------
@@ -619,6 +656,7 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Compressor: (none)\n";
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
+  os << indent << "AlignAppendedData: " << this->AlignAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
   if (this->Stream)
   {
@@ -1310,6 +1348,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the remaining blocks.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1666,32 +1710,86 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
 
+  // Compress a few blocks per thread at once.
+  size_t maxBlocks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  this->CompressionBatch->MaximumNumberOfBlocks =
+    std::max(static_cast<size_t>(1), std::min(numBlocks, maxBlocks));
+  this->CompressionBatch->Data.clear();
+  this->CompressionBatch->Sizes.clear();
+
   return result;
 }
 
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  // The blocks are compressed independently, so a batch of them is
+  // compressed in parallel and then written in order, which gives the same
+  // output as compressing them one at a time.
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  batch->Data.insert(batch->Data.end(), data, data + size);
+  batch->Sizes.push_back(size);
+  if (batch->Sizes.size() < batch->MaximumNumberOfBlocks)
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  const size_t numBlocks = batch->Sizes.size();
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
+
   // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  std::vector<size_t> offsets(numBlocks, 0);
+  for (size_t i = 1; i < numBlocks; ++i)
+  {
+    offsets[i] = offsets[i - 1] + batch->Sizes[i - 1];
+  }
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> outputArrays(numBlocks);
+  CompressBlocksFunctor compress = { this->Compressor, batch->Data.data(), offsets.data(),
+    batch->Sizes.data(), outputArrays.data() };
+  if (this->Compressor->IsThreadSafe())
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, compress);
+  }
+  else
+  {
+    compress(0, static_cast<vtkIdType>(numBlocks));
+  }
+  batch->Data.clear();
+  batch->Sizes.clear();
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    vtkUnsignedCharArray* outputArray = outputArrays[i];
+    if (!outputArray)
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+      return 0;
+    }
+
+    // Write the compressed data.
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    result = this->DataStream->Write(outputArray->GetPointer(0), outputSize);
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
   this->Stream->flush();
   if (this->Stream->fail())
   {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
-
   return result;
 }
 
@@ -2332,6 +2430,25 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  // Pad raw values to their alignment in the file, so that readers can
+  // memory map them, see vtkXMLReader::SetMemoryMapAppendedData().
+  if (this->AlignAppendedData && !this->EncodeAppendedData && !this->Compressor &&
+    vtkArrayDownCast<vtkDataArray>(a))
+  {
+    const vtkTypeInt64 wordSize =
+      static_cast<vtkTypeInt64>(this->GetOutputWordTypeSize(a->GetDataType()));
+    const vtkTypeInt64 headerSize = this->HeaderType == vtkXMLWriter::UInt64 ? 8 : 4;
+    if (wordSize > 1 && wordSize <= 8 && (wordSize & (wordSize - 1)) == 0)
+    {
+      ostream& os = *(this->Stream);
+      const vtkTypeInt64 misalignment = (vtkTypeInt64(os.tellp()) + headerSize) % wordSize;
+      if (misalignment)
+      {
+        const char padding[8] = { 0 };
+        os.write(padding, wordSize - misalignment);
+      }
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
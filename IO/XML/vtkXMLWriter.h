@@ -52,6 +52,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
 class vtkXMLDataHeader;
+class vtkXMLWriterCompressionBatch;
 
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -227,6 +228,22 @@ public:
   vtkBooleanMacro(EncodeAppendedData, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Get/Set whether the values of the arrays written uncompressed in a raw
+   * appended data section are aligned to the size of their type in the
+   * file. Zero bytes are then written before the headers of the arrays, so
+   * the file is larger and differs from an unaligned one, but readers can
+   * memory map the aligned arrays, see
+   * vtkXMLReader::SetMemoryMapAppendedData(). Readers skip the padding
+   * through the array offsets, so any reader can read the file. The default
+   * is not to align the values.
+   */
+  vtkSetMacro(AlignAppendedData, vtkTypeBool);
+  vtkGetMacro(AlignAppendedData, vtkTypeBool);
+  vtkBooleanMacro(AlignAppendedData, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Assign a data object as input. Note that this method does not
@@ -308,6 +325,9 @@ protected:
   // Whether to base64-encode the appended data section.
   vtkTypeBool EncodeAppendedData;
 
+  // Whether to align the raw uncompressed appended values.
+  vtkTypeBool AlignAppendedData;
+
   // The stream position at which appended data starts.
   vtkTypeInt64 AppendedDataPosition;
 
@@ -339,6 +359,8 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  // Blocks waiting to be compressed in parallel.
+  vtkXMLWriterCompressionBatch* CompressionBatch;
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel = 5;
@@ -462,6 +484,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -21,12 +21,14 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -601,6 +603,38 @@ size_t vtkXMLDataParser::FindBlockSize(vtkTypeUInt64 block)
   }
 }
 
+namespace
+{
+// Decompress the full blocks [begin, end) of a range of blocks read at once.
+struct UncompressBlocksFunctor
+{
+  vtkDataCompressor* Compressor;
+  const unsigned char* CompressedData;
+  const vtkTypeInt64* BlockStartOffsets;
+  const size_t* BlockCompressedSizes;
+  size_t BlockSize;
+  vtkTypeUInt64 FirstBlock;
+  unsigned char* Output;
+  std::atomic<bool> Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkTypeInt64 firstOffset = this->BlockStartOffsets[this->FirstBlock];
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const unsigned char* in =
+        this->CompressedData + (this->BlockStartOffsets[block] - firstOffset);
+      unsigned char* out = this->Output + (block - this->FirstBlock) * this->BlockSize;
+      if (this->Compressor->Uncompress(in, this->BlockCompressedSizes[block], out,
+            this->BlockSize) != this->BlockSize)
+      {
+        this->Failed = true;
+      }
+    }
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer)
 {
@@ -639,6 +673,46 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 begin, vtkTypeUInt64 end, unsigned char* buffer)
+{
+  // The compressed blocks follow each other in the stream, so that they are
+  // read at once, and then decompressed in parallel. All the blocks but the
+  // last one of the data are full.
+  const vtkTypeInt64 beginOffset = this->BlockStartOffsets[begin];
+  const size_t compressedSize = static_cast<size_t>(
+    this->BlockStartOffsets[end - 1] + this->BlockCompressedSizes[end - 1] - beginOffset);
+  if (!this->DataStream->Seek(beginOffset))
+  {
+    return 0;
+  }
+
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  UncompressBlocksFunctor uncompress;
+  uncompress.Compressor = this->Compressor;
+  uncompress.CompressedData = readBuffer.data();
+  uncompress.BlockStartOffsets = this->BlockStartOffsets;
+  uncompress.BlockCompressedSizes = this->BlockCompressedSizes;
+  uncompress.BlockSize = this->BlockUncompressedSize;
+  uncompress.FirstBlock = begin;
+  uncompress.Output = buffer;
+  uncompress.Failed = false;
+  if (this->Compressor->IsThreadSafe())
+  {
+    vtkSMPTools::For(static_cast<vtkIdType>(begin), static_cast<vtkIdType>(end), 1, uncompress);
+  }
+  else
+  {
+    uncompress(static_cast<vtkIdType>(begin), static_cast<vtkIdType>(end));
+  }
+  return uncompress.Failed ? 0 : 1;
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -811,21 +885,27 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the full blocks by batches of a few blocks per thread.
+    const vtkTypeUInt64 batchSize =
+      4 * static_cast<vtkTypeUInt64>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock != lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      // Read these blocks.
+      vtkTypeUInt64 endBlock = std::min(lastBlock, currentBlock + batchSize);
+      if (!this->ReadBlocks(currentBlock, endBlock, outputPointer))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      size_t batchLength = static_cast<size_t>(endBlock - currentBlock) * blockSize;
+      this->PerformByteSwap(outputPointer, batchLength / wordSize, wordSize);
 
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += batchLength;
+      currentBlock = endBlock;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -973,6 +1053,45 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::GetAppendedDataFilePosition(
+  vtkTypeInt64 offset, vtkTypeUInt64 startWord, size_t numWords, int wordType)
+{
+  if (!this->AppendedDataPosition || this->Compressor ||
+    this->AppendedDataStream->IsA("vtkBase64InputStream"))
+  {
+    return -1;
+  }
+  size_t wordSize = this->GetWordTypeSize(wordType);
+#ifdef VTK_WORDS_BIGENDIAN
+  if (wordSize > 1 && this->ByteOrder != vtkXMLDataParser::BigEndian)
+#else
+  if (wordSize > 1 && this->ByteOrder != vtkXMLDataParser::LittleEndian)
+#endif
+  {
+    return -1;
+  }
+
+  // Read the length of the data.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  istream* stream = this->GetStream();
+  stream->clear(stream->rdstate() & ~ios::eofbit);
+  stream->clear(stream->rdstate() & ~ios::failbit);
+  this->SeekG(this->AppendedDataPosition + offset);
+  if (!stream->read(reinterpret_cast<char*>(uh->Data()), headerSize))
+  {
+    return -1;
+  }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  if ((startWord + numWords) * wordSize > uh->Get(0))
+  {
+    return -1;
+  }
+  return this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize) +
+    static_cast<vtkTypeInt64>(startWord * wordSize);
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -158,6 +158,16 @@ public:
    */
   vtkTypeInt64 GetAppendedDataPosition() { return this->AppendedDataPosition; }
 
+  /**
+   * Returns the byte index in the file of the word @a startWord of the
+   * data at the given appended data offset, if @a numWords words of type
+   * @a wordType can be used there without decoding them: the appended
+   * data is raw and not compressed, and its byte order is the one of this
+   * machine. Returns -1 otherwise, or if the data holds fewer words.
+   */
+  vtkTypeInt64 GetAppendedDataFilePosition(
+    vtkTypeInt64 offset, vtkTypeUInt64 startWord, size_t numWords, int wordType);
+
 protected:
   vtkXMLDataParser();
   ~vtkXMLDataParser() override;
@@ -186,6 +196,7 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 begin, vtkTypeUInt64 end, unsigned char* buffer);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -0,0 +1,253 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTestDataSetComparison.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Comparisons of the outputs of two runs of a filter, typically its serial
+// and threaded paths. Values are compared exactly, unless a relative
+// tolerance is given. Each function prints the first difference found to
+// std::cerr and returns false.
+
+#ifndef vtkTestDataSetComparison_h
+#define vtkTestDataSetComparison_h
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream> // for std::cerr
+
+namespace vtkTest
+{
+inline bool SameValues(double a, double b, double tolerance)
+{
+  return tolerance > 0.0 ? vtkMathUtilities::FuzzyCompare(a, b, tolerance) : a == b;
+}
+
+// Both arrays must exist and have the same size and values.
+inline bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* what, double tolerance = 0.0)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    std::cerr << what << ": missing array or sizes differ" << std::endl;
+    return false;
+  }
+  int nc = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < nc; ++c)
+    {
+      if (!SameValues(a->GetComponent(i, c), b->GetComponent(i, c), tolerance))
+      {
+        std::cerr << what << ": value " << i * nc + c << " differs" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The attributes must hold the same data arrays. Named arrays are matched by
+// name, unnamed ones by index.
+inline bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b, double tolerance = 0.0)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    std::cerr << "Numbers of arrays differ" << std::endl;
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = a->GetArray(i);
+    if (!array)
+    {
+      continue;
+    }
+    const char* name = array->GetName();
+    vtkDataArray* other = name ? b->GetArray(name) : b->GetArray(i);
+    if (!SameArrays(array, other, name ? name : "unnamed", tolerance))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool SameCells(vtkCellArray* a, vtkCellArray* b, const char* what)
+{
+  return SameArrays(a->GetOffsetsArray(), b->GetOffsetsArray(), what) &&
+    SameArrays(a->GetConnectivityArray(), b->GetConnectivityArray(), what);
+}
+
+// Same points and cells, attributes are not compared.
+inline bool SamePolyDataGeometry(vtkPolyData* a, vtkPolyData* b, double tolerance = 0.0)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    std::cerr << "Sizes differ: " << a->GetNumberOfPoints() << "/" << a->GetNumberOfCells()
+              << " vs " << b->GetNumberOfPoints() << "/" << b->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  if (a->GetNumberOfPoints() > 0 &&
+    !SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData(), "Points", tolerance))
+  {
+    return false;
+  }
+  return SameCells(a->GetVerts(), b->GetVerts(), "Verts") &&
+    SameCells(a->GetLines(), b->GetLines(), "Lines") &&
+    SameCells(a->GetPolys(), b->GetPolys(), "Polys") &&
+    SameCells(a->GetStrips(), b->GetStrips(), "Strips");
+}
+
+// Same points, cells and attributes.
+inline bool SamePolyData(vtkPolyData* a, vtkPolyData* b, double tolerance = 0.0)
+{
+  return SamePolyDataGeometry(a, b, tolerance) &&
+    SameAttributes(a->GetPointData(), b->GetPointData(), tolerance) &&
+    SameAttributes(a->GetCellData(), b->GetCellData(), tolerance);
+}
+
+// Same points, cells, cell types and attributes.
+inline bool SameUnstructuredGrids(
+  vtkUnstructuredGrid* a, vtkUnstructuredGrid* b, double tolerance = 0.0)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    std::cerr << "Sizes differ: " << a->GetNumberOfPoints() << "/" << a->GetNumberOfCells()
+              << " vs " << b->GetNumberOfPoints() << "/" << b->GetNumberOfCells() << std::endl;
+    return false;
+  }
+  if (a->GetNumberOfCells() == 0)
+  {
+    return true;
+  }
+  return SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData(), "Points", tolerance) &&
+    SameCells(a->GetCells(), b->GetCells(), "Cells") &&
+    SameArrays(a->GetCellTypesArray(), b->GetCellTypesArray(), "Cell types") &&
+    SameAttributes(a->GetPointData(), b->GetPointData(), tolerance) &&
+    SameAttributes(a->GetCellData(), b->GetCellData(), tolerance);
+}
+
+inline bool SameTuples(
+  vtkDataArray* a, vtkIdType aId, vtkDataArray* b, vtkIdType bId, double tolerance)
+{
+  for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+  {
+    if (!SameValues(a->GetComponent(aId, c), b->GetComponent(bId, c), tolerance))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compare two outputs cell by cell when their points may be numbered in a
+// different order, or some unused points be kept by only one of them: the
+// points of each cell are compared through their coordinates and data.
+inline bool SameCellsByPoints(vtkDataSet* a, vtkDataSet* b, double tolerance = 0.0)
+{
+  vtkPointData* aPD = a->GetPointData();
+  vtkPointData* bPD = b->GetPointData();
+  vtkCellData* aCD = a->GetCellData();
+  vtkCellData* bCD = b->GetCellData();
+  if (a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    aPD->GetNumberOfArrays() != bPD->GetNumberOfArrays() ||
+    aCD->GetNumberOfArrays() != bCD->GetNumberOfArrays())
+  {
+    std::cerr << "Sizes differ: " << a->GetNumberOfCells() << " vs " << b->GetNumberOfCells()
+              << std::endl;
+    return false;
+  }
+  for (int i = 0; i < aCD->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = aCD->GetArray(i);
+    vtkDataArray* other = bCD->GetArray(i);
+    if (array && (!other || other->GetNumberOfTuples() != array->GetNumberOfTuples() ||
+                   other->GetNumberOfComponents() != array->GetNumberOfComponents()))
+    {
+      std::cerr << "Cell data arrays differ" << std::endl;
+      return false;
+    }
+  }
+  for (int i = 0; i < aPD->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = aPD->GetArray(i);
+    vtkDataArray* other = bPD->GetArray(i);
+    if (array && (!other || other->GetNumberOfComponents() != array->GetNumberOfComponents()))
+    {
+      std::cerr << "Point data arrays differ" << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkIdList> aPts;
+  vtkNew<vtkIdList> bPts;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, aPts);
+    b->GetCellPoints(cellId, bPts);
+    if (a->GetCellType(cellId) != b->GetCellType(cellId) ||
+      aPts->GetNumberOfIds() != bPts->GetNumberOfIds())
+    {
+      std::cerr << "Cell " << cellId << " differs" << std::endl;
+      return false;
+    }
+    for (int i = 0; i < aCD->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = aCD->GetArray(i);
+      if (array && !SameTuples(array, cellId, bCD->GetArray(i), cellId, tolerance))
+      {
+        std::cerr << "Data of cell " << cellId << " differs" << std::endl;
+        return false;
+      }
+    }
+    for (vtkIdType i = 0; i < aPts->GetNumberOfIds(); ++i)
+    {
+      double x[3], y[3];
+      a->GetPoint(aPts->GetId(i), x);
+      b->GetPoint(bPts->GetId(i), y);
+      if (!SameValues(x[0], y[0], tolerance) || !SameValues(x[1], y[1], tolerance) ||
+        !SameValues(x[2], y[2], tolerance))
+      {
+        std::cerr << "Point " << i << " of cell " << cellId << " differs" << std::endl;
+        return false;
+      }
+      for (int j = 0; j < aPD->GetNumberOfArrays(); ++j)
+      {
+        vtkDataArray* array = aPD->GetArray(j);
+        if (array &&
+          !SameTuples(array, aPts->GetId(i), bPD->GetArray(j), bPts->GetId(i), tolerance))
+        {
+          std::cerr << "Data of point " << i << " of cell " << cellId << " differs" << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkTestDataSetComparison.h
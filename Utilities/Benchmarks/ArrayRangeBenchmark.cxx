@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ArrayRangeBenchmark.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Report the time of vtkDataArray::GetRange() and GetFiniteRange() for arrays
+of float, double and int values, in the AOS and SOA layouts, with 1 and 3
+components, for the first call and for the following calls which use the
+cached ranges.
+
+Usage: ArrayRangeBenchmark [numberOfValues [numberOfThreads]]
+
+The arrays hold numberOfValues values (default 2^24). numberOfThreads is
+passed to vtkSMPTools::Initialize() (default: all the threads).
+*/
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+const int NumberOfRuns = 10;
+
+template <typename ArrayT>
+vtkSmartPointer<vtkDataArray> MakeArray(vtkIdType numValues, int numComps)
+{
+  using ValueType = typename ArrayT::ValueType;
+  auto array = vtkSmartPointer<ArrayT>::New();
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(numValues / numComps);
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      array->SetTypedComponent(
+        t, c, static_cast<ValueType>(((t * 7919 + c * 31) % 100000) - 50000) / 8);
+    }
+  }
+  return array;
+}
+
+// Return the mean time of the computation of the ranges of all the
+// components, computed again at each run unless cached.
+double TimeRanges(vtkDataArray* array, bool finite, bool cached)
+{
+  vtkNew<vtkTimerLog> timer;
+  double range[2];
+  double time = 0.0;
+  for (int run = 0; run < NumberOfRuns; ++run)
+  {
+    if (!cached)
+    {
+      array->Modified();
+    }
+    timer->StartTimer();
+    for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+    {
+      if (finite)
+      {
+        array->GetFiniteRange(range, c);
+      }
+      else
+      {
+        array->GetRange(range, c);
+      }
+    }
+    timer->StopTimer();
+    time += timer->GetElapsedTime();
+  }
+  return time / NumberOfRuns;
+}
+
+template <typename ValueType>
+void RunLayouts(const char* typeName, vtkIdType numValues)
+{
+  for (int numComps : { 1, 3 })
+  {
+    vtkSmartPointer<vtkDataArray> arrays[] = {
+      MakeArray<vtkAOSDataArrayTemplate<ValueType>>(numValues, numComps),
+      MakeArray<vtkSOADataArrayTemplate<ValueType>>(numValues, numComps)
+    };
+    const char* layouts[] = { "AOS", "SOA" };
+    for (int i = 0; i < 2; ++i)
+    {
+      std::cout << std::setw(8) << typeName << std::setw(8) << layouts[i] << std::setw(8)
+                << numComps << std::setw(12) << TimeRanges(arrays[i], false, false)
+                << std::setw(12) << TimeRanges(arrays[i], true, false) << std::setw(12)
+                << TimeRanges(arrays[i], false, true) << std::endl;
+    }
+  }
+}
+}
+
+int main(int argc, char* argv[])
+{
+  vtkIdType numValues = argc > 1 ? atoll(argv[1]) : (1 << 24);
+  int numThreads = argc > 2 ? atoi(argv[2]) : 0;
+  if (numValues < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " [numberOfValues [numberOfThreads]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkSMPTools::Initialize(numThreads);
+
+  std::cout << numValues << " values, " << vtkSMPTools::GetEstimatedNumberOfThreads()
+            << " threads, " << vtkSMPTools::GetBackend() << " backend" << std::endl;
+  std::cout << std::setw(8) << "type" << std::setw(8) << "layout" << std::setw(8) << "comps"
+            << std::setw(12) << "range" << std::setw(12) << "finite" << std::setw(12)
+            << "cached" << std::endl;
+  RunLayouts<float>("float", numValues);
+  RunLayouts<double>("double", numValues);
+  RunLayouts<int>("int", numValues);
+
+  return EXIT_SUCCESS;
+}
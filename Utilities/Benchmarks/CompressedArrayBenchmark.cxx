@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    CompressedArrayBenchmark.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Report the memory and the throughput of typical filters when the point data
+of an image is kept in vtkCompressedDataArray, for each compressor of VTK.
+
+Usage: CompressedArrayBenchmark [dimension [blockSize]]
+
+The image is the output of vtkRTAnalyticSource, of dimension^3 points
+(default 128), with its RTData scalars and an elevation array.
+*/
+
+#include "vtkArrayCompressor.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkImageData.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkLZMADataCompressor.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+unsigned long PointDataSize(vtkImageData* image)
+{
+  unsigned long size = 0;
+  vtkPointData* pd = image->GetPointData();
+  for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+  {
+    size += pd->GetArray(i)->GetActualMemorySize();
+  }
+  return size;
+}
+
+// Run the filters on the image and print their times.
+void RunFilters(vtkImageData* image)
+{
+  vtkNew<vtkTimerLog> timer;
+
+  timer->StartTimer();
+  double range[2];
+  image->GetPointData()->GetArray("RTData")->GetRange(range);
+  image->GetPointData()->GetArray("Elevation")->GetRange(range);
+  timer->StopTimer();
+  std::cout << std::setw(12) << timer->GetElapsedTime();
+
+  vtkNew<vtkPointDataToCellData> toCells;
+  toCells->SetInputData(image);
+  timer->StartTimer();
+  toCells->Update();
+  timer->StopTimer();
+  std::cout << std::setw(12) << timer->GetElapsedTime();
+
+  vtkNew<vtkFlyingEdges3D> contour;
+  contour->SetInputData(image);
+  contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  contour->SetValue(0, 150.0);
+  timer->StartTimer();
+  contour->Update();
+  timer->StopTimer();
+  std::cout << std::setw(12) << timer->GetElapsedTime() << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  int dimension = argc > 1 ? atoi(argv[1]) : 128;
+  vtkIdType blockSize = argc > 2 ? atoi(argv[2]) : 16384;
+  if (dimension < 2 || blockSize < 1)
+  {
+    std::cerr << "Usage: " << argv[0] << " [dimension [blockSize]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Filters reading the scalars through GetVoidPointer() decompress them
+  // entirely, which is part of the measure.
+  vtksys::SystemTools::PutEnv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS=1");
+
+  vtkNew<vtkRTAnalyticSource> source;
+  int half = dimension / 2;
+  source->SetWholeExtent(-half, dimension - half - 1, -half, dimension - half - 1, -half,
+    dimension - half - 1);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  elevation->SetLowPoint(-half, 0.0, 0.0);
+  elevation->SetHighPoint(half, 0.0, 0.0);
+  elevation->Update();
+  vtkImageData* image = vtkImageData::SafeDownCast(elevation->GetOutput());
+
+  std::cout << dimension << "^3 points, blocks of " << blockSize << " tuples" << std::endl;
+  std::cout << std::setw(10) << "codec" << std::setw(12) << "KiB" << std::setw(12) << "ratio"
+            << std::setw(12) << "compress" << std::setw(12) << "decompress" << std::setw(12)
+            << "range" << std::setw(12) << "toCells" << std::setw(12) << "contour"
+            << std::endl;
+
+  const unsigned long originalSize = PointDataSize(image);
+  std::cout << std::setw(10) << "none" << std::setw(12) << originalSize << std::setw(12) << 1.0
+            << std::setw(12) << 0.0 << std::setw(12) << 0.0;
+  RunFilters(image);
+
+  vtkSmartPointer<vtkDataCompressor> compressors[] = {
+    vtkSmartPointer<vtkLZ4DataCompressor>::New(), vtkSmartPointer<vtkZLibDataCompressor>::New(),
+    vtkSmartPointer<vtkLZMADataCompressor>::New()
+  };
+  const char* names[] = { "lz4", "zlib", "lzma" };
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkNew<vtkImageData> compressed;
+    compressed->ShallowCopy(image);
+    vtkNew<vtkArrayCompressor> arrayCompressor;
+    arrayCompressor->SetCompressor(compressors[i]);
+    arrayCompressor->SetBlockSize(blockSize);
+
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    arrayCompressor->CompressArrays(compressed);
+    timer->StopTimer();
+    double compressTime = timer->GetElapsedTime();
+    const unsigned long compressedSize = PointDataSize(compressed);
+
+    vtkNew<vtkImageData> decompressed;
+    decompressed->ShallowCopy(compressed);
+    timer->StartTimer();
+    arrayCompressor->DecompressArrays(decompressed);
+    timer->StopTimer();
+
+    std::cout << std::setw(10) << names[i] << std::setw(12) << compressedSize << std::setw(12)
+              << static_cast<double>(originalSize) / compressedSize << std::setw(12)
+              << compressTime << std::setw(12) << timer->GetElapsedTime();
+    RunFilters(compressed);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    XMLCompressionBenchmark.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Report the time taken to write and read back a compressed .vti file, for
+each compressor of VTK, on one thread and on numberOfThreads threads, and
+check that the files written with both thread counts are identical.
+
+Usage: XMLCompressionBenchmark [dimension [numberOfThreads [fileName]]]
+
+The image is the output of vtkRTAnalyticSource, of dimension^3 points
+(default 128), with its RTData scalars and an elevation array. The file is
+written to fileName (default XMLCompressionBenchmark.vti) and removed at
+the end.
+*/
+
+#include "vtkElevationFilter.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// Write the image, then read it back, and print the times.
+void WriteAndRead(vtkImageData* image, int compressorType, const std::string& fileName)
+{
+  vtkNew<vtkTimerLog> timer;
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorType(compressorType);
+  timer->StartTimer();
+  writer->Write();
+  timer->StopTimer();
+  std::cout << std::setw(12) << timer->GetElapsedTime();
+
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  std::cout << std::setw(12) << timer->GetElapsedTime();
+}
+}
+
+int main(int argc, char* argv[])
+{
+  int dimension = argc > 1 ? atoi(argv[1]) : 128;
+  int numThreads = argc > 2 ? atoi(argv[2]) : 0;
+  std::string fileName = argc > 3 ? argv[3] : "XMLCompressionBenchmark.vti";
+  if (dimension < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " [dimension [numberOfThreads [fileName]]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkRTAnalyticSource> source;
+  int half = dimension / 2;
+  source->SetWholeExtent(-half, dimension - half - 1, -half, dimension - half - 1, -half,
+    dimension - half - 1);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  elevation->SetLowPoint(-half, 0.0, 0.0);
+  elevation->SetHighPoint(half, 0.0, 0.0);
+  elevation->Update();
+  vtkImageData* image = vtkImageData::SafeDownCast(elevation->GetOutput());
+
+  vtkSMPTools::Initialize(numThreads);
+  numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  std::cout << dimension << "^3 points, " << vtkSMPTools::GetBackend() << " backend" << std::endl;
+  const std::string threads = std::to_string(numThreads);
+  std::cout << std::setw(10) << "codec" << std::setw(12) << "write 1" << std::setw(12)
+            << "read 1" << std::setw(12) << "write " + threads << std::setw(12)
+            << "read " + threads << std::setw(12) << "KiB" << std::setw(12) << "identical"
+            << std::endl;
+
+  const int compressors[] = { vtkXMLWriter::LZ4, vtkXMLWriter::ZLIB, vtkXMLWriter::LZMA };
+  const char* names[] = { "lz4", "zlib", "lzma" };
+  const std::string serialFileName = fileName + ".serial";
+  bool identical = true;
+  for (int i = 0; i < 3; ++i)
+  {
+    std::cout << std::setw(10) << names[i];
+    vtkSMPTools::Initialize(1);
+    WriteAndRead(image, compressors[i], serialFileName);
+    vtkSMPTools::Initialize(numThreads);
+    WriteAndRead(image, compressors[i], fileName);
+
+    const bool same = !vtksys::SystemTools::FilesDiffer(serialFileName, fileName);
+    identical = identical && same;
+    std::cout << std::setw(12) << vtksys::SystemTools::FileLength(fileName) / 1024
+              << std::setw(12) << (same ? "yes" : "NO") << std::endl;
+  }
+  vtksys::SystemTools::RemoveFile(serialFileName);
+  vtksys::SystemTools::RemoveFile(fileName);
+
+  return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}